@@ -135,14 +135,36 @@ void analogFrequency(uint32_t);
 void analogReadResolution(uint16_t);
 
 void delay(uint32_t milliseconds);
+void setTimerSlack(uint32_t milliseconds);
 
-/* Implemented in wiring.c */
+/* Implemented in wiring_timebase.c */
 void delayMicroseconds(unsigned int us);
+void delayMicrosecondsAtomic(unsigned int us);
 unsigned long micros();
 unsigned long millis();
+uint64_t micros64();
+uint32_t cyclesNow();
 
 void setDelayResolution(uint32_t milliseconds);
 
+/* Implemented in wiring_capture.c */
+int pulseCaptureBegin(uint8_t pin, uint32_t *buffer, uint16_t size);
+int pulseCaptureAvailable(uint8_t pin);
+int pulseCaptureRead(uint8_t pin, unsigned long *width);
+uint32_t pulseCaptureOverruns(uint8_t pin);
+void pulseCaptureEnd(uint8_t pin);
+
+/* Implemented in wiring_analog_stream.c */
+typedef void (*AnalogStreamCallback)(uint8_t pin, uint16_t *samples,
+    uint32_t *microVolts, uint16_t count, uint64_t timestamp);
+int analogReadStream(uint8_t pin, uint32_t rateHz, uint16_t *bufA,
+    uint16_t *bufB, uint16_t count, AnalogStreamCallback callback);
+int analogReadStreamPins(const uint8_t *pins, uint8_t numPins,
+    uint32_t rateHz, uint16_t *bufA, uint16_t *bufB, uint16_t count,
+    AnalogStreamCallback callback);
+void analogReadStreamMicroVolts(uint32_t *microVolts);
+void analogReadStreamEnd(void);
+
 /* our interrupt APIs take pin numbers */
 #define digitalPinToInterrupt(pin) pin
 
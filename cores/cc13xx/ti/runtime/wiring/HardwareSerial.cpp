@@ -34,16 +34,23 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/family/arm/m3/Hwi.h>
 
+#include <ti/drivers/uart/UARTCC26XX.h>
+
 #include "wiring_private.h"
 #include "HardwareSerial.h"
 
-#define RX_BUFFER_EMPTY   (rxReadIndex == rxWriteIndex)
-#define RX_BUFFER_FULL    (((rxWriteIndex + 1) % SERIAL_RX_BUFFER_SIZE) == rxReadIndex)
-
-#define TX_BUFFER_EMPTY   (txReadIndex == txWriteIndex)
-#define TX_BUFFER_FULL    (((txWriteIndex + 1) % SERIAL_TX_BUFFER_SIZE) == txReadIndex)
+/*
+ * rxRing: filled by readCallback(), drained by peek() and read(). Several
+ * threads may read at once, and readCallback() drops the oldest character
+ * when the ring is full, so consumers update the tail with Hwi_disable().
+ * txRing: drained by writeCallback(); write() can be called from several
+ * threads at once so producers still serialize with Hwi_disable().
+ */
+#define RX_BUFFER_COUNT   SPSCRing_getCount(&rxRing)
+#define TX_BUFFER_FULL    (SPSCRing_getSpace(&txRing) == 0)
 
 HardwareSerial::HardwareSerial(void)
 {
@@ -71,8 +78,14 @@ void HardwareSerial::init(unsigned long module, UART_Callback rCallback, UART_Ca
     /* by default, read() will not block */
     blockingModeEnabled = false;
 
+    /* by default, receive one character per UART callback */
+    rxStreaming = false;
+    rxBuffer = rxDefaultBuffer;
+    rxBufferSize = SERIAL_RX_BUFFER_SIZE;
+
     uartModule = module;
     begun = false;
+    txSemConstructed = false;
 }
 
 void HardwareSerial::flushAll(void)
@@ -103,11 +116,14 @@ void HardwareSerial::begin(unsigned long baud)
         uartParams.readCallback = rxCallback;
         uartParams.writeMode = UART_MODE_CALLBACK;
         uartParams.writeCallback = txCallback;
-        rxWriteIndex = 0;
-        rxReadIndex = 0;
-        txWriteIndex = 0;
-        txReadIndex = 0;
+        SPSCRing_construct(&rxRing, rxBuffer, rxBufferSize);
+        rxActive = false;
+        rxOverruns = 0;
+        rxUartOverruns = 0;
+        rxHighWater = 0;
+        SPSCRing_construct(&txRing, txBuffer, SERIAL_TX_BUFFER_SIZE);
         txActive = false;
+        txWaiters = 0;
     }
 
     uartParams.readDataMode = UART_DATA_BINARY;
@@ -121,8 +137,20 @@ void HardwareSerial::begin(unsigned long baud)
     if (uart != NULL) {
         GateMutex_construct(&gate, NULL);
         if (blockingModeEnabled == false) {
+            /* txSem outlives end(), which wakes any writers blocked on it */
+            if (txSemConstructed == false) {
+                Semaphore_construct(&txSem, 0, NULL);
+                txSemConstructed = true;
+            }
+            if (rxStreaming == true) {
+                /* let reads complete on the RX FIFO timeout */
+                UART_control(uart, UARTCC26XX_CMD_RETURN_PARTIAL_ENABLE, NULL);
+                begun = TRUE;
+                primeRx();
+                return;
+            }
             /* start the read process */
-            UART_read(uart, &rxBuffer[rxWriteIndex], 1);
+            UART_read(uart, rxSlot(), 1);
         }
         begun = TRUE;
     }
@@ -134,6 +162,38 @@ void HardwareSerial::begin(unsigned long baud, bool blockModeEnabled)
     begin(baud);
 }
 
+/*
+ * Open the port in streaming RX mode.
+ *
+ * Received data is read by the UART driver straight into an rxSize byte
+ * ring, as many bytes per callback as are contiguously free, instead of
+ * one byte per callback. rxSize is rounded down to a power of two.
+ * Falls back to the default SERIAL_RX_BUFFER_SIZE ring if rxSize bytes
+ * cannot be allocated.
+ */
+void HardwareSerial::beginStream(unsigned long baud, size_t rxSize)
+{
+    unsigned char *buf;
+
+    if (begun == TRUE) return;
+
+    while (rxSize & (rxSize - 1)) {
+        rxSize &= rxSize - 1;
+    }
+
+    if (rxSize > SERIAL_RX_BUFFER_SIZE) {
+        buf = (unsigned char *)malloc(rxSize);
+        if (buf != NULL) {
+            rxBuffer = buf;
+            rxBufferSize = rxSize;
+        }
+    }
+
+    blockingModeEnabled = false;
+    rxStreaming = true;
+    begin(baud);
+}
+
 void HardwareSerial::setModule(unsigned long module)
 {
     /* Change which pins UART is on */
@@ -157,9 +217,26 @@ void HardwareSerial::release(void)
 
 void HardwareSerial::end(void)
 {
+    unsigned int hwiKey;
+
     begun = false;
     UART_close(uart);
     uart = NULL;
+
+    /* release the tasks blocked in write(); they see begun == false */
+    hwiKey = Hwi_disable();
+    while (txWaiters) {
+        txWaiters--;
+        Semaphore_post(Semaphore_handle(&txSem));
+    }
+    Hwi_restore(hwiKey);
+
+    if (rxBuffer != rxDefaultBuffer) {
+        free(rxBuffer);
+        rxBuffer = rxDefaultBuffer;
+        rxBufferSize = SERIAL_RX_BUFFER_SIZE;
+    }
+    rxStreaming = false;
 }
 
 int HardwareSerial::available(void)
@@ -182,16 +259,21 @@ int HardwareSerial::available(void)
     else {
         unsigned int key;
 
+        if (rxStreaming == true) {
+            if (rxActive == false) {
+                primeRx();
+            }
+            return (RX_BUFFER_COUNT);
+        }
+
         key = Hwi_disable();
 
-        if (RX_BUFFER_EMPTY) {
+        if (RX_BUFFER_COUNT == 0) {
             /* kick off another character read operation */
-            UART_read(uart, &rxBuffer[rxWriteIndex], 1);
+            UART_read(uart, rxSlot(), 1);
         }
 
-        numChars = (rxWriteIndex >= rxReadIndex) ?
-            (rxWriteIndex - rxReadIndex)
-            : SERIAL_RX_BUFFER_SIZE - (rxReadIndex - rxWriteIndex);
+        numChars = RX_BUFFER_COUNT;
 
         Hwi_restore(key);
 
@@ -217,12 +299,21 @@ int HardwareSerial::peek(void)
         }
     }
     else {
+        unsigned int hwiKey;
+        unsigned char c;
+
+        hwiKey = Hwi_disable();
+
         if (available() == 0) {
-            return (-1);
+            iChar = -1;
+        }
+        else {
+            /* Read a character from the buffer. */
+            SPSCRing_peek(&rxRing, &c);
+            iChar = (int)c;
         }
 
-        /* Read a character from the buffer. */
-        iChar = (int)rxBuffer[rxReadIndex];
+        Hwi_restore(hwiKey);
 
         /* Return the character to the caller. */
         return (iChar);
@@ -248,17 +339,72 @@ int HardwareSerial::read(void)
 
         iChar = peek();
 
-        /* if a character is available, update buffer ptrs */
+        /* if a character is available, release its slot */
         if (iChar != -1) {
-            rxReadIndex = ((rxReadIndex) + 1) % SERIAL_RX_BUFFER_SIZE;
+            SPSCRing_consume(&rxRing, 1);
         }
 
         Hwi_restore(hwiKey);
 
+        if (rxStreaming == true && rxActive == false) {
+            primeRx();
+        }
+
         return (iChar);
     }
 }
 
+int HardwareSerial::read(uint8_t *buffer, size_t size)
+{
+    unsigned int hwiKey;
+    size_t count, chunk;
+
+    if (uart == NULL || size == 0) {
+        return (0);
+    }
+
+    if (blockingModeEnabled == true) {
+        return (UART_read(uart, buffer, size));
+    }
+
+    /* restarts the read process if needed */
+    available();
+
+    /* copy in ring-sized pieces to bound the time interrupts are off */
+    count = 0;
+    do {
+        hwiKey = Hwi_disable();
+        chunk = SPSCRing_read(&rxRing, buffer + count,
+            (size - count) < SERIAL_RX_BUFFER_SIZE ? (size - count) : SERIAL_RX_BUFFER_SIZE);
+        Hwi_restore(hwiKey);
+        count += chunk;
+    } while (chunk == SERIAL_RX_BUFFER_SIZE && count < size);
+
+    if (rxStreaming == true && rxActive == false) {
+        primeRx();
+    }
+
+    return (count);
+}
+
+/*
+ * Number of receive overruns: characters dropped because rxBuffer was
+ * full (the oldest one is dropped) or, in streaming mode, overrun errors
+ * reported by the UART.
+ */
+unsigned long HardwareSerial::getRxOverruns(void)
+{
+    return (rxOverruns);
+}
+
+/*
+ * Largest number of characters that have been waiting in rxBuffer
+ */
+unsigned long HardwareSerial::getRxHighWater(void)
+{
+    return (rxHighWater);
+}
+
 void HardwareSerial::flush()
 {
     if (blockingModeEnabled == false) {
@@ -290,29 +436,74 @@ size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
     }
     else {
         unsigned int hwiKey;
-        while (size) {
-            while (TX_BUFFER_FULL) {
-                if (txActive == false) {
-                    primeTx();
-                }
-            }
+        const uint8_t *src = buffer;
+        size_t remaining = size;
+        size_t count;
+
+        while (remaining) {
+            /* copy as much as fits in one pass */
             hwiKey = Hwi_disable();
-            txBuffer[txWriteIndex] = *buffer++;
-            txWriteIndex = (txWriteIndex + 1) % SERIAL_TX_BUFFER_SIZE;
-            size--;
+            count = SPSCRing_write(&txRing, src, remaining);
             Hwi_restore(hwiKey);
-        }
-        if ((txActive == false) && (!TX_BUFFER_EMPTY)) {
-            primeTx();
+
+            if (count == 0) {
+                waitTxSpace();
+                if (begun == false) {
+                    /* end() was called while waiting */
+                    return (size - remaining);
+                }
+                continue;
+            }
+
+            src += count;
+            remaining -= count;
+
+            if (txActive == false) {
+                primeTx();
+            }
         }
     }
 
     return (size);
 }
 
+/*
+ * Wait for writeCallback() to free up space in txBuffer.
+ *
+ * Tasks block on txSem; Hwi and Swi threads cannot block, so they
+ * spin until the UART driver has drained some of the buffer.
+ */
+void HardwareSerial::waitTxSpace(void)
+{
+    unsigned int hwiKey;
+
+    if (txActive == false) {
+        primeTx();
+    }
+
+    if (BIOS_getThreadType() != BIOS_ThreadType_Task) {
+        while (TX_BUFFER_FULL) ;
+        return;
+    }
+
+    hwiKey = Hwi_disable();
+
+    /* the buffer may have drained before interrupts were disabled */
+    if (!TX_BUFFER_FULL) {
+        Hwi_restore(hwiKey);
+        return;
+    }
+
+    txWaiters++;
+
+    Hwi_restore(hwiKey);
+
+    Semaphore_pend(Semaphore_handle(&txSem), BIOS_WAIT_FOREVER);
+}
+
 void HardwareSerial::primeTx(void) {
     unsigned int hwiKey;
-    size_t size;
+    SPSCRing_Span spans[2];
 
     hwiKey = Hwi_disable();
 
@@ -321,65 +512,136 @@ void HardwareSerial::primeTx(void) {
      * that calls Serial.print() has occurred just prior
      * to the call to primeTx().
      */
-    if (txActive == true) {
+    if (txActive == true || SPSCRing_peekSpans(&txRing, spans) == 0) {
         Hwi_restore(hwiKey);
         return;
     }
-    
-    if (txWriteIndex > txReadIndex) {
-        size = txWriteIndex - txReadIndex;
+
+    txActive = true;
+
+    Hwi_restore(hwiKey);
+
+    UART_write(uart, spans[0].buf, spans[0].len);
+}
+
+/*
+ * Next free byte of rxRing for a single character read, or rxDiscard
+ * if the ring is full.
+ */
+unsigned char *HardwareSerial::rxSlot(void)
+{
+    SPSCRing_Span spans[2];
+
+    if (SPSCRing_reserveSpans(&rxRing, spans) == 0) {
+        return (&rxDiscard);
     }
-    else {
-        size = SERIAL_TX_BUFFER_SIZE - txReadIndex;
+
+    return (spans[0].buf);
+}
+
+/*
+ * Hand the largest contiguous free span of rxBuffer to the UART driver.
+ *
+ * Used in streaming mode only. If rxBuffer is full, nothing is started
+ * and the next read() or available() call restarts the process.
+ */
+void HardwareSerial::primeRx(void)
+{
+    unsigned int hwiKey;
+    SPSCRing_Span spans[2];
+
+    hwiKey = Hwi_disable();
+
+    if (rxActive == true || begun == false) {
+        Hwi_restore(hwiKey);
+        return;
     }
 
-    txActive = true;
+    if (SPSCRing_reserveSpans(&rxRing, spans) == 0) {
+        Hwi_restore(hwiKey);
+        return;
+    }
+
+    rxActive = true;
 
     Hwi_restore(hwiKey);
 
-    UART_write(uart, &txBuffer[txReadIndex], size);
+    /* may call readCallback() directly with data already in the driver */
+    if (UART_read(uart, spans[0].buf, spans[0].len) == UART_ERROR) {
+        rxActive = false;
+    }
 }
 
 void HardwareSerial::readCallback(UART_Handle uart, void *buf, size_t count)
 {
-    uint8_t volatile full = RX_BUFFER_FULL;
+    unsigned long level;
+
+    if (rxStreaming == true) {
+        UARTCC26XX_Object *object = (UARTCC26XX_Object *)uart->object;
 
-    rxWriteIndex = ((rxWriteIndex) + 1) % SERIAL_RX_BUFFER_SIZE;
+        SPSCRing_commit(&rxRing, count);
+        rxActive = false;
 
-    if (full) {
-        rxReadIndex = ((rxReadIndex) + 1) % SERIAL_RX_BUFFER_SIZE;
+        /* status only holds the last error; the driver counts overruns */
+        rxOverruns += object->rxOverruns - rxUartOverruns;
+        rxUartOverruns = object->rxOverruns;
+
+        level = RX_BUFFER_COUNT;
+        if (level > rxHighWater) {
+            rxHighWater = level;
+        }
+
+        primeRx();
+        return;
+    }
+
+    /*
+     * the ring was full when the read was started: if it still is, drop
+     * the oldest char to make room for the new one; readers hold off
+     * interrupts while they move the tail, so this cannot race them
+     */
+    if (buf == &rxDiscard) {
+        if (SPSCRing_getSpace(&rxRing) == 0) {
+            SPSCRing_consume(&rxRing, 1);
+            rxOverruns++;
+        }
+        SPSCRing_put(&rxRing, rxDiscard);
+    }
+    else {
+        SPSCRing_commit(&rxRing, count);
+    }
+
+    level = RX_BUFFER_COUNT;
+    if (level > rxHighWater) {
+        rxHighWater = level;
     }
 }
 
 void HardwareSerial::writeCallback(UART_Handle uart, void *buf, size_t txCount)
 {
     unsigned int hwiKey;
-    size_t size;
+    SPSCRing_Span spans[2];
 
     hwiKey = Hwi_disable();
 
-    /*
-     * advance txReadIndex by the number of bytes
-     * sent by the last call to UART_write().
-     */
-    txReadIndex = (txReadIndex + txCount) % SERIAL_TX_BUFFER_SIZE;
+    /* release the bytes sent by the last call to UART_write() */
+    SPSCRing_consume(&txRing, txCount);
+
+    /* wake up every task blocked in write() waiting for space */
+    while (txWaiters) {
+        txWaiters--;
+        Semaphore_post(Semaphore_handle(&txSem));
+    }
 
-    if (TX_BUFFER_EMPTY) {
+    if (SPSCRing_peekSpans(&txRing, spans) == 0) {
         txActive = false;
         Hwi_restore(hwiKey);
         return;
     }
 
-    if (txWriteIndex > txReadIndex) {
-        size = txWriteIndex - txReadIndex;
-    }
-    else {
-        size = SERIAL_TX_BUFFER_SIZE - txReadIndex;
-    }
-
     Hwi_restore(hwiKey);
 
-    UART_write(uart, &txBuffer[txReadIndex], size);
+    UART_write(uart, spans[0].buf, spans[0].len);
 }
 
 void serialEvent() __attribute__((weak));
@@ -37,11 +37,13 @@
 #include "Stream.h"
 
 #include <ti/drivers/UART.h>
+#include <ti/drivers/utils/SPSCRing.h>
 
 #include <ti/sysbios/knl/Semaphore.h>
 #include <ti/sysbios/knl/Clock.h>
 #include <ti/sysbios/gates/GateMutex.h>
 
+/* ring sizes, must be powers of two */
 #define SERIAL_RX_BUFFER_SIZE  128
 #define SERIAL_TX_BUFFER_SIZE  128
 
@@ -51,13 +53,22 @@ class HardwareSerial : public Stream
     private:
         bool begun;
         bool blockingModeEnabled;
-        unsigned char rxBuffer[SERIAL_RX_BUFFER_SIZE];
-        volatile unsigned long rxWriteIndex;
-        volatile unsigned long rxReadIndex;
+        bool rxStreaming;
+        unsigned char rxDefaultBuffer[SERIAL_RX_BUFFER_SIZE];
+        unsigned char *rxBuffer;
+        unsigned long rxBufferSize;
+        SPSCRing_Object rxRing;
+        unsigned char rxDiscard;
+        volatile bool rxActive;
+        volatile unsigned long rxOverruns;
+        unsigned long rxUartOverruns;
+        volatile unsigned long rxHighWater;
         unsigned char txBuffer[SERIAL_TX_BUFFER_SIZE];
-        volatile unsigned long txWriteIndex;
-        volatile unsigned long txReadIndex;
+        SPSCRing_Object txRing;
         volatile bool txActive;
+        volatile unsigned int txWaiters;
+        Semaphore_Struct txSem;
+        bool txSemConstructed;
         unsigned long baudRate;
         uint8_t uartModule;
         UART_Handle uart;
@@ -67,6 +78,9 @@ class HardwareSerial : public Stream
         void init(unsigned long module, UART_Callback rxCallback, UART_Callback txCallback);
         void flushAll(void);
         void primeTx(void);
+        void primeRx(void);
+        unsigned char *rxSlot(void);
+        void waitTxSpace(void);
 
     public:
         operator bool();// Arduino compatibility (see StringLength example)
@@ -75,6 +89,7 @@ class HardwareSerial : public Stream
         HardwareSerial(unsigned long, UART_Callback, UART_Callback);
         void begin(unsigned long);
         void begin(unsigned long, bool);
+        void beginStream(unsigned long baud, size_t rxSize);
         void setModule(unsigned long);
         void setPins(unsigned long);
         void acquire(void);  /* acquire serial port for this thread */
@@ -83,6 +98,9 @@ class HardwareSerial : public Stream
         virtual int available(void);
         virtual int peek(void);
         virtual int read(void);
+        int read(uint8_t *buffer, size_t size);
+        unsigned long getRxOverruns(void);
+        unsigned long getRxHighWater(void);
         virtual void flush(void);
         void readCallback(UART_Handle uart, void *buf, size_t count);
         void writeCallback(UART_Handle uart, void *buf, size_t count);
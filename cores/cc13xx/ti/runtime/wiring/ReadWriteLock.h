@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Reader/writer lock for data shared between Tasks (sketch loops).
+ *
+ * A wrapper around ti/sysbios/gates/GateRW.h. Any number of readers may
+ * hold the lock at once; an uncontended read lock costs one atomic
+ * update. A writer holds it alone and runs at the priority of the
+ * highest Task waiting for it until it unlocks.
+ *
+ *   ReadWriteLock configLock;
+ *
+ *   {
+ *       ReadGuard guard(configLock);    // unlocked at the closing brace
+ *       value = config.value;
+ *   }
+ *
+ *   {
+ *       WriteGuard guard(configLock);
+ *       config.value = value;
+ *   }
+ *
+ * Not recursive, and not for use from interrupt handlers.
+ */
+
+#ifndef ReadWriteLock_h
+#define ReadWriteLock_h
+
+#include <stdint.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/gates/GateRW.h>
+
+class ReadWriteLock
+{
+    private:
+        GateRW_Struct gate;
+
+        /* the gate's wait queue must not be copied */
+        ReadWriteLock(const ReadWriteLock &);
+        ReadWriteLock &operator=(const ReadWriteLock &);
+
+        static UInt32 ticks(uint32_t milliseconds)
+        {
+            /* math below assumes tickPeriod is <= 1000 */
+            uint64_t t = ((uint64_t)milliseconds * (uint64_t)1000) /
+                (uint64_t)Clock_tickPeriod;
+
+            /* stay below BIOS_WAIT_FOREVER */
+            if (t > 0xFFFFFFFE) {
+                t = 0xFFFFFFFE;
+            }
+
+            return ((UInt32)t);
+        }
+
+    public:
+        ReadWriteLock(void) { GateRW_construct(&gate); }
+        ~ReadWriteLock(void) { GateRW_destruct(&gate); }
+
+        void readLock(void) { GateRW_enterRead(&gate, BIOS_WAIT_FOREVER); }
+        void readUnlock(void) { GateRW_leaveRead(&gate); }
+        void writeLock(void) { GateRW_enterWrite(&gate, BIOS_WAIT_FOREVER); }
+        void writeUnlock(void) { GateRW_leaveWrite(&gate); }
+
+        /* wait at most milliseconds, 0 = don't wait */
+        bool tryReadLock(uint32_t milliseconds = 0)
+        {
+            return (GateRW_enterRead(&gate, ticks(milliseconds)));
+        }
+        bool tryWriteLock(uint32_t milliseconds = 0)
+        {
+            return (GateRW_enterWrite(&gate, ticks(milliseconds)));
+        }
+
+        bool locked(void) { return (GateRW_isBusy(&gate)); }
+};
+
+/* holds a read lock for its lifetime */
+class ReadGuard
+{
+    private:
+        ReadWriteLock &lock;
+
+        ReadGuard(const ReadGuard &);
+        ReadGuard &operator=(const ReadGuard &);
+
+    public:
+        ReadGuard(ReadWriteLock &rwLock) : lock(rwLock) { lock.readLock(); }
+        ~ReadGuard(void) { lock.readUnlock(); }
+};
+
+/* holds the write lock for its lifetime */
+class WriteGuard
+{
+    private:
+        ReadWriteLock &lock;
+
+        WriteGuard(const WriteGuard &);
+        WriteGuard &operator=(const WriteGuard &);
+
+    public:
+        WriteGuard(ReadWriteLock &rwLock) : lock(rwLock) { lock.writeLock(); }
+        ~WriteGuard(void) { lock.writeUnlock(); }
+};
+
+#endif
@@ -37,6 +37,7 @@
 
 void spiTransferCallback(SPI_Handle handle,
                                         SPI_Transaction * transaction);
+void spiAsyncCallback(SPI_Handle handle, SPI_Transaction * transaction);
 SPIClass::SPIClass(void)
 {
     init(0);
@@ -58,6 +59,35 @@ void SPIClass::init(unsigned long module)
     bitOrder = MSBFIRST;
     clockDivider = SPI_CLOCK_DIV4;
     numUsingInterrupts = 0;
+
+    for (uint8_t i = 0; i < SPI_ASYNC_QUEUE_DEPTH; i++) {
+        asyncBusy[i] = false;
+    }
+}
+
+/*
+ * Fill in a queued transaction with the port's current settings. Every
+ * transaction carries its own frame format and bit rate, so the driver
+ * only reprograms the SSI when consecutive transactions differ.
+ */
+void SPIClass::prepareEntry(SPICC26XXDMA_QueuedTransaction *entry,
+    uint8_t ssPin, uint8_t *buffer, size_t size)
+{
+    entry->transaction.txBuf = buffer;
+    entry->transaction.rxBuf = buffer;
+    entry->transaction.count = size;
+    entry->transaction.arg = this;
+    entry->frameFormat = params.frameFormat;
+    entry->bitRate = params.bitRate;
+    entry->csnPin = PIN_UNASSIGNED;
+
+    /* chip select is driven by the SPI driver around the transaction */
+    if (ssPin != 0 && digital_pin_to_dio[ssPin] != NOT_A_DIO) {
+        if (digital_pin_to_pin_function[ssPin] != PIN_FUNC_DIGITAL_OUTPUT) {
+            digitalWrite(ssPin, HIGH);
+        }
+        entry->csnPin = digital_pin_to_dio[ssPin];
+    }
 }
 
 /*
@@ -96,6 +126,9 @@ void SPIClass::begin()
 }
 
 void SPIClass::end(uint8_t ssPin) {
+    /* let queued transfers finish before closing the driver */
+    flushAsync();
+
     begun = FALSE;
     numUsingInterrupts = 0;
     SPI_close(spi);
@@ -118,28 +151,60 @@ void SPIClass::setBitOrder(uint8_t bitOrder)
     setBitOrder(0, bitOrder);
 }
 
+/*
+ * Settings take effect with the next transfer; each transfer hands them
+ * to the driver, so the port doesn't need to be re-opened.
+ */
 void SPIClass::setDataMode(uint8_t mode)
 {
     dataMode = mode;
-
-    if (begun == TRUE) {
-        SPI_close(spi);
-        params.frameFormat = (SPI_FrameFormat) dataMode;
-        spi = SPI_open(spiModule, &params);
-    }
+    params.frameFormat = (SPI_FrameFormat) dataMode;
 }
 
 void SPIClass::setClockDivider(uint8_t divider)
 {
     clockDivider = divider;
+    params.bitRate = SPI_CLOCK_MAX / clockDivider;
+}
+
+/*
+ * Take the port for a sequence of transfers to one device. Other tasks
+ * calling beginTransaction() on the same port block until
+ * endTransaction().
+ */
+void SPIClass::beginTransaction(SPISettings settings)
+{
+    if (begun == TRUE) {
+        gateKey = GateMutex_enter(GateMutex_handle(&gate));
+    }
+
+    setBitOrder(settings.bitOrder);
+    dataMode = settings.dataMode;
+    params.frameFormat = (SPI_FrameFormat) dataMode;
+    params.bitRate = (settings.clock < SPI_CLOCK_MAX) ? settings.clock : SPI_CLOCK_MAX;
+}
 
+void SPIClass::endTransaction(void)
+{
     if (begun == TRUE) {
-        SPI_close(spi);
-        params.bitRate = SPI_CLOCK_MAX / clockDivider;
-        spi = SPI_open(spiModule, &params);
+        GateMutex_leave(GateMutex_handle(&gate), gateKey);
     }
 }
 
+#if !((defined(xdc_target__isaCompatible_v7M) || defined(xdc_target__isaCompatible_v7A))  \
+     && (defined(__TI_COMPILER_VERSION__) || defined(__GNUC__)))
+/* bit reversed value of every byte, for targets without RBIT */
+static const uint8_t reverseTable[256] = {
+#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
+#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
+#define R6(n) R4(n), R4(n + 2*4), R4(n + 1*4), R4(n + 3*4)
+    R6(0), R6(2), R6(1), R6(3)
+#undef R6
+#undef R4
+#undef R2
+};
+#endif
+
 uint8_t SPIClass::reverseBits(uint8_t rxtxData)
 {
 #if (defined(xdc_target__isaCompatible_v7M) || defined(xdc_target__isaCompatible_v7A))  \
@@ -153,34 +218,83 @@ uint8_t SPIClass::reverseBits(uint8_t rxtxData)
         /* reverse order of bytes to get original bits into lowest byte */
         asm("rev %0, %1" : "=r" (rxtxData) : "r" (rxtxData));
 #else
-    static  const uint8_t reverse_data[] =
-        { 0x0, 0x8, 0x4, 0xC,
-          0x2, 0xA, 0x6, 0xE,
-          0x1, 0x9, 0x5, 0xD,
-          0x3, 0xB, 0x7, 0xF
-        };
-
-    uint8_t b = 0;
-
-    b  = reverse_data[x & 0xF] << 4;
-    b |= reverse_data[(x & 0xF0) >> 4];
-    rxtxData = b;
+    rxtxData = reverseTable[rxtxData];
 #endif
     return (rxtxData);
 }
 
+/*
+ * Reverse the bit order of every byte in buffer, in place. RBIT reverses
+ * all 32 bits of a word and REV restores the byte order, so aligned words
+ * are converted four bytes at a time; the unaligned head and tail go
+ * through reverseBits().
+ */
+void SPIClass::reverseBuffer(uint8_t *buffer, size_t size)
+{
+#if (defined(xdc_target__isaCompatible_v7M) || defined(xdc_target__isaCompatible_v7A))  \
+     && (defined(__TI_COMPILER_VERSION__) || defined(__GNUC__))
+    uint32_t *words;
+    uint32_t word;
+
+    while (size != 0 && ((uintptr_t)buffer & 3) != 0) {
+        *buffer = reverseBits(*buffer);
+        buffer++;
+        size--;
+    }
+
+    words = (uint32_t *)buffer;
+
+    for (; size >= 4; size -= 4) {
+        word = *words;
+#if defined(__TI_COMPILER_VERSION__)
+        word = __rev(__rbit(word));
+#else
+        asm("rbit %0, %1" : "=r" (word) : "r" (word));
+        asm("rev %0, %1" : "=r" (word) : "r" (word));
+#endif
+        *words++ = word;
+    }
+
+    buffer = (uint8_t *)words;
+#endif
+
+    while (size-- != 0) {
+        *buffer = reverseBits(*buffer);
+        buffer++;
+    }
+}
+
+/*
+ * Any length can be passed; the SPI driver splits transfers longer than
+ * the uDMA's 1024 frame limit into back to back segments, so the bus
+ * doesn't idle between them. Returns NULL if the transfer couldn't be
+ * started.
+ */
 uint8_t *SPIClass::transfer(uint8_t *buffer, size_t size)
 {
     uint32_t taskKey, hwiKey;
-    uint8_t i;
+    uint8_t *result = NULL;
+    size_t i;
 
     if (spi == NULL) {
         return (0);
     }
-    
+
+    /* the driver rejects empty transactions, so the callback never comes */
+    if (size == 0) {
+        return (buffer);
+    }
+
     /* protect single 'transaction' content from re-rentrancy */
     taskKey = Task_disable();
 
+    /*
+     * SPI_transfer() fails while the bus is busy, let transferAsync()s
+     * finish; they complete from the driver's Swi, which still runs, and
+     * with Tasks disabled no other thread can queue one behind them
+     */
+    flushAsync();
+
     hwiKey = Hwi_disable();
 
     /* disable all interrupts registered with SPI.usingInterrupt() */
@@ -191,22 +305,23 @@ uint8_t *SPIClass::transfer(uint8_t *buffer, size_t size)
     Hwi_restore(hwiKey);
 
     if (bitOrder == LSBFIRST) {
-        for (i = 0; i < size; i++) {
-            buffer[i] = reverseBits(buffer[i]);
-        }
+        reverseBuffer(buffer, size);
     }
 
     transaction.txBuf = buffer;
     transaction.rxBuf = buffer;
     transaction.count = size;
+    transaction.arg = this;
     transferComplete = 0;
 
-    /* kick off the SPI transaction */
-    SPI_transfer(spi, &transaction);
-
-    /* wait for transfer to complete (ie for callback to be called) */
-    while (transferComplete == 0) {
-        ;
+    /* kick off the SPI transaction with this port's settings */
+    if (SPI_control(spi, SPICC26XXDMA_CMD_SET_FRAME_FORMAT, &params) == SPI_STATUS_SUCCESS &&
+        SPI_transfer(spi, &transaction)) {
+        /* wait for transfer to complete (ie for callback to be called) */
+        while (transferComplete == 0) {
+            ;
+        }
+        result = buffer;
     }
 
     /* now that the transaction is finished, allow other threads to pre-empt */
@@ -221,19 +336,20 @@ uint8_t *SPIClass::transfer(uint8_t *buffer, size_t size)
     Hwi_restore(hwiKey);
 
     if (bitOrder == LSBFIRST) {
-        for (i = 0; i < size; i++) {
-            buffer[i] = reverseBits(buffer[i]);
-        }
+        reverseBuffer(buffer, size);
     }
 
     Task_restore(taskKey);
 
-    return (buffer);
+    return (result);
 }
 
+/*
+ * Returns 0 if the transfer couldn't be started.
+ */
 uint8_t SPIClass::transfer(uint8_t ssPin, uint8_t data_out, uint8_t transferMode)
 {
-    uint8_t data_in;
+    uint8_t data_in = 0;
     uint8_t i;
     uint32_t taskKey, hwiKey;
 
@@ -248,6 +364,13 @@ uint8_t SPIClass::transfer(uint8_t ssPin, uint8_t data_out, uint8_t transferMode
     /* protect single 'transaction' content from re-rentrancy */
     taskKey = Task_disable();
 
+    /*
+     * SPI_transfer() fails while the bus is busy, let transferAsync()s
+     * finish; they complete from the driver's Swi, which still runs, and
+     * with Tasks disabled no other thread can queue one behind them
+     */
+    flushAsync();
+
     hwiKey = Hwi_disable();
 
     /* disable all interrupts registered with SPI.usingInterrupt() */
@@ -265,14 +388,16 @@ uint8_t SPIClass::transfer(uint8_t ssPin, uint8_t data_out, uint8_t transferMode
     transaction.txBuf = &data_out;
     transaction.rxBuf = &data_in;
     transaction.count = 1;
+    transaction.arg = this;
     transferComplete = 0;
 
-    /* kick off the SPI transaction */
-    SPI_transfer(spi, &transaction);
-
-    /* wait for transfer to complete (ie for callback to be called) */
-    while (transferComplete == 0) {
-        ;
+    /* kick off the SPI transaction with this port's settings */
+    if (SPI_control(spi, SPICC26XXDMA_CMD_SET_FRAME_FORMAT, &params) == SPI_STATUS_SUCCESS &&
+        SPI_transfer(spi, &transaction)) {
+        /* wait for transfer to complete (ie for callback to be called) */
+        while (transferComplete == 0) {
+            ;
+        }
     }
 
     /* deselect SPI peripheral if ssPin was provided */
@@ -310,6 +435,97 @@ uint8_t SPIClass::transfer(uint8_t data)
     return (transfer(0, data, SPI_LAST));
 }
 
+/*
+ * Queue a transfer and return without waiting for it. buffer is sent and
+ * overwritten with the received data; it must stay valid until callback
+ * (which may be NULL) is called from Swi context. If ssPin is given, the
+ * driver drives it low for the length of the transfer. Returns false if
+ * SPI_ASYNC_QUEUE_DEPTH transfers are already outstanding.
+ */
+bool SPIClass::transferAsync(uint8_t ssPin, uint8_t *buffer, size_t size,
+    SPIAsyncCallback callback)
+{
+    SPICC26XXDMA_QueuedTransaction *entry;
+    uint32_t hwiKey;
+    uint8_t slot;
+
+    if (spi == NULL || size == 0) {
+        return (false);
+    }
+
+    /* claim a free entry */
+    hwiKey = Hwi_disable();
+    for (slot = 0; slot < SPI_ASYNC_QUEUE_DEPTH; slot++) {
+        if (!asyncBusy[slot]) {
+            asyncBusy[slot] = true;
+            break;
+        }
+    }
+    Hwi_restore(hwiKey);
+
+    if (slot == SPI_ASYNC_QUEUE_DEPTH) {
+        return (false);
+    }
+
+    if (bitOrder == LSBFIRST) {
+        reverseBuffer(buffer, size);
+    }
+
+    entry = &asyncEntries[slot];
+    prepareEntry(entry, ssPin, buffer, size);
+    entry->callbackFxn = spiAsyncCallback;
+    asyncCallbacks[slot] = callback;
+    asyncBitOrder[slot] = bitOrder;
+
+    if (!SPICC26XXDMA_queueTransfer(spi, entry)) {
+        asyncBusy[slot] = false;
+        return (false);
+    }
+
+    return (true);
+}
+
+bool SPIClass::transferAsync(uint8_t *buffer, size_t size,
+    SPIAsyncCallback callback)
+{
+    return (transferAsync(0, buffer, size, callback));
+}
+
+/*
+ * Wait until every transferAsync() has completed
+ */
+void SPIClass::flushAsync(void)
+{
+    uint8_t slot;
+
+    for (slot = 0; slot < SPI_ASYNC_QUEUE_DEPTH; slot++) {
+        while (asyncBusy[slot]) {
+            ;
+        }
+    }
+}
+
+/*
+ * Called from the driver's Swi when a transferAsync() completes
+ */
+void SPIClass::asyncComplete(SPI_Transaction *done)
+{
+    uint8_t slot = (SPICC26XXDMA_QueuedTransaction *)done - asyncEntries;
+    uint8_t *buffer = (uint8_t *)done->rxBuf;
+    SPIAsyncCallback callback = asyncCallbacks[slot];
+
+    if (asyncBitOrder[slot] == LSBFIRST) {
+        reverseBuffer(buffer, done->count);
+    }
+
+    /* the entry may be re-used from within the callback */
+    asyncBusy[slot] = false;
+
+    if (callback != NULL) {
+        callback(buffer, done->count);
+    }
+}
+
 void SPIClass::setModule(uint8_t module)
 {
     spiModule = module;
@@ -326,5 +542,10 @@ void SPIClass::usingInterrupt(uint8_t pin)
 /* C type function */
 void spiTransferCallback(SPI_Handle spi, SPI_Transaction * transaction)
 {
-    SPI.transferComplete = 1;
+    ((SPIClass *)transaction->arg)->transferComplete = 1;
+}
+
+void spiAsyncCallback(SPI_Handle spi, SPI_Transaction * transaction)
+{
+    ((SPIClass *)transaction->arg)->asyncComplete(transaction);
 }
@@ -36,6 +36,7 @@
 #include <inttypes.h>
 
 #include <ti/drivers/SPI.h>
+#include <ti/drivers/spi/SPICC26XXDMA.h>
 #include <ti/sysbios/gates/GateMutex.h>
 
 #define SPI_MODE0 SPI_POL0_PHA0
@@ -56,6 +57,29 @@
 
 #define MAX_USING_INTERRUPTS 16
 
+/* number of transferAsync() calls that can be outstanding per SPI port */
+#define SPI_ASYNC_QUEUE_DEPTH 4
+
+/* called from Swi context when a transferAsync() completes */
+typedef void (*SPIAsyncCallback)(uint8_t *buffer, size_t size);
+
+class SPISettings
+{
+    public:
+        SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) :
+            clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+        SPISettings() :
+            clock(SPI_CLOCK_MAX / SPI_CLOCK_DIV4), bitOrder(MSBFIRST),
+            dataMode(SPI_MODE0) {}
+
+    private:
+        uint32_t clock;
+        uint8_t bitOrder;
+        uint8_t dataMode;
+
+    friend class SPIClass;
+};
+
 class SPIClass
 {
     private:
@@ -73,8 +97,19 @@ class SPIClass
         SPI_Params params;
         SPI_Transaction transaction;
         GateMutex_Struct gate;
+        IArg gateKey;
+
+        /* transferAsync() entries, each in flight until its callback */
+        SPICC26XXDMA_QueuedTransaction asyncEntries[SPI_ASYNC_QUEUE_DEPTH];
+        SPIAsyncCallback asyncCallbacks[SPI_ASYNC_QUEUE_DEPTH];
+        uint8_t asyncBitOrder[SPI_ASYNC_QUEUE_DEPTH];
+        volatile bool asyncBusy[SPI_ASYNC_QUEUE_DEPTH];
+
         void init(unsigned long);
         uint8_t reverseBits(uint8_t);
+        void reverseBuffer(uint8_t *, size_t);
+        void prepareEntry(SPICC26XXDMA_QueuedTransaction *, uint8_t ssPin,
+            uint8_t *, size_t);
 
     public:
         volatile bool transferComplete;
@@ -97,6 +132,14 @@ class SPIClass
         uint8_t transfer(uint8_t, uint8_t, uint8_t);
         uint8_t *transfer(uint8_t *, size_t);
 
+        void beginTransaction(SPISettings);
+        void endTransaction(void);
+
+        bool transferAsync(uint8_t *, size_t, SPIAsyncCallback);
+        bool transferAsync(uint8_t ssPin, uint8_t *, size_t, SPIAsyncCallback);
+        void flushAsync(void);
+        void asyncComplete(SPI_Transaction *);
+
         void setModule(uint8_t);
         void usingInterrupt(uint8_t);
 };
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Lock-free single-producer/single-consumer byte ring.
+ *
+ * A fixed size wrapper around ti/drivers/utils/SPSCRing.h. One thread
+ * (e.g. an interrupt handler) may write while exactly one other thread
+ * reads, without either disabling interrupts.
+ *
+ *   SPSCRingBuffer<256> ring;
+ *
+ *   ring.write(data, len);              // producer
+ *   n = ring.read(buf, sizeof(buf));    // consumer
+ *
+ * N must be a power of two.
+ */
+
+#ifndef SPSCRingBuffer_h
+#define SPSCRingBuffer_h
+
+#include <ti/drivers/utils/SPSCRing.h>
+
+typedef SPSCRing_Span SPSCRingSpan;
+
+template <size_t N>
+class SPSCRingBuffer
+{
+    private:
+        unsigned char storage[N];
+        SPSCRing_Object ring;
+
+        /* fails to compile unless N is a power of two */
+        typedef char sizeCheck[(N != 0 && (N & (N - 1)) == 0) ? 1 : -1];
+
+    public:
+        SPSCRingBuffer(void) { SPSCRing_construct(&ring, storage, N); }
+
+        /* either side, but only while the other side is idle */
+        void clear(void) { SPSCRing_construct(&ring, storage, N); }
+
+        size_t size(void) { return (N); }
+        size_t available(void) { return (SPSCRing_getCount(&ring)); }
+        size_t availableForWrite(void) { return (SPSCRing_getSpace(&ring)); }
+
+        /* producer side */
+        size_t write(const void *src, size_t len)
+        {
+            return (SPSCRing_write(&ring, src, len));
+        }
+        bool put(unsigned char c) { return (SPSCRing_put(&ring, c)); }
+        size_t reserveSpans(SPSCRingSpan spans[2])
+        {
+            return (SPSCRing_reserveSpans(&ring, spans));
+        }
+        void commit(size_t count) { SPSCRing_commit(&ring, count); }
+
+        /* consumer side */
+        size_t read(void *dst, size_t len)
+        {
+            return (SPSCRing_read(&ring, dst, len));
+        }
+        int read(void)
+        {
+            unsigned char c;
+            return (SPSCRing_get(&ring, &c) ? c : -1);
+        }
+        int peek(void)
+        {
+            unsigned char c;
+            return (SPSCRing_peek(&ring, &c) ? c : -1);
+        }
+        size_t peekSpans(SPSCRingSpan spans[2])
+        {
+            return (SPSCRing_peekSpans(&ring, spans));
+        }
+        void consume(size_t count) { SPSCRing_consume(&ring, count); }
+};
+
+#endif
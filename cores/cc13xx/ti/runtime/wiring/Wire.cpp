@@ -240,6 +240,86 @@ uint8_t TwoWire::requestFrom(int address, int quantity, int sendStop)
     return (requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)sendStop));
 }
 
+/*
+ *  ======== transfer ========
+ *  Write txLen bytes from tx, then read rxLen bytes into rx after a
+ *  repeated START, as a single I2C_Transaction. Both buffers belong to
+ *  the caller: nothing is copied through the Wire ring buffers and the
+ *  lengths are not limited to BUFFER_LENGTH.
+ *
+ *  Returns 0 on success, 4 on error (same codes as endTransmission()).
+ */
+uint8_t TwoWire::transfer(uint8_t address, const uint8_t *tx, size_t txLen,
+                          uint8_t *rx, size_t rxLen)
+{
+    TwoWireSegment segment;
+
+    segment.buf = rx;
+    segment.count = rxLen;
+
+    return (transfer(address, tx, txLen, &segment, 1));
+}
+
+/*
+ *  ======== transfer ========
+ *  Scatter-gather flavour: the read phase fills each segment in turn as
+ *  one burst, so the slave sees a single read of the total length
+ *  (e.g. a FIFO dump split between a header struct and a sample array).
+ */
+uint8_t TwoWire::transfer(uint8_t address, const uint8_t *tx, size_t txLen,
+                          const TwoWireSegment *rx, size_t numSegments)
+{
+    I2C_Transaction transaction;
+    I2CCC26XX_ReadSegments chain;
+    IArg key;
+    bool ret;
+
+    if (i2c == NULL) {
+        return (4); /* 4 = 'other error' */
+    }
+
+    /* leading empty segments would hide the read from the driver */
+    while (numSegments && rx->count == 0) {
+        rx++;
+        numSegments--;
+    }
+
+    if (txLen == 0 && numSegments == 0) {
+        return (0);
+    }
+
+    transaction.slaveAddress = address;
+    transaction.writeBuf = (void *)tx;
+    transaction.writeCount = txLen;
+    transaction.readBuf = numSegments ? rx->buf : NULL;
+    transaction.readCount = numSegments ? rx->count : 0;
+    transaction.arg = NULL;
+
+    key = GateMutex_enter(GateMutex_handle(&gate));
+
+    if (numSegments > 1) {
+        chain.segments = rx + 1;
+        chain.numSegments = numSegments - 1;
+        if (I2C_control(i2c, I2CCC26XX_CMD_SET_READ_SEGMENTS, &chain) != I2C_STATUS_SUCCESS) {
+            /* the driver can't chain reads; don't read into just the first */
+            GateMutex_leave(GateMutex_handle(&gate), key);
+            return (4);
+        }
+    }
+
+    ret = I2C_transfer(i2c, &transaction);
+
+    /* disarm in case the driver returned before priming the transfer */
+    if (numSegments > 1) {
+        I2C_control(i2c, I2CCC26XX_CMD_SET_READ_SEGMENTS, NULL);
+    }
+
+    GateMutex_leave(GateMutex_handle(&gate), key);
+
+    /* success = 0; 4 = other error */
+    return (ret ? 0 : 4);
+}
+
 // must be called in:
 // slave tx event callback
 // or after beginTransmission(address)
@@ -37,6 +37,7 @@
 #include "Stream.h"
 
 #include <ti/drivers/I2C.h>
+#include <ti/drivers/i2c/I2CCC26XX.h>
 #include <ti/sysbios/gates/GateMutex.h>
 
 #define BUFFER_LENGTH     64
@@ -61,6 +62,9 @@ typedef struct WireContext {
     bool idle;
 } WireContext;
 
+/* One caller buffer of a scatter-gather TwoWire::transfer() read */
+typedef I2CCC26XX_ReadSegment TwoWireSegment;
+
 class TwoWire : public Stream
 {
     private:
@@ -95,6 +99,9 @@ class TwoWire : public Stream
         uint8_t requestFrom(uint8_t, uint8_t, uint8_t);
         uint8_t requestFrom(int, int);
         uint8_t requestFrom(int, int, int);
+        uint8_t transfer(uint8_t, const uint8_t *, size_t, uint8_t *, size_t);
+        uint8_t transfer(uint8_t, const uint8_t *, size_t,
+                         const TwoWireSegment *, size_t);
         virtual size_t write(uint8_t);
         virtual size_t write(const uint8_t *, size_t);
         virtual int available(void);
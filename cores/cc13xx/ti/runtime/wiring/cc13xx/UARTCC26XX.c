@@ -289,7 +289,7 @@ static int32_t readData2RingBuf(UART_Handle handle, int32_t size)
                                  hwAttrs->baseAddr, (uint8_t)readIn);
 
         size--;
-        RingBuf_put(&object->ringBuffer, (unsigned char)readIn);
+        SPSCRing_put(&object->ringBuffer, (unsigned char)readIn);
     }
 
     return (size);
@@ -474,7 +474,7 @@ void UARTCC26XX_hwiIntFxn(UArg arg)
 
     /* Record readSize */
     int32_t readSize = object->readSize;
-    int32_t readSize_ringBuf = object->ringBuffer.length - object->ringBuffer.count;
+    int32_t readSize_ringBuf = SPSCRing_getSpace(&object->ringBuffer);
 
     /* Basic error handling */
     if(intStatus & (UART_INT_OE | UART_INT_BE | UART_INT_PE | UART_INT_FE)) {
@@ -484,6 +484,8 @@ void UARTCC26XX_hwiIntFxn(UArg arg)
             /* check receive status register */
             errStatus = UARTRxErrorGet(hwAttrs->baseAddr);
             UARTRxErrorClear(hwAttrs->baseAddr);
+            /* status is reset by the next read or write, keep a count */
+            object->rxOverruns++;
             /* read out min of readsize and fifo size */
             int32_t bytesToRead = MIN(UARTCC26XX_FIFO_SIZE, readSize);
             readData((UART_Handle)arg, bytesToRead);
@@ -691,6 +693,7 @@ UART_Handle UARTCC26XX_open(UART_Handle handle, UART_Params *params)
     } paramsUnion;
     UARTCC26XX_Object               *object;
     UARTCC26XX_HWAttrsV2 const     *hwAttrs;
+    size_t                          ringBufSize;
 
     /* Get the pointer to the object and hwAttrs */
     object = handle->object;
@@ -805,8 +808,17 @@ UART_Handle UARTCC26XX_open(UART_Handle handle, UART_Params *params)
                     (Clock_FuncPtr) &writeFinishedDoCallback,
                     10, &(paramsUnion.clkParams));
 
-    /* Create circular buffer object to be used for read buffering */
-    RingBuf_construct(&object->ringBuffer, hwAttrs->ringBufPtr, hwAttrs->ringBufSize);
+    /*
+     * Create circular buffer object to be used for read buffering. The
+     * Hwi fills it and UART_read() drains it without locking, which needs
+     * a power of two size: drop low bits until ringBufSize is one.
+     */
+    ringBufSize = hwAttrs->ringBufSize;
+    while (!SPSCRing_construct(&object->ringBuffer, hwAttrs->ringBufPtr,
+                               ringBufSize) && ringBufSize != 0) {
+        ringBufSize &= ringBufSize - 1;
+    }
+    object->rxOverruns = 0;
 
     /* Register notification function */
     Power_registerNotify(&object->uartPostObj, PowerCC26XX_AWAKE_STANDBY, (Fxn)uartPostNotify, (uint32_t)handle);
@@ -922,7 +934,8 @@ int_fast16_t UARTCC26XX_control(UART_Handle handle, uint_fast16_t cmd,
     /* Initialize return value*/
     int ret = UART_STATUS_UNDEFINEDCMD;
 
-    bufferCount = RingBuf_peek(&object->ringBuffer, &data);
+    bufferCount = SPSCRing_getCount(&object->ringBuffer);
+    SPSCRing_peek(&object->ringBuffer, &data);
 
     /* Do command*/
     switch(cmd)
@@ -966,9 +979,8 @@ int_fast16_t UARTCC26XX_control(UART_Handle handle, uint_fast16_t cmd,
             while (((int32_t)UARTCharGetNonBlocking(hwAttrs->baseAddr)) != -1);
 
             /* Reset RingBuf */
-            object->ringBuffer.count = 0;
-            object->ringBuffer.head = object->ringBuffer.length - 1;
-            object->ringBuffer.tail = 0;
+            SPSCRing_construct(&object->ringBuffer, object->ringBuffer.buffer,
+                               SPSCRing_getSize(&object->ringBuffer));
 
             /* Set size = 0 to prevent reading and restore interrupts. */
             object->readSize = 0;
@@ -1238,7 +1250,7 @@ void UARTCC26XX_writeCancel(UART_Handle handle)
  */
 int_fast32_t UARTCC26XX_read(UART_Handle handle, void *buffer, size_t size)
 {
-    unsigned char                    readIn;
+    size_t                           count;
     UARTCC26XX_Object                *object;
     UARTCC26XX_HWAttrsV2 const       *hwAttrs;
 
@@ -1271,63 +1283,61 @@ int_fast32_t UARTCC26XX_read(UART_Handle handle, void *buffer, size_t size)
     object->readBuf = buffer;
     object->readCount = 0;
 
-    /* Read from RingBuf as much as is available */
-    while (object->readSize) {
-        if (RingBuf_get(&object->ringBuffer, &readIn) < 0) {
-            /* RingBuf is empty, need to read from FIFO */
+    /* Take as much as is available from RingBuf in one go */
+    count = SPSCRing_read(&object->ringBuffer, object->readBuf,
+                          object->readSize);
+    object->readBuf = (unsigned char *)object->readBuf + count;
+    object->readCount += count;
+    object->readSize -= count;
 
-            /* Set constraint for sleep to guarantee transaction */
-            threadSafeStdbyDisSet(&uartRxPowerConstraint);
+    if (object->readSize) {
+        /* RingBuf is empty, need to read from FIFO */
 
-            /* Enable RX */
-            HWREG(UART0_BASE + UART_O_CTL) |= UART_CTL_RXE;
+        /* Set constraint for sleep to guarantee transaction */
+        threadSafeStdbyDisSet(&uartRxPowerConstraint);
 
-            /* Enable RX interrupts */
-            UARTIntEnable(hwAttrs->baseAddr, UART_INT_RX | UART_INT_RT |
-                          UART_INT_OE | UART_INT_BE | UART_INT_PE | UART_INT_FE);
+        /* Enable RX */
+        HWREG(UART0_BASE + UART_O_CTL) |= UART_CTL_RXE;
 
-            /* If readMode is blocking, block and get the status. */
-            if (object->readMode == UART_MODE_BLOCKING) {
-                /* Pend on semaphore and wait for Hwi to finish. */
-                if (!Semaphore_pend(Semaphore_handle(&(object->readSem)),
-                                    object->readTimeout)) {
-                    /* Semaphore timed out, make the read empty and log the read. */
-                    object->readSize = 0;
+        /* Enable RX interrupts */
+        UARTIntEnable(hwAttrs->baseAddr, UART_INT_RX | UART_INT_RT |
+                      UART_INT_OE | UART_INT_BE | UART_INT_PE | UART_INT_FE);
 
-                    /* Release constraint since transaction timed out, allowed to enter standby */
-                    threadSafeStdbyDisRelease(&uartRxPowerConstraint);
+        /* If readMode is blocking, block and get the status. */
+        if (object->readMode == UART_MODE_BLOCKING) {
+            /* Pend on semaphore and wait for Hwi to finish. */
+            if (!Semaphore_pend(Semaphore_handle(&(object->readSem)),
+                                object->readTimeout)) {
+                /* Semaphore timed out, make the read empty and log the read. */
+                object->readSize = 0;
 
-                    /* Reset the read buffer so we can pass it back */
-                    object->readBuf = (unsigned char *)object->readBuf - object->readCount;
+                /* Release constraint since transaction timed out, allowed to enter standby */
+                threadSafeStdbyDisRelease(&uartRxPowerConstraint);
 
-                    /* Set status to TIMED_OUT */
-                    object->status = UART_TIMED_OUT;
+                /* Reset the read buffer so we can pass it back */
+                object->readBuf = (unsigned char *)object->readBuf - object->readCount;
 
-                    Log_print2(Diags_USER1, "UART:(%p) Read timed out, %d bytes read",
-                             ((UARTCC26XX_HWAttrsV2 const *)(handle->hwAttrs))->baseAddr,
-                               object->readCount);
-                }
-                /* return the number of data read */
-                return (object->readCount);
-            }
+                /* Set status to TIMED_OUT */
+                object->status = UART_TIMED_OUT;
 
-            /* readMode is callback */
-            if ((object->readRetPartial) && (object->readCount)) {
-                /* Return partial enabled and some data has been read */
-                /* reset readSize to allow next UART_read() */
-                object->readSize = 0;
-                /* Read succeeded */
-                Swi_post(Swi_handle(&(object->swi)));
+                Log_print2(Diags_USER1, "UART:(%p) Read timed out, %d bytes read",
+                         ((UARTCC26XX_HWAttrsV2 const *)(handle->hwAttrs))->baseAddr,
+                           object->readCount);
             }
+            /* return the number of data read */
+            return (object->readCount);
+        }
 
-            return (0);
+        /* readMode is callback */
+        if ((object->readRetPartial) && (object->readCount)) {
+            /* Return partial enabled and some data has been read */
+            /* reset readSize to allow next UART_read() */
+            object->readSize = 0;
+            /* Read succeeded */
+            Swi_post(Swi_handle(&(object->swi)));
         }
 
-        /* save data to receive buffer */
-        *((unsigned char *)object->readBuf) = (uint8_t)readIn;
-        object->readBuf = (unsigned char *)object->readBuf + 1;
-        object->readCount++;
-        object->readSize--;
+        return (0);
     }
 
     /* Enable RX interrupts after reading from RingBuf is done */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The build options system/energia/src/sysbios/makefile compiles the
+ * prebuilt kernel library (sysbios.am3g) with. Kernel sources built into
+ * the core include this first so their copy matches the library's.
+ */
+
+#ifndef ti_runtime_wiring_cc13xx_sysbios_defs__include
+#define ti_runtime_wiring_cc13xx_sysbios_defs__include
+
+#define ti_sysbios_BIOS_swiEnabled__D TRUE
+#define ti_sysbios_BIOS_taskEnabled__D TRUE
+#define ti_sysbios_BIOS_clockEnabled__D TRUE
+#define ti_sysbios_BIOS_runtimeCreatesEnabled__D TRUE
+#define ti_sysbios_knl_Task_moduleStateCheckFlag__D FALSE
+#define ti_sysbios_knl_Task_objectCheckFlag__D FALSE
+#define ti_sysbios_hal_Hwi_DISABLE_ALL_HOOKS 1
+#define ti_sysbios_knl_Swi_DISABLE_ALL_HOOKS 1
+#define ti_sysbios_BIOS_smpEnabled__D FALSE
+#define ti_sysbios_Build_useHwiMacros 1
+#define ti_sysbios_Build_useIndirectReferences FALSE
+#define ti_sysbios_knl_Swi_numPriorities__D 16
+#define ti_sysbios_knl_Task_deleteTerminatedTasks__D FALSE
+#define ti_sysbios_knl_Task_numPriorities__D 4
+#define ti_sysbios_knl_Task_checkStackFlag__D FALSE
+#define ti_sysbios_knl_Task_initStackFlag__D TRUE
+#define ti_sysbios_knl_Clock_TICK_SOURCE ti_sysbios_knl_Clock_TickSource_TIMER
+#define ti_sysbios_knl_Clock_TICK_MODE ti_sysbios_knl_Clock_TickMode_DYNAMIC
+#define ti_sysbios_knl_Clock_stopCheckNext__D TRUE
+#define ti_sysbios_hal_Core_delegate_getId ti_sysbios_hal_CoreNull_getId__E
+#define ti_sysbios_hal_Core_delegate_interruptCore ti_sysbios_hal_CoreNull_interruptCore__E
+#define ti_sysbios_hal_Core_delegate_lock ti_sysbios_hal_CoreNull_lock__E
+#define ti_sysbios_hal_Core_delegate_unlock ti_sysbios_hal_CoreNull_unlock__E
+#define ti_sysbios_hal_Core_numCores__D 1
+#define ti_sysbios_hal_CoreNull_numCores__D 1
+#define ti_sysbios_utils_Load_taskEnabled__D TRUE
+#define ti_sysbios_utils_Load_swiEnabled__D FALSE
+#define ti_sysbios_utils_Load_hwiEnabled__D FALSE
+#define ti_sysbios_family_arm_m3_Hwi_dispatcherSwiSupport__D TRUE
+#define ti_sysbios_family_arm_m3_Hwi_dispatcherTaskSupport__D TRUE
+#define ti_sysbios_family_arm_m3_Hwi_dispatcherAutoNestingSupport__D TRUE
+#define ti_sysbios_family_arm_m3_Hwi_dispatcherIrpTrackingSupport__D TRUE
+#define ti_sysbios_knl_Semaphore_supportsEvents__D FALSE
+#define ti_sysbios_knl_Semaphore_supportsPriority__D TRUE
+#define xdc_runtime_Assert_DISABLE_ALL 1
+#define xdc_runtime_Log_DISABLE_ALL 1
+
+#endif
@@ -52,4 +52,53 @@ static const uint8_t A5 = 26;
 static const uint8_t A6 = 27;
 static const uint8_t A7 = 28;
 
+/*
+ * DIO number behind each pin, used by the digitalWriteFast() family
+ */
+#define NOT_A_DIO 0xff
+
+static const uint8_t digital_pin_to_dio[] = {
+    NOT_A_DIO,  /*  0  - dummy */
+    NOT_A_DIO,  /*  1  - 3.3V */
+    23,         /*  2  - DIO_23 */
+    3,          /*  3  - DIO_03 */
+    2,          /*  4  - DIO_02 */
+    22,         /*  5  - DIO_22 */
+    24,         /*  6  - DIO_24 */
+    10,         /*  7  - DIO_10 */
+    21,         /*  8  - DIO_21 */
+    4,          /*  9  - DIO_04 */
+    5,          /*  10 - DIO_05 */
+    15,         /*  11 - DIO_15 */
+    14,         /*  12 - DIO_14 */
+    13,         /*  13 - DIO_13 */
+    8,          /*  14 - DIO_08 */
+    9,          /*  15 - DIO_09 */
+    NOT_A_DIO,  /*  16 - LPRST */
+    NOT_A_DIO,  /*  17 - NC */
+    11,         /*  18 - DIO_11 */
+    12,         /*  19 - DIO_12 */
+    NOT_A_DIO,  /*  20 - GND */
+    NOT_A_DIO,  /*  21 - 5V */
+    NOT_A_DIO,  /*  22 - GND */
+    25,         /*  23 - DIO_25 */
+    26,         /*  24 - DIO_26 */
+    27,         /*  25 - DIO_27 */
+    28,         /*  26 - DIO_28 */
+    29,         /*  27 - DIO_29 */
+    30,         /*  28 - DIO_30 */
+    0,          /*  29 - DIO_00 */
+    1,          /*  30 - DIO_01 */
+    17,         /*  31 - DIO_17 */
+    16,         /*  32 - DIO_16 */
+    NOT_A_DIO,  /*  33 - TCK */
+    NOT_A_DIO,  /*  34 - TMS */
+    NOT_A_DIO,  /*  35 - BPRST */
+    18,         /*  36 - DIO_18 */
+    19,         /*  37 - DIO_19 */
+    20,         /*  38 - DIO_20 */
+    6,          /*  39 - DIO_06 */
+    7,          /*  40 - DIO_07 */
+};
+
 #endif
@@ -39,85 +39,67 @@
 #include <ti/sysbios/knl/Clock.h>
 #include <ti/sysbios/knl/Task.h>
 
-/*
- *  ======== micros ========
- */
-unsigned long micros(void)
-{
-    Types_FreqHz freq;
-    Types_Timestamp64 time;
-    uint64_t t64;
-
-    TimestampProvider_getFreq(&freq);
-    TimestampProvider_get64(&time);
-    t64 = ((uint64_t)time.hi << 32) | time.lo;
-    return (t64/(freq.lo/1000000));
-}
+#include "wiring_timebase.h"
+
+static uint32_t timerSlack = 0;     /* ticks, see setTimerSlack() */
 
 /*
- *  ======== millis ========
+ *  ======== delay ========
  */
-unsigned long millis(void)
+void delay(uint32_t milliseconds)
 {
-    uint64_t milliseconds;
+    uint64_t delay;
+    uint32_t slack, align, now, wake, until;
 
-    milliseconds = ((uint64_t)Clock_getTicks() * (uint64_t)Clock_tickPeriod) / (uint64_t)1000;
+    if (milliseconds == 0) {
+        Task_yield();
+        return;
+    }
 
-    return (milliseconds);
-}
+    /* math below assumes tickPeriod is <= 1000 */
+    delay = ((uint64_t)milliseconds * (uint64_t)1000) / (uint64_t)Clock_tickPeriod;
 
-/*
- *  ======== delayMicroseconds ========
- *  Delay for the given number of microseconds
- */
-void delayMicroseconds(unsigned int us)
-{
-    if (us <7) {
-        //The overhead in calling and returning from this function takes about 6us
-    }
-    else if (us <=20) {
-        int time;
-        for (time = 5*(us-6); time > 0; time--) {
-            asm("   nop");
+    /*
+     * Join the wakeup the Clock module has already scheduled if it is
+     * within the slack, as Clock_start() does for Clocks with slack.
+     * Otherwise wake up on the last multiple of the largest power of 2
+     * <= slack + 1 that is not more than slack ticks late. Delays whose
+     * windows overlap tend to end on the same tick and share one wakeup.
+     */
+    slack = timerSlack;
+    if (slack != 0 && delay <= 0x7FFFFFFF) {
+        until = Clock_getTicksUntilInterrupt();
+        if (until >= delay && until - delay <= slack) {
+            delay = until;
         }
-    }
-    else if (us < 70) {
-        int time;
-        for (time = 5*us; time > 0; time--) {
-            asm("   nop");
+        else {
+            align = 0x80000000 >> __builtin_clz(slack + 1);
+            now = Clock_getTicks();
+            wake = (now + (uint32_t)delay + slack) & ~(align - 1);
+            delay = wake - now;
         }
     }
-    else {
-        uint32_t t0, deltaT;
-        Types_FreqHz freq;
-
-        TimestampProvider_getFreq(&freq);
-        deltaT = us * (freq.lo/1000000);
 
-        t0 = TimestampProvider_get32();
-
-        while ((TimestampProvider_get32()-t0) < deltaT) {
-            ;
-        }
-    }
+    Task_sleep(delay);
 }
 
 /*
- *  ======== delay ========
+ *  ======== setTimerSlack ========
+ *  Let delay() return up to 'milliseconds' late so that the CPU can
+ *  serve nearby delays with a single wakeup. Other Task timeouts are
+ *  not affected; Clock objects take their own slack from
+ *  Clock_setSlack().
  */
-void delay(uint32_t milliseconds)
+void setTimerSlack(uint32_t milliseconds)
 {
-    uint64_t delay;
+    uint64_t slack;
 
-    if (milliseconds == 0) {
-        Task_yield();
-        return;
+    slack = ((uint64_t)milliseconds * (uint64_t)1000) / (uint64_t)Clock_tickPeriod;
+    if (slack > 0x7FFFFFFF) {
+        slack = 0x7FFFFFFF;
     }
 
-    /* math below assumes tickPeriod is <= 1000 */
-    delay = ((uint64_t)milliseconds * (uint64_t)1000) / (uint64_t)Clock_tickPeriod;
-
-    Task_sleep(delay);
+    timerSlack = (uint32_t)slack;
 }
 
 /*
@@ -153,6 +135,7 @@ void myClock_doTick(UArg arg) {
  * so that they will nest user "attachInterrupt()" pin interrupts.
  */
 void energiaLastFxn() {
+    timebaseInit();
     Hwi_setPriority(20, 0xc0);
     Clock_TimerProxy_setFunc(Clock_getTimerHandle(), myClock_doTick, 0);
 }
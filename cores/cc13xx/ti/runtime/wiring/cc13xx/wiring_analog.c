@@ -167,6 +167,9 @@ void analogWrite(uint8_t pin, int val)
             case PIN_FUNC_DIGITAL_OUTPUT:
                 stopDigitalWrite(pin);
                 break;
+            case PIN_FUNC_ANALOG_STREAM:
+                stopAnalogStream(pin);
+                break;
         }
 
         /* find an unused PWM resource and port map it */
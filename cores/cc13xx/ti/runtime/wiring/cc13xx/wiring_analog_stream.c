@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define DEVICE_FAMILY cc13x0
+
+#include <ti/runtime/wiring/wiring_private.h>
+
+#include <ti/drivers/ADCBuf.h>
+#include <ti/drivers/adcbuf/ADCBufCC26XX.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <xdc/runtime/Types.h>
+
+/*
+ * analogReadStream*() sample pins continuously with ADCBufCC26XX:
+ * GPTimer0A triggers the ADC at the requested rate and the uDMA
+ * ping-pongs the results into two sketch buffers, so no CPU time is
+ * spent per sample. The callback runs in Swi context once per
+ * completed block.
+ *
+ * The ADC has a single input mux, so several pins are sampled round
+ * robin one block at a time: each pin gets count consecutive samples
+ * at rateHz, then the next pin takes over.
+ *
+ * Samples are 12-bit values against the ADC's fixed internal reference
+ * (input scaling on, 4.3V full scale), not analogReadResolution().
+ *
+ * GPTimer0A is also the first timer analogWrite() hands out, so start
+ * the stream before using analogWrite() on other pins.
+ */
+#define STREAM_MAX_PINS         ADCBufCC26XX_MAX_CHANNELS
+#define STREAM_MAX_COUNT        1024    /* uDMA transfer limit */
+#define STREAM_MAX_RATE         200000  /* ADC conversion limit */
+#define STREAM_TIMER_MAX        (1UL << 24) /* 16-bit timer + prescaler */
+
+typedef struct AnalogStream {
+    ADCBuf_Handle hAdcBuf;          /* NULL while idle */
+    AnalogStreamCallback callback;
+    uint32_t *microVolts;           /* count entries, NULL for raw only */
+    uint16_t count;
+    uint8_t numPins;
+    uint8_t pins[STREAM_MAX_PINS];
+    uint32_t periodTicks;           /* CPU cycles between samples */
+    uint32_t ticksPerMicro;
+    uint32_t blocks;                /* blocks sampled since begin */
+    uint64_t start;                 /* micros64() when sampling started */
+    ADCBuf_Conversion conversions[STREAM_MAX_PINS];
+} AnalogStream;
+
+static AnalogStream stream;
+
+/*
+ *  ======== streamCallback ========
+ *  Called by ADCBufCC26XX in Swi context for each finished block. The
+ *  timestamp is derived from the block index and the trigger period,
+ *  so it has no interrupt latency jitter.
+ */
+static void streamCallback(ADCBuf_Handle handle, ADCBuf_Conversion *conversion,
+    void *completedADCBuffer, uint32_t completedChannel)
+{
+    ADCBufCC26XX_Object *object = handle->object;
+    uint64_t ticks;
+    uint64_t timestamp;
+    uint32_t pending;
+    uint32_t done;
+    uint8_t pin;
+
+    pin = stream.pins[conversion - stream.conversions];
+
+    /*
+     * If the Swi falls more than a block behind, the uDMA ping-pong runs
+     * dry and blocks are lost. Count them from the time elapsed: done
+     * blocks have ended by now, pending of them still queue behind this
+     * one. Anything beyond one block of latency was dropped.
+     */
+    ticks = (micros64() - stream.start) * stream.ticksPerMicro;
+    pending = object->blocksCompleted - object->blocksHandled;
+    done = ticks / ((uint64_t)stream.count * stream.periodTicks);
+    if (done > stream.blocks + pending + 1) {
+        stream.blocks = done - pending - 1;
+    }
+
+    /* the first sample of block n is the (n * count + 1)th trigger */
+    ticks = ((uint64_t)stream.blocks * stream.count + 1) * stream.periodTicks;
+    timestamp = stream.start + ticks / stream.ticksPerMicro;
+    stream.blocks++;
+
+    if (stream.microVolts != NULL) {
+        ADCBuf_adjustRawValues(handle, completedADCBuffer, stream.count,
+            completedChannel);
+        ADCBuf_convertAdjustedToMicroVolts(handle, completedChannel,
+            completedADCBuffer, stream.microVolts, stream.count);
+    }
+
+    stream.callback(pin, (uint16_t *)completedADCBuffer, stream.microVolts,
+        stream.count, timestamp);
+}
+
+/*
+ * Start sampling numPins pins round robin at rateHz. bufA and bufB each
+ * hold numPins * count samples; pins[i] fills bufA[i * count] and
+ * bufB[i * count] alternately. callback gets every completed block
+ * together with the micros64() time of its first sample. Returns 1 on
+ * success, 0 if the arguments are invalid, a stream is already
+ * running or the ADC or GPTimer0A is busy.
+ */
+int analogReadStreamPins(const uint8_t *pins, uint8_t numPins,
+    uint32_t rateHz, uint16_t *bufA, uint16_t *bufB, uint16_t count,
+    AnalogStreamCallback callback)
+{
+    ADCBufCC26XX_ParamsExtension adcBufExt;
+    ADCBuf_Params adcBufParams;
+    ADCBuf_Handle hAdcBuf;
+    Types_FreqHz freq;
+    uint8_t adcIndex;
+    uint8_t pin;
+    uint8_t i, j;
+
+    if (stream.hAdcBuf != NULL || pins == NULL || numPins == 0 ||
+        numPins > STREAM_MAX_PINS || bufA == NULL || bufB == NULL ||
+        count == 0 || count > STREAM_MAX_COUNT || callback == NULL ||
+        rateHz == 0 || rateHz > STREAM_MAX_RATE) {
+        return (0);
+    }
+
+    BIOS_getCpuFreq(&freq);
+    if (freq.lo / rateHz > STREAM_TIMER_MAX) {
+        return (0); /* slower than the trigger timer can count */
+    }
+
+    for (i = 0; i < numPins; i++) {
+        if (digital_pin_to_adc_index[pins[i]] == NOT_ON_ADC ||
+            digital_pin_to_pin_function[pins[i]] == PIN_FUNC_INVALID) {
+            return (0);
+        }
+        for (j = 0; j < i; j++) {
+            if (pins[j] == pins[i]) {
+                return (0);
+            }
+        }
+    }
+
+    ADCBuf_init();
+
+    adcBufExt.samplingDuration = ADCBufCC26XX_SAMPLING_DURATION_2P7_US;
+    adcBufExt.samplingMode = ADCBufCC26XX_SAMPING_MODE_SYNCHRONOUS;
+    adcBufExt.refSource = ADCBufCC26XX_FIXED_REFERENCE;
+    adcBufExt.inputScalingEnabled = true;
+
+    ADCBuf_Params_init(&adcBufParams);
+    adcBufParams.returnMode = ADCBuf_RETURN_MODE_CALLBACK;
+    adcBufParams.recurrenceMode = ADCBuf_RECURRENCE_MODE_CONTINUOUS;
+    adcBufParams.callbackFxn = streamCallback;
+    adcBufParams.samplingFrequency = rateHz;
+    adcBufParams.custom = &adcBufExt;
+
+    /* there is a single ADCBuf instance */
+    hAdcBuf = ADCBuf_open(0, &adcBufParams);
+    if (hAdcBuf == NULL) {
+        return (0);
+    }
+
+    for (i = 0; i < numPins; i++) {
+        pin = pins[i];
+        adcIndex = digital_pin_to_adc_index[pin];
+
+        /* undo pin's current plumbing */
+        switch (digital_pin_to_pin_function[pin]) {
+            case PIN_FUNC_ANALOG_OUTPUT:
+                stopAnalogWrite(pin);
+                break;
+            case PIN_FUNC_ANALOG_INPUT:
+                stopAnalogRead(pin);
+                break;
+            case PIN_FUNC_DIGITAL_INPUT:
+                stopDigitalRead(pin);
+                break;
+            case PIN_FUNC_DIGITAL_OUTPUT:
+                stopDigitalWrite(pin);
+                break;
+            case PIN_FUNC_CAPTURE:
+                stopCapture(pin);
+                break;
+        }
+        digital_pin_to_pin_function[pin] = PIN_FUNC_UNUSED;
+
+        /* ADCBuf channels are in the same order as the ADC instances */
+        stream.conversions[i].arg = NULL;
+        stream.conversions[i].adcChannel = adcIndex;
+        stream.conversions[i].sampleBuffer = bufA + i * count;
+        stream.conversions[i].sampleBufferTwo = bufB + i * count;
+        stream.conversions[i].samplesRequestedCount = count;
+        stream.pins[i] = pin;
+    }
+
+    stream.callback = callback;
+    stream.count = count;
+    stream.numPins = numPins;
+    stream.periodTicks = freq.lo / rateHz;
+    stream.ticksPerMicro = freq.lo / 1000000;
+    stream.blocks = 0;
+    stream.hAdcBuf = hAdcBuf;
+
+    /* the timer starts within a few microseconds of this */
+    stream.start = micros64();
+
+    if (ADCBuf_convert(hAdcBuf, stream.conversions, numPins) !=
+        ADCBuf_STATUS_SUCCESS) {
+        /* the sensor controller or analogRead() holds the ADC */
+        stream.hAdcBuf = NULL;
+        ADCBuf_close(hAdcBuf);
+        return (0);
+    }
+
+    for (i = 0; i < numPins; i++) {
+        digital_pin_to_pin_function[pins[i]] = PIN_FUNC_ANALOG_STREAM;
+    }
+
+    return (1);
+}
+
+/*
+ *  ======== analogReadStream ========
+ *  Single pin analogReadStreamPins(): bufA and bufB hold count samples.
+ */
+int analogReadStream(uint8_t pin, uint32_t rateHz, uint16_t *bufA,
+    uint16_t *bufB, uint16_t count, AnalogStreamCallback callback)
+{
+    return (analogReadStreamPins(&pin, 1, rateHz, bufA, bufB, count,
+        callback));
+}
+
+/*
+ * Have every completed block calibrated in place and converted to
+ * microvolts before the callback sees it. microVolts must hold count
+ * entries and is passed to the callback; NULL returns to raw samples.
+ * May be called while streaming.
+ */
+void analogReadStreamMicroVolts(uint32_t *microVolts)
+{
+    stream.microVolts = microVolts;
+}
+
+/*
+ *  ======== analogReadStreamEnd ========
+ *  Stop sampling and release the ADC, GPTimer0A and the pins.
+ */
+void analogReadStreamEnd(void)
+{
+    ADCBuf_Handle hAdcBuf = stream.hAdcBuf;
+    uint8_t i;
+
+    if (hAdcBuf == NULL) {
+        return;
+    }
+
+    /* cancels the running conversion */
+    ADCBuf_close(hAdcBuf);
+    stream.hAdcBuf = NULL;
+
+    for (i = 0; i < stream.numPins; i++) {
+        digital_pin_to_pin_function[stream.pins[i]] = PIN_FUNC_UNUSED;
+    }
+}
+
+/*
+ * This internal API is used to de-configure a pin that is being
+ * streamed. The pins share one conversion, so the whole stream ends.
+ */
+void stopAnalogStream(uint8_t pin)
+{
+    analogReadStreamEnd();
+}
@@ -0,0 +1,577 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define DEVICE_FAMILY cc13x0
+
+#include <ti/runtime/wiring/wiring_private.h>
+
+#include <ti/drivers/GPIO.h>
+#include <ti/drivers/gpio/GPIOCC26XX.h>
+
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/pin/PINCC26XX.h>
+
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <xdc/runtime/Types.h>
+
+/*
+ * pulseIn() and pulseCapture*() time pin edges with a GPTimer in
+ * edge-time mode. The 16-bit timer plus its 8-bit prescaler extension
+ * free-runs as a 24-bit counter clocked at the CPU frequency; the
+ * timeout interrupt counts rollovers so edge timestamps extend to 32
+ * bits (about 89 seconds at 48MHz).
+ *
+ * Timers are taken from the top of the GPTimer table down, since
+ * analogWrite() allocates its PWM timers from the bottom up.
+ */
+#define CAPTURE_NUM_TIMERS      8   /* GPT0A..GPT3B */
+#define CAPTURE_CHANNELS        4
+
+#define CAPTURE_WRAP_SHIFT      24
+#define CAPTURE_WRAP            (1UL << CAPTURE_WRAP_SHIFT)
+
+/* pulseIn() edge sequence */
+#define PULSE_WAIT_PREVIOUS     0   /* pin already in state, wait for it to leave */
+#define PULSE_WAIT_START        1
+#define PULSE_WAIT_END          2
+#define PULSE_DONE              3
+
+typedef struct CaptureChannel {
+    bool claimed;                   /* false while the channel is free */
+    GPTimerCC26XX_Handle hTimer;    /* NULL until the channel is open */
+    PIN_Handle hPin;
+    PIN_State pinState;
+    uint8_t pin;
+    uint8_t pinId;
+    uint8_t mode;                   /* pinMode() to restore when done */
+    volatile uint32_t wraps;        /* 24-bit counter rollovers */
+
+    /* pulseIn() */
+    Semaphore_Struct done;
+    volatile uint8_t phase;
+    GPTimerCC26XX_Edge startEdge;
+    GPTimerCC26XX_Edge endEdge;
+    uint32_t start;
+    uint32_t width;
+
+    /* pulseCapture*(): edge timestamps, bit 0 holds the new pin level */
+    uint32_t *ring;
+    uint16_t size;
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    volatile uint32_t overruns;
+    uint32_t last;
+    bool haveLast;
+} CaptureChannel;
+
+extern const GPIOCC26XX_Config GPIOCC26XX_config;
+
+static CaptureChannel channels[CAPTURE_CHANNELS];
+static uint32_t ticksPerMicro = 0;
+
+/*
+ *  ======== captureFind ========
+ */
+static CaptureChannel *captureFind(uint8_t pin)
+{
+    uint8_t i;
+
+    for (i = 0; i < CAPTURE_CHANNELS; i++) {
+        if (channels[i].hTimer != NULL && channels[i].pin == pin) {
+            return (&channels[i]);
+        }
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== captureStamp ========
+ *  Extend the 24-bit capture to 32 bits. A rollover that is pending
+ *  alongside the capture happened before the edge if the captured
+ *  count is still small.
+ */
+static uint32_t captureStamp(CaptureChannel *ch, GPTimerCC26XX_IntMask mask)
+{
+    uint32_t value = GPTimerCC26XX_getValue(ch->hTimer);
+    uint32_t wraps = ch->wraps;
+
+    if ((mask & GPT_INT_TIMEOUT) && value < (CAPTURE_WRAP / 2)) {
+        wraps++;
+    }
+
+    return ((wraps << CAPTURE_WRAP_SHIFT) | value);
+}
+
+/*
+ *  ======== captureHwiFxn ========
+ */
+static void captureHwiFxn(GPTimerCC26XX_Handle handle,
+                          GPTimerCC26XX_IntMask mask)
+{
+    CaptureChannel *ch = NULL;
+    uint32_t stamp;
+    uint16_t next;
+    uint8_t i;
+
+    for (i = 0; i < CAPTURE_CHANNELS; i++) {
+        if (channels[i].hTimer == handle) {
+            ch = &channels[i];
+            break;
+        }
+    }
+
+    if (ch == NULL) {
+        return;
+    }
+
+    if (mask & GPT_INT_CAPTURE) {
+        stamp = captureStamp(ch, mask);
+
+        if (ch->ring != NULL) {
+            /*
+             * Reading the level here rather than toggling a copy keeps
+             * the stream self-correcting if two edges arrive closer
+             * together than the interrupt latency.
+             */
+            stamp = (stamp & ~1) | (PIN_getInputValue(ch->pinId) ? 1 : 0);
+
+            next = ch->head + 1;
+            if (next == ch->size) {
+                next = 0;
+            }
+
+            if (next == ch->tail) {
+                ch->overruns++;
+            }
+            else {
+                ch->ring[ch->head] = stamp;
+                ch->head = next;
+            }
+        }
+        else {
+            switch (ch->phase) {
+                case PULSE_WAIT_PREVIOUS:
+                    ch->phase = PULSE_WAIT_START;
+                    GPTimerCC26XX_setCaptureEdge(handle, ch->startEdge);
+                    break;
+
+                case PULSE_WAIT_START:
+                    ch->start = stamp;
+                    ch->phase = PULSE_WAIT_END;
+                    GPTimerCC26XX_setCaptureEdge(handle, ch->endEdge);
+                    break;
+
+                case PULSE_WAIT_END:
+                    ch->width = stamp - ch->start;
+                    ch->phase = PULSE_DONE;
+                    Semaphore_post(Semaphore_handle(&ch->done));
+                    break;
+            }
+        }
+    }
+
+    if (mask & GPT_INT_TIMEOUT) {
+        ch->wraps++;
+    }
+}
+
+/*
+ *  ======== captureOpen ========
+ *  Claim a free channel and GPTimer, and route the pin to the timer's
+ *  capture input. Returns NULL if the pin can't be captured.
+ *
+ *  Only the channel and pin claim is made with interrupts disabled; the
+ *  driver calls that may block or take their own locks are made after,
+ *  and undo the claim if they fail.
+ */
+static CaptureChannel *captureOpen(uint8_t pin)
+{
+    GPTimerCC26XX_Params params;
+    GPTimerCC26XX_Handle hTimer = NULL;
+    CaptureChannel *ch = NULL;
+    PIN_Config pinConfig[2];
+    PIN_Config pull;
+    Types_FreqHz freq;
+    uint32_t hwiKey;
+    uint8_t function;
+    uint8_t pinId;
+    uint8_t i;
+
+    if (ticksPerMicro == 0) {
+        BIOS_getCpuFreq(&freq);
+        ticksPerMicro = freq.lo / 1000000;
+    }
+
+    hwiKey = Hwi_disable();
+
+    function = digital_pin_to_pin_function[pin];
+
+    if (function == PIN_FUNC_INVALID || function == PIN_FUNC_CAPTURE) {
+        Hwi_restore(hwiKey);
+        return (NULL);
+    }
+
+    for (i = 0; i < CAPTURE_CHANNELS; i++) {
+        if (channels[i].claimed == false) {
+            ch = &channels[i];
+            break;
+        }
+    }
+
+    if (ch == NULL) {
+        Hwi_restore(hwiKey);
+        return (NULL); /* all channels busy */
+    }
+
+    /* keep other threads off the channel and the pin while opening */
+    ch->claimed = true;
+    digital_pin_to_pin_function[pin] = PIN_FUNC_CAPTURE;
+
+    Hwi_restore(hwiKey);
+
+    GPTimerCC26XX_Params_init(&params);
+    params.width = GPT_CONFIG_16BIT;
+    params.mode = GPT_MODE_EDGE_TIME_UP;
+    params.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+
+    for (i = CAPTURE_NUM_TIMERS; i > 0; i--) {
+        hTimer = GPTimerCC26XX_open(i - 1, &params);
+        if (hTimer != NULL) {
+            break;
+        }
+    }
+
+    if (hTimer == NULL) {
+        /* every timer is in use, leave the pin as it was */
+        hwiKey = Hwi_disable();
+        digital_pin_to_pin_function[pin] = function;
+        ch->claimed = false;
+        Hwi_restore(hwiKey);
+        return (NULL);
+    }
+
+    /* extract 16bit pinID from pin */
+    pinId = GPIOCC26XX_config.pinConfigs[pin] & 0xff;
+
+    /* keep the pin's pull setting across the capture */
+    pull = PIN_getConfig(pinId) & PIN_BM_PULLING;
+
+    /* undo pin's current plumbing */
+    switch (function) {
+        case PIN_FUNC_ANALOG_OUTPUT:
+            stopAnalogWrite(pin);
+            break;
+        case PIN_FUNC_ANALOG_INPUT:
+            stopAnalogRead(pin);
+            break;
+        case PIN_FUNC_ANALOG_STREAM:
+            stopAnalogStream(pin);
+            break;
+        default:
+            stopDigitalRead(pin);
+            break;
+    }
+
+    pinConfig[0] = pinId | PIN_INPUT_EN | PIN_HYSTERESIS | PIN_GEN | pull;
+    pinConfig[1] = PIN_TERMINATE;
+
+    ch->hPin = PIN_open(&ch->pinState, pinConfig);
+
+    if (ch->hPin == NULL) {
+        /* pin is owned by another driver */
+        GPTimerCC26XX_close(hTimer);
+        hwiKey = Hwi_disable();
+        digital_pin_to_pin_function[pin] = PIN_FUNC_UNUSED;
+        ch->claimed = false;
+        Hwi_restore(hwiKey);
+        return (NULL);
+    }
+
+    PINCC26XX_setMux(ch->hPin, pinId, GPTimerCC26XX_getPinMux(hTimer));
+
+    ch->pin = pin;
+    ch->pinId = pinId;
+    ch->mode = (pull == PIN_PULLUP) ? INPUT_PULLUP :
+               (pull == PIN_PULLDOWN) ? INPUT_PULLDOWN : INPUT;
+    ch->wraps = 0;
+    ch->ring = NULL;
+
+    hwiKey = Hwi_disable();
+    ch->hTimer = hTimer;
+    /* the stop*() calls above may have marked the pin unused */
+    digital_pin_to_pin_function[pin] = PIN_FUNC_CAPTURE;
+    Hwi_restore(hwiKey);
+
+    GPTimerCC26XX_setLoadValue(hTimer, CAPTURE_WRAP - 1);
+    GPTimerCC26XX_registerInterrupt(hTimer, captureHwiFxn,
+        GPT_INT_CAPTURE | GPT_INT_TIMEOUT);
+
+    return (ch);
+}
+
+/*
+ *  ======== captureClose ========
+ *  Release the channel's timer and pin. The pin is left unconfigured.
+ */
+static void captureClose(CaptureChannel *ch)
+{
+    GPTimerCC26XX_Handle hTimer = ch->hTimer;
+    uint32_t hwiKey;
+
+    /* stopping the timer also releases its standby constraint */
+    GPTimerCC26XX_stop(hTimer);
+    GPTimerCC26XX_unregisterInterrupt(hTimer);
+
+    hwiKey = Hwi_disable();
+    ch->hTimer = NULL;
+    ch->ring = NULL;
+    digital_pin_to_pin_function[ch->pin] = PIN_FUNC_UNUSED;
+    Hwi_restore(hwiKey);
+
+    GPTimerCC26XX_close(hTimer);
+    PIN_close(ch->hPin);
+
+    ch->claimed = false;
+}
+
+/*
+ * This internal API is used to de-configure a pin that has been
+ * put in pulseCapture mode. It is called by pinMode() when a pin's
+ * function is being modified.
+ */
+void stopCapture(uint8_t pin)
+{
+    CaptureChannel *ch = captureFind(pin);
+
+    if (ch != NULL) {
+        captureClose(ch);
+    }
+}
+
+/*
+ * Measures the length (in microseconds) of a pulse on the pin; state is
+ * HIGH or LOW, the type of pulse to measure. The edges are timestamped
+ * by a GPTimer in hardware and the calling Task sleeps until the pulse
+ * ends or timeout microseconds pass. Returns 0 on timeout.
+ *
+ * Pulses shorter than the capture interrupt latency (a few
+ * microseconds) can't be resolved since the timer is re-armed for the
+ * opposite edge from the interrupt. Falls back to GPIO polling when no
+ * capture timer is free or when not called from a Task.
+ */
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout)
+{
+    CaptureChannel *ch;
+    UInt32 ticks;
+    uint32_t width = 0;
+    uint8_t mode;
+
+    if (BIOS_getThreadType() != BIOS_ThreadType_Task) {
+        return (pulseInPolling(pin, state, timeout));
+    }
+
+    ch = captureOpen(pin);
+    if (ch == NULL) {
+        return (pulseInPolling(pin, state, timeout));
+    }
+
+    if (state) {
+        ch->startEdge = GPTimerCC26XX_POS_EDGE;
+        ch->endEdge = GPTimerCC26XX_NEG_EDGE;
+    }
+    else {
+        ch->startEdge = GPTimerCC26XX_NEG_EDGE;
+        ch->endEdge = GPTimerCC26XX_POS_EDGE;
+    }
+
+    /* wait for any previous pulse to end */
+    if ((PIN_getInputValue(ch->pinId) ? 1 : 0) == (state ? 1 : 0)) {
+        ch->phase = PULSE_WAIT_PREVIOUS;
+        GPTimerCC26XX_setCaptureEdge(ch->hTimer, ch->endEdge);
+    }
+    else {
+        ch->phase = PULSE_WAIT_START;
+        GPTimerCC26XX_setCaptureEdge(ch->hTimer, ch->startEdge);
+    }
+
+    Semaphore_construct(&ch->done, 0, NULL);
+
+    /* round the timeout up to whole Clock ticks */
+    ticks = (timeout + Clock_tickPeriod - 1) / Clock_tickPeriod;
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    GPTimerCC26XX_start(ch->hTimer);
+
+    if (Semaphore_pend(Semaphore_handle(&ch->done), ticks)) {
+        width = ch->width / ticksPerMicro;
+    }
+
+    mode = ch->mode;
+    captureClose(ch);
+    Semaphore_destruct(&ch->done);
+
+    pinMode(pin, mode);
+
+    return (width);
+}
+
+/*
+ * Start timestamping every edge on the pin into buffer, a ring of size
+ * entries. Up to CAPTURE_CHANNELS pins can be captured at once, each
+ * using its own GPTimer. Returns 1 on success, 0 if the pin or no
+ * timer is available.
+ */
+int pulseCaptureBegin(uint8_t pin, uint32_t *buffer, uint16_t size)
+{
+    CaptureChannel *ch;
+
+    if (buffer == NULL || size < 2) {
+        return (0);
+    }
+
+    ch = captureOpen(pin);
+    if (ch == NULL) {
+        return (0);
+    }
+
+    ch->size = size;
+    ch->head = 0;
+    ch->tail = 0;
+    ch->overruns = 0;
+    ch->haveLast = false;
+    ch->ring = buffer;
+
+    GPTimerCC26XX_setCaptureEdge(ch->hTimer, GPTimerCC26XX_BOTH_EDGES);
+    GPTimerCC26XX_start(ch->hTimer);
+
+    return (1);
+}
+
+/*
+ *  ======== pulseCaptureAvailable ========
+ *  Number of complete pulses waiting to be read.
+ */
+int pulseCaptureAvailable(uint8_t pin)
+{
+    CaptureChannel *ch = captureFind(pin);
+    int count;
+
+    if (ch == NULL || ch->ring == NULL) {
+        return (0);
+    }
+
+    count = ch->head - ch->tail;
+    if (count < 0) {
+        count += ch->size;
+    }
+
+    /* the first edge only marks the start of the first pulse */
+    if (!ch->haveLast && count > 0) {
+        count--;
+    }
+
+    return (count);
+}
+
+/*
+ * Read the next complete pulse: its width in microseconds is stored in
+ * *width and its level (HIGH or LOW) is returned. Returns -1 if no
+ * pulse is available. A pulse spanning a dropped edge (see
+ * pulseCaptureOverruns()) reads as the sum of its neighbours.
+ */
+int pulseCaptureRead(uint8_t pin, unsigned long *width)
+{
+    CaptureChannel *ch = captureFind(pin);
+    uint32_t stamp;
+    int level;
+
+    if (ch == NULL || ch->ring == NULL) {
+        return (-1);
+    }
+
+    while (ch->tail != ch->head) {
+        stamp = ch->ring[ch->tail];
+        ch->tail = (ch->tail + 1 == ch->size) ? 0 : ch->tail + 1;
+
+        if (!ch->haveLast) {
+            ch->last = stamp;
+            ch->haveLast = true;
+            continue;
+        }
+
+        level = (ch->last & 1) ? HIGH : LOW;
+        *width = ((stamp & ~1) - (ch->last & ~1)) / ticksPerMicro;
+        ch->last = stamp;
+
+        return (level);
+    }
+
+    return (-1);
+}
+
+/*
+ *  ======== pulseCaptureOverruns ========
+ *  Number of edges dropped because the ring was full.
+ */
+uint32_t pulseCaptureOverruns(uint8_t pin)
+{
+    CaptureChannel *ch = captureFind(pin);
+
+    return ((ch != NULL) ? ch->overruns : 0);
+}
+
+/*
+ *  ======== pulseCaptureEnd ========
+ *  Stop capturing and return the pin to a digital input.
+ */
+void pulseCaptureEnd(uint8_t pin)
+{
+    CaptureChannel *ch = captureFind(pin);
+    uint8_t mode;
+
+    if (ch == NULL) {
+        return;
+    }
+
+    mode = ch->mode;
+    captureClose(ch);
+
+    pinMode(pin, mode);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Direct register access to the DIOs behind Energia pins.
+ *
+ * These bypass pinMode() bookkeeping and the GPIO driver: the pin must
+ * already have been configured with pinMode(), and pin numbers that
+ * are not compile-time constants lose most of the benefit.
+ *
+ *   #include <wiring_digital_fast.h>
+ *
+ *   pinMode(RED_LED, OUTPUT);
+ *   digitalWriteFast(RED_LED, HIGH);
+ *   FastPin<GREEN_LED>::toggle();
+ */
+
+#ifndef WiringDigitalFast_h
+#define WiringDigitalFast_h
+
+#include <ti/runtime/wiring/Energia.h>
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+
+#include <ti/devices/cc13x0/inc/hw_types.h>
+#include <ti/devices/cc13x0/inc/hw_memmap.h>
+#include <ti/devices/cc13x0/inc/hw_gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* pins without a DIO (NOT_A_DIO) get an empty mask, so they are ignored */
+#define digitalPinToDio(pin)        (digital_pin_to_dio[pin])
+#define digitalPinToBitMask(pin)    (digital_pin_to_dio[pin] == NOT_A_DIO ? \
+                                        0UL : 1UL << digital_pin_to_dio[pin])
+
+static inline void digitalWriteFast(uint8_t pin, uint8_t val)
+{
+    if (val) {
+        HWREG(GPIO_BASE + GPIO_O_DOUTSET31_0) = digitalPinToBitMask(pin);
+    }
+    else {
+        HWREG(GPIO_BASE + GPIO_O_DOUTCLR31_0) = digitalPinToBitMask(pin);
+    }
+}
+
+static inline int digitalReadFast(uint8_t pin)
+{
+    return ((HWREG(GPIO_BASE + GPIO_O_DIN31_0) & digitalPinToBitMask(pin)) != 0);
+}
+
+static inline void digitalToggleFast(uint8_t pin)
+{
+    HWREG(GPIO_BASE + GPIO_O_DOUTTGL31_0) = digitalPinToBitMask(pin);
+}
+
+/*
+ * Drive the DIOs selected by mask (built from digitalPinToBitMask())
+ * to the corresponding bits of value. This is a read-modify-write of
+ * DOUT31_0 with interrupts disabled: the selected pins all change with
+ * the one store, so a parallel bus never shows a half-updated word,
+ * which separate DOUTSET31_0 and DOUTCLR31_0 stores would not give.
+ */
+static inline void portWriteMask(uint32_t mask, uint32_t value)
+{
+    unsigned int key;
+
+    key = Hwi_disable();
+    HWREG(GPIO_BASE + GPIO_O_DOUT31_0) =
+        (HWREG(GPIO_BASE + GPIO_O_DOUT31_0) & ~mask) | (value & mask);
+    Hwi_restore(key);
+}
+
+static inline uint32_t portReadMask(uint32_t mask)
+{
+    return (HWREG(GPIO_BASE + GPIO_O_DIN31_0) & mask);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+
+/*
+ * Never defined: a call that survives optimization fails the build.
+ * The toolchain's C++ dialect has no static_assert, and the pin table
+ * is not a constant expression, but -Os folds the table lookup.
+ */
+extern void FastPin_pinHasNoDio(void)
+    __attribute__((error("FastPin<> used with a pin that has no DIO")));
+
+/*
+ * Pin bound at compile time; every member reduces to one load or store.
+ */
+template <uint8_t pin>
+class FastPin
+{
+    private:
+        static void check(void)
+        {
+#ifdef __OPTIMIZE__
+            if (digitalPinToDio(pin) == NOT_A_DIO) {
+                FastPin_pinHasNoDio();
+            }
+#endif
+        }
+
+    public:
+        static void mode(uint8_t mode) { check(); pinMode(pin, mode); }
+        static void high(void) { check(); digitalWriteFast(pin, HIGH); }
+        static void low(void) { check(); digitalWriteFast(pin, LOW); }
+        static void write(uint8_t val) { check(); digitalWriteFast(pin, val); }
+        static void toggle(void) { check(); digitalToggleFast(pin); }
+        static int read(void) { check(); return (digitalReadFast(pin)); }
+        static uint32_t mask(void) { check(); return (digitalPinToBitMask(pin)); }
+};
+#endif
+
+#endif
@@ -0,0 +1,545 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== wiring_profile.c ========
+ *
+ *  Threads are kept in a small table, looked up by handle; the table
+ *  only grows, so an index stays valid until the next reboot. It is
+ *  updated from the sampler Hwi and from the kernel hooks, always with
+ *  interrupts disabled, and read by profileGet() the same way.
+ *
+ *  The hooks charge the cycles since the previous hook to the thread on
+ *  top of 'running': entry 0 is the current Task, Swis and Hwis are
+ *  pushed by their begin hooks and popped by their end hooks.
+ */
+
+#define DEVICE_FAMILY cc13x0
+
+#include <stdbool.h>
+
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Swi.h>
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+#include <ti/sysbios/utils/Load.h>
+#include <xdc/runtime/Types.h>
+
+#include <ti/devices/cc13x0/inc/hw_types.h>
+#include <ti/devices/cc13x0/inc/hw_memmap.h>
+#include <ti/devices/cc13x0/inc/hw_cpu_dwt.h>
+
+#include "wiring_profile.h"
+
+/* the DWT cycle counter is started by timebaseInit() */
+#define CYCCNT              HWREG(CPU_DWT_BASE + CPU_DWT_O_CYCCNT)
+
+#define PROFILE_NUM_TIMERS  8       /* GPT0A..GPT3B */
+#define PROFILE_MAX_PERIOD  (1UL << 24)
+#define PROFILE_NEST        8       /* Task plus nested Swis and Hwis */
+
+typedef struct ProfileThread {
+    void *handle;
+    uint8_t kind;
+    uint32_t samples;
+    uint32_t switches;
+    uint64_t cycles;
+} ProfileThread;
+
+static ProfileThread threads[PROFILE_MAX_THREADS];
+static unsigned int numThreads = 0;
+
+static volatile bool enabled = false;
+static bool hooked = false;
+static uint8_t running[PROFILE_NEST];
+static unsigned int depth = 0;
+static unsigned int unpushed = 0;   /* begin hooks past PROFILE_NEST */
+static uint32_t lastStamp;
+
+static GPTimerCC26XX_Handle hTimer = NULL;
+static uint32_t samplePeriod = 0;   /* cycles */
+static uint32_t samples = 0;
+static uint32_t latencyMax = 0;
+static uint64_t latencySum = 0;
+
+static uint32_t cyclesPerMicro = 0;
+
+/*
+ *  ======== threadIndex ========
+ *  Find or add the table entry of a thread. Called with interrupts
+ *  disabled.
+ */
+static unsigned int threadIndex(void *handle, uint8_t kind)
+{
+    ProfileThread *t;
+    unsigned int i;
+
+    for (i = 0; i < numThreads; i++) {
+        if (threads[i].handle == handle) {
+            return (i);
+        }
+    }
+
+    if (numThreads == PROFILE_MAX_THREADS) {
+        return (PROFILE_MAX_THREADS - 1);
+    }
+
+    t = &threads[numThreads];
+    if (numThreads == PROFILE_MAX_THREADS - 1) {
+        /* last slot collects everything that doesn't fit */
+        handle = NULL;
+        kind = PROFILE_KIND_OTHER;
+    }
+    t->handle = handle;
+    t->kind = kind;
+    t->samples = 0;
+    t->switches = 0;
+    t->cycles = 0;
+
+    return (numThreads++);
+}
+
+/*
+ *  ======== profileCharge ========
+ *  Charge the cycles since the last hook to the running thread
+ */
+static inline void profileCharge(void)
+{
+    uint32_t now = CYCCNT;
+
+    threads[running[depth]].cycles += now - lastStamp;
+    lastStamp = now;
+}
+
+/*
+ *  ======== profilePush ========
+ */
+static void profilePush(void *handle, uint8_t kind)
+{
+    uint32_t hwiKey = Hwi_disable();
+    unsigned int i;
+
+    if (enabled) {
+        hooked = true;
+        profileCharge();
+        i = threadIndex(handle, kind);
+        threads[i].switches++;
+        if (depth < PROFILE_NEST - 1) {
+            running[++depth] = i;
+        }
+        else {
+            unpushed++;
+        }
+    }
+
+    Hwi_restore(hwiKey);
+}
+
+/*
+ *  ======== profilePop ========
+ */
+static void profilePop(void)
+{
+    uint32_t hwiKey = Hwi_disable();
+
+    if (enabled) {
+        profileCharge();
+        if (unpushed > 0) {
+            unpushed--;
+        }
+        else if (depth > 0) {
+            depth--;
+        }
+    }
+
+    Hwi_restore(hwiKey);
+}
+
+/*
+ *  ======== profileTaskSwitch ========
+ *  Task switch hook
+ */
+void profileTaskSwitch(Task_Handle prev, Task_Handle next)
+{
+    uint32_t hwiKey = Hwi_disable();
+
+    if (enabled) {
+        hooked = true;
+        profileCharge();
+        running[0] = threadIndex(next, PROFILE_KIND_TASK);
+        threads[running[0]].switches++;
+    }
+
+    Hwi_restore(hwiKey);
+}
+
+/*
+ *  ======== profileSwiBegin ========
+ */
+void profileSwiBegin(Swi_Handle swi)
+{
+    profilePush(swi, PROFILE_KIND_SWI);
+}
+
+/*
+ *  ======== profileSwiEnd ========
+ */
+void profileSwiEnd(Swi_Handle swi)
+{
+    profilePop();
+}
+
+/*
+ *  ======== profileHwiBegin ========
+ */
+void profileHwiBegin(Hwi_Handle hwi)
+{
+    profilePush(hwi, PROFILE_KIND_HWI);
+}
+
+/*
+ *  ======== profileHwiEnd ========
+ */
+void profileHwiEnd(Hwi_Handle hwi)
+{
+    profilePop();
+}
+
+/*
+ *  ======== profileSample ========
+ *  Sampler timeout interrupt. The timer restarts from 0 at every
+ *  timeout, so its value is the number of cycles it took to get here.
+ */
+static void profileSample(GPTimerCC26XX_Handle handle,
+                          GPTimerCC26XX_IntMask mask)
+{
+    uint32_t latency = GPTimerCC26XX_getValue(handle);
+    Swi_Handle swi = Swi_self();
+    uint32_t hwiKey;
+    unsigned int i;
+
+    hwiKey = Hwi_disable();
+
+    if (swi != NULL) {
+        i = threadIndex(swi, PROFILE_KIND_SWI);
+    }
+    else {
+        i = threadIndex(Task_self(), PROFILE_KIND_TASK);
+    }
+    threads[i].samples++;
+    samples++;
+
+    latencySum += latency;
+    if (latency > latencyMax) {
+        latencyMax = latency;
+    }
+
+    Hwi_restore(hwiKey);
+}
+
+/*
+ *  ======== profileBegin ========
+ *  Start profiling; sampleHz == 0 only enables the cfg hooks. Returns
+ *  false if no GPTimer is free for the sampler.
+ */
+bool profileBegin(uint32_t sampleHz)
+{
+    GPTimerCC26XX_Params params;
+    Types_FreqHz freq;
+    uint32_t hwiKey;
+    uint8_t i;
+
+    profileEnd();
+
+    BIOS_getCpuFreq(&freq);
+    cyclesPerMicro = freq.lo / 1000000;
+
+    profileReset();
+
+    hwiKey = Hwi_disable();
+    running[0] = threadIndex(Task_self(), PROFILE_KIND_TASK);
+    depth = 0;
+    unpushed = 0;
+    lastStamp = CYCCNT;
+    enabled = true;
+    Hwi_restore(hwiKey);
+
+    if (sampleHz == 0) {
+        return (true);
+    }
+
+    if (sampleHz > PROFILE_MAX_SAMPLE_HZ) {
+        sampleHz = PROFILE_MAX_SAMPLE_HZ;
+    }
+    samplePeriod = freq.lo / sampleHz;
+    if (samplePeriod > PROFILE_MAX_PERIOD) {
+        samplePeriod = PROFILE_MAX_PERIOD;
+    }
+
+    /*
+     * 16-bit periodic up mode uses the prescaler as a timer extension,
+     * giving a 24-bit period. Take timers from the top like pulseIn().
+     */
+    GPTimerCC26XX_Params_init(&params);
+    params.width = GPT_CONFIG_16BIT;
+    params.mode = GPT_MODE_PERIODIC_UP;
+    params.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+
+    for (i = PROFILE_NUM_TIMERS; i > 0; i--) {
+        hTimer = GPTimerCC26XX_open(i - 1, &params);
+        if (hTimer != NULL) {
+            break;
+        }
+    }
+
+    if (hTimer == NULL) {
+        samplePeriod = 0;
+        return (false);
+    }
+
+    GPTimerCC26XX_setLoadValue(hTimer, samplePeriod - 1);
+    GPTimerCC26XX_registerInterrupt(hTimer, profileSample, GPT_INT_TIMEOUT);
+    GPTimerCC26XX_start(hTimer);
+
+    return (true);
+}
+
+/*
+ *  ======== profileEnd ========
+ *  Stop collecting; the numbers stay available to profileGet()
+ */
+void profileEnd(void)
+{
+    enabled = false;
+
+    if (hTimer != NULL) {
+        GPTimerCC26XX_stop(hTimer);
+        GPTimerCC26XX_unregisterInterrupt(hTimer);
+        GPTimerCC26XX_close(hTimer);
+        hTimer = NULL;
+    }
+}
+
+/*
+ *  ======== profileReset ========
+ *  Clear all counters, keeping the known threads
+ */
+void profileReset(void)
+{
+    uint32_t hwiKey = Hwi_disable();
+    unsigned int i;
+
+    for (i = 0; i < numThreads; i++) {
+        threads[i].samples = 0;
+        threads[i].switches = 0;
+        threads[i].cycles = 0;
+    }
+    samples = 0;
+    latencyMax = 0;
+    latencySum = 0;
+    lastStamp = CYCCNT;
+
+    Hwi_restore(hwiKey);
+}
+
+/*
+ *  ======== taskExists ========
+ *  Called with the Task scheduler disabled
+ */
+static bool taskExists(Task_Handle task)
+{
+    Task_Handle t;
+    int i;
+
+    for (i = 0; i < Task_Object_count(); i++) {
+        if (Task_Object_get(NULL, i) == task) {
+            return (true);
+        }
+    }
+
+    for (t = Task_Object_first(); t != NULL; t = Task_Object_next(t)) {
+        if (t == task) {
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+/*
+ *  ======== profileTaskStat ========
+ */
+static void profileTaskStat(ProfileStat *stat)
+{
+    Task_Handle task = (Task_Handle)stat->handle;
+    Task_Stat ts;
+    UInt taskKey;
+
+    taskKey = Task_disable();
+
+    if (!taskExists(task)) {
+        Task_restore(taskKey);
+        stat->state = PROFILE_STATE_DONE;
+        return;
+    }
+
+    Task_stat(task, &ts);
+    stat->name = Task_Handle_name(task);
+
+    Task_restore(taskKey);
+
+    switch (ts.mode) {
+        case Task_Mode_RUNNING:
+            stat->state = PROFILE_STATE_RUNNING;
+            break;
+        case Task_Mode_READY:
+            stat->state = PROFILE_STATE_READY;
+            break;
+        case Task_Mode_BLOCKED:
+            stat->state = PROFILE_STATE_BLOCKED;
+            break;
+        default:
+            stat->state = PROFILE_STATE_DONE;
+            break;
+    }
+    stat->priority = ts.priority;
+    stat->stackUsed = ts.used;
+    stat->stackSize = ts.stackSize;
+}
+
+/*
+ *  ======== profileGet ========
+ *  Fill in stat for the index'th thread seen since boot. Returns false
+ *  past the last one.
+ */
+bool profileGet(unsigned int index, ProfileStat *stat)
+{
+    ProfileThread t;
+    uint64_t totalCycles = 0;
+    uint64_t runCycles;
+    uint32_t totalSamples;
+    uint32_t hwiKey;
+    unsigned int i;
+
+    hwiKey = Hwi_disable();
+
+    if (index >= numThreads) {
+        Hwi_restore(hwiKey);
+        return (false);
+    }
+    t = threads[index];
+    totalSamples = samples;
+
+    Hwi_restore(hwiKey);
+
+    /* other threads may add up while we sum, but never by much */
+    for (i = 0; i < numThreads; i++) {
+        totalCycles += threads[i].cycles;
+    }
+
+    stat->handle = t.handle;
+    stat->name = NULL;
+    stat->kind = t.kind;
+    stat->state = PROFILE_STATE_NONE;
+    stat->priority = -1;
+    stat->samples = t.samples;
+    stat->cycles = t.cycles;
+    stat->switches = t.switches;
+    stat->stackUsed = 0;
+    stat->stackSize = 0;
+
+    if (totalSamples != 0) {
+        stat->permille = (uint64_t)t.samples * 1000 / totalSamples;
+    }
+    else if (totalCycles != 0) {
+        stat->permille = t.cycles * 1000 / totalCycles;
+    }
+    else {
+        stat->permille = 0;
+    }
+
+    /* without the hooks, estimate the run time from the samples */
+    runCycles = hooked ? t.cycles : (uint64_t)t.samples * samplePeriod;
+    stat->runMicros = cyclesPerMicro ? runCycles / cyclesPerMicro : 0;
+
+    switch (t.kind) {
+        case PROFILE_KIND_TASK:
+            profileTaskStat(stat);
+            break;
+        case PROFILE_KIND_SWI:
+            stat->name = Swi_Handle_name((Swi_Handle)t.handle);
+            break;
+        case PROFILE_KIND_HWI:
+            stat->name = Hwi_Handle_name((Hwi_Handle)t.handle);
+            break;
+        default:
+            break;
+    }
+
+    return (true);
+}
+
+/*
+ *  ======== profileSummary ========
+ */
+void profileSummary(ProfileSummary *summary)
+{
+    Hwi_StackInfo info;
+    uint32_t latencyAvg = 0;
+    uint32_t hwiKey;
+
+    hwiKey = Hwi_disable();
+
+    summary->samples = samples;
+    summary->latencyMaxNanos = latencyMax;
+    if (samples != 0) {
+        latencyAvg = latencySum / samples;
+    }
+
+    Hwi_restore(hwiKey);
+
+    if (cyclesPerMicro != 0) {
+        summary->latencyMaxNanos =
+            summary->latencyMaxNanos * 1000 / cyclesPerMicro;
+        latencyAvg = latencyAvg * 1000 / cyclesPerMicro;
+    }
+    summary->latencyAvgNanos = latencyAvg;
+
+    Hwi_getStackInfo(&info, TRUE);
+    summary->isrStackPeak = info.hwiStackPeak;
+    summary->isrStackSize = info.hwiStackSize;
+
+    summary->cpuLoad = Load_getCPULoad();
+    summary->hooked = hooked;
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * CPU load profiler.
+ *
+ * Reports, per Task and Swi, the share of CPU time, the run time, how
+ * often it was switched in and how much of its stack it has used, plus
+ * the worst case and average interrupt latency and the ISR stack peak.
+ *
+ *   #include <wiring_profile.h>
+ *
+ *   profileBegin(1000);         // sample 1000 times a second
+ *   ...
+ *   profilePrint(Serial);       // top-like table
+ *
+ * In sampling mode a GPTimer interrupts the CPU sampleHz times a second
+ * and charges the sample to whatever Swi or Task it interrupted, so the
+ * overhead is fixed by the sample rate no matter how busy the system is.
+ * The timer runs at the lowest Hwi priority, so the cycles between its
+ * timeout and the sample are the latency a low priority ISR sees.
+ *
+ * Cycle accurate run times and switch counts need the hooks below in the
+ * application .cfg file. They charge every Task, Swi and Hwi with the DWT
+ * cycle counter; the sampler can run alongside or be left off with
+ * profileBegin(0):
+ *
+ *   Task.addHookSet({switchFxn: '&profileTaskSwitch'});
+ *   Swi.addHookSet({beginFxn: '&profileSwiBegin', endFxn: '&profileSwiEnd'});
+ *   Hwi.addHookSet({beginFxn: '&profileHwiBegin', endFxn: '&profileHwiEnd'});
+ *
+ * The cycle counter stops while the CPU sleeps in the idle loop, so run
+ * times only add up to the time the CPU was awake; CPU shares are taken
+ * from the samples when there are any.
+ */
+
+#ifndef WiringProfile_h
+#define WiringProfile_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* threads tracked individually; any further ones share the last slot */
+#ifndef PROFILE_MAX_THREADS
+#define PROFILE_MAX_THREADS     16
+#endif
+
+#define PROFILE_MAX_SAMPLE_HZ   10000
+
+#define PROFILE_KIND_TASK       0
+#define PROFILE_KIND_SWI        1
+#define PROFILE_KIND_HWI        2
+#define PROFILE_KIND_OTHER      3
+
+#define PROFILE_STATE_RUNNING   0
+#define PROFILE_STATE_READY     1
+#define PROFILE_STATE_BLOCKED   2
+#define PROFILE_STATE_DONE      3   /* terminated, inactive or deleted */
+#define PROFILE_STATE_NONE      4   /* Swi, Hwi */
+
+typedef struct ProfileStat {
+    void *handle;
+    const char *name;       /* NULL if the instance has no name */
+    uint8_t kind;
+    uint8_t state;
+    int8_t priority;        /* -1 for Swi and Hwi */
+    uint16_t permille;      /* share of the CPU, 0..1000 */
+    uint32_t samples;
+    uint64_t cycles;
+    uint32_t runMicros;
+    uint32_t switches;      /* times switched in (Task) or run (Swi, Hwi) */
+    uint32_t stackUsed;     /* Tasks only, 0 otherwise */
+    uint32_t stackSize;
+} ProfileStat;
+
+typedef struct ProfileSummary {
+    uint32_t cpuLoad;       /* percent, from the Load module's last window */
+    uint32_t samples;
+    uint32_t latencyMaxNanos;
+    uint32_t latencyAvgNanos;
+    uint32_t isrStackPeak;
+    uint32_t isrStackSize;
+    bool hooked;            /* cfg hooks are installed and have run */
+} ProfileSummary;
+
+extern bool profileBegin(uint32_t sampleHz);
+extern void profileEnd(void);
+extern void profileReset(void);
+
+extern bool profileGet(unsigned int index, ProfileStat *stat);
+extern void profileSummary(ProfileSummary *summary);
+
+#ifdef __cplusplus
+} // extern "C"
+
+#include <string.h>
+
+#include "Print.h"
+
+static inline void profileColumn(Print &out, unsigned long value,
+    unsigned int width)
+{
+    unsigned long limit;
+
+    for (limit = 10; width > 1; width--, limit *= 10) {
+        if (value < limit) {
+            out.print(' ');
+        }
+    }
+    out.print(value);
+}
+
+/*
+ * Print a top-like table of all threads seen so far to out, e.g. Serial
+ */
+static inline void profilePrint(Print &out)
+{
+    static const char *states[] = {"run  ", "ready", "block", "done ", "     "};
+    static const char *kinds[] = {"", "swi ", "hwi ", ""};
+    ProfileSummary sum;
+    ProfileStat st;
+    unsigned int i, len;
+
+    profileSummary(&sum);
+
+    out.print("cpu ");
+    out.print(sum.cpuLoad);
+    out.print("%  samples ");
+    out.print(sum.samples);
+    out.print("  isr latency max ");
+    out.print(sum.latencyMaxNanos);
+    out.print("ns avg ");
+    out.print(sum.latencyAvgNanos);
+    out.print("ns  isr stack ");
+    out.print(sum.isrStackPeak);
+    out.print('/');
+    out.println(sum.isrStackSize);
+    out.println("NAME                 PRI STATE   CPU%    RUN(ms)   SWITCH  STACK");
+
+    for (i = 0; profileGet(i, &st); i++) {
+        out.print(kinds[st.kind]);
+        len = strlen(kinds[st.kind]);
+        if (st.kind == PROFILE_KIND_OTHER) {
+            len += out.print("(other)");
+        }
+        else if (st.name != NULL && st.name[0] != '\0') {
+            len += out.print(st.name);
+        }
+        else {
+            len += out.print("0x");
+            len += out.print((unsigned long)st.handle, HEX);
+        }
+        do {
+            out.print(' ');
+        } while (++len < 20);
+
+        if (st.priority < 0) {
+            out.print("   -");
+        }
+        else {
+            profileColumn(out, st.priority, 4);
+        }
+        out.print(' ');
+        out.print(states[st.state]);
+        profileColumn(out, st.permille / 10, 5);
+        out.print('.');
+        out.print(st.permille % 10);
+        profileColumn(out, st.runMicros / 1000, 11);
+        profileColumn(out, st.switches, 9);
+        if (st.stackSize != 0) {
+            out.print("  ");
+            out.print(st.stackUsed);
+            out.print('/');
+            out.print(st.stackSize);
+        }
+        out.println();
+    }
+}
+#endif
+
+#endif
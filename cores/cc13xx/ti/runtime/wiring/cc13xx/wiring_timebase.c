@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define DEVICE_FAMILY cc13x0
+
+#include <ti/runtime/wiring/Energia.h>
+#include <ti/sysbios/family/arm/m3/TimestampProvider.h>
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+#include <xdc/runtime/Types.h>
+#include <ti/sysbios/knl/Clock.h>
+
+#include <ti/devices/cc13x0/inc/hw_types.h>
+#include <ti/devices/cc13x0/inc/hw_memmap.h>
+#include <ti/devices/cc13x0/inc/hw_cpu_dwt.h>
+#include <ti/devices/cc13x0/inc/hw_cpu_scs.h>
+
+#include "wiring_timebase.h"
+
+/*
+ * delayMicroseconds() and cyclesNow() run off the Cortex-M3 DWT cycle
+ * counter, which counts CPU clock cycles regardless of interrupts.
+ */
+#define CYCCNT              HWREG(CPU_DWT_BASE + CPU_DWT_O_CYCCNT)
+#define CYCCNT_ENABLED      (HWREG(CPU_DWT_BASE + CPU_DWT_O_CTRL) & CPU_DWT_CTRL_CYCCNTENA)
+
+/* longest single spin, keeps us * cyclesPerMicro within 32 bits */
+#define DELAY_CHUNK_US      1000000
+
+/*
+ * micros() converts the CPU cycle timestamp relative to a cached
+ * (cycles, microseconds) base pair. Keeping the delta from the base
+ * below maxDelta (at most TIMEBASE_MAX_DELTA) lets a single
+ * 32 x 32 -> 64 bit multiply and a shift replace the 64-bit division,
+ * with exactly the same result.
+ */
+#define TIMEBASE_MAX_DELTA  0x40000000UL
+
+typedef struct Timebase_Reciprocal {
+    uint32_t mult;
+    uint32_t shift;
+} Timebase_Reciprocal;
+
+#define TIMEBASE_SCALE(r, x) \
+    ((uint32_t)(((uint64_t)(uint32_t)(x) * (r).mult) >> (r).shift))
+
+static Timebase_Reciprocal cyclesToMicros;
+static Timebase_Reciprocal ticksToMillis;
+static bool microsExact = false;
+static bool millisExact = false;
+
+/* cycles to microseconds as a reduced fraction, for the inexact case */
+static uint32_t microsNum;
+static uint32_t microsDen;
+static uint32_t maxDelta = TIMEBASE_MAX_DELTA;
+
+/* the base is advanced in steps that are an exact number of microseconds */
+static uint32_t rebaseCycles;
+static uint32_t rebaseMicros;
+
+static uint64_t baseCycles = 0;
+static uint64_t baseMicros = 0;
+
+static uint32_t cyclesPerMicro = 0;
+
+/* cycles spent entering and leaving the delay functions */
+static uint32_t delayOverhead = 0;
+static uint32_t delayAtomicOverhead = 0;
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    uint32_t t;
+
+    while (b != 0) {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return (a);
+}
+
+/*
+ *  ======== reciprocal ========
+ *  Find mult and shift such that (x * mult) >> shift approximates
+ *  x * num / den with mult as large as fits in 32 bits.
+ *
+ *  Returns true if the result is exactly floor(x * num / den) for every
+ *  x < range.
+ */
+static bool reciprocal(uint32_t num, uint32_t den, uint64_t range,
+    Timebase_Reciprocal *r)
+{
+    uint64_t scaled = 0;
+    uint64_t mult = 0;
+    uint32_t shift;
+
+    for (shift = 63; shift > 0; shift--) {
+        scaled = (uint64_t)num << shift;
+        if ((scaled >> shift) != num) {
+            continue;
+        }
+        mult = (scaled + den - 1) / den;
+        if (mult <= 0xffffffff) {
+            break;
+        }
+    }
+
+    r->mult = mult;
+    r->shift = shift;
+
+    /* the rounding error of mult must not carry into the integer part */
+    return (range * (mult * den - scaled) < ((uint64_t)1 << shift));
+}
+
+/*
+ *  ======== cyclesEnable ========
+ *  The DWT is not retained in standby, so this is re-checked before use.
+ */
+static void cyclesEnable(void)
+{
+    HWREG(CPU_SCS_BASE + CPU_SCS_O_DEMCR) |= CPU_SCS_DEMCR_TRCENA;
+    HWREG(CPU_DWT_BASE + CPU_DWT_O_CTRL) |= CPU_DWT_CTRL_CYCCNTENA;
+}
+
+/*
+ *  ======== delayFrom ========
+ *  Spin until us microseconds, less overhead cycles, have elapsed
+ *  since the cycle count start.
+ */
+static inline void delayFrom(uint32_t start, unsigned int us, uint32_t overhead)
+{
+    uint32_t cycles;
+
+    while (us > DELAY_CHUNK_US) {
+        cycles = DELAY_CHUNK_US * cyclesPerMicro;
+        while ((CYCCNT - start) < cycles) {
+            ;
+        }
+        start += cycles;
+        us -= DELAY_CHUNK_US;
+    }
+
+    cycles = us * cyclesPerMicro;
+    if (cycles <= overhead) {
+        return;
+    }
+    cycles -= overhead;
+
+    while ((CYCCNT - start) < cycles) {
+        ;
+    }
+}
+
+/*
+ *  ======== delayCalibrate ========
+ *  Measure how many cycles a 1us delay really takes, on top of the
+ *  cost of reading the cycle counter, and keep the excess as overhead.
+ *  The shortest of a few runs is used so that cold flash cache lines
+ *  do not inflate the result.
+ */
+static void delayCalibrate(void)
+{
+    unsigned int key;
+    uint32_t t0, t1, read, total, atomic;
+    int i;
+
+    read = total = atomic = ~0;
+
+    key = Hwi_disable();
+
+    delayOverhead = 0;
+    delayAtomicOverhead = 0;
+
+    for (i = 0; i < 4; i++) {
+        t0 = CYCCNT;
+        t1 = CYCCNT;
+        read = min(read, t1 - t0);
+
+        t0 = CYCCNT;
+        delayMicroseconds(1);
+        t1 = CYCCNT;
+        total = min(total, t1 - t0);
+
+        t0 = CYCCNT;
+        delayMicrosecondsAtomic(1);
+        t1 = CYCCNT;
+        atomic = min(atomic, t1 - t0);
+    }
+
+    if (total > read + cyclesPerMicro) {
+        delayOverhead = total - read - cyclesPerMicro;
+    }
+    if (atomic > read + cyclesPerMicro) {
+        delayAtomicOverhead = atomic - read - cyclesPerMicro;
+    }
+
+    Hwi_restore(key);
+}
+
+/*
+ *  ======== timebaseInit ========
+ */
+void timebaseInit(void)
+{
+    Types_FreqHz freq;
+    uint32_t g, k;
+
+    TimestampProvider_getFreq(&freq);
+
+    cyclesEnable();
+    cyclesPerMicro = max(freq.lo / 1000000, 1);
+    delayCalibrate();
+
+    g = gcd(freq.lo, 1000000);
+    microsNum = 1000000 / g;
+    microsDen = freq.lo / g;
+
+    /*
+     * The reciprocal is exact over 2^30 cycles at whole MHz clocks. At
+     * other clocks, shrink the rebase interval until it is exact, and
+     * fall back to dividing if that would leave less than one step.
+     */
+    maxDelta = TIMEBASE_MAX_DELTA;
+    while (!(microsExact = reciprocal(microsNum, microsDen, maxDelta,
+        &cyclesToMicros)) && (maxDelta >> 1) > microsDen) {
+        maxDelta >>= 1;
+    }
+    if (!microsExact) {
+        maxDelta = TIMEBASE_MAX_DELTA;
+    }
+
+    k = (maxDelta - 1) / microsDen;
+    rebaseCycles = k * microsDen;
+    rebaseMicros = k * microsNum;
+
+    g = gcd(Clock_tickPeriod, 1000);
+    millisExact = reciprocal(Clock_tickPeriod / g, 1000 / g,
+        (uint64_t)1 << 32, &ticksToMillis);
+}
+
+/*
+ *  ======== micros64 ========
+ */
+uint64_t micros64(void)
+{
+    Types_Timestamp64 time;
+    uint64_t cycles;
+    uint64_t us;
+    uint64_t steps;
+    uint32_t delta;
+    unsigned int key;
+
+    if (rebaseCycles == 0) {
+        timebaseInit();
+    }
+
+    key = Hwi_disable();
+
+    TimestampProvider_get64(&time);
+    cycles = ((uint64_t)time.hi << 32) | time.lo;
+
+    if ((cycles - baseCycles) >= maxDelta) {
+        /* only a long gap between calls needs a divide to catch up */
+        if ((cycles - baseCycles) < 2 * (uint64_t)rebaseCycles) {
+            steps = 1;
+        }
+        else {
+            steps = (cycles - baseCycles) / rebaseCycles;
+        }
+        baseCycles += steps * rebaseCycles;
+        baseMicros += steps * rebaseMicros;
+    }
+
+    delta = cycles - baseCycles;
+    if (microsExact) {
+        us = baseMicros + TIMEBASE_SCALE(cyclesToMicros, delta);
+    }
+    else {
+        us = baseMicros + ((uint64_t)delta * microsNum) / microsDen;
+    }
+
+    Hwi_restore(key);
+
+    return (us);
+}
+
+/*
+ *  ======== micros ========
+ */
+unsigned long micros(void)
+{
+    return ((unsigned long)micros64());
+}
+
+/*
+ *  ======== cyclesNow ========
+ *  Free running CPU cycle count, for profiling. Wraps every 2^32 cycles
+ *  and does not advance while the CPU is asleep.
+ */
+uint32_t cyclesNow(void)
+{
+    if (!CYCCNT_ENABLED) {
+        cyclesEnable();
+    }
+
+    return (CYCCNT);
+}
+
+/*
+ *  ======== delayMicroseconds ========
+ *  Delay for the given number of microseconds
+ *
+ *  Interrupts that run past the end of the delay lengthen it; use
+ *  delayMicrosecondsAtomic() where that cannot be tolerated.
+ */
+void delayMicroseconds(unsigned int us)
+{
+    uint32_t start = CYCCNT;
+
+    if (!CYCCNT_ENABLED) {
+        cyclesEnable();
+        start = CYCCNT;
+    }
+
+    delayFrom(start, us, delayOverhead);
+}
+
+/*
+ *  ======== delayMicrosecondsAtomic ========
+ *  Delay for the given number of microseconds with interrupts masked.
+ *
+ *  Interrupt latency grows by the full delay, so keep this to the short
+ *  windows of bit-banged protocols.
+ */
+void delayMicrosecondsAtomic(unsigned int us)
+{
+    unsigned int key;
+    uint32_t start;
+
+    key = Hwi_disable();
+
+    start = CYCCNT;
+
+    if (!CYCCNT_ENABLED) {
+        cyclesEnable();
+        start = CYCCNT;
+    }
+
+    delayFrom(start, us, delayAtomicOverhead);
+
+    Hwi_restore(key);
+}
+
+/*
+ *  ======== millis ========
+ */
+unsigned long millis(void)
+{
+    uint64_t milliseconds;
+
+    if (millisExact) {
+        return (TIMEBASE_SCALE(ticksToMillis, Clock_getTicks()));
+    }
+
+    milliseconds = ((uint64_t)Clock_getTicks() * (uint64_t)Clock_tickPeriod) / (uint64_t)1000;
+
+    return (milliseconds);
+}
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== wiring_trace.c ========
+ *
+ *  Record format, all fields unsigned LEB128 varints:
+ *
+ *      header      id << 4 | TRACE_HDR_ABS | nargs
+ *      time        cycles since the previous record in the same ring, or
+ *                  the absolute cycle count if TRACE_HDR_ABS is set
+ *      arg[nargs]
+ *
+ *  Any number of writers, preempting each other in any order, share a
+ *  ring without disabling interrupts:
+ *
+ *   - bytes are claimed with an LDREX/STREX on 'reserve'; an interrupt
+ *     between the two makes the STREX fail and the claim is retried
+ *   - a delta timestamp is only used if the previous claim has recorded
+ *     its time ('lastEnd' == claim position); a writer that preempted
+ *     another one between its claim and that update logs absolute time
+ *   - 'writers' counts claims not yet filled in; whoever brings it back
+ *     to zero publishes everything claimed so far by moving 'commit'
+ *
+ *  traceDrain() is the single reader and only reads up to 'commit'.
+ *  A record that does not fit in the ring is dropped and counted.
+ */
+
+#include <stdbool.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Swi.h>
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+
+#include <ti/devices/cc13x0/inc/hw_types.h>
+#include <ti/devices/cc13x0/inc/hw_memmap.h>
+#include <ti/devices/cc13x0/inc/hw_cpu_dwt.h>
+
+#include "wiring_trace.h"
+
+#if (TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) != 0
+#error TRACE_RING_SIZE must be a power of two
+#endif
+
+/* the DWT cycle counter is started by timebaseInit() */
+#define CYCCNT              HWREG(CPU_DWT_BASE + CPU_DWT_O_CYCCNT)
+
+#define TRACE_HDR_ABS       0x8
+#define TRACE_HDR(id, n)    (((id) << 4) | (n))
+
+/* "TRC1", marks the start of traceLog in a RAM dump */
+#define TRACE_MAGIC         0x31435254
+
+/* traceDrain() frame: sync, ctx, dropped, length, then the ring bytes */
+#define TRACE_FRAME_SYNC    0xA5
+#define TRACE_FRAME_MAX_HDR (1 + 1 + 5 + 5)
+
+/* longest record: header, time and four args */
+#define TRACE_MAX_RECORD    (6 * 5)
+
+/* keep the compiler from moving ring accesses across index updates */
+#define TRACE_BARRIER()     asm volatile("" : : : "memory")
+
+#if TRACE_RING_SIZE
+
+typedef struct TraceRing {
+    volatile uint32_t reserve;  /* bytes claimed by writers */
+    volatile uint32_t commit;   /* bytes complete, visible to traceDrain() */
+    volatile uint32_t tail;     /* bytes consumed by traceDrain() */
+    volatile uint32_t writers;  /* claims not yet filled in */
+    volatile uint32_t last;     /* time of the record ending at lastEnd */
+    volatile uint32_t lastEnd;
+    volatile uint32_t dropped;
+    uint8_t data[TRACE_RING_SIZE];
+} TraceRing;
+
+/*
+ * Kept global and self-describing so a RAM dump can be decoded: the
+ * host tool looks for the magic word and reads the rings that follow.
+ */
+typedef struct TraceLog {
+    uint32_t magic;
+    uint32_t ringSize;
+    uint32_t numCtx;
+    volatile uint32_t enabled;
+    TraceRing ring[TRACE_NUM_CTX];
+} TraceLog;
+
+TraceLog traceLog;
+
+/*
+ *  ======== traceLdrex, traceStrex, traceClrex ========
+ *  Exclusive access to the ring indices; traceStrex() returns non-zero
+ *  if the store failed. extras/trace_vectors.c builds this file on the
+ *  host with versions that inject preemption.
+ */
+#ifndef TRACE_HOST_EXCLUSIVES
+static inline uint32_t traceLdrex(volatile uint32_t *addr)
+{
+    uint32_t value;
+
+    asm volatile("ldrex %0, [%1]" : "=r" (value) : "r" (addr) : "memory");
+
+    return (value);
+}
+
+static inline uint32_t traceStrex(volatile uint32_t *addr, uint32_t value)
+{
+    uint32_t failed;
+
+    asm volatile("strex %0, %2, [%1]" : "=&r" (failed)
+        : "r" (addr), "r" (value) : "memory");
+
+    return (failed);
+}
+
+static inline void traceClrex(void)
+{
+    asm volatile("clrex" : : : "memory");
+}
+#endif
+
+/*
+ *  ======== traceAdd ========
+ *  Atomically add inc to *count, returning the previous value
+ */
+static inline uint32_t traceAdd(volatile uint32_t *count, uint32_t inc)
+{
+    uint32_t old;
+
+    do {
+        old = traceLdrex(count);
+    } while (traceStrex(count, old + inc));
+
+    return (old);
+}
+
+/*
+ *  ======== varintLen ========
+ */
+static inline uint32_t varintLen(uint32_t v)
+{
+    return ((32 - __builtin_clz(v | 1) + 6) / 7);
+}
+
+/*
+ *  ======== varintPut ========
+ */
+static inline uint8_t *varintPut(uint8_t *p, uint32_t v)
+{
+    while (v >= 0x80) {
+        *p++ = (uint8_t)v | 0x80;
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+
+    return (p);
+}
+
+/*
+ *  ======== ringPublish ========
+ *  Move commit up to reserve unless a claim is still being filled in
+ */
+static void ringPublish(TraceRing *r)
+{
+    do {
+        traceLdrex(&r->commit);
+        if (r->writers != 0) {
+            /* the last writer out will publish */
+            traceClrex();
+            return;
+        }
+    } while (traceStrex(&r->commit, r->reserve));
+}
+
+/*
+ *  ======== traceRecord ========
+ */
+static void traceRecord(TraceRing *r, uint32_t hdr, const uint32_t *args)
+{
+    uint8_t tmp[TRACE_MAX_RECORD];
+    uint8_t *p, *dst;
+    uint32_t nargs = hdr & 0x7;
+    uint32_t argLen = 0;
+    uint32_t head, pos, ts, time, len, offset, i;
+
+    for (i = 0; i < nargs; i++) {
+        argLen += varintLen(args[i]);
+    }
+
+    traceAdd(&r->writers, 1);
+
+    do {
+        pos = traceLdrex(&r->reserve);
+        ts = CYCCNT;
+        if (r->lastEnd == pos) {
+            head = hdr;
+            time = ts - r->last;
+        }
+        else {
+            head = hdr | TRACE_HDR_ABS;
+            time = ts;
+        }
+        len = varintLen(head) + varintLen(time) + argLen;
+        if (pos + len - r->tail > TRACE_RING_SIZE) {
+            traceClrex();
+            traceAdd(&r->dropped, 1);
+            goto done;
+        }
+    } while (traceStrex(&r->reserve, pos + len));
+
+    r->last = ts;
+    r->lastEnd = pos + len;
+
+    /* encode in place unless the record wraps around the end */
+    offset = pos & (TRACE_RING_SIZE - 1);
+    dst = (offset + len <= TRACE_RING_SIZE) ? &r->data[offset] : tmp;
+
+    p = varintPut(dst, head);
+    p = varintPut(p, time);
+    for (i = 0; i < nargs; i++) {
+        p = varintPut(p, args[i]);
+    }
+
+    if (dst == tmp) {
+        for (i = 0; i < len; i++) {
+            r->data[(offset + i) & (TRACE_RING_SIZE - 1)] = tmp[i];
+        }
+    }
+
+done:
+    TRACE_BARRIER();
+    if (traceAdd(&r->writers, (uint32_t)-1) == 1) {
+        ringPublish(r);
+    }
+}
+
+/*
+ *  ======== recordLen ========
+ *  Length of the committed record at pos: header, time and the number
+ *  of args given by the low bits of the header's first byte
+ */
+static uint32_t recordLen(TraceRing *r, uint32_t pos)
+{
+    uint32_t fields = 2 + (r->data[pos & (TRACE_RING_SIZE - 1)] & 0x7);
+    uint32_t len = 0;
+
+    while (fields != 0) {
+        if ((r->data[(pos + len++) & (TRACE_RING_SIZE - 1)] & 0x80) == 0) {
+            fields--;
+        }
+    }
+
+    return (len);
+}
+
+/*
+ *  ======== traceRing ========
+ *  Ring of the calling thread's context
+ */
+static inline TraceRing *traceRing(void)
+{
+    switch (BIOS_getThreadType()) {
+        case BIOS_ThreadType_Hwi:
+            return (&traceLog.ring[TRACE_CTX_HWI]);
+        case BIOS_ThreadType_Swi:
+            return (&traceLog.ring[TRACE_CTX_SWI]);
+        default:
+            return (&traceLog.ring[TRACE_CTX_TASK]);
+    }
+}
+
+/*
+ *  ======== traceStart ========
+ *  Empty all rings and start recording. Must not race with writers,
+ *  i.e. call it before the first event or after traceStop().
+ */
+void traceStart(void)
+{
+    TraceRing *r;
+    unsigned int ctx;
+
+    traceLog.magic = TRACE_MAGIC;
+    traceLog.ringSize = TRACE_RING_SIZE;
+    traceLog.numCtx = TRACE_NUM_CTX;
+
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        r = &traceLog.ring[ctx];
+        r->reserve = 0;
+        r->commit = 0;
+        r->tail = 0;
+        r->writers = 0;
+        r->last = 0;
+        r->lastEnd = 0xFFFFFFFF;    /* first record carries absolute time */
+        r->dropped = 0;
+    }
+
+    TRACE_BARRIER();
+    traceLog.enabled = true;
+}
+
+/*
+ *  ======== traceStop ========
+ */
+void traceStop(void)
+{
+    traceLog.enabled = false;
+}
+
+void traceEvent0(uint32_t id)
+{
+    if (traceLog.enabled) {
+        traceRecord(traceRing(), TRACE_HDR(id, 0), NULL);
+    }
+}
+
+void traceEvent1(uint32_t id, uint32_t a1)
+{
+    if (traceLog.enabled) {
+        traceRecord(traceRing(), TRACE_HDR(id, 1), &a1);
+    }
+}
+
+void traceEvent2(uint32_t id, uint32_t a1, uint32_t a2)
+{
+    uint32_t args[2];
+
+    if (traceLog.enabled) {
+        args[0] = a1;
+        args[1] = a2;
+        traceRecord(traceRing(), TRACE_HDR(id, 2), args);
+    }
+}
+
+void traceEvent4(uint32_t id, uint32_t a1, uint32_t a2, uint32_t a3,
+    uint32_t a4)
+{
+    uint32_t args[4];
+
+    if (traceLog.enabled) {
+        args[0] = a1;
+        args[1] = a2;
+        args[2] = a3;
+        args[3] = a4;
+        traceRecord(traceRing(), TRACE_HDR(id, 4), args);
+    }
+}
+
+/*
+ *  ======== traceDrain ========
+ *  Copy committed records into buffer as frames, one per ring with data.
+ *  Only whole records are taken, so the rings always start on a record
+ *  boundary. Single reader only. Returns the number of bytes stored.
+ */
+size_t traceDrain(uint8_t *buffer, size_t size)
+{
+    TraceRing *r;
+    uint8_t *p = buffer;
+    uint32_t tail, avail, count, len, i;
+    size_t room;
+    unsigned int ctx;
+
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        r = &traceLog.ring[ctx];
+        tail = r->tail;
+        avail = r->commit - tail;
+        room = size - (p - buffer);
+
+        if (room <= TRACE_FRAME_MAX_HDR) {
+            break;
+        }
+
+        TRACE_BARRIER();
+
+        for (count = 0; count < avail; count += len) {
+            len = recordLen(r, tail + count);
+            if (count + len > room - TRACE_FRAME_MAX_HDR) {
+                break;
+            }
+        }
+
+        if (count == 0) {
+            continue;
+        }
+
+        *p++ = TRACE_FRAME_SYNC;
+        *p++ = ctx;
+        p = varintPut(p, r->dropped);
+        p = varintPut(p, count);
+        for (i = 0; i < count; i++) {
+            *p++ = r->data[(tail + i) & (TRACE_RING_SIZE - 1)];
+        }
+
+        /* the bytes may be reused once tail moves */
+        TRACE_BARRIER();
+        r->tail = tail + count;
+    }
+
+    return (p - buffer);
+}
+
+/*
+ *  ======== traceDropped ========
+ *  Records dropped because the ring of context ctx was full
+ */
+uint32_t traceDropped(unsigned int ctx)
+{
+    return (ctx < TRACE_NUM_CTX ? traceLog.ring[ctx].dropped : 0);
+}
+
+/*
+ *  ======== kernel hooks ========
+ *  Registered in the application .cfg, see wiring_trace.h.
+ */
+void traceTaskSwitch(Task_Handle prev, Task_Handle next)
+{
+    uint32_t args[2];
+
+    if (traceLog.enabled) {
+        args[0] = (uint32_t)prev;
+        args[1] = (uint32_t)next;
+        traceRecord(&traceLog.ring[TRACE_CTX_TASK],
+            TRACE_HDR(TRACE_ID_TASK_SWITCH, 2), args);
+    }
+}
+
+void traceSwiBegin(Swi_Handle swi)
+{
+    if (traceLog.enabled) {
+        traceRecord(&traceLog.ring[TRACE_CTX_SWI],
+            TRACE_HDR(TRACE_ID_SWI_BEGIN, 1), (uint32_t *)&swi);
+    }
+}
+
+void traceSwiEnd(Swi_Handle swi)
+{
+    if (traceLog.enabled) {
+        traceRecord(&traceLog.ring[TRACE_CTX_SWI],
+            TRACE_HDR(TRACE_ID_SWI_END, 1), (uint32_t *)&swi);
+    }
+}
+
+void traceHwiBegin(Hwi_Handle hwi)
+{
+    if (traceLog.enabled) {
+        traceRecord(&traceLog.ring[TRACE_CTX_HWI],
+            TRACE_HDR(TRACE_ID_HWI_BEGIN, 1), (uint32_t *)&hwi);
+    }
+}
+
+void traceHwiEnd(Hwi_Handle hwi)
+{
+    if (traceLog.enabled) {
+        traceRecord(&traceLog.ring[TRACE_CTX_HWI],
+            TRACE_HDR(TRACE_ID_HWI_END, 1), (uint32_t *)&hwi);
+    }
+}
+
+#else /* TRACE_RING_SIZE == 0 */
+
+void traceStart(void) {}
+void traceStop(void) {}
+void traceEvent0(uint32_t id) {}
+void traceEvent1(uint32_t id, uint32_t a1) {}
+void traceEvent2(uint32_t id, uint32_t a1, uint32_t a2) {}
+void traceEvent4(uint32_t id, uint32_t a1, uint32_t a2, uint32_t a3,
+    uint32_t a4) {}
+size_t traceDrain(uint8_t *buffer, size_t size) { return (0); }
+uint32_t traceDropped(unsigned int ctx) { return (0); }
+
+void traceTaskSwitch(Task_Handle prev, Task_Handle next) {}
+void traceSwiBegin(Swi_Handle swi) {}
+void traceSwiEnd(Swi_Handle swi) {}
+void traceHwiBegin(Hwi_Handle hwi) {}
+void traceHwiEnd(Hwi_Handle hwi) {}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Low overhead event tracing.
+ *
+ * Events are packed into variable length records, timestamped with the
+ * CPU cycle counter, and written without locks into one ring per
+ * execution context (Hwi, Swi, Task). The rings are drained while the
+ * sketch runs, e.g. over Serial, or read out of a RAM dump, and turned
+ * into Chrome trace-event JSON on the host with extras/trace2json.py.
+ *
+ *   #include <wiring_trace.h>
+ *
+ *   traceStart();
+ *   traceEvent2(TRACE_ID_USER + 1, len, crc);
+ *   ...
+ *   traceDrainTo(Serial);
+ *
+ * Kernel thread switches are traced by adding the hooks below to the
+ * application .cfg file:
+ *
+ *   Task.addHookSet({switchFxn: '&traceTaskSwitch'});
+ *   Swi.addHookSet({beginFxn: '&traceSwiBegin', endFxn: '&traceSwiEnd'});
+ *   Hwi.addHookSet({beginFxn: '&traceHwiBegin', endFxn: '&traceHwiEnd'});
+ */
+
+#ifndef WiringTrace_h
+#define WiringTrace_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* per context ring size in bytes, a power of two; 0 disables tracing */
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE         512
+#endif
+
+#define TRACE_CTX_HWI           0
+#define TRACE_CTX_SWI           1
+#define TRACE_CTX_TASK          2
+#define TRACE_NUM_CTX           3
+
+/* event ids logged by the kernel hooks */
+#define TRACE_ID_TASK_SWITCH    1   /* prev Task, next Task */
+#define TRACE_ID_SWI_BEGIN      2   /* Swi */
+#define TRACE_ID_SWI_END        3   /* Swi */
+#define TRACE_ID_HWI_BEGIN      4   /* Hwi */
+#define TRACE_ID_HWI_END        5   /* Hwi */
+
+/* first id free for sketches and libraries */
+#define TRACE_ID_USER           16
+
+extern void traceStart(void);
+extern void traceStop(void);
+
+extern void traceEvent0(uint32_t id);
+extern void traceEvent1(uint32_t id, uint32_t a1);
+extern void traceEvent2(uint32_t id, uint32_t a1, uint32_t a2);
+extern void traceEvent4(uint32_t id, uint32_t a1, uint32_t a2, uint32_t a3,
+    uint32_t a4);
+
+extern size_t traceDrain(uint8_t *buffer, size_t size);
+extern uint32_t traceDropped(unsigned int ctx);
+
+#ifdef __cplusplus
+} // extern "C"
+
+#include "Print.h"
+
+/*
+ * Drain all committed records to out, e.g. Serial
+ */
+static inline size_t traceDrainTo(Print &out)
+{
+    uint8_t chunk[64];
+    size_t count, total = 0;
+
+    while ((count = traceDrain(chunk, sizeof(chunk))) != 0) {
+        out.write(chunk, count);
+        total += count;
+    }
+
+    return (total);
+}
+#endif
+
+#endif
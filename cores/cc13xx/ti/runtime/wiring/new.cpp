@@ -1,5 +1,7 @@
 #include "new.h"
 
+#include <stdint.h>
+
 #if 1
 static void * smalloc(size_t size)
 {
@@ -14,24 +16,226 @@ static void * smalloc(size_t size)
 #define smalloc malloc
 #endif
 
+#if NEW_SLAB_ARENA_SIZE > 0
+
+/*
+ * Small object slab caches
+ *
+ * Objects of up to NEW_SLAB_MAX_SIZE bytes are carved from fixed size pages
+ * of a static arena. Each page is dedicated to one size class the first
+ * time that class runs dry, and freed objects go back onto their class'
+ * free list, never to the heap. The free lists and the page allocator are
+ * updated with LDREX/STREX only, so new/delete of small objects is safe
+ * from Hwi and Swi context and never contends on the heap gate. Any
+ * exception entry or return clears the exclusive monitor, so a pop that
+ * was preempted simply retries (no ABA window).
+ *
+ * Larger objects, and small ones once the arena is used up, go to the
+ * system heap as before.
+ *
+ * The pages are the fixed size blocks a HeapBuf would manage, but a
+ * HeapBuf or HeapMultiBuf is not used: their alloc and free disable
+ * interrupts rather than using LDREX/STREX, and their instances are
+ * created by the application's configuration, which the core is not
+ * built against.
+ */
+#define SLAB_PAGE_SIZE  128
+#define SLAB_PAGES      (NEW_SLAB_ARENA_SIZE / SLAB_PAGE_SIZE)
+
+static const uint8_t slabSizes[NEW_SLAB_CLASSES] = {8, 16, 24, 32, 48, 64};
+
+/* size class of a request, indexed by (size - 1) / 8 */
+static const uint8_t slabClassOf[NEW_SLAB_MAX_SIZE / 8] = {
+    0, 1, 2, 3, 4, 4, 5, 5
+};
+
+static uint64_t slabArena[SLAB_PAGES * SLAB_PAGE_SIZE / sizeof(uint64_t)];
+static uint8_t slabPageClass[SLAB_PAGES];
+static uint32_t slabPagesUsed;
+
+static void *slabFree[NEW_SLAB_CLASSES];
+static uint32_t slabHits[NEW_SLAB_CLASSES];
+static uint32_t slabMisses[NEW_SLAB_CLASSES];
+static uint32_t slabPagesOf[NEW_SLAB_CLASSES];
+
+/*
+ *  ======== slabAdd ========
+ *  Atomically add inc to *count, returning the previous value
+ */
+static uint32_t slabAdd(uint32_t *count, uint32_t inc)
+{
+    uint32_t old, failed;
+
+    do {
+        asm volatile("ldrex %0, [%1]" : "=r" (old) : "r" (count) : "memory");
+        asm volatile("strex %0, %2, [%1]" : "=&r" (failed)
+            : "r" (count), "r" (old + inc) : "memory");
+    } while (failed);
+
+    return (old);
+}
+
+/*
+ *  ======== slabPop ========
+ */
+static void *slabPop(void **head)
+{
+    void *block, *next;
+    uint32_t failed;
+
+    do {
+        asm volatile("ldrex %0, [%1]" : "=r" (block) : "r" (head) : "memory");
+        if (block == NULL) {
+            asm volatile("clrex" : : : "memory");
+            return (NULL);
+        }
+        next = *(void **)block;
+        asm volatile("strex %0, %2, [%1]" : "=&r" (failed)
+            : "r" (head), "r" (next) : "memory");
+    } while (failed);
+
+    return (block);
+}
+
+/*
+ *  ======== slabPush ========
+ *  Push the chain first..last (linked through their first word)
+ */
+static void slabPush(void **head, void *first, void *last)
+{
+    void *old;
+    uint32_t failed;
+
+    do {
+        asm volatile("ldrex %0, [%1]" : "=r" (old) : "r" (head) : "memory");
+        *(void **)last = old;
+        asm volatile("strex %0, %2, [%1]" : "=&r" (failed)
+            : "r" (head), "r" (first) : "memory");
+    } while (failed);
+}
+
+/*
+ *  ======== slabGrow ========
+ *  Dedicate a fresh arena page to class cls and return its first block;
+ *  the rest of the page is pushed onto the class' free list.
+ */
+static void *slabGrow(unsigned int cls)
+{
+    uint32_t page;
+    uint8_t *base, *block, *last;
+    unsigned int size = slabSizes[cls];
+
+    if (slabPagesUsed >= SLAB_PAGES) {
+        return (NULL);
+    }
+    page = slabAdd(&slabPagesUsed, 1);
+    if (page >= SLAB_PAGES) {
+        return (NULL);
+    }
+
+    slabPageClass[page] = cls;
+    slabAdd(&slabPagesOf[cls], 1);
+
+    base = (uint8_t *)slabArena + page * SLAB_PAGE_SIZE;
+    last = base + (SLAB_PAGE_SIZE / size - 1) * size;
+    if (last != base) {
+        for (block = base + size; block < last; block += size) {
+            *(void **)block = block + size;
+        }
+        slabPush(&slabFree[cls], base + size, last);
+    }
+
+    return (base);
+}
+
+/*
+ *  ======== slabAlloc ========
+ */
+static void *slabAlloc(size_t size)
+{
+    unsigned int cls;
+    void *ptr;
+
+    if (size > NEW_SLAB_MAX_SIZE) {
+        return (smalloc(size));
+    }
+
+    cls = slabClassOf[size ? (size - 1) / 8 : 0];
+    ptr = slabPop(&slabFree[cls]);
+    if (ptr == NULL) {
+        ptr = slabGrow(cls);
+    }
+    if (ptr == NULL) {
+        slabAdd(&slabMisses[cls], 1);
+        return (smalloc(size));
+    }
+
+    slabAdd(&slabHits[cls], 1);
+    return (ptr);
+}
+
+/*
+ *  ======== slabRelease ========
+ */
+static void slabRelease(void *ptr)
+{
+    uintptr_t offset = (uintptr_t)ptr - (uintptr_t)slabArena;
+
+    if (offset < sizeof(slabArena)) {
+        slabPush(&slabFree[slabPageClass[offset / SLAB_PAGE_SIZE]], ptr, ptr);
+    }
+    else {
+        free(ptr);
+    }
+}
+
+/*
+ *  ======== newGetSlabStats ========
+ */
+bool newGetSlabStats(unsigned int sizeClass, NewSlabStats *stats)
+{
+    if (sizeClass >= NEW_SLAB_CLASSES) {
+        return (false);
+    }
+
+    stats->blockSize = slabSizes[sizeClass];
+    stats->pages = slabPagesOf[sizeClass];
+    stats->hits = slabHits[sizeClass];
+    stats->misses = slabMisses[sizeClass];
+
+    return (true);
+}
+
+#else
+
+#define slabAlloc smalloc
+#define slabRelease free
+
+bool newGetSlabStats(unsigned int, NewSlabStats *)
+{
+    return (false);
+}
+
+#endif
+
 void * operator new(size_t size)
 {
-    return smalloc(size);
+    return slabAlloc(size);
 }
 
 void operator delete(void * ptr)
 {
-  free(ptr);
+  slabRelease(ptr);
 }
 
 void * operator new[](size_t size)
 {
-  return smalloc(size);
+  return slabAlloc(size);
 }
 
 void operator delete[](void * ptr)
 {
-  free(ptr);
+  slabRelease(ptr);
 }
 
 int __cxa_guard_acquire(__guard *g) {return !*(char *)(g);};
@@ -7,6 +7,39 @@
 
 #include <stdlib.h>
 
+/*
+ * Small objects (up to NEW_SLAB_MAX_SIZE bytes) are served from lock-free
+ * per-size-class slab caches carved out of a NEW_SLAB_ARENA_SIZE byte
+ * static arena (a multiple of 128); everything else, and small objects
+ * once the arena is used up, comes from the system heap.
+ *
+ * The default 1 KB arena (8 pages) costs 1132 bytes of .bss: the arena
+ * plus 108 bytes of page map, free lists and counters. The heap is what
+ * is left of SRAM, so it shrinks by the same amount. A small object in
+ * the slab saves the 8 byte malloc() header and the rounding of header
+ * and object to 8 bytes (e.g. 16 instead of 24 bytes for 12 bytes).
+ * Build with -DNEW_SLAB_ARENA_SIZE=0 to send all allocations to the heap.
+ */
+#ifndef NEW_SLAB_ARENA_SIZE
+#define NEW_SLAB_ARENA_SIZE 1024
+#endif
+
+#define NEW_SLAB_CLASSES    6
+#define NEW_SLAB_MAX_SIZE   64
+
+typedef struct NewSlabStats {
+    size_t blockSize;   /* object size served by this class */
+    size_t pages;       /* arena pages dedicated to this class */
+    size_t hits;        /* allocations served from the cache */
+    size_t misses;      /* allocations that fell back to the heap */
+} NewSlabStats;
+
+/*
+ * Retrieve the counters of size class 0 .. NEW_SLAB_CLASSES - 1;
+ * returns false for an invalid class or when the caches are disabled.
+ */
+bool newGetSlabStats(unsigned int sizeClass, NewSlabStats *stats);
+
 void * operator new(size_t size);
 void operator delete(void * ptr);
 void * operator new[](size_t size);
@@ -65,6 +65,9 @@ uint16_t analogRead(uint8_t pin)
             case PIN_FUNC_DIGITAL_OUTPUT:
                 stopDigitalWrite(pin);
                 break;
+            case PIN_FUNC_ANALOG_STREAM:
+                stopAnalogStream(pin);
+                break;
         }
 
         if (adcInitialized == false) {
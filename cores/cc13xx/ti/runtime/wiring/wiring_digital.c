@@ -71,6 +71,14 @@ void pinMode(uint8_t pin, uint8_t mode)
         case PIN_FUNC_ANALOG_INPUT:
             stopAnalogRead(pin);
             break;
+
+        case PIN_FUNC_CAPTURE:
+            stopCapture(pin);
+            break;
+
+        case PIN_FUNC_ANALOG_STREAM:
+            stopAnalogStream(pin);
+            break;
     }
 
     GPIO_PinConfig gpioConfig = mode2gpioConfig(pin, mode);
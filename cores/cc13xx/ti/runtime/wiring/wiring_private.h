@@ -44,6 +44,8 @@ extern "C" {
 #define PIN_FUNC_ANALOG_OUTPUT      3
 #define PIN_FUNC_ANALOG_INPUT       4
 #define PIN_FUNC_INVALID            5
+#define PIN_FUNC_CAPTURE            6
+#define PIN_FUNC_ANALOG_STREAM      7
 
 #define NOT_ON_ADC      0xff
 
@@ -51,6 +53,10 @@ extern void stopAnalogWrite(uint8_t pin);
 extern void stopAnalogRead(uint8_t pin);
 extern void stopDigitalWrite(uint8_t pin);
 extern void stopDigitalRead(uint8_t pin);
+extern void stopCapture(uint8_t pin);
+extern void stopAnalogStream(uint8_t pin);
+
+extern unsigned long pulseInPolling(uint8_t pin, uint8_t state, unsigned long timeout);
 
 extern int8_t analogReadShift;
 
@@ -37,9 +37,12 @@
 /* Measures the length (in microseconds) of a pulse on the pin; state is HIGH
  * or LOW, the type of pulse to measure.  Works on pulses from 2-3 microseconds
  * to 3 minutes in length, but must be called at least a few dozen microseconds
- * before the start of the pulse. */
+ * before the start of the pulse.
+ *
+ * This is the GPIO polling fallback behind the device's pulseIn(), used
+ * when no capture timer is free or the caller is not a Task. */
 
-unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout)
+unsigned long pulseInPolling(uint8_t pin, uint8_t state, unsigned long timeout)
 {
     uint8_t stateMask;
     uint32_t start, end, result;
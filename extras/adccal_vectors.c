@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== adccal_vectors.c ========
+ *  Host test vectors for ti/drivers/adcbuf/ADCBufCC26XXCalibration.c
+ *
+ *  Checks the bulk adjust and microvolt conversion against the per-sample
+ *  driverlib functions, kept below as Ref_*. The adjust is run over every
+ *  12-bit sample for every factory offset and a sweep of gains, and over
+ *  the full 16-bit input range wherever the driverlib arithmetic doesn't
+ *  overflow. The conversion is run over every adjusted value for both
+ *  reference voltages and random ones, and the reciprocal behind it over
+ *  every dividend below 2^31. Buffers start at odd and even addresses and
+ *  have odd and even lengths. It also times both implementations.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o adccal_vectors -Isystem/source extras/adccal_vectors.c \
+ *          system/source/ti/drivers/adcbuf/ADCBufCC26XXCalibration.c
+ *      ./adccal_vectors
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ti/drivers/adcbuf/ADCBufCC26XXCalibration.h>
+
+/* from driverlib/aux_adc.h */
+#define AUXADC_FIXED_REF_VOLTAGE_NORMAL     4300000
+#define AUXADC_FIXED_REF_VOLTAGE_UNSCALED   1478500
+
+#define NUM_VALUES      65536
+
+/*
+ *  ======== Reference implementation ========
+ *  driverlib/aux_adc.c. On the device these are ROM calls, so they are
+ *  kept out of line here too.
+ */
+
+static __attribute__((noinline)) int32_t Ref_AUXADCValueToMicrovolts(int32_t fixedRefVoltage, int32_t adcValue)
+{
+    // Chop off 4 bits during calculations to avoid 32-bit overflow
+    fixedRefVoltage >>= 4;
+    return (((adcValue * fixedRefVoltage) + 2047) / 4095) << 4;
+}
+
+static __attribute__((noinline)) int32_t Ref_AUXADCAdjustValueForGainAndOffset(int32_t adcValue, int32_t gain, int32_t offset)
+{
+    // Apply gain and offset adjustment
+    adcValue = (((adcValue + offset) * gain) + 16384) / 32768;
+
+    // Saturate
+    if (adcValue < 0) {
+        return 0;
+    } else if (adcValue > 4095) {
+        return 4095;
+    } else {
+        return adcValue;
+    }
+}
+
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, long a, long b, long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s (%ld, %ld, %ld)\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState = rndState * 1664525 + 1013904223;
+    return (rndState >> 8);
+}
+
+/*
+ *  ======== testAdjust ========
+ *  Adjust the input values [0, numValues) at a random alignment and
+ *  length split, so both the pair loop and the tail are exercised.
+ */
+static void testAdjust(int32_t gain, int32_t offset, uint32_t numValues)
+{
+    static uint16_t buf[NUM_VALUES + 2];
+    ADCBufCC26XXCalibration cal;
+    uint16_t *samples = buf + (rnd() & 1);
+    uint32_t split = rnd() % numValues;
+    uint32_t i;
+
+    for (i = 0; i < numValues; i++) {
+        samples[i] = (uint16_t)i;
+    }
+
+    ADCBufCC26XXCalibration_init(&cal, gain, offset, AUXADC_FIXED_REF_VOLTAGE_NORMAL);
+    ADCBufCC26XXCalibration_adjust(&cal, samples, split);
+    ADCBufCC26XXCalibration_adjust(&cal, samples + split, numValues - split);
+
+    for (i = 0; i < numValues; i++) {
+        if (samples[i] != Ref_AUXADCAdjustValueForGainAndOffset(i, gain, offset)) {
+            fail("adjust", gain, offset, i);
+            break;
+        }
+    }
+    vectors++;
+}
+
+/*
+ *  ======== testMicroVolts ========
+ */
+static void testMicroVolts(int32_t fixedRefVoltage)
+{
+    static uint16_t buf[4096 + 1];
+    static uint32_t out[4096 + 1];
+    ADCBufCC26XXCalibration cal;
+    uint16_t *samples = buf + (rnd() & 1);
+    uint32_t split = rnd() % 4096;
+    uint32_t i;
+
+    for (i = 0; i < 4096; i++) {
+        samples[i] = (uint16_t)i;
+    }
+
+    ADCBufCC26XXCalibration_init(&cal, 32768, 0, fixedRefVoltage);
+    ADCBufCC26XXCalibration_toMicroVolts(&cal, samples, out, split);
+    ADCBufCC26XXCalibration_toMicroVolts(&cal, samples + split, out + split, 4096 - split);
+
+    for (i = 0; i < 4096; i++) {
+        if (out[i] != (uint32_t)Ref_AUXADCValueToMicrovolts(fixedRefVoltage, i)) {
+            fail("microvolts", fixedRefVoltage, i, out[i]);
+            break;
+        }
+    }
+    vectors++;
+}
+
+/*
+ *  ======== testReciprocal ========
+ *  The microvolt conversion divides by 4095 with a multiply and shift;
+ *  check the constant against every dividend it can be given.
+ */
+static void testReciprocal(void)
+{
+    uint32_t n;
+
+    for (n = 0; n < 0x80000000UL; n++) {
+        if ((uint32_t)(((uint64_t)n * 2148008065ULL) >> 43) != n / 4095) {
+            fail("reciprocal", n, 0, 0);
+            break;
+        }
+    }
+    vectors++;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + (double)ts.tv_nsec * 1e-9);
+}
+
+/*
+ *  ======== timeCalibration ========
+ */
+static void timeCalibration(void)
+{
+    static uint16_t raw[1024], samples[1024];
+    static uint32_t out[1024];
+    ADCBufCC26XXCalibration cal;
+    const int passes = 20000;
+    double t0, tRefAdj, tAdj, tRefUv, tUv;
+    volatile uint32_t sink = 0;
+    int p, i;
+
+    for (i = 0; i < 1024; i++) {
+        raw[i] = rnd() & 0xfff;
+    }
+    ADCBufCC26XXCalibration_init(&cal, 33012, -7, AUXADC_FIXED_REF_VOLTAGE_NORMAL);
+
+    t0 = now();
+    for (p = 0; p < passes; p++) {
+        memcpy(samples, raw, sizeof(raw));
+        for (i = 0; i < 1024; i++) {
+            samples[i] = Ref_AUXADCAdjustValueForGainAndOffset(samples[i], 33012, -7);
+        }
+        sink += samples[p & 1023];
+    }
+    tRefAdj = now() - t0;
+    t0 = now();
+    for (p = 0; p < passes; p++) {
+        memcpy(samples, raw, sizeof(raw));
+        ADCBufCC26XXCalibration_adjust(&cal, samples, 1024);
+        sink += samples[p & 1023];
+    }
+    tAdj = now() - t0;
+    t0 = now();
+    for (p = 0; p < passes; p++) {
+        for (i = 0; i < 1024; i++) {
+            out[i] = Ref_AUXADCValueToMicrovolts(AUXADC_FIXED_REF_VOLTAGE_NORMAL, samples[i]);
+        }
+        sink += out[p & 1023];
+    }
+    tRefUv = now() - t0;
+    t0 = now();
+    for (p = 0; p < passes; p++) {
+        ADCBufCC26XXCalibration_toMicroVolts(&cal, samples, out, 1024);
+        sink += out[p & 1023];
+    }
+    tUv = now() - t0;
+
+    printf("adjust          %.2f ns/sample (reference %.2f, incl. copy)\n",
+        tAdj * 1e9 / passes / 1024, tRefAdj * 1e9 / passes / 1024);
+    printf("microvolts      %.2f ns/sample (reference %.2f)\n",
+        tUv * 1e9 / passes / 1024, tRefUv * 1e9 / passes / 1024);
+}
+
+int main(void)
+{
+    int32_t gain, offset;
+    int i;
+
+    for (offset = -128; offset < 128; offset++) {
+        /* 12-bit samples, gains from 0 to full 16 bits */
+        for (gain = 0; gain < 65536; gain += (gain < 24576 || gain > 40960) ? 97 : 11) {
+            testAdjust(gain, offset, 4096);
+        }
+        testAdjust(65535, offset, 4096);
+
+        /* 16-bit samples, as far as driverlib's int32 math goes */
+        for (i = 0; i < 8; i++) {
+            gain = rnd() % (0x7fffffff / (65535 + 128));
+            testAdjust(gain, offset, NUM_VALUES);
+        }
+    }
+
+    testMicroVolts(AUXADC_FIXED_REF_VOLTAGE_NORMAL);
+    testMicroVolts(AUXADC_FIXED_REF_VOLTAGE_UNSCALED);
+    for (i = 0; i < 1000; i++) {
+        /* any reference for which driverlib's v * (ref >> 4) fits */
+        testMicroVolts((int32_t)(rnd() % ((0x7fffffffUL - 2047) / 4095 * 16)));
+    }
+
+    testReciprocal();
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+    timeCalibration();
+
+    return (failures != 0);
+}
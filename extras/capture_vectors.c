@@ -0,0 +1,690 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== capture_vectors.c ========
+ *  Host test vectors for cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_capture.c
+ *
+ *  Builds the real capture module against a mocked GPTimer, PIN driver
+ *  and kernel, then drives its interrupt handler with simulated edge
+ *  streams. The mock timer is a 24-bit counter that captures only the
+ *  armed edge; each interrupt runs a random latency after its event, so
+ *  a rollover can be pending alongside a capture on either side of it.
+ *
+ *  pulseCaptureRead() widths and levels and pulseIn() results are checked
+ *  against widths computed directly from the 32-bit edge times, over
+ *  pulses from a few cycles to several rollovers long and across the
+ *  2^32 wrap of the extended timestamp. captureOpen() is also run with
+ *  no free timer and with the pin owned elsewhere, and must leave the
+ *  pin, the channel and the timer as it found them.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o capture_vectors -Icores/cc13xx -Isystem/source \
+ *          -Isystem/kernel/tirtos/packages extras/capture_vectors.c
+ *      ./capture_vectors
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *  ======== Mocks ========
+ *  Stand-ins for the headers wiring_capture.c includes.
+ */
+#define WiringPrivate_h
+#define ti_drivers_GPIO__include
+#define ti_drivers_GPIOCC26XX__include
+#define ti_drivers_PIN__include
+#define ti_drivers_PINCC26XX__include
+#define ti_drivers_timer_GPTIMERCC26XX__include
+#define ti_sysbios_BIOS__include
+#define ti_sysbios_BIOS__localnames__done
+#define ti_sysbios_family_arm_m3_Hwi__include
+#define ti_sysbios_family_arm_m3_Hwi__localnames__done
+#define ti_sysbios_knl_Clock__include
+#define ti_sysbios_knl_Clock__localnames__done
+#define ti_sysbios_knl_Semaphore__include
+#define ti_sysbios_knl_Semaphore__localnames__done
+#define xdc_runtime_Types__include
+#define xdc_runtime_Types__localnames__done
+
+#define LOW             0
+#define HIGH            1
+#define INPUT           0
+#define INPUT_PULLUP    2
+#define INPUT_PULLDOWN  3
+
+#define PIN_FUNC_UNUSED             0
+#define PIN_FUNC_DIGITAL_OUTPUT     1
+#define PIN_FUNC_DIGITAL_INPUT      2
+#define PIN_FUNC_ANALOG_OUTPUT      3
+#define PIN_FUNC_ANALOG_INPUT       4
+#define PIN_FUNC_INVALID            5
+#define PIN_FUNC_CAPTURE            6
+#define PIN_FUNC_ANALOG_STREAM      7
+
+#define NUM_PINS        8
+
+typedef uint32_t UInt32;
+
+typedef struct Types_FreqHz {
+    uint32_t hi;
+    uint32_t lo;
+} Types_FreqHz;
+
+static uint8_t digital_pin_to_pin_function[NUM_PINS];
+static unsigned stopCalls;
+static unsigned pinModeCalls;
+
+static void stopAnalogWrite(uint8_t pin) { (void)pin; stopCalls++; }
+static void stopAnalogRead(uint8_t pin) { (void)pin; stopCalls++; }
+static void stopAnalogStream(uint8_t pin) { (void)pin; stopCalls++; }
+static void stopDigitalRead(uint8_t pin) { (void)pin; stopCalls++; }
+
+static void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)mode;
+    pinModeCalls++;
+    digital_pin_to_pin_function[pin] = PIN_FUNC_DIGITAL_INPUT;
+}
+
+static unsigned pollingCalls;
+
+static unsigned long pulseInPolling(uint8_t pin, uint8_t state,
+    unsigned long timeout)
+{
+    (void)pin;
+    (void)state;
+    (void)timeout;
+    pollingCalls++;
+    return (0);
+}
+
+/* kernel */
+#define BIOS_ThreadType_Task    1
+
+static uint32_t Clock_tickPeriod = 10;
+
+static int BIOS_getThreadType(void)
+{
+    return (BIOS_ThreadType_Task);
+}
+
+static void BIOS_getCpuFreq(Types_FreqHz *freq)
+{
+    freq->hi = 0;
+    freq->lo = 48000000;
+}
+
+static inline uint32_t Hwi_disable(void)
+{
+    return (0);
+}
+
+static inline void Hwi_restore(uint32_t key)
+{
+    (void)key;
+}
+
+typedef struct Semaphore_Struct {
+    int count;
+} Semaphore_Struct;
+
+typedef Semaphore_Struct *Semaphore_Handle;
+
+#define Semaphore_handle(s)     (s)
+
+static void Semaphore_construct(Semaphore_Struct *s, int count, void *params)
+{
+    (void)params;
+    s->count = count;
+}
+
+static void Semaphore_destruct(Semaphore_Struct *s)
+{
+    (void)s;
+}
+
+static void Semaphore_post(Semaphore_Handle s)
+{
+    s->count++;
+}
+
+static bool simulate(Semaphore_Handle s);
+
+static bool Semaphore_pend(Semaphore_Handle s, UInt32 timeout)
+{
+    (void)timeout;
+    return (simulate(s));
+}
+
+/* PIN driver */
+typedef uint32_t PIN_Config;
+typedef uint32_t PIN_Id;
+
+typedef struct PIN_State {
+    int open;
+} PIN_State;
+
+typedef PIN_State *PIN_Handle;
+
+#define PIN_INPUT_EN        (1 << 29)
+#define PIN_HYSTERESIS      (1 << 30)
+#define PIN_GEN             (1 << 31)
+#define PIN_PULLUP          (1 << 13)
+#define PIN_PULLDOWN        (2 << 13)
+#define PIN_BM_PULLING      (3 << 13)
+#define PIN_TERMINATE       0xfe
+
+typedef struct GPIOCC26XX_Config {
+    uint32_t pinConfigs[NUM_PINS];
+} GPIOCC26XX_Config;
+
+const GPIOCC26XX_Config GPIOCC26XX_config = {{0, 1, 2, 3, 4, 5, 6, 7}};
+
+static bool pinLevel;
+static bool pinOwnedElsewhere;
+static int pinsOpen;
+
+static PIN_Handle PIN_open(PIN_State *state, const PIN_Config config[])
+{
+    (void)config;
+    if (pinOwnedElsewhere) {
+        return (NULL);
+    }
+    pinsOpen++;
+    return (state);
+}
+
+static void PIN_close(PIN_Handle handle)
+{
+    (void)handle;
+    pinsOpen--;
+}
+
+static PIN_Config PIN_getConfig(PIN_Id pinId)
+{
+    (void)pinId;
+    return (PIN_PULLUP);
+}
+
+static uint32_t PIN_getInputValue(PIN_Id pinId)
+{
+    (void)pinId;
+    return (pinLevel);
+}
+
+static void PINCC26XX_setMux(PIN_Handle handle, PIN_Id pinId, int mux)
+{
+    (void)handle;
+    (void)pinId;
+    (void)mux;
+}
+
+/* GPTimer driver */
+typedef enum GPTimerCC26XX_Edge {
+    GPTimerCC26XX_POS_EDGE,
+    GPTimerCC26XX_NEG_EDGE,
+    GPTimerCC26XX_BOTH_EDGES,
+} GPTimerCC26XX_Edge;
+
+typedef uint32_t GPTimerCC26XX_IntMask;
+
+#define GPT_INT_TIMEOUT     (1 << 0)
+#define GPT_INT_CAPTURE     (1 << 2)
+#define GPT_CONFIG_16BIT    1
+#define GPT_MODE_EDGE_TIME_UP   7
+#define GPTimerCC26XX_DEBUG_STALL_OFF   0
+
+typedef struct GPTimerCC26XX_Params {
+    int width;
+    int mode;
+    int debugStallMode;
+} GPTimerCC26XX_Params;
+
+typedef struct GPTimerCC26XX_Object *GPTimerCC26XX_Handle;
+typedef void (*GPTimerCC26XX_HwiFxn)(GPTimerCC26XX_Handle handle,
+    GPTimerCC26XX_IntMask mask);
+
+typedef struct GPTimerCC26XX_Object {
+    bool open;
+    GPTimerCC26XX_Edge edge;
+    GPTimerCC26XX_HwiFxn fxn;
+} GPTimerCC26XX_Object;
+
+static GPTimerCC26XX_Object timers[8];
+static bool timersExhausted;
+static uint32_t timerValue;
+
+static void GPTimerCC26XX_Params_init(GPTimerCC26XX_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+}
+
+static GPTimerCC26XX_Handle GPTimerCC26XX_open(unsigned index,
+    const GPTimerCC26XX_Params *params)
+{
+    (void)params;
+    if (timersExhausted || timers[index].open) {
+        return (NULL);
+    }
+    timers[index].open = true;
+    return (&timers[index]);
+}
+
+static void GPTimerCC26XX_close(GPTimerCC26XX_Handle handle)
+{
+    handle->open = false;
+}
+
+static uint32_t GPTimerCC26XX_getValue(GPTimerCC26XX_Handle handle)
+{
+    (void)handle;
+    return (timerValue);
+}
+
+static void GPTimerCC26XX_setCaptureEdge(GPTimerCC26XX_Handle handle,
+    GPTimerCC26XX_Edge edge)
+{
+    handle->edge = edge;
+}
+
+static void GPTimerCC26XX_setLoadValue(GPTimerCC26XX_Handle handle,
+    uint32_t value)
+{
+    (void)handle;
+    (void)value;
+}
+
+static void GPTimerCC26XX_registerInterrupt(GPTimerCC26XX_Handle handle,
+    GPTimerCC26XX_HwiFxn fxn, GPTimerCC26XX_IntMask mask)
+{
+    (void)mask;
+    handle->fxn = fxn;
+}
+
+static void GPTimerCC26XX_unregisterInterrupt(GPTimerCC26XX_Handle handle)
+{
+    handle->fxn = NULL;
+}
+
+static void GPTimerCC26XX_start(GPTimerCC26XX_Handle handle) { (void)handle; }
+static void GPTimerCC26XX_stop(GPTimerCC26XX_Handle handle) { (void)handle; }
+
+static int GPTimerCC26XX_getPinMux(GPTimerCC26XX_Handle handle)
+{
+    (void)handle;
+    return (0);
+}
+
+void stopCapture(uint8_t pin);
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout);
+int pulseCaptureBegin(uint8_t pin, uint32_t *buffer, uint16_t size);
+int pulseCaptureAvailable(uint8_t pin);
+int pulseCaptureRead(uint8_t pin, unsigned long *width);
+uint32_t pulseCaptureOverruns(uint8_t pin);
+void pulseCaptureEnd(uint8_t pin);
+
+#include "../cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_capture.c"
+
+/*
+ *  ======== Edge simulator ========
+ *  Edges alternate the pin level. Time is in CPU cycles from the point
+ *  the timer was started, which the mock sets to zero.
+ */
+#define MAX_EDGES       4096
+#define MAX_LATENCY     400
+
+static uint64_t edges[MAX_EDGES];
+static int numEdges;
+static int nextEdge;
+static uint64_t nextWrap;
+static GPTimerCC26XX_Handle simTimer;
+
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, long long a, long long b, long long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %lld got %lld expected %lld\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+/* run the interrupt for whatever is pending at time t */
+static void interrupt(uint64_t t, GPTimerCC26XX_IntMask mask, uint64_t edge)
+{
+    (void)t;
+    timerValue = (uint32_t)(edge & (CAPTURE_WRAP - 1));
+    simTimer->fxn(simTimer, mask);
+}
+
+static bool edgeArmed(bool rising)
+{
+    switch (simTimer->edge) {
+        case GPTimerCC26XX_POS_EDGE:
+            return (rising);
+        case GPTimerCC26XX_NEG_EDGE:
+            return (!rising);
+        default:
+            return (true);
+    }
+}
+
+/*
+ * Advance through the next edge: wraps whose interrupt would run first
+ * are serviced alone, the rest are folded into the capture interrupt.
+ * Returns false when the edges run out.
+ */
+static bool step(void)
+{
+    uint64_t t;
+    uint64_t isr;
+    GPTimerCC26XX_IntMask mask;
+    bool rising;
+
+    if (nextEdge == numEdges) {
+        return (false);
+    }
+
+    t = edges[nextEdge++];
+    pinLevel = !pinLevel;
+    rising = pinLevel;
+    isr = t + rnd() % MAX_LATENCY;
+
+    while (nextWrap + rnd() % MAX_LATENCY < isr && nextWrap <= isr) {
+        interrupt(nextWrap, GPT_INT_TIMEOUT, 0);
+        nextWrap += CAPTURE_WRAP;
+    }
+
+    mask = edgeArmed(rising) ? GPT_INT_CAPTURE : 0;
+    if (nextWrap <= isr) {
+        mask |= GPT_INT_TIMEOUT;
+        nextWrap += CAPTURE_WRAP;
+    }
+    if (mask != 0) {
+        interrupt(isr, mask, t);
+    }
+
+    return (true);
+}
+
+static bool simulate(Semaphore_Handle s)
+{
+    while (s->count == 0) {
+        if (!step()) {
+            return (false);
+        }
+    }
+    s->count--;
+
+    return (true);
+}
+
+/* fill edges[] with gaps drawn from the given range */
+static void makeEdges(uint64_t first, uint32_t minGap, uint32_t maxGap, int n)
+{
+    uint64_t t = first;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        edges[i] = t;
+        t += minGap + rnd() % (maxGap - minGap + 1);
+    }
+    numEdges = n;
+    nextEdge = 0;
+    nextWrap = CAPTURE_WRAP;
+}
+
+static void startSim(uint8_t pin)
+{
+    CaptureChannel *ch = captureFind(pin);
+
+    simTimer = ch->hTimer;
+}
+
+/*
+ *  ======== pulseCapture vectors ========
+ *  Ring larger than the edge count, read once at the end.
+ */
+static uint32_t ring[MAX_EDGES + 1];
+
+static void testCaptureStream(uint32_t minGap, uint32_t maxGap,
+    uint64_t first)
+{
+    unsigned long width;
+    uint32_t expect;
+    bool startLevel;
+    int level;
+    int i;
+
+    startLevel = rnd() & 1;
+    pinLevel = startLevel;
+    digital_pin_to_pin_function[1] = PIN_FUNC_DIGITAL_INPUT;
+
+    if (!pulseCaptureBegin(1, ring, MAX_EDGES + 1)) {
+        fail("pulseCaptureBegin", 1, 0, 1);
+        return;
+    }
+    startSim(1);
+    makeEdges(first, minGap, maxGap, MAX_EDGES);
+    /* the timer starts at zero, so the first rollovers are at CAPTURE_WRAP */
+    nextWrap = CAPTURE_WRAP;
+    while (nextWrap <= first) {
+        interrupt(nextWrap, GPT_INT_TIMEOUT, 0);
+        nextWrap += CAPTURE_WRAP;
+    }
+    while (step()) {
+        ;
+    }
+
+    if (pulseCaptureAvailable(1) != MAX_EDGES - 1) {
+        fail("pulseCaptureAvailable", minGap, pulseCaptureAvailable(1),
+            MAX_EDGES - 1);
+    }
+
+    for (i = 1; i < MAX_EDGES; i++) {
+        level = pulseCaptureRead(1, &width);
+        expect = (((uint32_t)edges[i] & ~1) - ((uint32_t)edges[i - 1] & ~1))
+            / 48;
+        vectors++;
+        /* the pulse between edges i-1 and i has the level after edge i-1 */
+        if (level != (int)(((i - 1) & 1) ? startLevel : !startLevel)) {
+            fail("pulseCaptureRead level", i, level, !startLevel);
+        }
+        if (width != expect) {
+            fail("pulseCaptureRead width", i, width, expect);
+        }
+    }
+
+    if (pulseCaptureRead(1, &width) != -1) {
+        fail("pulseCaptureRead empty", 1, 0, -1);
+    }
+
+    pulseCaptureEnd(1);
+}
+
+/*
+ *  ======== pulseIn vectors ========
+ */
+static void testPulseIn(uint8_t state, uint32_t minGap, uint32_t maxGap)
+{
+    unsigned long width;
+    uint32_t expect;
+    int start;
+
+    pinLevel = rnd() & 1;
+    digital_pin_to_pin_function[2] = PIN_FUNC_DIGITAL_INPUT;
+    makeEdges(1000 + rnd() % CAPTURE_WRAP, minGap, maxGap, 8);
+
+    /* the first whole pulse at the requested level */
+    start = (pinLevel == state) ? 1 : 0;
+    expect = (uint32_t)(edges[start + 1] - edges[start]) / 48;
+
+    /* pulseIn() opens the channel itself, hook the simulator to it */
+    timers[7].fxn = NULL;
+    simTimer = &timers[7];
+    width = pulseIn(2, state, 1000000);
+    vectors++;
+
+    if (width != expect) {
+        fail("pulseIn", state, width, expect);
+    }
+    if (digital_pin_to_pin_function[2] != PIN_FUNC_DIGITAL_INPUT) {
+        fail("pulseIn pin function", 2, digital_pin_to_pin_function[2],
+            PIN_FUNC_DIGITAL_INPUT);
+    }
+}
+
+/*
+ *  ======== captureOpen rollback ========
+ */
+static void checkReleased(const char *what, uint8_t function)
+{
+    int i;
+
+    vectors++;
+    if (digital_pin_to_pin_function[3] != function) {
+        fail(what, 3, digital_pin_to_pin_function[3], function);
+    }
+    for (i = 0; i < CAPTURE_CHANNELS; i++) {
+        if (channels[i].claimed || channels[i].hTimer != NULL) {
+            fail(what, i, 1, 0);
+        }
+    }
+    for (i = 0; i < CAPTURE_NUM_TIMERS; i++) {
+        if (timers[i].open) {
+            fail(what, i, 1, 0);
+        }
+    }
+    if (pinsOpen != 0) {
+        fail(what, 3, pinsOpen, 0);
+    }
+}
+
+static void testRollback(void)
+{
+    unsigned stops = stopCalls;
+
+    digital_pin_to_pin_function[3] = PIN_FUNC_ANALOG_OUTPUT;
+    timersExhausted = true;
+    if (pulseCaptureBegin(3, ring, 16)) {
+        fail("no timer", 3, 1, 0);
+    }
+    timersExhausted = false;
+    checkReleased("no timer", PIN_FUNC_ANALOG_OUTPUT);
+    if (stopCalls != stops) {
+        fail("no timer left pin plumbing", 3, stopCalls - stops, 0);
+    }
+
+    pinOwnedElsewhere = true;
+    if (pulseCaptureBegin(3, ring, 16)) {
+        fail("pin owned", 3, 1, 0);
+    }
+    pinOwnedElsewhere = false;
+    checkReleased("pin owned", PIN_FUNC_UNUSED);
+
+    /* every channel in use, then one more */
+    digital_pin_to_pin_function[0] = PIN_FUNC_UNUSED;
+    digital_pin_to_pin_function[4] = PIN_FUNC_UNUSED;
+    digital_pin_to_pin_function[5] = PIN_FUNC_UNUSED;
+    digital_pin_to_pin_function[6] = PIN_FUNC_UNUSED;
+    pulseCaptureBegin(0, ring, 16);
+    pulseCaptureBegin(4, ring, 16);
+    pulseCaptureBegin(5, ring, 16);
+    pulseCaptureBegin(6, ring, 16);
+    digital_pin_to_pin_function[3] = PIN_FUNC_UNUSED;
+    if (pulseCaptureBegin(3, ring, 16)) {
+        fail("channels busy", 3, 1, 0);
+    }
+    if (pulseCaptureBegin(0, ring, 16)) {
+        fail("pin busy", 0, 1, 0);
+    }
+    pulseCaptureEnd(0);
+    pulseCaptureEnd(4);
+    pulseCaptureEnd(5);
+    pulseCaptureEnd(6);
+    checkReleased("channels busy", PIN_FUNC_UNUSED);
+}
+
+int main(void)
+{
+    int i;
+
+    /* short pulses to pulses several rollovers long */
+    for (i = 0; i < 20; i++) {
+        testCaptureStream(2 * MAX_LATENCY, 5000, rnd() % CAPTURE_WRAP);
+        testCaptureStream(CAPTURE_WRAP - 1000, CAPTURE_WRAP + 1000,
+            rnd() % CAPTURE_WRAP);
+        testCaptureStream(2 * MAX_LATENCY, 3 * CAPTURE_WRAP,
+            rnd() % CAPTURE_WRAP);
+    }
+
+    /* across the 2^32 wrap of the extended timestamp */
+    for (i = 0; i < 20; i++) {
+        testCaptureStream(2 * MAX_LATENCY, 4 * CAPTURE_WRAP,
+            ((uint64_t)1 << 32) - 200 * (uint64_t)CAPTURE_WRAP);
+    }
+
+    for (i = 0; i < 2000; i++) {
+        testPulseIn(i & 1, 2 * MAX_LATENCY, 2000);
+        testPulseIn(i & 1, 2 * MAX_LATENCY, 3 * CAPTURE_WRAP);
+    }
+
+    testRollback();
+
+    if (pollingCalls != 0) {
+        fail("pulseIn fell back to polling", 0, pollingCalls, 0);
+    }
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+
+    return (failures ? 1 : 0);
+}
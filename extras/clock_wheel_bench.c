@@ -0,0 +1,929 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== clock_wheel_bench.c ========
+ *  Host test vectors and benchmark for the Clock.timingWheel backend in
+ *  system/kernel/tirtos/packages/ti/sysbios/knl/Clock.c
+ *
+ *  Builds the real Clock module with the timing wheel in TickMode_PERIODIC
+ *  against mocked Queue, Hwi, Log and Timer modules. The tick Hwi is
+ *  modelled on the Clock_doTick() that Clock.xdt generates, so the Clock
+ *  Swi is only posted while objects are active, and the Swi can be held
+ *  back to let ticks pile up in swiCount as they do under load.
+ *
+ *  10, 100 and 1000 objects, half periodic and half one-shots re-armed
+ *  from their own functions, are stopped and restarted at random from
+ *  "tasks" and from other objects' functions. Every expiry is checked
+ *  against the stock linear clockQ walk, kept below as Ref_*, ticked in
+ *  lockstep. Starting a clock after the wheel sat idle, including across
+ *  the 2^32 tick wrap and while the Swi is behind, must also fire on the
+ *  right tick and report the right Clock_getTicksUntilTimeout(), as must
+ *  a lone one-shot that re-arms itself from a late Swi. The per-Clock
+ *  slack table must hand out, find and free its entries, and slack must
+ *  not move any expiry in TickMode_PERIODIC.
+ *
+ *  Finally both are timed per tick with every object armed, and with all
+ *  objects stopped, where the linear walk still posts the Swi each tick
+ *  and the wheel posts nothing.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o clock_wheel_bench -Icores/cc13xx \
+ *          -Isystem/kernel/tirtos/packages extras/clock_wheel_bench.c
+ *      ./clock_wheel_bench
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ *  ======== Mocks ========
+ *  Stand-ins for the headers Clock.c includes.
+ */
+#define xdc_std__include
+#define xdc_runtime_Assert__include
+#define xdc_runtime_Assert__localnames__done
+#define xdc_runtime_Log__include
+#define xdc_runtime_Log__localnames__done
+#define xdc_runtime_Startup__include
+#define xdc_runtime_Startup__localnames__done
+#define ti_sysbios_BIOS__include
+#define ti_sysbios_BIOS__localnames__done
+#define ti_sysbios_knl_Intrinsics__include
+#define ti_sysbios_knl_Intrinsics__localnames__done
+#define ti_sysbios_knl_Queue__include
+#define ti_sysbios_knl_Queue__localnames__done
+#define ti_sysbios_knl_Swi__include
+#define ti_sysbios_knl_Swi__localnames__done
+#define ti_sysbios_hal_Hwi__include
+#define ti_sysbios_hal_Hwi__localnames__done
+#define ti_sysbios_knl_Clock__INTERNAL__
+
+typedef void            Void;
+typedef int             Int;
+typedef unsigned int    UInt;
+typedef uint32_t        UInt32;
+typedef unsigned short  Bool;
+typedef uintptr_t       UArg;
+typedef void           *Ptr;
+
+#define TRUE            1
+#define FALSE           0
+
+typedef int Assert_Id;
+#define Assert_isTrue(expr, id) \
+    do { if (!(expr)) { printf("assert: %s\n", #expr); exit(2); } } while (0)
+
+#define Log_write1(evt, a1)     ((void)0)
+#define Log_write2(evt, a1, a2) ((void)0)
+
+#define Startup_DONE    (-1)
+#define Startup_NOTDONE 0
+
+#define BIOS_ThreadType_Hwi     0
+#define BIOS_ThreadType_Swi     1
+#define BIOS_ThreadType_Task    2
+#define BIOS_clockEnabled       TRUE
+#define BIOS_getThreadType()    BIOS_ThreadType_Task
+
+#define Intrinsics_maxbit(bits) (31 - __builtin_clz(bits))
+
+static UInt Hwi_disable(void) { return (0); }
+static void Hwi_restore(UInt key) { (void)key; }
+
+/* ti.sysbios.knl.Queue, as in Queue.c */
+typedef struct Queue_Elem {
+    struct Queue_Elem *next;
+    struct Queue_Elem *prev;
+} Queue_Elem;
+
+typedef Queue_Elem *Queue_Handle;
+
+static void Queue_elemClear(Queue_Elem *e) { e->next = e->prev = e; }
+static Ptr Queue_head(Queue_Handle q) { return (q->next); }
+static Ptr Queue_next(Queue_Elem *e) { return (e->next); }
+static Bool Queue_empty(Queue_Handle q) { return (q->next == q); }
+
+static void Queue_enqueue(Queue_Handle q, Queue_Elem *e)
+{
+    e->next = q;
+    e->prev = q->prev;
+    q->prev->next = e;
+    q->prev = e;
+}
+
+#define Queue_put Queue_enqueue
+
+static Ptr Queue_dequeue(Queue_Handle q)
+{
+    Queue_Elem *e = q->next;
+
+    q->next = e->next;
+    e->next->prev = q;
+
+    return (e);
+}
+
+static void Queue_remove(Queue_Elem *e)
+{
+    e->prev->next = e->next;
+    e->next->prev = e->prev;
+}
+
+/* ti.sysbios.knl.Clock */
+typedef void (*Clock_FuncPtr)(UArg);
+
+typedef struct Clock_Object {
+    Queue_Elem elem;
+    UInt32 timeout;
+    UInt32 currTimeout;
+    UInt32 period;
+    volatile Bool active;
+    Clock_FuncPtr fxn;
+    UArg arg;
+} Clock_Object;
+
+typedef struct Clock_Params {
+    UArg arg;
+    Bool startFlag;
+    UInt32 period;
+} Clock_Params;
+
+typedef Ptr Clock_TimerProxy_Handle;
+
+typedef struct Clock_Module_State {
+    volatile UInt32 ticks;
+    UInt swiCount;
+    Clock_TimerProxy_Handle timer;
+    Ptr swi;
+    volatile UInt numTickSkip;
+    UInt32 nextScheduledTick;
+    UInt32 maxSkippable;
+    Bool inWorkFunc;
+    Bool startDuringWorkFunc;
+    Bool ticking;
+} Clock_Module_State;
+
+static Clock_Module_State mockModule;
+static Queue_Elem mockClockQ;
+
+#define Clock_module (&mockModule)
+#define Clock_Module_State_clockQ() (&mockClockQ)
+
+enum { Clock_TickSource_TIMER, Clock_TickSource_USER, Clock_TickSource_NULL };
+enum { Clock_TickMode_PERIODIC, Clock_TickMode_DYNAMIC };
+
+#define ti_sysbios_knl_Clock_TICK_SOURCE    Clock_TickSource_USER
+#define ti_sysbios_knl_Clock_TICK_MODE      Clock_TickMode_PERIODIC
+#define ti_sysbios_knl_Clock_timingWheel__D TRUE
+
+#define Clock_tickPeriod        10
+#define Clock_A_clockDisabled   1
+#define Clock_A_badThreadType   2
+#define Clock_triggerClock      ((Clock_Object *)NULL)
+
+#define Clock_TimerProxy_Module_startupDone()           TRUE
+#define Clock_TimerProxy_getMaxTicks(t)                 0xFFFFFFFF
+#define Clock_TimerProxy_getPeriod(t)                   480000
+#define Clock_TimerProxy_getCurrentTick(t, save)        (Clock_module->ticks)
+#define Clock_TimerProxy_setNextTick(t, ticks)          ((void)0)
+#define Clock_TimerProxy_setPeriodMicroSecs(t, us)      TRUE
+#define Clock_TimerProxy_start(t)                       ((void)0)
+#define Clock_TimerProxy_stop(t)                        ((void)0)
+
+static void mockDoTick(UArg arg);
+#define Clock_doTickFunc mockDoTick
+
+UInt32 Clock_walkQueuePeriodic(void);
+Void Clock_start(Clock_Object *obj);
+Bool Clock_setSlack(Clock_Object *obj, UInt32 slack);
+UInt32 Clock_getSlack(Clock_Object *obj);
+
+#include "../system/kernel/tirtos/packages/ti/sysbios/knl/Clock.c"
+
+/*
+ *  ======== Tick Hwi ========
+ *  The TickMode_PERIODIC, timingWheel, swiEnabled branch of the generated
+ *  Clock_doTick(). While swiHeld the posted Swi is not run.
+ */
+static unsigned swiPosts = 0;
+static bool swiHeld = false;
+
+static void mockDoTick(UArg arg)
+{
+    (void)arg;
+
+    Clock_module->ticks++;
+
+    if (ti_sysbios_knl_Clock_wheelActive != 0) {
+        Clock_module->swiCount++;
+        swiPosts++;
+        if (!swiHeld) {
+            Clock_workFunc(0, 0);
+        }
+    }
+}
+
+static void runSwi(void)
+{
+    swiHeld = false;
+    if (Clock_module->swiCount != 0) {
+        Clock_workFunc(0, 0);
+    }
+}
+
+/*
+ *  ======== Reference implementation ========
+ *  The stock TickMode_PERIODIC Clock: every object stays on one queue,
+ *  the Hwi posts the Swi whenever that queue is not empty and the Swi
+ *  walks all of it for every tick it was posted for.
+ */
+typedef struct Ref_Clock {
+    struct Ref_Clock *next;
+    UInt32 timeout;
+    UInt32 currTimeout;
+    UInt32 period;
+    bool active;
+    void (*fxn)(unsigned);
+    unsigned arg;
+} Ref_Clock;
+
+static Ref_Clock *Ref_clockQ = NULL;
+static UInt32 Ref_ticks = 0;
+static unsigned Ref_swiCount = 0;
+static unsigned Ref_swiPosts = 0;
+static bool Ref_swiHeld = false;
+
+static void Ref_start(Ref_Clock *obj)
+{
+    obj->currTimeout = Ref_ticks + obj->timeout;
+    obj->active = true;
+}
+
+static void Ref_stop(Ref_Clock *obj)
+{
+    obj->active = false;
+}
+
+static __attribute__((noinline)) void Ref_workFunc(void)
+{
+    unsigned count = Ref_swiCount;
+    UInt32 compare = Ref_ticks - count;
+    Ref_Clock *obj;
+
+    Ref_swiCount = 0;
+
+    while (count) {
+        compare++;
+        count--;
+
+        for (obj = Ref_clockQ; obj != NULL; obj = obj->next) {
+            if (obj->active && obj->currTimeout == compare) {
+                if (obj->period == 0) {
+                    obj->active = false;
+                }
+                else {
+                    obj->currTimeout += obj->period;
+                }
+                obj->fxn(obj->arg);
+            }
+        }
+    }
+}
+
+static __attribute__((noinline)) void Ref_doTick(void)
+{
+    Ref_ticks++;
+
+    if (Ref_clockQ != NULL) {
+        Ref_swiCount++;
+        Ref_swiPosts++;
+        if (!Ref_swiHeld) {
+            Ref_workFunc();
+        }
+    }
+}
+
+static void Ref_runSwi(void)
+{
+    Ref_swiHeld = false;
+    if (Ref_swiCount != 0) {
+        Ref_workFunc();
+    }
+}
+
+/*
+ *  ======== Harness ========
+ */
+#define MAX_CLOCKS  1000
+#define MAX_FIRES   (1 << 21)
+
+typedef struct Fire {
+    UInt32 tick;
+    uint32_t idx;
+} Fire;
+
+static Clock_Object clocks[MAX_CLOCKS];
+static Ref_Clock refClocks[MAX_CLOCKS];
+static unsigned numClocks;
+static unsigned fireCount[MAX_CLOCKS];
+static unsigned refFireCount[MAX_CLOCKS];
+static UInt32 lastRun[MAX_CLOCKS];
+static UInt32 refLastRun[MAX_CLOCKS];
+
+static Fire fires[MAX_FIRES];
+static Fire refFires[MAX_FIRES];
+static unsigned numFires;
+static unsigned numRefFires;
+
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, unsigned long long a,
+    unsigned long long b, unsigned long long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %llu got %llu expected %llu\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+/* what a clock function does on its n-th run, the same for both sides */
+static uint32_t hash(uint32_t idx, uint32_t n)
+{
+    uint32_t h = idx * 0x9E3779B1u ^ n * 0x85EBCA77u;
+
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+
+    return (h);
+}
+
+static uint32_t maxTimeout;
+
+/*
+ * The object a function stops (even) or starts (odd) on its n-th run,
+ * -1 for none. Functions run on one tick in either order must have the
+ * same effect, so they never stop and start the same object.
+ */
+static int otherOf(uint32_t h)
+{
+    unsigned k = (h >> 8) % numClocks;
+
+    switch (h >> 28) {
+        case 0:
+            return (k & ~1u);
+        case 1:
+            return (k | 1);
+        default:
+            return (-1);
+    }
+}
+
+static void clockFxn(UArg arg)
+{
+    Clock_Object *obj = &clocks[arg];
+    Clock_Object *other;
+    uint32_t h = hash(arg, fireCount[arg]++);
+    UInt32 tick;
+    int k;
+
+    /* a periodic object has already been refreshed */
+    tick = obj->currTimeout - obj->period;
+    lastRun[arg] = tick;
+
+    if (numFires < MAX_FIRES) {
+        fires[numFires].tick = tick;
+        fires[numFires].idx = arg;
+        numFires++;
+    }
+
+    if (obj->period == 0) {
+        Clock_setTimeout(obj, 1 + h % maxTimeout);
+        Clock_start(obj);
+    }
+
+    /* leave objects due on this tick alone, see compareFires() */
+    k = otherOf(h);
+    if (k < 0) {
+        return;
+    }
+    other = &clocks[k];
+    if ((other->active && other->currTimeout == tick) ||
+        (fireCount[k] != 0 && lastRun[k] == tick)) {
+        return;
+    }
+    if (k & 1) {
+        Clock_start(other);
+    }
+    else {
+        Clock_stop(other);
+    }
+}
+
+static void refFxn(unsigned arg)
+{
+    Ref_Clock *obj = &refClocks[arg];
+    Ref_Clock *other;
+    uint32_t h = hash(arg, refFireCount[arg]++);
+    UInt32 tick = obj->currTimeout - obj->period;
+    int k;
+
+    refLastRun[arg] = tick;
+
+    if (numRefFires < MAX_FIRES) {
+        refFires[numRefFires].tick = tick;
+        refFires[numRefFires].idx = arg;
+        numRefFires++;
+    }
+
+    if (obj->period == 0) {
+        obj->timeout = 1 + h % maxTimeout;
+        Ref_start(obj);
+    }
+
+    k = otherOf(h);
+    if (k < 0) {
+        return;
+    }
+    other = &refClocks[k];
+    if ((other->active && other->currTimeout == tick) ||
+        (refFireCount[k] != 0 && refLastRun[k] == tick)) {
+        return;
+    }
+    if (k & 1) {
+        Ref_start(other);
+    }
+    else {
+        Ref_stop(other);
+    }
+}
+
+/* a freshly started Clock module and reference at 'ticks' */
+static void reset(UInt32 ticks)
+{
+    memset(&mockModule, 0, sizeof(mockModule));
+    Queue_elemClear(&mockClockQ);
+    ti_sysbios_knl_Clock_wheelActive = 0;
+    Clock_module->ticks = ticks;
+    Clock_Module_startup(0);
+    swiPosts = 0;
+    swiHeld = false;
+
+    Ref_clockQ = NULL;
+    Ref_ticks = ticks;
+    Ref_swiCount = 0;
+    Ref_swiPosts = 0;
+    Ref_swiHeld = false;
+
+    numClocks = 0;
+    numFires = 0;
+    numRefFires = 0;
+}
+
+static void addClock(UInt32 timeout, UInt32 period)
+{
+    unsigned i = numClocks++;
+
+    memset(&clocks[i], 0, sizeof(clocks[i]));
+    Clock_addI(&clocks[i], clockFxn, timeout, (UArg)i);
+    Clock_setPeriod(&clocks[i], period);
+    fireCount[i] = 0;
+
+    refClocks[i].timeout = timeout;
+    refClocks[i].period = period;
+    refClocks[i].active = false;
+    refClocks[i].fxn = refFxn;
+    refClocks[i].arg = i;
+    refClocks[i].next = (i == 0) ? NULL : &refClocks[i - 1];
+    Ref_clockQ = &refClocks[i];
+    refFireCount[i] = 0;
+}
+
+static void tickBoth(void)
+{
+    mockDoTick(0);
+    Ref_doTick();
+}
+
+static int fireCmp(const void *a, const void *b)
+{
+    const Fire *x = a, *y = b;
+
+    if (x->tick != y->tick) {
+        return ((int32_t)(x->tick - y->tick) < 0 ? -1 : 1);
+    }
+    return ((x->idx > y->idx) - (x->idx < y->idx));
+}
+
+/*
+ * Both sides must run the same objects on the same ticks, in tick order.
+ * Objects due on one tick may run in a different order, so a function
+ * never stops or restarts another object due on the same tick, see
+ * also otherOf().
+ */
+static void compareFires(const char *what, unsigned n)
+{
+    unsigned i;
+
+    if (numFires == MAX_FIRES || numRefFires == MAX_FIRES) {
+        fail("fire log full", n, numFires, numRefFires);
+        return;
+    }
+
+    for (i = 1; i < numFires; i++) {
+        if ((int32_t)(fires[i].tick - fires[i - 1].tick) < 0) {
+            fail(what, n, fires[i].tick, fires[i - 1].tick);
+            break;
+        }
+    }
+
+    qsort(fires, numFires, sizeof(Fire), fireCmp);
+    qsort(refFires, numRefFires, sizeof(Fire), fireCmp);
+
+    vectors += numRefFires;
+    if (numFires != numRefFires) {
+        fail(what, n, numFires, numRefFires);
+        return;
+    }
+    for (i = 0; i < numFires; i++) {
+        if (fires[i].tick != refFires[i].tick || fires[i].idx != refFires[i].idx) {
+            fail(what, n, fires[i].tick, refFires[i].tick);
+            return;
+        }
+    }
+}
+
+/* random objects, stopped and restarted at random, checked against Ref */
+static void testRandom(unsigned n, UInt32 startTick, uint32_t timeoutRange,
+    unsigned ticks)
+{
+    unsigned i, j, k;
+    uint32_t r;
+
+    reset(startTick);
+    maxTimeout = timeoutRange;
+
+    for (i = 0; i < n; i++) {
+        r = rnd();
+        addClock(1 + r % timeoutRange,
+            (i & 1) ? 1 + (r >> 12) % timeoutRange : 0);
+    }
+
+    for (i = 0; i < ticks; i++) {
+        /* a task starting or stopping something */
+        if ((rnd() & 7) == 0) {
+            r = rnd();
+            k = r % n;
+            if (r & 0x80000000) {
+                Clock_stop(&clocks[k]);
+                Ref_stop(&refClocks[k]);
+            }
+            else {
+                r = 1 + (r >> 12) % timeoutRange;
+                Clock_setTimeout(&clocks[k], r);
+                refClocks[k].timeout = r;
+                Clock_start(&clocks[k]);
+                Ref_start(&refClocks[k]);
+            }
+        }
+
+        /* now and then the Swi falls behind by a few ticks */
+        if ((rnd() & 255) == 0) {
+            swiHeld = true;
+            Ref_swiHeld = true;
+            k = 1 + rnd() % 40;
+            for (j = 0; j < k; j++) {
+                tickBoth();
+            }
+            runSwi();
+            Ref_runSwi();
+        }
+        else {
+            tickBoth();
+        }
+    }
+
+    compareFires("random", n);
+
+    if (ti_sysbios_knl_Clock_wheelActive != 0 || swiPosts != 0) {
+        for (i = 0, k = 0; i < n; i++) {
+            k += clocks[i].active;
+        }
+        vectors++;
+        if (ti_sysbios_knl_Clock_wheelActive != k) {
+            fail("wheelActive", n, ti_sysbios_knl_Clock_wheelActive, k);
+        }
+    }
+}
+
+/* ticks with nothing armed must not post the Swi */
+static void testIdle(void)
+{
+    unsigned i;
+
+    reset(0);
+    maxTimeout = 1000;
+    addClock(100, 0);
+
+    for (i = 0; i < 10000; i++) {
+        mockDoTick(0);
+    }
+
+    vectors++;
+    if (swiPosts != 0) {
+        fail("idle posts", 0, swiPosts, 0);
+    }
+}
+
+/*
+ * Arm a single one-shot after 'idle' ticks with nothing armed, the Swi
+ * 'behind' ticks late when it is started. It must fire exactly 'timeout'
+ * ticks after the start and report the right distance in between.
+ */
+static void testWake(UInt32 startTick, UInt32 idle, unsigned behind,
+    UInt32 timeout)
+{
+    UInt32 due, until;
+    unsigned i;
+
+    reset(startTick);
+    maxTimeout = 1;
+    addClock(timeout, 0);
+
+    /* an idle wheel gets no Swi, so only the tick count moves */
+    Clock_module->ticks += idle;
+
+    /* an object that kept the Swi posting, stopped while it was held */
+    if (behind != 0) {
+        addClock(1000, 0);
+        Clock_start(&clocks[1]);
+        swiHeld = true;
+        for (i = 0; i < behind; i++) {
+            mockDoTick(0);
+        }
+        Clock_stop(&clocks[1]);
+    }
+
+    Clock_start(&clocks[0]);
+    due = Clock_module->ticks + timeout;
+    runSwi();
+
+    until = Clock_getTicksUntilTimeout();
+    vectors++;
+    if (until != timeout) {
+        fail("wake distance", startTick + idle, until, timeout);
+    }
+
+    /* the one-shot re-arms itself with maxTimeout, so count runs */
+    while (numFires == 0 && Clock_module->ticks != due + 1) {
+        mockDoTick(0);
+    }
+
+    vectors++;
+    if (numFires != 1 || fires[0].tick != due) {
+        fail("wake fire", startTick + idle, numFires ? fires[0].tick : 0, due);
+    }
+}
+
+static UInt32 rearmTimeout;
+
+static void rearmFxn(UArg arg)
+{
+    Clock_Object *obj = &clocks[arg];
+
+    if (numFires < MAX_FIRES) {
+        fires[numFires].tick = obj->currTimeout;
+        fires[numFires].idx = arg;
+        numFires++;
+    }
+
+    if (rearmTimeout != 0) {
+        Clock_setTimeout(obj, rearmTimeout);
+        rearmTimeout = 0;
+        Clock_start(obj);
+    }
+}
+
+/*
+ * A one-shot that re-arms itself from a Swi running 'behind' ticks late,
+ * leaving nothing armed for a moment, must run on both of its ticks.
+ */
+static void testRearm(UInt32 startTick, UInt32 timeout, unsigned behind,
+    UInt32 retimeout)
+{
+    UInt32 second;
+    unsigned i;
+
+    reset(startTick);
+    addClock(timeout, 0);
+    Clock_setFunc(&clocks[0], rearmFxn, 0);
+    rearmTimeout = retimeout;
+
+    Clock_start(&clocks[0]);
+    swiHeld = true;
+    for (i = 0; i < behind; i++) {
+        mockDoTick(0);
+    }
+    second = Clock_module->ticks + retimeout;
+    runSwi();
+
+    while (Clock_module->ticks != second && numFires < 2) {
+        mockDoTick(0);
+    }
+
+    vectors++;
+    if (numFires != 2 || fires[0].tick != startTick + timeout ||
+        Clock_module->ticks != second) {
+        fail("rearm", startTick, Clock_module->ticks, second);
+    }
+}
+
+/*
+ *  ======== testSlack ========
+ */
+static void testSlack(void)
+{
+    const unsigned n = ti_sysbios_knl_Clock_numSlack__D;
+    unsigned i;
+
+    for (i = 0; i < n; i++) {
+        vectors++;
+        if (!Clock_setSlack(&clocks[i], i + 1)) {
+            fail("setSlack", i, 0, 1);
+        }
+    }
+
+    /* table full */
+    vectors++;
+    if (Clock_setSlack(&clocks[n], 5) || Clock_getSlack(&clocks[n]) != 0) {
+        fail("setSlack full", n, Clock_getSlack(&clocks[n]), 0);
+    }
+
+    for (i = 0; i < n; i++) {
+        vectors++;
+        if (Clock_getSlack(&clocks[i]) != i + 1) {
+            fail("getSlack", i, Clock_getSlack(&clocks[i]), i + 1);
+        }
+    }
+
+    /* a slack of 0 frees the entry for the next object */
+    vectors++;
+    Clock_setSlack(&clocks[3], 0);
+    if (!Clock_setSlack(&clocks[n], 0xFFFFFFFF) ||
+            Clock_getSlack(&clocks[n]) != 0x7FFFFFFF ||
+            Clock_getSlack(&clocks[3]) != 0) {
+        fail("setSlack reuse", n, Clock_getSlack(&clocks[n]), 0x7FFFFFFF);
+    }
+
+    for (i = 0; i <= n; i++) {
+        Clock_setSlack(&clocks[i], 0);
+    }
+    vectors++;
+    if (Clock_slackUsed != 0) {
+        fail("slackUsed", 0, Clock_slackUsed, 0);
+    }
+
+    /* TickMode_PERIODIC ignores slack: the usual random run must match */
+    for (i = 0; i < n; i++) {
+        Clock_setSlack(&clocks[i], 1000);
+    }
+    testRandom(n, 0, 5000, 20000);
+    for (i = 0; i < n; i++) {
+        Clock_setSlack(&clocks[i], 0);
+    }
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+static void nop(UArg arg) { (void)arg; }
+static void refNop(unsigned arg) { (void)arg; }
+
+/* ns per tick with n periodic objects armed, or all stopped */
+static void timeWheel(unsigned n, bool armed)
+{
+    const unsigned ticks = 1000000;
+    double t0, tRef, tNew;
+    unsigned i;
+
+    reset(0);
+    for (i = 0; i < n; i++) {
+        addClock(1 + rnd() % 1000, 100 + rnd() % 10000);
+        Clock_setFunc(&clocks[i], nop, i);
+        refClocks[i].fxn = refNop;
+        if (armed) {
+            Clock_start(&clocks[i]);
+            Ref_start(&refClocks[i]);
+        }
+    }
+
+    t0 = now();
+    for (i = 0; i < ticks; i++) {
+        Ref_doTick();
+    }
+    tRef = now() - t0;
+
+    t0 = now();
+    for (i = 0; i < ticks; i++) {
+        mockDoTick(0);
+    }
+    tNew = now() - t0;
+
+    printf("%4u clocks %s: Ref %8.1f ns, wheel %6.1f ns per tick, "
+        "Swi posts %u vs %u\n", n, armed ? "armed  " : "stopped",
+        tRef * 1e9 / ticks, tNew * 1e9 / ticks, Ref_swiPosts, swiPosts);
+}
+
+int main(void)
+{
+    static const unsigned sizes[] = {10, 100, 1000};
+    unsigned i;
+
+    for (i = 0; i < 3; i++) {
+        testRandom(sizes[i], 0, 50, 20000000 / sizes[i]);
+        testRandom(sizes[i], 0, 5000, 200000);
+        testRandom(sizes[i], 0xFFFF0000, 100000, 200000);
+        testRandom(sizes[i], rnd(), 2000000, 100000);
+    }
+
+    testIdle();
+    testSlack();
+
+    testWake(0, 0, 0, 5);
+    testWake(0, 1000000, 0, 5);
+    testWake(0, 1000000, 0, 300000);
+    testWake(0xFFFFFF00, 0x100, 0, 0x200);
+    testWake(0x10, 0xFFFFFF00, 0, 0x200);
+    testWake(0x7FFFFFF0, 0x80000020, 0, 70000);
+    testWake(0, 5000, 7, 3);
+    testWake(0xFFFFFFF0, 0x20000, 30, 0x1000);
+
+    testRearm(0, 31, 33, 14);
+    for (i = 0; i < 10000; i++) {
+        testRearm(rnd(), 1 + rnd() % 64, 64 + rnd() % 40, 1 + rnd() % 300);
+    }
+
+    for (i = 0; i < 3; i++) {
+        timeWheel(sizes[i], true);
+        timeWheel(sizes[i], false);
+    }
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+
+    return (failures ? 1 : 0);
+}
@@ -0,0 +1,633 @@
+/*
+ * Copyright (c) 2017 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free,
+ * non-exclusive license under copyrights and patents it now or hereafter
+ * owns or controls to make, have made, use, import, offer to sell and sell
+ * ("Utilize") this software subject to the terms herein. With respect to the
+ * foregoing patent license, such license is granted solely to the extent that
+ * any such patent is necessary to Utilize the software alone. The patent
+ * license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI
+ * ("TI Devices"). No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce
+ * this license (including the above copyright notice and the disclaimer and
+ * (if applicable) source code license limitations below) in the documentation
+ * and/or other materials provided with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * * No reverse engineering, decompilation, or disassembly of this software is
+ *   permitted with respect to any software provided in binary form.
+ *
+ * * any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * * Nothing shall obligate TI to provide you with source code for the software
+ *   licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution
+ * of the source code are permitted provided that the following conditions are
+ * met:
+ *
+ * * any redistribution and use of the source code, including any resulting
+ *   derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * * any redistribution and use of any object code compiled from the source
+ *   code and any resulting derivative works, are licensed by TI for use only
+ *   with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its
+ * suppliers may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+ * NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== codec1_vectors.c ========
+ *  Host test vectors for ti/drivers/pdm/Codec1.c
+ *
+ *  Runs the Codec1 functions against the original per-nibble
+ *  implementation, kept below as Ref_*, and checks that the encoded bytes,
+ *  the decoded samples and the coder state match exactly. Signals cover
+ *  silence, sines, noise, full scale steps that saturate the predictor and
+ *  wrap its 16-bit arithmetic, and random start states. It also times
+ *  both implementations.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o codec1_vectors -Isystem/source extras/codec1_vectors.c \
+ *          system/source/ti/drivers/pdm/Codec1.c -lm
+ *      ./codec1_vectors
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ti/drivers/pdm/Codec1.h>
+
+/* largest vector, in samples */
+#define MAX_SAMPLES     4096
+
+/*
+ *  ======== Reference implementation ========
+ *  Codec1.c as it was before the block-optimized rewrite
+ */
+
+static int16_t Ref_pvEnc;
+static int16_t Ref_pvDec;
+static int8_t Ref_siEnc;
+static int8_t Ref_siDec;
+
+static const uint16_t Ref_stepsizeLut[89] =
+{
+    7,    8,    9,   10,   11,   12,   13,   14, 16,   17,   19,   21,   23,   25,   28,   31,
+    34,   37,   41,   45,   50,   55,   60,   66, 73,   80,   88,   97,  107,  118,  130,  143,
+    157,  173,  190,  209,  230,  253,  279,  307, 337,  371,  408,  449,  494,  544,  598,  658,
+    724,  796,  876,  963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493,10442,11487,12635,13899,
+    15289,16818,18500,20350,22385,24623,27086,29794, 32767
+};
+
+static const int8_t Ref_IndexLut[16] =
+{
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/*
+*  ======== Ref_encodeSingle ========
+*/
+static uint8_t Ref_encodeSingle(int16_t audSample)
+{
+    // Difference between samples and previous predicted value.
+    // This difference will be encoded
+    int16_t difference = audSample - Ref_pvEnc;
+    //Final nibble value
+    uint8_t tic1_nibble_4bits = 0;
+    //Step size to quantisize the difference,
+    int16_t step = Ref_stepsizeLut[Ref_siEnc];
+    //cumulated difference from samples.
+    int16_t cum_diff = step>>3;
+
+    if(difference<0)
+    {
+        tic1_nibble_4bits = 8;
+        difference = -difference;
+    }
+
+    if(difference>=step)
+    {
+        tic1_nibble_4bits |= 4;
+        difference -= step;
+        cum_diff += step;
+    }
+    step >>= 1;
+    if(difference>=step)
+    {
+        tic1_nibble_4bits |= 2;
+        difference -= step;
+        cum_diff += step;
+    }
+    step >>= 1;
+    if(difference>=step)
+    {
+        tic1_nibble_4bits |= 1;
+        cum_diff += step;
+    }
+
+    if(tic1_nibble_4bits&8)
+    {
+        if (Ref_pvEnc < (-32768+cum_diff))
+            (Ref_pvEnc) = -32768;
+        else
+            Ref_pvEnc -= cum_diff;
+    }
+    else
+    {
+        if (Ref_pvEnc > (0x7fff-cum_diff))
+            (Ref_pvEnc) = 0x7fff;
+        else
+            Ref_pvEnc += cum_diff;
+    }
+
+    Ref_siEnc += Ref_IndexLut[tic1_nibble_4bits];
+
+    if(Ref_siEnc<0)
+        Ref_siEnc = 0;
+    else if(Ref_siEnc>88)
+        Ref_siEnc = 88;
+
+    return tic1_nibble_4bits;
+}
+
+
+/*
+*  ======== Ref_decodeSingle ========
+*/
+static int16_t Ref_decodeSingle(uint8_t nibble_4bits)
+{
+    int16_t step = Ref_stepsizeLut[Ref_siDec];
+    int16_t cum_diff  = step>>3;
+
+    Ref_siDec += Ref_IndexLut[nibble_4bits];
+    if(Ref_siDec<0)
+        Ref_siDec = 0;
+    else if(Ref_siDec>88)
+        Ref_siDec = 88;
+
+    if(nibble_4bits&4)
+        cum_diff += step;
+    if(nibble_4bits&2)
+        cum_diff += step>>1;
+    if(nibble_4bits&1)
+        cum_diff += step>>2;
+
+    if(nibble_4bits&8)
+    {
+        if (Ref_pvDec < (-32767+cum_diff))
+            (Ref_pvDec) = -32767;
+        else
+            Ref_pvDec -= cum_diff;
+    }
+    else
+    {
+        if (Ref_pvDec > (0x7fff-cum_diff))
+            (Ref_pvDec) = 0x7fff;
+        else
+            Ref_pvDec += cum_diff;
+    }
+    return Ref_pvDec;
+}
+
+
+/*
+*  ======== Ref_encodeBuff ========
+*/
+static uint8_t Ref_encodeBuff(uint8_t* dst, int16_t* src, int16_t srcSize, int8_t *si, int16_t *pv)
+{
+    Ref_pvEnc = *pv;
+    Ref_siEnc = *si;
+    int16_t* end = (src + srcSize);
+    int8_t len = 0;
+
+    while(src < end)
+    {
+        // encode a pcm value from input buffer
+        uint8_t nibble = Ref_encodeSingle( *src++ );
+
+        nibble |= (Ref_encodeSingle( *src++ ) << 4);
+
+        *dst++ = nibble;
+
+        len++;
+    }
+
+    *pv = Ref_pvEnc;
+    *si = Ref_siEnc;
+    return len;
+}
+
+
+/*
+*  ======== Ref_decodeBuff ========
+*/
+static void Ref_decodeBuff(int16_t* dst, uint8_t* src, unsigned srcSize,  int8_t *si, int16_t *pv)
+{
+    Ref_pvDec = *pv;
+    Ref_siDec = *si;
+
+    // calculate pointers to iterate output buffer
+    int16_t* out = dst;
+    int16_t* end = out+(srcSize>>1);
+
+    while(out<end)
+    {
+        // get byte from src
+        uint8_t nibble = *src;
+        *out++ = Ref_decodeSingle((nibble&0xF));  // decode value and store it
+        nibble >>= 4;  // use high nibble of byte
+        nibble &= 0xF;  // use high nibble of byte
+        *out++ = Ref_decodeSingle(nibble);  // decode value and store it
+        ++src;        // move on a byte for next sample
+    }
+
+    *pv = Ref_pvDec;
+    *si = Ref_siDec;
+}
+
+/*
+ *  ======== Test ========
+ */
+
+static unsigned failures;
+static unsigned vectors;
+static uint32_t seed = 12345;
+
+static uint32_t rnd(void)
+{
+    /* xorshift32, so the vectors are the same on every host */
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return (seed);
+}
+
+static void fail(const char *what, unsigned vector, size_t at)
+{
+    if (failures < 20) {
+        printf("FAIL %s: vector %u, index %zu\n", what, vector, at);
+    }
+    failures++;
+}
+
+/*
+ *  ======== makeSignal ========
+ */
+static void makeSignal(int16_t *pcm, size_t n, unsigned kind)
+{
+    size_t i;
+    double f = 50.0 + (rnd() % 7000);
+    double amp = (double)(rnd() % 32768);
+
+    for (i = 0; i < n; i++) {
+        switch (kind % 7) {
+            case 0:     /* silence */
+                pcm[i] = 0;
+                break;
+            case 1:     /* sine */
+                pcm[i] = (int16_t)(amp * sin(2.0 * M_PI * f * (double)i / 16000.0));
+                break;
+            case 2:     /* full scale noise */
+                pcm[i] = (int16_t)rnd();
+                break;
+            case 3:     /* full scale square, saturates and wraps */
+                pcm[i] = ((i / (1 + kind % 5)) & 1) ? INT16_MIN : INT16_MAX;
+                break;
+            case 4:     /* single extremes on a quiet signal */
+                pcm[i] = (rnd() % 97 == 0) ? (int16_t)(rnd() & 1 ? INT16_MAX : INT16_MIN) : (int16_t)(rnd() % 64);
+                break;
+            case 5:     /* sine with noise, clipped */
+                {
+                    double v = 1.5 * amp * sin(2.0 * M_PI * f * (double)i / 16000.0) + (double)(int16_t)rnd() / 8.0;
+
+                    pcm[i] = (int16_t)(v > 32767.0 ? 32767.0 : (v < -32768.0 ? -32768.0 : v));
+                }
+                break;
+            default:    /* small noise */
+                pcm[i] = (int16_t)((int32_t)(rnd() % 512) - 256);
+                break;
+        }
+    }
+}
+
+/*
+ *  ======== randomState ========
+ *  Mostly zero, as at stream start, otherwise any reachable state
+ */
+static void randomState(int8_t *si, int16_t *pv)
+{
+    if (rnd() % 4 == 0) {
+        *si = 0;
+        *pv = 0;
+    }
+    else {
+        *si = (int8_t)(rnd() % 89);
+        *pv = (int16_t)rnd();
+    }
+}
+
+/*
+ *  ======== testBuffers ========
+ *  Codec1_encodeBuff/decodeBuff against the reference, mono
+ */
+static void testBuffers(unsigned vector)
+{
+    static int16_t pcm[MAX_SAMPLES + 2];
+    static uint8_t refEnc[MAX_SAMPLES / 2 + 1], enc[MAX_SAMPLES / 2 + 1];
+    static int16_t refDec[MAX_SAMPLES + 2], dec[MAX_SAMPLES + 2];
+    int16_t n = (int16_t)(2 + rnd() % (MAX_SAMPLES - 1));
+    int8_t si, refSi;
+    int16_t pv, refPv;
+    uint8_t len, refLen;
+    size_t i;
+
+    makeSignal(pcm, MAX_SAMPLES + 2, vector);
+    randomState(&si, &pv);
+    refSi = si;
+    refPv = pv;
+
+    refLen = Ref_encodeBuff(refEnc, pcm, n, &refSi, &refPv);
+    len = Codec1_encodeBuff(enc, pcm, n, &si, &pv);
+    if (len != refLen || si != refSi || pv != refPv) {
+        fail("encodeBuff state", vector, 0);
+    }
+    for (i = 0; i < ((size_t)n + 1) / 2; i++) {
+        if (enc[i] != refEnc[i]) {
+            fail("encodeBuff", vector, i);
+            break;
+        }
+    }
+
+    /* decode the same bytes, from another start state */
+    randomState(&si, &pv);
+    refSi = si;
+    refPv = pv;
+    Ref_decodeBuff(refDec, refEnc, (unsigned)n * 2, &refSi, &refPv);
+    Codec1_decodeBuff(dec, refEnc, (unsigned)n * 2, &si, &pv);
+    if (si != refSi || pv != refPv) {
+        fail("decodeBuff state", vector, 0);
+    }
+    for (i = 0; i < (size_t)n; i++) {
+        if (dec[i] != refDec[i]) {
+            fail("decodeBuff", vector, i);
+            break;
+        }
+    }
+}
+
+/*
+ *  ======== testSingle ========
+ *  Every nibble from every step index, and the single sample calls
+ */
+static void testSingle(void)
+{
+    static int16_t pcm[MAX_SAMPLES];
+    int8_t si;
+    int16_t pv;
+    unsigned s, nibble, i;
+    int16_t out, refOut;
+    uint8_t buf[1];
+
+    for (s = 0; s <= 88; s++) {
+        for (nibble = 0; nibble < 16; nibble++) {
+            for (i = 0; i < 8; i++) {
+                int16_t start = (i == 0) ? INT16_MIN : (i == 1) ? INT16_MAX : (int16_t)rnd();
+
+                /* Codec1_decodeBuff primes the decoder state */
+                si = (int8_t)s;
+                pv = start;
+                buf[0] = 0;
+                Ref_decodeBuff(pcm, buf, 0, &si, &pv);
+                si = (int8_t)s;
+                pv = start;
+                Codec1_decodeBuff(pcm, buf, 0, &si, &pv);
+
+                refOut = Ref_decodeSingle((uint8_t)nibble);
+                out = Codec1_decodeSingle((uint8_t)nibble);
+                vectors++;
+                if (out != refOut) {
+                    fail("decodeSingle", s, nibble);
+                }
+            }
+        }
+    }
+
+    makeSignal(pcm, MAX_SAMPLES, 2);
+    si = 0;
+    pv = 0;
+    Ref_encodeBuff(buf, pcm, 0, &si, &pv);
+    Codec1_encodeBuff(buf, pcm, 0, &si, &pv);
+    for (i = 0; i < MAX_SAMPLES; i++) {
+        vectors++;
+        if (Codec1_encodeSingle(pcm[i]) != Ref_encodeSingle(pcm[i])) {
+            fail("encodeSingle", 0, i);
+            break;
+        }
+    }
+}
+
+/*
+ *  ======== testStereo ========
+ *  Each channel must code as if it were encoded alone by the reference
+ */
+static void testStereo(unsigned vector)
+{
+    static int16_t left[MAX_SAMPLES], right[MAX_SAMPLES];
+    static int16_t pcm[2 * MAX_SAMPLES], out[2 * MAX_SAMPLES];
+    static int16_t refLeft[MAX_SAMPLES], refRight[MAX_SAMPLES];
+    static uint8_t encL[MAX_SAMPLES / 2], encR[MAX_SAMPLES / 2];
+    static uint8_t enc[MAX_SAMPLES];
+    size_t frames = 2 * (1 + rnd() % (MAX_SAMPLES / 2 - 1));
+    Codec1_State state[2] = {{0, 0}, {0, 0}};
+    int8_t siL = 0, siR = 0;
+    int16_t pvL = 0, pvR = 0;
+    size_t i;
+
+    makeSignal(left, frames, vector);
+    makeSignal(right, frames, vector + 3);
+    for (i = 0; i < frames; i++) {
+        pcm[2 * i] = left[i];
+        pcm[2 * i + 1] = right[i];
+    }
+
+    if (Codec1_encodeInterleaved(enc, pcm, 2 * frames, state, 2) != frames) {
+        fail("encodeInterleaved length", vector, 0);
+    }
+    Ref_encodeBuff(encL, left, (int16_t)frames, &siL, &pvL);
+    Ref_encodeBuff(encR, right, (int16_t)frames, &siR, &pvR);
+    if (state[0].si != siL || state[0].pv != pvL || state[1].si != siR || state[1].pv != pvR) {
+        fail("encodeInterleaved state", vector, 0);
+    }
+    for (i = 0; i < frames; i++) {
+        unsigned l = (encL[i / 2] >> ((i & 1) * 4)) & 0xF;
+        unsigned r = (encR[i / 2] >> ((i & 1) * 4)) & 0xF;
+
+        if (enc[i] != (uint8_t)(l | (r << 4))) {
+            fail("encodeInterleaved", vector, i);
+            break;
+        }
+    }
+
+    /* decode, both into a buffer and through a ring in odd sized pieces */
+    state[0].si = state[0].pv = state[1].si = state[1].pv = 0;
+    Codec1_decodeInterleaved(out, enc, frames, state, 2);
+    siL = siR = 0;
+    pvL = pvR = 0;
+    Ref_decodeBuff(refLeft, encL, (unsigned)frames * 2, &siL, &pvL);
+    Ref_decodeBuff(refRight, encR, (unsigned)frames * 2, &siR, &pvR);
+    for (i = 0; i < frames; i++) {
+        if (out[2 * i] != refLeft[i] || out[2 * i + 1] != refRight[i]) {
+            fail("decodeInterleaved", vector, i);
+            break;
+        }
+    }
+
+    {
+        static unsigned char ringData[512];
+        SPSCRing_Object ring;
+        size_t size = (size_t)16 << (rnd() % 6);
+        size_t consumed = 0, got = 0, n;
+
+        SPSCRing_construct(&ring, ringData, size);
+
+        /* start at an odd offset so the fallback copy is exercised too */
+        if (vector & 1) {
+            unsigned char pad;
+
+            SPSCRing_write(&ring, "x", 1);
+            SPSCRing_read(&ring, &pad, 1);
+        }
+
+        state[0].si = state[0].pv = state[1].si = state[1].pv = 0;
+        while (consumed < frames) {
+            n = 1 + rnd() % 40;
+            if (n > frames - consumed) {
+                n = frames - consumed;
+            }
+            consumed += Codec1_decodeToRing(&ring, enc + consumed, n, state, 2);
+
+            /* drain part of the ring, in whole samples */
+            n = SPSCRing_getCount(&ring);
+            if (rnd() & 1) {
+                n = (n / 2) & ~(size_t)1;
+            }
+            got += SPSCRing_read(&ring, (unsigned char *)out + got, n);
+        }
+        got += SPSCRing_read(&ring, (unsigned char *)out + got, SPSCRing_getCount(&ring));
+
+        if (got != frames * 4) {
+            fail("decodeToRing length", vector, got);
+        }
+        for (i = 0; i < frames; i++) {
+            if (out[2 * i] != refLeft[i] || out[2 * i + 1] != refRight[i]) {
+                fail("decodeToRing", vector, i);
+                break;
+            }
+        }
+    }
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + (double)ts.tv_nsec * 1e-9);
+}
+
+/*
+ *  ======== timeCoders ========
+ */
+static void timeCoders(void)
+{
+    static int16_t pcm[MAX_SAMPLES], dec[MAX_SAMPLES];
+    static uint8_t enc[MAX_SAMPLES / 2];
+    const int passes = 2000;
+    double t0, tRefEnc, tEnc, tRefDec, tDec;
+    int8_t si;
+    int16_t pv;
+    int p;
+
+    makeSignal(pcm, MAX_SAMPLES, 5);
+
+    t0 = now();
+    for (p = 0, si = 0, pv = 0; p < passes; p++) {
+        Ref_encodeBuff(enc, pcm, MAX_SAMPLES, &si, &pv);
+    }
+    tRefEnc = now() - t0;
+    t0 = now();
+    for (p = 0, si = 0, pv = 0; p < passes; p++) {
+        Codec1_encodeBuff(enc, pcm, MAX_SAMPLES, &si, &pv);
+    }
+    tEnc = now() - t0;
+    t0 = now();
+    for (p = 0, si = 0, pv = 0; p < passes; p++) {
+        Ref_decodeBuff(dec, enc, MAX_SAMPLES * 2, &si, &pv);
+    }
+    tRefDec = now() - t0;
+    t0 = now();
+    for (p = 0, si = 0, pv = 0; p < passes; p++) {
+        Codec1_decodeBuff(dec, enc, MAX_SAMPLES * 2, &si, &pv);
+    }
+    tDec = now() - t0;
+
+    printf("encode          %.2f ns/sample (reference %.2f)\n",
+        tEnc * 1e9 / passes / MAX_SAMPLES, tRefEnc * 1e9 / passes / MAX_SAMPLES);
+    printf("decode          %.2f ns/sample (reference %.2f)\n",
+        tDec * 1e9 / passes / MAX_SAMPLES, tRefDec * 1e9 / passes / MAX_SAMPLES);
+}
+
+int main(void)
+{
+    unsigned v;
+
+    testSingle();
+    for (v = 0; v < 20000; v++) {
+        testBuffers(v);
+        vectors++;
+    }
+    for (v = 0; v < 2000; v++) {
+        testStereo(v);
+        vectors++;
+    }
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+    timeCoders();
+
+    return (failures != 0);
+}
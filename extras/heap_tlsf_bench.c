@@ -0,0 +1,877 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== heap_tlsf_bench.c ========
+ *  Host test vectors and trace-replay benchmark for
+ *  system/kernel/tirtos/packages/ti/sysbios/heaps/HeapTLSF.c
+ *
+ *  Builds the real HeapTLSF and HeapMem modules against mocked xdc
+ *  runtime headers and replays the same allocation trace through both.
+ *  Every block handed out is filled with a pattern that is checked when
+ *  it is freed, and after every operation the HeapTLSF block chain, free
+ *  lists and bitmaps are checked against the Ref_* walk below. Both heaps
+ *  must coalesce back to a single free block when the trace is done.
+ *
+ *  For each heap the replay reports the requests that failed although
+ *  enough memory was free in total, the fragmentation
+ *  (1 - largest free block / total free) averaged over the steady part
+ *  of the trace, and the mean and worst alloc and free times. HeapMem's
+ *  first-fit walk grows with the number of free blocks; HeapTLSF's
+ *  worst case should stay flat.
+ *
+ *  The built-in traces are generated: radio-style packet buffers, a
+ *  few long lived objects that pin the heap, and the odd large or
+ *  over-aligned request. A recorded trace can be replayed instead by
+ *  passing a file of lines
+ *
+ *      a <id> <size> [<align>]
+ *      f <id>
+ *
+ *  Words are twice as large on a 64-bit host as on the target: the
+ *  HeapTLSF size-class index and per-allocation word double, and
+ *  HeapMem rounds blocks to 16 bytes instead of 8. Absolute numbers
+ *  differ from the device, and HeapTLSF's failure count is overstated
+ *  more than HeapMem's.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o heap_tlsf_bench -Icores/cc13xx \
+ *          -Isystem/kernel/tirtos/packages extras/heap_tlsf_bench.c
+ *      ./heap_tlsf_bench [trace]
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ *  ======== Mocks ========
+ *  Stand-ins for the headers HeapMem.c and HeapTLSF.c include.
+ */
+#define xdc_std__include
+#define xdc_runtime_Error__include
+#define xdc_runtime_Error__localnames__done
+#define xdc_runtime_Assert__include
+#define xdc_runtime_Assert__localnames__done
+#define xdc_runtime_Gate__include
+#define xdc_runtime_Gate__localnames__done
+#define xdc_runtime_Memory__include
+#define xdc_runtime_Memory__localnames__done
+#define xdc_runtime_Startup__include
+#define xdc_runtime_Startup__localnames__done
+#define ti_sysbios_knl_Intrinsics__include
+#define ti_sysbios_knl_Intrinsics__localnames__done
+#define ti_sysbios_heaps_HeapMem__INTERNAL__
+#define ti_sysbios_heaps_HeapTLSF__INTERNAL__
+
+typedef void            Void;
+typedef char            Char;
+typedef int             Int;
+typedef unsigned int    UInt;
+typedef uint8_t         UInt8;
+typedef uint32_t        UInt32;
+typedef unsigned short  Bool;
+typedef uintptr_t       UArg;
+typedef intptr_t        IArg;
+typedef void           *Ptr;
+typedef size_t          SizeT;
+typedef uintptr_t       Memory_Size;
+
+#define TRUE            1
+#define FALSE           0
+
+#define xdc_uargToPtr(a)        ((Ptr)(a))
+
+typedef int Error_Block;
+#define Error_raise(eb, id, a1, a2)     ((void)0)
+
+#define Assert_isTrue(expr, id) \
+    do { if (!(expr)) { printf("assert: %s\n", #expr); exit(2); } } while (0)
+
+#define Gate_enterModule()      ((IArg)0)
+#define Gate_leaveModule(key)   ((void)(key))
+#define Gate_canBlock()         FALSE
+
+#define Intrinsics_maxbit(bits) (63 - __builtin_clzll((uint64_t)(bits)))
+
+typedef struct Memory_Stats {
+    SizeT totalSize;
+    SizeT totalFreeSize;
+    SizeT largestFreeSize;
+} Memory_Stats;
+
+/* ti.sysbios.heaps.HeapMem */
+typedef struct HeapMem_Header {
+    struct HeapMem_Header *next;
+    Memory_Size size;
+} HeapMem_Header;
+
+typedef struct HeapMem_ExtendedStats {
+    Ptr buf;
+    SizeT size;
+} HeapMem_ExtendedStats;
+
+typedef struct HeapMem_Params {
+    SizeT minBlockAlign;
+    Ptr buf;
+    Memory_Size size;
+} HeapMem_Params;
+
+typedef struct HeapMem_Object {
+    Memory_Size align;
+    Char *buf;
+    HeapMem_Header head;
+    SizeT minBlockAlign;
+} HeapMem_Object;
+
+#define HeapMem_reqAlign                sizeof(HeapMem_Header)
+#define HeapMem_primaryHeapBaseAddr     NULL
+#define HeapMem_primaryHeapEndAddr      NULL
+#define HeapMem_Object_count()          0
+#define HeapMem_Object_get(a, i)        ((HeapMem_Object *)NULL)
+#define HeapMem_A_align                 0
+#define HeapMem_A_heapSize              0
+#define HeapMem_A_invalidFree           0
+#define HeapMem_A_zeroBlock             0
+#define HeapMem_E_memory                0
+
+/* ti.sysbios.heaps.HeapTLSF */
+typedef struct HeapTLSF_Header {
+    struct HeapTLSF_Header *prevPhys;
+    Memory_Size size;
+    struct HeapTLSF_Header *nextFree;
+    struct HeapTLSF_Header *prevFree;
+} HeapTLSF_Header;
+
+typedef struct HeapTLSF_ExtendedStats {
+    Ptr buf;
+    SizeT size;
+} HeapTLSF_ExtendedStats;
+
+typedef struct HeapTLSF_Params {
+    Ptr buf;
+    Memory_Size size;
+} HeapTLSF_Params;
+
+typedef struct HeapTLSF_Object {
+    Memory_Size align;
+    Char *buf;
+    Memory_Size size;
+    Memory_Size freeSize;
+    UInt flCount;
+    UInt32 flBitmap;
+    Ptr slBitmap;
+    Ptr freeLists;
+} HeapTLSF_Object;
+
+#define HeapTLSF_Object_count()         0
+#define HeapTLSF_Object_get(a, i)       ((HeapTLSF_Object *)NULL)
+#define HeapTLSF_A_align                0
+#define HeapTLSF_A_heapSize             0
+#define HeapTLSF_A_invalidFree          0
+#define HeapTLSF_A_zeroBlock            0
+#define HeapTLSF_E_memory               0
+
+Void HeapMem_restore(HeapMem_Object *obj);
+Ptr HeapMem_allocUnprotected(HeapMem_Object *obj, SizeT size, SizeT align);
+Void HeapMem_freeUnprotected(HeapMem_Object *obj, Ptr addr, SizeT size);
+Void HeapTLSF_restore(HeapTLSF_Object *obj);
+Ptr HeapTLSF_allocUnprotected(HeapTLSF_Object *obj, SizeT size, SizeT align);
+Void HeapTLSF_freeUnprotected(HeapTLSF_Object *obj, Ptr addr, SizeT size);
+
+#include "../system/kernel/tirtos/packages/ti/sysbios/heaps/HeapMem.c"
+#include "../system/kernel/tirtos/packages/ti/sysbios/heaps/HeapTLSF.c"
+
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, unsigned long long a,
+    unsigned long long b, unsigned long long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %llu got %llu expected %llu\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+static uint64_t nsNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+/*
+ *  ======== Ref_mapping ========
+ *  Size class by definition: the first level is the power of two range
+ *  [2^k, 2^(k+1)) above SMALL_BLOCK, split into SL_COUNT equal parts.
+ */
+static __attribute__((noinline)) void Ref_mapping(Memory_Size size,
+    UInt *fl, UInt *sl)
+{
+    Memory_Size lo = HeapTLSF_SMALL_BLOCK;
+    UInt k = 1;
+
+    if (size < HeapTLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = size / HeapTLSF_ALIGN;
+        return;
+    }
+    while (size >= lo * 2) {
+        lo *= 2;
+        k++;
+    }
+    *fl = k;
+    *sl = (size - lo) / (lo / HeapTLSF_SL_COUNT);
+}
+
+/*
+ *  ======== Ref_classBase ========
+ *  Smallest size in the size class of the given size.
+ */
+static __attribute__((noinline)) Memory_Size Ref_classBase(Memory_Size size)
+{
+    Memory_Size lo = HeapTLSF_SMALL_BLOCK;
+    UInt fl, sl;
+
+    Ref_mapping(size, &fl, &sl);
+    if (fl == 0) {
+        return (sl * HeapTLSF_ALIGN);
+    }
+    while (--fl != 0) {
+        lo *= 2;
+    }
+
+    return (lo + sl * (lo / HeapTLSF_SL_COUNT));
+}
+
+/*
+ *  ======== Ref_check ========
+ *  Walk the physical block chain and check it against the free lists
+ *  and bitmaps. Returns the largest free block, header included.
+ *  prevPhys is only checked where the previous block is free.
+ */
+static __attribute__((noinline)) Memory_Size Ref_check(HeapTLSF_Object *obj,
+    unsigned long long op)
+{
+    HeapTLSF_Header **lists = (HeapTLSF_Header **)obj->freeLists;
+    UInt8 *slBitmap = (UInt8 *)obj->slBitmap;
+    HeapTLSF_Header *block, *prev = NULL, *b;
+    Memory_Size freeSum = 0, largest = 0, size;
+    unsigned numFree = 0, numListed = 0;
+    UInt fl, sl, i;
+    bool prevFree = false, found;
+
+    /* the first block follows the control area */
+    size = obj->flCount * (1 + HeapTLSF_SL_COUNT * sizeof(Ptr));
+    size = (size + HeapTLSF_ALIGN - 1) & ~(Memory_Size)(HeapTLSF_ALIGN - 1);
+    block = (HeapTLSF_Header *)(obj->buf + size);
+
+    while (HeapTLSF_size(block) != 0) {
+        size = HeapTLSF_size(block);
+        if (HeapTLSF_isPrevFree(block) != prevFree) {
+            fail("prevFree", op, (uintptr_t)block, prevFree);
+        }
+        if (prevFree && block->prevPhys != prev) {
+            fail("prevPhys", op, (uintptr_t)block->prevPhys,
+                (uintptr_t)prev);
+        }
+        if ((size & (HeapTLSF_ALIGN - 1)) != 0 || size < HeapTLSF_MINBLOCK) {
+            fail("block size", op, size, HeapTLSF_MINBLOCK);
+            return (0);
+        }
+        if (HeapTLSF_isFree(block)) {
+            if (prevFree) {
+                fail("uncoalesced", op, size, 0);
+            }
+            Ref_mapping(size, &fl, &sl);
+            found = false;
+            for (b = lists[fl * HeapTLSF_SL_COUNT + sl]; b != NULL;
+                    b = b->nextFree) {
+                if (b == block) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                fail("not listed", op, size, fl * HeapTLSF_SL_COUNT + sl);
+            }
+            freeSum += size;
+            numFree++;
+            if (size > largest) {
+                largest = size;
+            }
+        }
+        prevFree = HeapTLSF_isFree(block);
+        prev = block;
+        block = HeapTLSF_nextPhys(block);
+        if ((Char *)block >= obj->buf + obj->size) {
+            fail("chain overrun", op, (uintptr_t)block, 0);
+            return (0);
+        }
+    }
+    if (HeapTLSF_isPrevFree(block) != prevFree ||
+            (prevFree && block->prevPhys != prev)) {
+        fail("end prevPhys", op, (uintptr_t)block->prevPhys, (uintptr_t)prev);
+    }
+
+    for (i = 0; i < obj->flCount * HeapTLSF_SL_COUNT; i++) {
+        fl = i / HeapTLSF_SL_COUNT;
+        sl = i % HeapTLSF_SL_COUNT;
+        if (((slBitmap[fl] >> sl) & 1) != (lists[i] != NULL)) {
+            fail("slBitmap", op, slBitmap[fl], i);
+        }
+        if (sl == 0 && ((obj->flBitmap >> fl) & 1) != (slBitmap[fl] != 0)) {
+            fail("flBitmap", op, obj->flBitmap, fl);
+        }
+        for (b = lists[i]; b != NULL; b = b->nextFree) {
+            numListed++;
+        }
+    }
+    if (numListed != numFree) {
+        fail("listed blocks", op, numListed, numFree);
+    }
+    if (freeSum != obj->freeSize) {
+        fail("freeSize", op, obj->freeSize, freeSum);
+    }
+
+    return (largest);
+}
+
+/*
+ *  ======== Heaps under test ========
+ */
+typedef struct Heap {
+    const char *name;
+    Ptr (*alloc)(Ptr obj, SizeT size, SizeT align);
+    void (*free)(Ptr obj, Ptr addr, SizeT size);
+    void (*getStats)(Ptr obj, Memory_Stats *stats);
+    void (*init)(Ptr obj, Char *buf, SizeT size);
+    Ptr obj;
+} Heap;
+
+static HeapMem_Object memObj;
+static HeapTLSF_Object tlsfObj;
+
+/* Memory_alloc() passes align 0 on as the target's default alignment */
+#define DEFAULT_ALIGN   8
+#define reqAlign(align) ((align) == 0 ? DEFAULT_ALIGN : (align))
+
+static Ptr memAlloc(Ptr obj, SizeT size, SizeT align)
+{
+    return (HeapMem_alloc(obj, size, reqAlign(align), NULL));
+}
+
+static void memFree(Ptr obj, Ptr addr, SizeT size)
+{
+    HeapMem_free(obj, addr, size);
+}
+
+static void memGetStats(Ptr obj, Memory_Stats *stats)
+{
+    HeapMem_getStats(obj, stats);
+}
+
+static void memInit(Ptr obj, Char *buf, SizeT size)
+{
+    HeapMem_Params params = {0, buf, size};
+
+    HeapMem_Instance_init(obj, &params);
+}
+
+static Ptr tlsfAlloc(Ptr obj, SizeT size, SizeT align)
+{
+    return (HeapTLSF_alloc(obj, size, reqAlign(align), NULL));
+}
+
+static void tlsfFree(Ptr obj, Ptr addr, SizeT size)
+{
+    HeapTLSF_free(obj, addr, size);
+}
+
+static void tlsfGetStats(Ptr obj, Memory_Stats *stats)
+{
+    HeapTLSF_getStats(obj, stats);
+}
+
+static void tlsfInit(Ptr obj, Char *buf, SizeT size)
+{
+    HeapTLSF_Params params = {buf, size};
+
+    HeapTLSF_Instance_init(obj, &params);
+}
+
+static Heap heaps[] = {
+    {"HeapMem ", memAlloc, memFree, memGetStats, memInit, &memObj},
+    {"HeapTLSF", tlsfAlloc, tlsfFree, tlsfGetStats, tlsfInit, &tlsfObj},
+};
+
+#define NUM_HEAPS       (sizeof(heaps) / sizeof(heaps[0]))
+#define MAX_HEAP        (64 * 1024)
+
+static Char heapBuf[MAX_HEAP] __attribute__((aligned(64)));
+
+/*
+ *  ======== Traces ========
+ */
+typedef struct Op {
+    uint32_t id;
+    uint32_t size;      /* 0 for a free */
+    uint32_t align;
+} Op;
+
+#define MAX_OPS         400000
+#define MAX_IDS         (MAX_OPS / 2 + 1)
+
+static Op trace[MAX_OPS];
+static unsigned numOps;
+static unsigned numIds;
+
+static uint32_t liveIds[MAX_IDS];
+static uint32_t liveSize[MAX_IDS];
+
+/*
+ *  ======== genTrace ========
+ *  Keep about 'fill' percent of heapSize allocated. Most requests are
+ *  packet sized; one in thirty-two is pinned until the end of the trace,
+ *  up to a tenth of the heap.
+ */
+static void genTrace(uint32_t seed, SizeT heapSize, unsigned fill,
+    unsigned steps)
+{
+    unsigned numLive = 0, numPinned = 0, i, k;
+    SizeT live = 0, pinned = 0, target = heapSize * fill / 100;
+    uint32_t r, size, align, tmp;
+
+    rndState = seed;
+    numOps = 0;
+    numIds = 0;
+
+    for (i = 0; i < steps && numIds < MAX_IDS - 1; i++) {
+        if (numLive == numPinned || (live < target && (rnd() & 3) != 0)) {
+            r = rnd() % 100;
+            if (r < 70) {
+                size = 16 + rnd() % 112;
+            }
+            else if (r < 90) {
+                size = 128 + rnd() % 384;
+            }
+            else if (r < 98) {
+                size = 512 + rnd() % 512;
+            }
+            else {
+                size = 1024 + rnd() % 2048;
+            }
+            align = (rnd() & 31) == 0 ? 32u << (rnd() & 1) : 0;
+
+            trace[numOps++] = (Op){numIds, size, align};
+            liveSize[numIds] = size;
+
+            /* pinned ids are kept at the front of liveIds[] */
+            liveIds[numLive++] = numIds;
+            if ((rnd() & 31) == 0 && pinned + size < heapSize / 10) {
+                pinned += size;
+                tmp = liveIds[numPinned];
+                liveIds[numPinned++] = numIds;
+                liveIds[numLive - 1] = tmp;
+            }
+            live += size;
+            numIds++;
+        }
+        else {
+            k = numPinned + rnd() % (numLive - numPinned);
+            trace[numOps++] = (Op){liveIds[k], 0, 0};
+            live -= liveSize[liveIds[k]];
+            liveIds[k] = liveIds[--numLive];
+        }
+    }
+
+    /* free everything, pinned objects included */
+    while (numLive != 0) {
+        k = rnd() % numLive;
+        trace[numOps++] = (Op){liveIds[k], 0, 0};
+        liveIds[k] = liveIds[--numLive];
+    }
+}
+
+/*
+ *  ======== loadTrace ========
+ */
+static bool loadTrace(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[128];
+    unsigned id, size, align;
+
+    if (f == NULL) {
+        perror(path);
+        return (false);
+    }
+
+    numOps = 0;
+    numIds = 0;
+    while (fgets(line, sizeof(line), f) != NULL && numOps < MAX_OPS) {
+        align = 0;
+        if (sscanf(line, "a %u %u %u", &id, &size, &align) >= 2 &&
+                id < MAX_IDS && size != 0) {
+            trace[numOps++] = (Op){id, size, align};
+        }
+        else if (sscanf(line, "f %u", &id) == 1 && id < MAX_IDS) {
+            trace[numOps++] = (Op){id, 0, 0};
+        }
+        else {
+            continue;
+        }
+        if (id >= numIds) {
+            numIds = id + 1;
+        }
+    }
+    fclose(f);
+
+    return (true);
+}
+
+/*
+ *  ======== replay ========
+ *  With 'check' set, every block is filled and verified and HeapTLSF is
+ *  checked against Ref_check() after each operation; otherwise each
+ *  operation is timed. The trace is deterministic, so the timed replay
+ *  is run TIMED_RUNS times and each operation keeps its fastest time,
+ *  which filters out host preemption without hiding slow paths.
+ */
+typedef struct Result {
+    unsigned fragFails;     /* failed although enough was free in total */
+    unsigned oomFails;
+    double frag;
+    double allocMean, allocP999, allocMax;
+    double freeMean, freeP999, freeMax;
+} Result;
+
+static Ptr ptrs[MAX_IDS];
+static uint32_t sizes[MAX_IDS];
+#define TIMED_RUNS      5
+
+static uint32_t allocNs[MAX_OPS];
+static uint32_t freeNs[MAX_OPS];
+
+static void keepMin(uint32_t *ns, bool first, uint64_t t)
+{
+    if (first || t < *ns) {
+        *ns = (uint32_t)t;
+    }
+}
+
+static int cmpU32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x < y ? -1 : x > y);
+}
+
+static void summarize(uint32_t *ns, unsigned n, double *mean, double *p999,
+    double *max)
+{
+    uint64_t sum = 0;
+    unsigned i;
+
+    *mean = *p999 = *max = 0;
+    if (n == 0) {
+        return;
+    }
+    qsort(ns, n, sizeof(ns[0]), cmpU32);
+    for (i = 0; i < n; i++) {
+        sum += ns[i];
+    }
+    *mean = (double)sum / n;
+    *p999 = ns[(unsigned)((n - 1) * 0.999)];
+    *max = ns[n - 1];
+}
+
+static void replay(Heap *heap, SizeT heapSize, bool check, unsigned run,
+    Result *res)
+{
+    Memory_Stats stats;
+    Memory_Size largest;
+    unsigned i, j, numAlloc = 0, numFree = 0, samples = 0;
+    uint64_t t0;
+    uint8_t *p;
+    SizeT minAlign;
+    const Op *op;
+
+    memset(res, 0, sizeof(*res));
+    memset(ptrs, 0, numIds * sizeof(ptrs[0]));
+    heap->init(heap->obj, heapBuf, heapSize);
+
+    for (i = 0; i < numOps; i++) {
+        op = &trace[i];
+
+        if (op->size != 0) {
+            if (ptrs[op->id] != NULL) {
+                continue;
+            }
+            t0 = nsNow();
+            p = heap->alloc(heap->obj, op->size, op->align);
+            keepMin(&allocNs[numAlloc++], run == 0, nsNow() - t0);
+
+            ptrs[op->id] = p;
+            sizes[op->id] = op->size;
+            if (p == NULL) {
+                heap->getStats(heap->obj, &stats);
+                if (stats.totalFreeSize >= op->size) {
+                    res->fragFails++;
+                }
+                else {
+                    res->oomFails++;
+                }
+            }
+            else if (check) {
+                minAlign = op->align > HeapTLSF_ALIGN ? op->align :
+                    HeapTLSF_ALIGN;
+                if (((uintptr_t)p & (minAlign - 1)) != 0 ||
+                        (Char *)p < heapBuf ||
+                        (Char *)p + op->size > heapBuf + heapSize) {
+                    fail(heap->name, i, (uintptr_t)p, minAlign);
+                }
+                memset(p, (uint8_t)op->id, op->size);
+            }
+        }
+        else {
+            if ((p = ptrs[op->id]) == NULL) {
+                continue;
+            }
+            if (check) {
+                for (j = 0; j < sizes[op->id]; j++) {
+                    if (p[j] != (uint8_t)op->id) {
+                        fail("overwritten", i, p[j], (uint8_t)op->id);
+                        break;
+                    }
+                }
+            }
+            t0 = nsNow();
+            heap->free(heap->obj, p, sizes[op->id]);
+            keepMin(&freeNs[numFree++], run == 0, nsNow() - t0);
+            ptrs[op->id] = NULL;
+        }
+
+        if (check && heap->obj == &tlsfObj) {
+            vectors++;
+            largest = Ref_check(&tlsfObj, i);
+            heap->getStats(heap->obj, &stats);
+            if (stats.largestFreeSize != (largest ?
+                    Ref_classBase(largest) - HeapTLSF_OVERHEAD : 0)) {
+                fail("largestFreeSize", i, stats.largestFreeSize, largest);
+            }
+        }
+
+        /*
+         *  Fragmentation over the middle 80% of the trace. HeapTLSF only
+         *  reports the base of its largest size class, so take the actual
+         *  largest block from the reference walk.
+         */
+        if (i > numOps / 10 && i < numOps - numOps / 10 && (i & 63) == 0) {
+            heap->getStats(heap->obj, &stats);
+            if (heap->obj == &tlsfObj) {
+                largest = Ref_check(&tlsfObj, i);
+                stats.largestFreeSize = largest ?
+                    largest - HeapTLSF_OVERHEAD : 0;
+            }
+            if (stats.totalFreeSize != 0) {
+                res->frag += 1.0 -
+                    (double)stats.largestFreeSize / stats.totalFreeSize;
+                samples++;
+            }
+        }
+    }
+
+    if (samples != 0) {
+        res->frag /= samples;
+    }
+    if (!check && run == TIMED_RUNS - 1) {
+        summarize(allocNs, numAlloc, &res->allocMean, &res->allocP999,
+            &res->allocMax);
+        summarize(freeNs, numFree, &res->freeMean, &res->freeP999,
+            &res->freeMax);
+    }
+
+    /* anything the trace left allocated */
+    for (i = 0; i < numIds; i++) {
+        if (ptrs[i] != NULL) {
+            heap->free(heap->obj, ptrs[i], sizes[i]);
+            ptrs[i] = NULL;
+        }
+    }
+
+    /* all blocks must have coalesced back into one */
+    vectors++;
+    heap->getStats(heap->obj, &stats);
+    if (heap->obj == &tlsfObj) {
+        stats.largestFreeSize = Ref_check(&tlsfObj, numOps);
+    }
+    if (stats.totalFreeSize != stats.largestFreeSize) {
+        fail("coalesce", heapSize, stats.largestFreeSize,
+            stats.totalFreeSize);
+    }
+}
+
+/*
+ *  ======== testLargest ========
+ *  A request for exactly the largestFreeSize getStats() reports must
+ *  succeed, however fragmented the heap is.
+ */
+static void testLargest(Heap *heap, SizeT heapSize, unsigned cases)
+{
+    static Ptr held[256];
+    static SizeT heldSize[256];
+    Memory_Stats stats;
+    unsigned c, i, n;
+    Ptr p;
+
+    for (c = 0; c < cases; c++) {
+        heap->init(heap->obj, heapBuf, heapSize);
+
+        n = rnd() % 256;
+        for (i = 0; i < n; i++) {
+            heldSize[i] = 8 + rnd() % 600;
+            held[i] = heap->alloc(heap->obj, heldSize[i], 0);
+        }
+        for (i = 0; i < n; i++) {
+            if (held[i] != NULL && (rnd() & 1)) {
+                heap->free(heap->obj, held[i], heldSize[i]);
+            }
+        }
+
+        heap->getStats(heap->obj, &stats);
+        if (stats.largestFreeSize == 0) {
+            continue;
+        }
+        vectors++;
+        p = heap->alloc(heap->obj, stats.largestFreeSize, 0);
+        if (p == NULL) {
+            fail(heap->name, c, 0, stats.largestFreeSize);
+        }
+    }
+}
+
+/*
+ *  ======== testMapping ========
+ */
+static void testMapping(void)
+{
+    Memory_Size size;
+    UInt fl, sl, refFl, refSl;
+
+    for (size = HeapTLSF_MINBLOCK; size < (1 << 24); size += HeapTLSF_ALIGN) {
+        vectors++;
+        HeapTLSF_mapping(size, &fl, &sl);
+        Ref_mapping(size, &refFl, &refSl);
+        if (fl != refFl || sl != refSl) {
+            fail("mapping", size, fl * HeapTLSF_SL_COUNT + sl,
+                refFl * HeapTLSF_SL_COUNT + refSl);
+        }
+    }
+}
+
+static void report(const char *what, SizeT heapSize)
+{
+    Result res[NUM_HEAPS];
+    unsigned h, run;
+
+    for (h = 0; h < NUM_HEAPS; h++) {
+        replay(&heaps[h], heapSize, true, 0, &res[h]);
+        for (run = 0; run < TIMED_RUNS; run++) {
+            replay(&heaps[h], heapSize, false, run, &res[h]);
+        }
+    }
+
+    printf("%s, %zu byte heap, %u ops\n", what, heapSize, numOps);
+    for (h = 0; h < NUM_HEAPS; h++) {
+        printf("  %s  failed %5u (+%5u oom)  frag %4.1f%%"
+            "  alloc %5.0f/%5.0f/%6.0f ns  free %5.0f/%5.0f/%6.0f ns\n",
+            heaps[h].name, res[h].fragFails, res[h].oomFails,
+            res[h].frag * 100, res[h].allocMean, res[h].allocP999,
+            res[h].allocMax, res[h].freeMean, res[h].freeP999,
+            res[h].freeMax);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const unsigned fills[] = {50, 70, 90};
+    char what[64];
+    unsigned i;
+
+    testMapping();
+    for (i = 0; i < NUM_HEAPS; i++) {
+        testLargest(&heaps[i], 4096, 2000);
+        testLargest(&heaps[i], 16384, 2000);
+    }
+
+    printf("columns: mean/99.9%%/max\n");
+    if (argc > 1) {
+        if (!loadTrace(argv[1])) {
+            return (2);
+        }
+        report(argv[1], MAX_HEAP);
+    }
+    else {
+        for (i = 0; i < sizeof(fills) / sizeof(fills[0]); i++) {
+            genTrace(1 + i, 16384, fills[i], 200000);
+            snprintf(what, sizeof(what), "generated, %u%% full", fills[i]);
+            report(what, 16384);
+        }
+        genTrace(7, MAX_HEAP, 80, 300000);
+        report("generated, 80% full", MAX_HEAP);
+    }
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+
+    return (failures ? 1 : 0);
+}
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== pdm2pcm_bench.c ========
+ *  Host harness for the PDM2PCM decimator of the PDM driver.
+ *
+ *  Runs a PDM bit stream through ti/drivers/pdm/PDM2PCM.c and reports
+ *  the SINAD of the test tone it contains and the host time per output
+ *  sample. Without -i a tone is synthesized with a 2nd order sigma-delta
+ *  modulator at 1.024 MHz.
+ *
+ *  Build from the repository root:
+ *
+ *      cc -O2 -o pdm2pcm_bench -Isystem/source extras/pdm2pcm_bench.c \
+ *          system/source/ti/drivers/pdm/PDM2PCM.c -lm
+ *
+ *  Usage:
+ *
+ *      pdm2pcm_bench [-r 8|16|32] [-i pdm.raw] [-o pcm.raw] [-f hz]
+ *                    [-a dbfs] [-s seconds] [-g gain]
+ *
+ *      -r  output rate in kHz (default 16)
+ *      -i  recorded PDM stream, raw bytes, earliest bit in the MSB
+ *      -o  write the PCM output, 16-bit little endian
+ *      -f  frequency of the test tone (default 1000; for -i the
+ *          strongest tone is searched if not given)
+ *      -a  level of the synthesized tone in dB of full scale (default -6)
+ *      -s  seconds to synthesize (default 2)
+ *      -g  gain coefficient (default 83, 0 dB; 331 is +12 dB)
+ *
+ *  The time per sample is measured on the host and only useful to
+ *  compare filter variants; measure on the target for absolute numbers.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#include <ti/drivers/pdm/PDM2PCM.h>
+
+#define PDM_RATE        1024000.0
+
+/* PDM words the driver hands over per block */
+#define BLOCK_WORDS     128
+
+/* output samples skipped while the filters settle */
+#define SETTLE          256
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: pdm2pcm_bench [-r 8|16|32] [-i pdm.raw] "
+        "[-o pcm.raw] [-f hz] [-a dbfs] [-s seconds] [-g gain]\n");
+    exit(2);
+}
+
+/*
+ *  ======== synthesize ========
+ *  2nd order sigma-delta modulator, one bit per PDM clock
+ */
+static uint16_t *synthesize(double freq, double dbfs, double seconds,
+    size_t *numWords)
+{
+    size_t n = (size_t)(seconds * PDM_RATE) / (16 * BLOCK_WORDS) *
+        BLOCK_WORDS;
+    uint16_t *words = calloc(n, sizeof(*words));
+    double amp = pow(10.0, dbfs / 20.0);
+    double i1 = 0.0, i2 = 0.0, y = 0.0;
+    size_t bit;
+
+    if (words == NULL) {
+        perror("calloc");
+        exit(1);
+    }
+
+    for (bit = 0; bit < n * 16; bit++) {
+        double x = amp * sin(2.0 * M_PI * freq * (double)bit / PDM_RATE);
+
+        i1 += x - y;
+        i2 += i1 - y;
+        y = (i2 >= 0.0) ? 1.0 : -1.0;
+        if (y > 0.0) {
+            words[bit / 16] |= (uint16_t)(0x8000 >> (bit % 16));
+        }
+    }
+
+    *numWords = n;
+    return (words);
+}
+
+/*
+ *  ======== load ========
+ *  Raw PDM bytes in time order, earliest bit in the MSB
+ */
+static uint16_t *load(const char *path, size_t *numWords)
+{
+    FILE *f = fopen(path, "rb");
+    uint16_t *words;
+    unsigned char pair[2];
+    size_t n = 0;
+    long size;
+
+    if (f == NULL) {
+        perror(path);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    words = malloc((size_t)size / 2 * sizeof(*words) + 1);
+    if (words == NULL) {
+        perror("malloc");
+        exit(1);
+    }
+    while (fread(pair, 1, 2, f) == 2) {
+        words[n++] = (uint16_t)((pair[0] << 8) | pair[1]);
+    }
+    fclose(f);
+
+    *numWords = n / BLOCK_WORDS * BLOCK_WORDS;
+    return (words);
+}
+
+/*
+ *  ======== findTone ========
+ *  Frequency of the strongest DFT bin, 10 Hz steps from 50 Hz to 0.45 fs
+ */
+static double findTone(const int16_t *pcm, size_t n, double fs)
+{
+    double best = 0.0, bestFreq = 1000.0, f;
+    size_t i;
+
+    if (n > 8192) {
+        n = 8192;
+    }
+    for (f = 50.0; f < 0.45 * fs; f += 10.0) {
+        double re = 0.0, im = 0.0, w = 2.0 * M_PI * f / fs;
+
+        for (i = 0; i < n; i++) {
+            re += pcm[i] * cos(w * (double)i);
+            im += pcm[i] * sin(w * (double)i);
+        }
+        if (re * re + im * im > best) {
+            best = re * re + im * im;
+            bestFreq = f;
+        }
+    }
+
+    return (bestFreq);
+}
+
+/*
+ *  ======== sinad ========
+ *  Least-squares fit of a sine at freq plus offset; returns the ratio of
+ *  the sine's power to the power of everything else, in dB.
+ */
+static double sinad(const int16_t *pcm, size_t n, double fs, double freq,
+    double *level)
+{
+    double w = 2.0 * M_PI * freq / fs;
+    double ss = 0, sc = 0, cc = 0, s1 = 0, c1 = 0, ys = 0, yc = 0, y1 = 0;
+    double m[3][4], a, b, c, sig, err;
+    size_t i;
+    int r, k, j;
+
+    for (i = 0; i < n; i++) {
+        double s = sin(w * (double)i), co = cos(w * (double)i);
+
+        ss += s * s; sc += s * co; cc += co * co;
+        s1 += s; c1 += co;
+        ys += pcm[i] * s; yc += pcm[i] * co; y1 += pcm[i];
+    }
+
+    /* normal equations, solved by Gauss-Jordan elimination */
+    m[0][0] = ss; m[0][1] = sc; m[0][2] = s1; m[0][3] = ys;
+    m[1][0] = sc; m[1][1] = cc; m[1][2] = c1; m[1][3] = yc;
+    m[2][0] = s1; m[2][1] = c1; m[2][2] = (double)n; m[2][3] = y1;
+    for (r = 0; r < 3; r++) {
+        for (k = 0; k < 3; k++) {
+            double f = m[k][r] / m[r][r];
+
+            if (k == r) {
+                continue;
+            }
+            for (j = 0; j < 4; j++) {
+                m[k][j] -= f * m[r][j];
+            }
+        }
+    }
+    a = m[0][3] / m[0][0];
+    b = m[1][3] / m[1][1];
+    c = m[2][3] / m[2][2];
+
+    sig = 0.0;
+    err = 0.0;
+    for (i = 0; i < n; i++) {
+        double fit = a * sin(w * (double)i) + b * cos(w * (double)i);
+        double e = pcm[i] - fit - c;
+
+        sig += fit * fit;
+        err += e * e;
+    }
+
+    *level = 10.0 * log10(sig / (double)n / (32768.0 * 32768.0 / 2.0));
+    return (10.0 * log10(sig / err));
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + (double)ts.tv_nsec * 1e-9);
+}
+
+int main(int argc, char *argv[])
+{
+    int32_t coeffs[PDM2PCM_DEFAULT_COEFFS_LEN];
+    PDM2PCM_State state;
+    PDM2PCM_Rate rate = PDM2PCM_RATE_16K;
+    const char *in = NULL, *outPath = NULL;
+    double freq = 0.0, dbfs = -6.0, seconds = 2.0, fs, t0, t1, level, snr;
+    long gain = 83;
+    uint16_t *pdm;
+    int16_t *pcm;
+    size_t numWords, numSamples, n, w;
+    int passes, p, opt;
+#ifdef HAVE_TSC
+    unsigned long long c0, c1;
+#endif
+
+    while ((opt = getopt(argc, argv, "r:i:o:f:a:s:g:h")) != -1) {
+        switch (opt) {
+            case 'r':
+                switch (atoi(optarg)) {
+                    case 8:  rate = PDM2PCM_RATE_8K; break;
+                    case 16: rate = PDM2PCM_RATE_16K; break;
+                    case 32: rate = PDM2PCM_RATE_32K; break;
+                    default: usage();
+                }
+                break;
+            case 'i': in = optarg; break;
+            case 'o': outPath = optarg; break;
+            case 'f': freq = atof(optarg); break;
+            case 'a': dbfs = atof(optarg); break;
+            case 's': seconds = atof(optarg); break;
+            case 'g': gain = atol(optarg); break;
+            default: usage();
+        }
+    }
+    fs = PDM_RATE / 16.0 / (double)rate;
+
+    if (in != NULL) {
+        pdm = load(in, &numWords);
+    }
+    else {
+        if (freq == 0.0) {
+            freq = 1000.0;
+        }
+        pdm = synthesize(freq, dbfs, seconds, &numWords);
+    }
+
+    numSamples = PDM2PCM_SAMPLES(rate, numWords);
+    if (numSamples <= SETTLE) {
+        fprintf(stderr, "pdm2pcm_bench: input too short\n");
+        return (1);
+    }
+    pcm = malloc(numSamples * sizeof(*pcm));
+    if (pcm == NULL) {
+        perror("malloc");
+        return (1);
+    }
+
+    memcpy(coeffs, PDM2PCM_defaultCoeffs, sizeof(coeffs));
+    coeffs[0] = (int32_t)gain;
+
+    /* enough passes for a stable time */
+    passes = 1;
+    if (numWords < 4000000) {
+        passes = (int)(4000000 / numWords) + 1;
+    }
+
+    t0 = now();
+#ifdef HAVE_TSC
+    c0 = __rdtsc();
+#endif
+    for (p = 0; p < passes; p++) {
+        PDM2PCM_init(&state, rate, coeffs);
+        for (w = 0, n = 0; w < numWords; w += BLOCK_WORDS) {
+            n += PDM2PCM_process(&state, pdm + w, BLOCK_WORDS, pcm + n);
+        }
+    }
+#ifdef HAVE_TSC
+    c1 = __rdtsc();
+#endif
+    t1 = now();
+
+    if (outPath != NULL) {
+        FILE *f = fopen(outPath, "wb");
+
+        if (f == NULL) {
+            perror(outPath);
+            return (1);
+        }
+        for (n = 0; n < numSamples; n++) {
+            fputc(pcm[n] & 0xFF, f);
+            fputc((pcm[n] >> 8) & 0xFF, f);
+        }
+        fclose(f);
+    }
+
+    if (freq == 0.0) {
+        freq = findTone(pcm + SETTLE, numSamples - SETTLE, fs);
+    }
+    snr = sinad(pcm + SETTLE, numSamples - SETTLE, fs, freq, &level);
+
+    printf("output rate     %.0f Hz (%zu samples)\n", fs, numSamples);
+    printf("tone            %.1f Hz at %.1f dBFS\n", freq, level);
+    printf("SINAD           %.1f dB\n", snr);
+    printf("clipped         %u samples\n", (unsigned)state.clipCount);
+    printf("host time       %.1f ns/sample\n",
+        (t1 - t0) * 1e9 / ((double)numSamples * passes));
+#ifdef HAVE_TSC
+    printf("host cycles     %.0f TSC/sample\n",
+        (double)(c1 - c0) / ((double)numSamples * passes));
+#endif
+
+    free(pcm);
+    free(pdm);
+
+    return (0);
+}
@@ -0,0 +1,1069 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== profile_vectors.c ========
+ *  Host test vectors for cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_profile.c
+ *
+ *  Builds the real profiler against a mocked GPTimer, kernel and cycle
+ *  counter, then runs a random schedule through it: Tasks switch, Swis
+ *  and Hwis nest up to past the depth the profiler tracks, and the
+ *  sampler timer times out every period and interrupts whatever Task or
+ *  Swi is running once no Hwi is in the way, as the lowest priority Hwi
+ *  does. The cycle counter wraps during every run.
+ *
+ *  The cycles the hooks charge to each thread, the samples each one gets,
+ *  its switch count, CPU share and run time are checked against what the
+ *  schedule gave it, with the threads past the end of the table summed
+ *  in the last slot. The latency is checked against the time since the
+ *  timer's last timeout, and the timer against the requested rate. The
+ *  Task state, priority and stack high-water mark must come from
+ *  Task_stat() of the live Task, with a mock stack the schedule fills to
+ *  a known depth, and a deleted Task must show as done. Runs cover the
+ *  sampler without the hooks, the hooks without a sampler and with no
+ *  free timer, the sample rate clamps, profileReset() and profileEnd().
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o profile_vectors -Icores/cc13xx -Isystem/source \
+ *          -Isystem/kernel/tirtos/packages extras/profile_vectors.c
+ *      ./profile_vectors
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *  ======== Mocks ========
+ *  Stand-ins for the headers wiring_profile.c includes.
+ */
+#define ti_drivers_timer_GPTIMERCC26XX__include
+#define ti_sysbios_BIOS__include
+#define ti_sysbios_BIOS__localnames__done
+#define ti_sysbios_knl_Task__include
+#define ti_sysbios_knl_Task__localnames__done
+#define ti_sysbios_knl_Swi__include
+#define ti_sysbios_knl_Swi__localnames__done
+#define ti_sysbios_family_arm_m3_Hwi__include
+#define ti_sysbios_family_arm_m3_Hwi__localnames__done
+#define ti_sysbios_utils_Load__include
+#define ti_sysbios_utils_Load__localnames__done
+#define xdc_runtime_Types__include
+#define xdc_runtime_Types__localnames__done
+#define __HW_TYPES_H__
+#define __HW_MEMMAP_H__
+#define __HW_CPU_DWT_H__
+
+/* small enough for the schedule below to overflow it */
+#define PROFILE_MAX_THREADS     8
+
+#define CPU_FREQ                48000000
+#define STACK_SIZE              512
+#define ISR_STACK_PEAK          300
+#define ISR_STACK_SIZE          768
+#define CPU_LOAD                37
+
+#define TRUE                    1
+
+typedef unsigned int UInt;
+
+typedef struct Types_FreqHz {
+    uint32_t hi;
+    uint32_t lo;
+} Types_FreqHz;
+
+#define CPU_DWT_BASE            0xE0001000
+#define CPU_DWT_O_CYCCNT        0x00000004
+#define HWREG(x)                mockRead(x)
+
+static uint32_t mockRead(uint32_t addr);
+
+static void BIOS_getCpuFreq(Types_FreqHz *freq)
+{
+    freq->hi = 0;
+    freq->lo = CPU_FREQ;
+}
+
+static unsigned hwiDisabled;
+static unsigned taskDisabled;
+
+static inline uint32_t Hwi_disable(void)
+{
+    return (hwiDisabled++);
+}
+
+static inline void Hwi_restore(uint32_t key)
+{
+    hwiDisabled = key;
+}
+
+static UInt Task_disable(void)
+{
+    return (taskDisabled++);
+}
+
+static void Task_restore(UInt key)
+{
+    taskDisabled = key;
+}
+
+typedef struct Hwi_Object {
+    const char *name;
+} Hwi_Object;
+
+typedef Hwi_Object *Hwi_Handle;
+
+typedef struct Hwi_StackInfo {
+    size_t hwiStackPeak;
+    size_t hwiStackSize;
+    void *hwiStackBase;
+} Hwi_StackInfo;
+
+static bool Hwi_getStackInfo(Hwi_StackInfo *info, bool computeStackDepth)
+{
+    (void)computeStackDepth;
+    info->hwiStackPeak = ISR_STACK_PEAK;
+    info->hwiStackSize = ISR_STACK_SIZE;
+    info->hwiStackBase = NULL;
+    return (false);
+}
+
+#define Hwi_Handle_name(h)      ((h)->name)
+
+typedef struct Swi_Object {
+    const char *name;
+} Swi_Object;
+
+typedef Swi_Object *Swi_Handle;
+
+#define Swi_Handle_name(h)      ((h)->name)
+
+static Swi_Handle Swi_self(void);
+
+typedef enum Task_Mode {
+    Task_Mode_RUNNING,
+    Task_Mode_READY,
+    Task_Mode_BLOCKED,
+    Task_Mode_TERMINATED,
+    Task_Mode_INACTIVE
+} Task_Mode;
+
+/* the stack is filled with 0xbe at creation, as the kernel does */
+typedef struct Task_Object {
+    const char *name;
+    int priority;
+    Task_Mode mode;
+    uint8_t stack[STACK_SIZE];
+    struct Task_Object *next;   /* created at run time */
+    bool deleted;
+} Task_Object;
+
+typedef Task_Object *Task_Handle;
+
+typedef struct Task_Stat {
+    int priority;
+    void *stack;
+    size_t stackSize;
+    void *stackHeap;
+    void *env;
+    Task_Mode mode;
+    void *sp;
+    size_t used;
+} Task_Stat;
+
+#define NUM_STATIC_TASKS        4
+#define NUM_DYNAMIC_TASKS       2
+
+static Task_Object staticTasks[NUM_STATIC_TASKS];
+static Task_Object dynamicTasks[NUM_DYNAMIC_TASKS];
+static Task_Object *dynamicList;
+
+#define Task_Handle_name(t)     ((t)->name)
+
+static Task_Handle Task_self(void);
+
+static int Task_Object_count(void)
+{
+    return (NUM_STATIC_TASKS);
+}
+
+static Task_Handle Task_Object_get(void *array, int i)
+{
+    (void)array;
+    return (&staticTasks[i]);
+}
+
+static Task_Handle Task_Object_first(void)
+{
+    return (dynamicList);
+}
+
+static Task_Handle Task_Object_next(Task_Handle task)
+{
+    return (task->next);
+}
+
+static void Task_stat(Task_Handle task, Task_Stat *stat)
+{
+    size_t unused = 0;
+
+    if (taskDisabled == 0 || task->deleted) {
+        printf("FAIL Task_stat() of a deleted Task or unlocked\n");
+        exit(1);
+    }
+
+    while (unused < STACK_SIZE && task->stack[unused] == 0xbe) {
+        unused++;
+    }
+
+    memset(stat, 0, sizeof(*stat));
+    stat->priority = task->priority;
+    stat->stack = task->stack;
+    stat->stackSize = STACK_SIZE;
+    stat->mode = task->mode;
+    stat->used = STACK_SIZE - unused;
+}
+
+static uint32_t Load_getCPULoad(void)
+{
+    return (CPU_LOAD);
+}
+
+/* GPTimer driver */
+typedef uint32_t GPTimerCC26XX_IntMask;
+
+#define GPT_INT_TIMEOUT                 (1 << 0)
+#define GPT_CONFIG_16BIT                1
+#define GPT_MODE_PERIODIC_UP            2
+#define GPTimerCC26XX_DEBUG_STALL_OFF   0
+
+typedef struct GPTimerCC26XX_Params {
+    int width;
+    int mode;
+    int debugStallMode;
+} GPTimerCC26XX_Params;
+
+typedef struct GPTimerCC26XX_Object *GPTimerCC26XX_Handle;
+typedef void (*GPTimerCC26XX_HwiFxn)(GPTimerCC26XX_Handle handle,
+    GPTimerCC26XX_IntMask mask);
+
+typedef struct GPTimerCC26XX_Object {
+    bool open;
+    bool running;
+    GPTimerCC26XX_Params params;
+    uint32_t load;
+    GPTimerCC26XX_IntMask mask;
+    GPTimerCC26XX_HwiFxn fxn;
+} GPTimerCC26XX_Object;
+
+#define NUM_TIMERS      8
+
+static GPTimerCC26XX_Object timers[NUM_TIMERS];
+static uint64_t lastTimeout;            /* the timer restarted from 0 here */
+static uint64_t nextTimeout;
+
+static void GPTimerCC26XX_Params_init(GPTimerCC26XX_Params *params)
+{
+    memset(params, 0xff, sizeof(*params));
+}
+
+static GPTimerCC26XX_Handle GPTimerCC26XX_open(unsigned index,
+    const GPTimerCC26XX_Params *params)
+{
+    if (timers[index].open) {
+        return (NULL);
+    }
+    timers[index].open = true;
+    timers[index].params = *params;
+    return (&timers[index]);
+}
+
+static void GPTimerCC26XX_close(GPTimerCC26XX_Handle handle)
+{
+    handle->open = false;
+}
+
+static void GPTimerCC26XX_setLoadValue(GPTimerCC26XX_Handle handle,
+    uint32_t value)
+{
+    handle->load = value;
+}
+
+static void GPTimerCC26XX_registerInterrupt(GPTimerCC26XX_Handle handle,
+    GPTimerCC26XX_HwiFxn fxn, GPTimerCC26XX_IntMask mask)
+{
+    handle->fxn = fxn;
+    handle->mask = mask;
+}
+
+static void GPTimerCC26XX_unregisterInterrupt(GPTimerCC26XX_Handle handle)
+{
+    handle->fxn = NULL;
+}
+
+static uint64_t now;                    /* the cycle counter, unwrapped */
+
+static void GPTimerCC26XX_start(GPTimerCC26XX_Handle handle)
+{
+    handle->running = true;
+    lastTimeout = now;
+    nextTimeout = now + handle->load + 1;
+}
+
+static void GPTimerCC26XX_stop(GPTimerCC26XX_Handle handle)
+{
+    handle->running = false;
+}
+
+static uint32_t GPTimerCC26XX_getValue(GPTimerCC26XX_Handle handle)
+{
+    (void)handle;
+    return ((uint32_t)(now - lastTimeout));
+}
+
+void profileTaskSwitch(Task_Handle prev, Task_Handle next);
+void profileSwiBegin(Swi_Handle swi);
+void profileSwiEnd(Swi_Handle swi);
+void profileHwiBegin(Hwi_Handle hwi);
+void profileHwiEnd(Hwi_Handle hwi);
+
+#include "../cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_profile.c"
+
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, long long a, long long b, long long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %lld got %lld expected %lld\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+static uint32_t mockRead(uint32_t addr)
+{
+    if (addr != CPU_DWT_BASE + CPU_DWT_O_CYCCNT) {
+        printf("FAIL read of 0x%08x\n", (unsigned)addr);
+        exit(1);
+    }
+
+    return ((uint32_t)now);
+}
+
+/*
+ *  ======== Schedule simulator ========
+ *  Every thread the schedule runs, with what the profiler should have
+ *  recorded for it. Level 0 of the nesting stack is the current Task.
+ */
+#define NUM_TASKS       (NUM_STATIC_TASKS + NUM_DYNAMIC_TASKS)
+#define NUM_SWIS        3
+#define NUM_HWIS        3
+#define SAMPLER         (NUM_TASKS + NUM_SWIS + NUM_HWIS)
+#define NUM_SIM         (SAMPLER + 1)
+#define MAX_NEST        (PROFILE_NEST + 2)
+
+typedef struct SimThread {
+    void *handle;
+    uint8_t kind;
+    bool deleted;
+    uint64_t cycles;
+    uint32_t samples;
+    uint32_t switches;
+    uint32_t stackPeak;
+} SimThread;
+
+static SimThread sim[NUM_SIM];
+static Swi_Object swis[NUM_SWIS];
+static Hwi_Object hwis[NUM_HWIS + 1];
+
+static int nest;
+static int stack[MAX_NEST + 1];         /* and the sampler on top */
+static bool hooks;                      /* the cfg hooks are installed */
+static bool everHooked;
+static bool recording;                  /* between profileBegin() and End */
+static bool masked;                     /* interrupts disabled */
+static bool pending;                    /* sampler timeout not yet taken */
+static uint64_t uncharged;              /* cycles since the last hook */
+static GPTimerCC26XX_Handle simTimer;
+static uint32_t expectSamples;
+static uint32_t expectLatencyMax;
+static uint64_t expectLatencySum;
+
+static Task_Handle Task_self(void)
+{
+    return ((Task_Handle)sim[stack[0]].handle);
+}
+
+static Swi_Handle Swi_self(void)
+{
+    int i;
+
+    for (i = nest; i > 0; i--) {
+        if (sim[stack[i]].kind == PROFILE_KIND_SWI) {
+            return ((Swi_Handle)sim[stack[i]].handle);
+        }
+    }
+
+    return (NULL);
+}
+
+static bool hwiActive(void)
+{
+    int i;
+
+    for (i = nest; i > 0; i--) {
+        if (sim[stack[i]].kind == PROFILE_KIND_HWI) {
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+static void checkKeys(const char *what)
+{
+    vectors++;
+    if (hwiDisabled != 0 || taskDisabled != 0) {
+        fail(what, nest, hwiDisabled + taskDisabled, 0);
+    }
+}
+
+/* the hooks charge the cycles since the last one to the thread on top */
+static void charge(void)
+{
+    int top = nest < PROFILE_NEST ? nest : PROFILE_NEST - 1;
+
+    if (recording && hooks) {
+        sim[stack[top]].cycles += uncharged;
+    }
+    uncharged = 0;
+}
+
+static void push(int t)
+{
+    charge();
+    stack[++nest] = t;
+    if (recording && hooks) {
+        sim[t].switches++;
+        everHooked = true;
+    }
+
+    if (!hooks) {
+        return;
+    }
+    if (sim[t].kind == PROFILE_KIND_SWI) {
+        profileSwiBegin((Swi_Handle)sim[t].handle);
+    }
+    else {
+        profileHwiBegin((Hwi_Handle)sim[t].handle);
+    }
+    checkKeys("begin hook");
+}
+
+static void pop(void)
+{
+    int t = stack[nest];
+
+    charge();
+    nest--;
+
+    if (!hooks) {
+        return;
+    }
+    if (sim[t].kind == PROFILE_KIND_SWI) {
+        profileSwiEnd((Swi_Handle)sim[t].handle);
+    }
+    else {
+        profileHwiEnd((Hwi_Handle)sim[t].handle);
+    }
+    checkKeys("end hook");
+}
+
+static void touchStack(int t)
+{
+    Task_Object *task = (Task_Object *)sim[t].handle;
+    uint32_t depth;
+
+    /* mostly shallow, now and then deep */
+    depth = 16 + (rnd() % (STACK_SIZE - 16)) * (rnd() % STACK_SIZE)
+        / STACK_SIZE;
+    memset(task->stack + STACK_SIZE - depth, 0x5a, depth);
+    if (depth > sim[t].stackPeak) {
+        sim[t].stackPeak = depth;
+    }
+}
+
+static void advance(uint32_t cycles);
+
+/* the sampler Hwi, taken when no other Hwi is running */
+static void takeSample(void)
+{
+    uint32_t latency;
+    int t;
+
+    pending = false;
+
+    /* charged to the Swi it interrupted, else to the Task */
+    t = stack[0];
+    if (Swi_self() != NULL) {
+        for (t = nest; sim[stack[t]].kind != PROFILE_KIND_SWI; t--) {
+        }
+        t = stack[t];
+    }
+
+    push(SAMPLER);
+    advance(rnd() % 40);
+
+    latency = (uint32_t)(now - lastTimeout);
+    simTimer->fxn(simTimer, GPT_INT_TIMEOUT);
+    checkKeys("sample");
+    sim[t].samples++;
+    expectSamples++;
+    expectLatencySum += latency;
+    if (latency > expectLatencyMax) {
+        expectLatencyMax = latency;
+    }
+
+    advance(rnd() % 40);
+    pop();
+}
+
+/* run for a number of cycles, timing out the sampler on the way */
+static void advance(uint32_t cycles)
+{
+    uint64_t step;
+
+    while (cycles > 0) {
+        step = cycles;
+        if (simTimer != NULL && simTimer->running
+            && nextTimeout - now < step) {
+            step = nextTimeout - now;
+        }
+        now += step;
+        uncharged += step;
+        cycles -= step;
+
+        if (simTimer != NULL && simTimer->running && now == nextTimeout) {
+            pending = true;
+            lastTimeout = now;
+            nextTimeout = now + simTimer->load + 1;
+        }
+    }
+
+    if (pending && !masked && !hwiActive()) {
+        takeSample();
+    }
+}
+
+static void switchTask(void)
+{
+    int prev = stack[0];
+    int next;
+
+    do {
+        next = rnd() % NUM_TASKS;
+    } while (next == prev || sim[next].deleted
+        || ((Task_Object *)sim[next].handle)->mode == Task_Mode_TERMINATED);
+
+    ((Task_Object *)sim[prev].handle)->mode =
+        rnd() & 1 ? Task_Mode_READY : Task_Mode_BLOCKED;
+    ((Task_Object *)sim[next].handle)->mode = Task_Mode_RUNNING;
+
+    charge();
+    stack[0] = next;
+    if (recording && hooks) {
+        sim[next].switches++;
+        everHooked = true;
+    }
+    if (hooks) {
+        profileTaskSwitch((Task_Handle)sim[prev].handle,
+            (Task_Handle)sim[next].handle);
+        checkKeys("switch hook");
+    }
+
+    touchStack(next);
+}
+
+static void step(void)
+{
+    uint32_t r = rnd() % 16;
+
+    if (r < 6) {
+        advance(1 + rnd() % 3000);
+    }
+    else if (r < 7) {
+        masked = true;
+        advance(1 + rnd() % 2000);
+        masked = false;
+        advance(0);
+    }
+    else if (r < 9) {
+        if (nest < MAX_NEST - 1) {
+            push(NUM_TASKS + NUM_SWIS + rnd() % NUM_HWIS);
+        }
+    }
+    else if (r < 11) {
+        if (nest < MAX_NEST - 1 && !hwiActive()) {
+            push(NUM_TASKS + rnd() % NUM_SWIS);
+        }
+    }
+    else if (r < 14) {
+        if (nest > 0) {
+            pop();
+            advance(0);
+        }
+    }
+    else if (r < 15) {
+        if (nest == 0) {
+            switchTask();
+        }
+    }
+    else if (nest == 0) {
+        touchStack(stack[0]);
+    }
+}
+
+static void unwind(void)
+{
+    while (nest > 0) {
+        advance(1 + rnd() % 100);
+        pop();
+    }
+}
+
+static void resetExpected(void)
+{
+    int i;
+
+    for (i = 0; i < NUM_SIM; i++) {
+        sim[i].cycles = 0;
+        sim[i].samples = 0;
+        sim[i].switches = 0;
+    }
+    expectSamples = 0;
+    expectLatencyMax = 0;
+    expectLatencySum = 0;
+    uncharged = 0;
+}
+
+static void initThreads(void)
+{
+    static const char *taskNames[NUM_TASKS] = {
+        "loop", "serial", NULL, "radio", "worker", NULL
+    };
+    static const char *swiNames[NUM_SWIS] = {"clock", NULL, "uart"};
+    static const char *hwiNames[NUM_HWIS + 1] = {
+        "rtc", "gpio", NULL, "sampler"
+    };
+    Task_Object *task;
+    int i;
+
+    for (i = 0; i < NUM_TASKS; i++) {
+        task = i < NUM_STATIC_TASKS ? &staticTasks[i]
+            : &dynamicTasks[i - NUM_STATIC_TASKS];
+        task->name = taskNames[i];
+        task->priority = 1 + i % 4;
+        task->mode = Task_Mode_READY;
+        memset(task->stack, 0xbe, STACK_SIZE);
+        sim[i].handle = task;
+        sim[i].kind = PROFILE_KIND_TASK;
+    }
+    dynamicList = &dynamicTasks[0];
+    dynamicTasks[0].next = &dynamicTasks[1];
+    dynamicTasks[1].next = NULL;
+
+    for (i = 0; i < NUM_SWIS; i++) {
+        swis[i].name = swiNames[i];
+        sim[NUM_TASKS + i].handle = &swis[i];
+        sim[NUM_TASKS + i].kind = PROFILE_KIND_SWI;
+    }
+    for (i = 0; i <= NUM_HWIS; i++) {
+        hwis[i].name = hwiNames[i];
+        sim[NUM_TASKS + NUM_SWIS + i].handle = &hwis[i];
+        sim[NUM_TASKS + NUM_SWIS + i].kind = PROFILE_KIND_HWI;
+    }
+
+    /* the Task deleted later is the first one the profiler sees */
+    stack[0] = NUM_TASKS - 1;
+    dynamicTasks[NUM_DYNAMIC_TASKS - 1].mode = Task_Mode_RUNNING;
+    touchStack(NUM_TASKS - 1);
+}
+
+/* the last Task created goes away; the one before it runs to the end */
+static void deleteTasks(void)
+{
+    int t;
+
+    for (t = NUM_TASKS - 2; t < NUM_TASKS; t++) {
+        while (stack[0] == t) {
+            switchTask();
+        }
+    }
+    ((Task_Object *)sim[NUM_TASKS - 2].handle)->mode = Task_Mode_TERMINATED;
+    sim[NUM_TASKS - 1].deleted = true;
+    dynamicTasks[1].deleted = true;
+    dynamicTasks[0].next = NULL;
+}
+
+/*
+ *  ======== checkStat ========
+ *  Check one table entry against the sum of the threads it stands for
+ */
+static void checkStat(unsigned index, const ProfileStat *st,
+    const SimThread *expect, int t, uint64_t totalCycles, uint32_t period)
+{
+    uint64_t runCycles;
+    uint32_t permille;
+    Task_Object *task;
+    int state;
+
+    vectors++;
+
+    if (st->samples != expect->samples) {
+        fail("samples", index, st->samples, expect->samples);
+    }
+    if (st->cycles != expect->cycles) {
+        fail("cycles", index, st->cycles, expect->cycles);
+    }
+    if (st->switches != expect->switches) {
+        fail("switches", index, st->switches, expect->switches);
+    }
+
+    if (expectSamples != 0) {
+        permille = (uint64_t)expect->samples * 1000 / expectSamples;
+    }
+    else if (totalCycles != 0) {
+        permille = expect->cycles * 1000 / totalCycles;
+    }
+    else {
+        permille = 0;
+    }
+    if (st->permille != permille) {
+        fail("permille", index, st->permille, permille);
+    }
+
+    runCycles = everHooked ? expect->cycles
+        : (uint64_t)expect->samples * period;
+    if (st->runMicros != (uint32_t)(runCycles / (CPU_FREQ / 1000000))) {
+        fail("runMicros", index, st->runMicros,
+            runCycles / (CPU_FREQ / 1000000));
+    }
+
+    if (t < 0) {
+        if (st->handle != NULL || st->name != NULL
+            || st->state != PROFILE_STATE_NONE || st->priority != -1) {
+            fail("other slot", index, st->state, PROFILE_STATE_NONE);
+        }
+        return;
+    }
+
+    if (st->kind != sim[t].kind) {
+        fail("kind", index, st->kind, sim[t].kind);
+    }
+
+    if (sim[t].kind != PROFILE_KIND_TASK) {
+        const char *name = sim[t].kind == PROFILE_KIND_SWI
+            ? ((Swi_Object *)sim[t].handle)->name
+            : ((Hwi_Object *)sim[t].handle)->name;
+
+        if (st->name != name || st->state != PROFILE_STATE_NONE
+            || st->priority != -1 || st->stackSize != 0) {
+            fail("swi/hwi fields", index, st->state, PROFILE_STATE_NONE);
+        }
+        return;
+    }
+
+    task = (Task_Object *)sim[t].handle;
+
+    if (sim[t].deleted) {
+        if (st->state != PROFILE_STATE_DONE || st->name != NULL
+            || st->priority != -1 || st->stackUsed != 0
+            || st->stackSize != 0) {
+            fail("deleted task", index, st->state, PROFILE_STATE_DONE);
+        }
+        return;
+    }
+
+    switch (task->mode) {
+        case Task_Mode_RUNNING:
+            state = PROFILE_STATE_RUNNING;
+            break;
+        case Task_Mode_READY:
+            state = PROFILE_STATE_READY;
+            break;
+        case Task_Mode_BLOCKED:
+            state = PROFILE_STATE_BLOCKED;
+            break;
+        default:
+            state = PROFILE_STATE_DONE;
+            break;
+    }
+    if (st->state != state) {
+        fail("task state", index, st->state, state);
+    }
+    if (st->name != task->name) {
+        fail("task name", index, 0, 1);
+    }
+    if (st->priority != task->priority) {
+        fail("task priority", index, st->priority, task->priority);
+    }
+    if (st->stackUsed != sim[t].stackPeak) {
+        fail("stack high-water", index, st->stackUsed, sim[t].stackPeak);
+    }
+    if (st->stackSize != STACK_SIZE) {
+        fail("stack size", index, st->stackSize, STACK_SIZE);
+    }
+}
+
+/*
+ *  ======== checkProfile ========
+ *  Check every table entry and the summary
+ */
+static void checkProfile(uint32_t period)
+{
+    SimThread other;
+    ProfileSummary sum;
+    ProfileStat st;
+    uint64_t totalCycles = 0;
+    bool listed[NUM_SIM];
+    bool haveOther = false;
+    uint32_t avg;
+    unsigned i;
+    int t;
+
+    memset(listed, 0, sizeof(listed));
+    memset(&other, 0, sizeof(other));
+
+    for (t = 0; t < NUM_SIM; t++) {
+        totalCycles += sim[t].cycles;
+    }
+
+    /* first pass: which threads have a slot of their own */
+    for (i = 0; profileGet(i, &st); i++) {
+        checkKeys("profileGet");
+        if (st.kind == PROFILE_KIND_OTHER) {
+            haveOther = true;
+            continue;
+        }
+        for (t = 0; t < NUM_SIM && sim[t].handle != st.handle; t++) {
+        }
+        if (t == NUM_SIM || listed[t]) {
+            fail("unknown or repeated handle", i, t, 0);
+            continue;
+        }
+        listed[t] = true;
+    }
+    checkKeys("profileGet");
+    if (i > PROFILE_MAX_THREADS || (haveOther && i != PROFILE_MAX_THREADS)) {
+        fail("table size", 0, i, PROFILE_MAX_THREADS);
+    }
+
+    for (t = 0; t < NUM_SIM; t++) {
+        if (!listed[t]) {
+            other.cycles += sim[t].cycles;
+            other.samples += sim[t].samples;
+            other.switches += sim[t].switches;
+        }
+    }
+    if (!haveOther && (other.cycles != 0 || other.samples != 0
+        || other.switches != 0)) {
+        fail("unlisted thread ran", 0, other.switches, 0);
+    }
+
+    for (i = 0; profileGet(i, &st); i++) {
+        if (st.kind == PROFILE_KIND_OTHER) {
+            checkStat(i, &st, &other, -1, totalCycles, period);
+            continue;
+        }
+        for (t = 0; t < NUM_SIM && sim[t].handle != st.handle; t++) {
+        }
+        if (t < NUM_SIM) {
+            checkStat(i, &st, &sim[t], t, totalCycles, period);
+        }
+    }
+    checkKeys("profileGet");
+
+    profileSummary(&sum);
+    checkKeys("profileSummary");
+    vectors++;
+
+    if (sum.samples != expectSamples) {
+        fail("summary samples", 0, sum.samples, expectSamples);
+    }
+    if (sum.latencyMaxNanos
+        != expectLatencyMax * 1000 / (CPU_FREQ / 1000000)) {
+        fail("latency max", 0, sum.latencyMaxNanos,
+            expectLatencyMax * 1000 / (CPU_FREQ / 1000000));
+    }
+    avg = expectSamples ? expectLatencySum / expectSamples : 0;
+    if (sum.latencyAvgNanos != avg * 1000 / (CPU_FREQ / 1000000)) {
+        fail("latency avg", 0, sum.latencyAvgNanos,
+            avg * 1000 / (CPU_FREQ / 1000000));
+    }
+    if (sum.isrStackPeak != ISR_STACK_PEAK
+        || sum.isrStackSize != ISR_STACK_SIZE || sum.cpuLoad != CPU_LOAD) {
+        fail("summary stack/load", 0, sum.isrStackPeak, ISR_STACK_PEAK);
+    }
+    if (sum.hooked != everHooked) {
+        fail("summary hooked", 0, sum.hooked, everHooked);
+    }
+}
+
+/*
+ *  ======== testRun ========
+ *  Profile a random schedule of the given length. busyTimers has a bit
+ *  set for each GPTimer someone else holds.
+ */
+static void testRun(uint32_t sampleHz, bool withHooks, uint32_t busyTimers,
+    unsigned steps)
+{
+    uint32_t hz = sampleHz > PROFILE_MAX_SAMPLE_HZ ? PROFILE_MAX_SAMPLE_HZ
+        : sampleHz;
+    uint32_t period = 0;
+    bool expectTimer = sampleHz != 0 && busyTimers != 0xff;
+    bool ok;
+    unsigned i;
+    int top;
+
+    for (i = 0; i < NUM_TIMERS; i++) {
+        timers[i].open = (busyTimers >> i) & 1;
+        timers[i].running = false;
+    }
+
+    hooks = withHooks;
+    simTimer = NULL;
+    pending = false;
+    resetExpected();
+
+    ok = profileBegin(sampleHz);
+    checkKeys("profileBegin");
+    recording = true;
+    vectors++;
+    if (ok != (sampleHz == 0 || expectTimer)) {
+        fail("profileBegin", sampleHz, ok, !ok);
+    }
+
+    if (expectTimer) {
+        period = CPU_FREQ / hz;
+        if (period > (1UL << 24)) {
+            period = 1UL << 24;
+        }
+
+        /* the highest free timer, 24-bit periodic up */
+        for (top = NUM_TIMERS - 1; (busyTimers >> top) & 1; top--) {
+        }
+        simTimer = &timers[top];
+        if (!simTimer->running || simTimer->load + 1 != period
+            || simTimer->mask != GPT_INT_TIMEOUT
+            || simTimer->params.width != GPT_CONFIG_16BIT
+            || simTimer->params.mode != GPT_MODE_PERIODIC_UP) {
+            fail("sampler timer", top, simTimer->load + 1, period);
+        }
+    }
+    for (i = 0; i < NUM_TIMERS; i++) {
+        if (&timers[i] != simTimer
+            && timers[i].open != ((busyTimers >> i) & 1)) {
+            fail("timer left open", i, timers[i].open, 0);
+        }
+    }
+
+    for (i = 0; i < steps; i++) {
+        step();
+        if (i == steps / 2) {
+            unwind();
+            advance(1 + rnd() % 1000);
+            profileReset();
+            checkKeys("profileReset");
+            resetExpected();
+        }
+    }
+    unwind();
+    checkProfile(period);
+
+    /* once ended, the numbers stay put and the timer is released */
+    profileEnd();
+    checkKeys("profileEnd");
+    recording = false;
+    if (simTimer != NULL && (simTimer->open || simTimer->running)) {
+        fail("timer not released", 0, simTimer->open, 0);
+    }
+    simTimer = NULL;
+    pending = false;
+    for (i = 0; i < steps / 10; i++) {
+        step();
+    }
+    unwind();
+    checkProfile(period);
+}
+
+int main(void)
+{
+    /* the cycle counter wraps a few thousand cycles in */
+    now = 0xFFFFFFFFULL - 5000;
+    initThreads();
+
+    /* sampling only; the hooks have never run */
+    testRun(1000, false, 0x00, 400000);
+
+    /* hooks and sampler, the rate clamped at the top and the bottom */
+    testRun(50000, true, 0x80, 400000);
+    testRun(1, true, 0x00, 400000);
+    testRun(997, true, 0xc0, 400000);
+
+    /* hooks only, by request and for want of a timer */
+    testRun(0, true, 0x00, 200000);
+    testRun(1000, true, 0xff, 200000);
+
+    /* a Task has ended and another is gone */
+    deleteTasks();
+    testRun(2000, true, 0x00, 400000);
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+
+    return (failures ? 1 : 0);
+}
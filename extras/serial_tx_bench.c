@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== serial_tx_bench.c ========
+ *  Host benchmark and wraparound check for the HardwareSerial TX path
+ *
+ *  Runs the per-byte TX loop that HardwareSerial::write() used before
+ *  (kept below as Old*) and the current bulk-copy path on
+ *  ti/drivers/utils/SPSCRing.h (New*) against a mocked UART_write().
+ *  The mock "transmits" the started span the moment the writer would
+ *  have to wait for space, which stands in for the UART Hwi firing while
+ *  the task is blocked, and appends the bytes to a sink.
+ *
+ *  Every write size from 1 to 3 * SERIAL_TX_BUFFER_SIZE is sent so that
+ *  copies start and end at every ring offset and wrap around the end of
+ *  txBuffer; the sink must match the source byte for byte. Then both
+ *  paths are timed on a long stream of mixed-size writes, reporting
+ *  bytes per CPU cycle (per ns where no cycle counter is available) and
+ *  critical sections per byte.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o serial_tx_bench -Isystem/source extras/serial_tx_bench.c
+ *      ./serial_tx_bench
+ *
+ *  Exits with 0 if both paths deliver every stream intact.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ti/drivers/utils/SPSCRing.h>
+
+
+#define SERIAL_TX_BUFFER_SIZE   128
+
+#define SINK_SIZE       (1 << 22)
+
+static unsigned char sink[SINK_SIZE];
+static size_t sinkLen;
+static unsigned long criticalSections;
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES()        __rdtsc()
+#define CYCLE_UNIT      "cycle"
+#else
+#define CYCLES()        nowNs()
+#define CYCLE_UNIT      "ns"
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+#endif
+
+/*
+ *  ======== Mocked UART driver ========
+ *  One write in flight, completed on demand by uartComplete().
+ */
+static const unsigned char *uartBuf;
+static size_t uartLen;
+static void (*uartCallback)(size_t count);
+
+static void UART_write(const void *buf, size_t len)
+{
+    uartBuf = buf;
+    uartLen = len;
+}
+
+static void uartComplete(void)
+{
+    size_t len = uartLen;
+
+    if (len == 0) {
+        return;
+    }
+    if (sinkLen + len <= SINK_SIZE) {
+        memcpy(sink + sinkLen, uartBuf, len);
+    }
+    sinkLen += len;
+    uartLen = 0;
+    uartCallback(len);
+}
+
+static inline unsigned int Hwi_disable(void)
+{
+    criticalSections++;
+    return (0);
+}
+
+static inline void Hwi_restore(unsigned int key)
+{
+    (void)key;
+}
+
+/*
+ *  ======== Old* ========
+ *  The per-byte path: one critical section per byte, spinning while
+ *  txBuffer is full.
+ */
+static unsigned char oldBuffer[SERIAL_TX_BUFFER_SIZE];
+static volatile unsigned int oldReadIndex;
+static volatile unsigned int oldWriteIndex;
+static volatile bool oldActive;
+
+#define OLD_TX_BUFFER_EMPTY (oldReadIndex == oldWriteIndex)
+#define OLD_TX_BUFFER_FULL  (((oldWriteIndex + 1) % SERIAL_TX_BUFFER_SIZE) == oldReadIndex)
+
+static void oldPrimeTx(void)
+{
+    unsigned int hwiKey;
+    size_t size;
+
+    hwiKey = Hwi_disable();
+    if (oldActive == true) {
+        Hwi_restore(hwiKey);
+        return;
+    }
+    if (oldWriteIndex > oldReadIndex) {
+        size = oldWriteIndex - oldReadIndex;
+    }
+    else {
+        size = SERIAL_TX_BUFFER_SIZE - oldReadIndex;
+    }
+    oldActive = true;
+    Hwi_restore(hwiKey);
+
+    UART_write(&oldBuffer[oldReadIndex], size);
+}
+
+static void oldWriteCallback(size_t txCount)
+{
+    unsigned int hwiKey;
+    size_t size;
+
+    hwiKey = Hwi_disable();
+    oldReadIndex = (oldReadIndex + txCount) % SERIAL_TX_BUFFER_SIZE;
+    if (OLD_TX_BUFFER_EMPTY) {
+        oldActive = false;
+        Hwi_restore(hwiKey);
+        return;
+    }
+    if (oldWriteIndex > oldReadIndex) {
+        size = oldWriteIndex - oldReadIndex;
+    }
+    else {
+        size = SERIAL_TX_BUFFER_SIZE - oldReadIndex;
+    }
+    Hwi_restore(hwiKey);
+
+    UART_write(&oldBuffer[oldReadIndex], size);
+}
+
+static size_t oldWrite(const uint8_t *buffer, size_t size)
+{
+    unsigned int hwiKey;
+
+    while (size) {
+        while (OLD_TX_BUFFER_FULL) {
+            if (oldActive == false) {
+                oldPrimeTx();
+            }
+            uartComplete();
+        }
+        hwiKey = Hwi_disable();
+        oldBuffer[oldWriteIndex] = *buffer++;
+        oldWriteIndex = (oldWriteIndex + 1) % SERIAL_TX_BUFFER_SIZE;
+        size--;
+        Hwi_restore(hwiKey);
+    }
+    if ((oldActive == false) && (!OLD_TX_BUFFER_EMPTY)) {
+        oldPrimeTx();
+    }
+
+    return (0);
+}
+
+static void oldReset(void)
+{
+    oldReadIndex = 0;
+    oldWriteIndex = 0;
+    oldActive = false;
+    uartCallback = oldWriteCallback;
+}
+
+static bool oldIdle(void)
+{
+    return (!oldActive);
+}
+
+/*
+ *  ======== New* ========
+ *  The bulk-copy path of HardwareSerial::write(), waitTxSpace(),
+ *  primeTx() and writeCallback(). waitTxSpace() completes the UART write
+ *  instead of pending on txSem.
+ */
+static unsigned char newBuffer[SERIAL_TX_BUFFER_SIZE];
+static SPSCRing_Object newRing;
+static volatile bool newActive;
+
+static void newPrimeTx(void)
+{
+    unsigned int hwiKey;
+    SPSCRing_Span spans[2];
+
+    hwiKey = Hwi_disable();
+    if (newActive == true || SPSCRing_peekSpans(&newRing, spans) == 0) {
+        Hwi_restore(hwiKey);
+        return;
+    }
+    newActive = true;
+    Hwi_restore(hwiKey);
+
+    UART_write(spans[0].buf, spans[0].len);
+}
+
+static void newWriteCallback(size_t txCount)
+{
+    unsigned int hwiKey;
+    SPSCRing_Span spans[2];
+
+    hwiKey = Hwi_disable();
+    SPSCRing_consume(&newRing, txCount);
+    if (SPSCRing_peekSpans(&newRing, spans) == 0) {
+        newActive = false;
+        Hwi_restore(hwiKey);
+        return;
+    }
+    Hwi_restore(hwiKey);
+
+    UART_write(spans[0].buf, spans[0].len);
+}
+
+static void newWaitTxSpace(void)
+{
+    if (newActive == false) {
+        newPrimeTx();
+    }
+    uartComplete();
+}
+
+static size_t newWrite(const uint8_t *buffer, size_t size)
+{
+    unsigned int hwiKey;
+    const uint8_t *src = buffer;
+    size_t remaining = size;
+    size_t count;
+
+    while (remaining) {
+        hwiKey = Hwi_disable();
+        count = SPSCRing_write(&newRing, src, remaining);
+        Hwi_restore(hwiKey);
+
+        if (count == 0) {
+            newWaitTxSpace();
+            continue;
+        }
+
+        src += count;
+        remaining -= count;
+
+        if (newActive == false) {
+            newPrimeTx();
+        }
+    }
+
+    return (size);
+}
+
+static void newReset(void)
+{
+    SPSCRing_construct(&newRing, newBuffer, SERIAL_TX_BUFFER_SIZE);
+    newActive = false;
+    uartCallback = newWriteCallback;
+}
+
+static bool newIdle(void)
+{
+    return (!newActive);
+}
+
+/*
+ *  ======== Harness ========
+ */
+typedef struct Engine {
+    const char *name;
+    void (*reset)(void);
+    size_t (*write)(const uint8_t *buffer, size_t size);
+    bool (*idle)(void);
+} Engine;
+
+static const Engine engines[] = {
+    {"per-byte", oldReset, oldWrite, oldIdle},
+    {"bulk", newReset, newWrite, newIdle},
+};
+
+static unsigned char source[SINK_SIZE];
+static unsigned failures = 0;
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+static void drain(const Engine *e)
+{
+    while (!e->idle()) {
+        uartComplete();
+    }
+}
+
+/* send the source in writes of the given sizes, cycling through them */
+static size_t run(const Engine *e, const size_t *sizes, size_t numSizes,
+    size_t total)
+{
+    size_t sent = 0;
+    size_t i = 0;
+    size_t n;
+
+    e->reset();
+    uartLen = 0;
+    sinkLen = 0;
+
+    while (sent < total) {
+        n = sizes[i++ % numSizes];
+        if (n > total - sent) {
+            n = total - sent;
+        }
+        e->write(source + sent, n);
+        sent += n;
+    }
+    drain(e);
+
+    return (sent);
+}
+
+static void check(const Engine *e, size_t sent, const char *what, size_t arg)
+{
+    if (sinkLen != sent || memcmp(sink, source, sent) != 0) {
+        failures++;
+        printf("FAIL %s %s %zu: sent %zu, received %zu\n", e->name, what,
+            arg, sent, sinkLen);
+    }
+}
+
+static void testWraparound(const Engine *e)
+{
+    size_t size;
+    size_t offset;
+    size_t sizes[2];
+    size_t sent;
+
+    /* every write size, starting at every ring offset */
+    for (size = 1; size <= 3 * SERIAL_TX_BUFFER_SIZE; size++) {
+        for (offset = 0; offset < SERIAL_TX_BUFFER_SIZE; offset += 13) {
+            sizes[0] = offset ? offset : 1;
+            sizes[1] = size;
+            sent = run(e, sizes, 2, 8 * SERIAL_TX_BUFFER_SIZE + size);
+            check(e, sent, "size", size);
+        }
+    }
+}
+
+static void benchmark(const Engine *e, const size_t *sizes, size_t numSizes,
+    double *bytesPerCycle, double *sectionsPerByte)
+{
+    size_t total = SINK_SIZE;
+    uint64_t start;
+    uint64_t best = UINT64_MAX;
+    unsigned long sections = 0;
+    size_t sent = 0;
+    int rep;
+
+    for (rep = 0; rep < 5; rep++) {
+        criticalSections = 0;
+        start = CYCLES();
+        sent = run(e, sizes, numSizes, total);
+        start = CYCLES() - start;
+        if (start < best) {
+            best = start;
+            sections = criticalSections;
+        }
+    }
+    check(e, sent, "benchmark", numSizes);
+
+    *bytesPerCycle = (double)sent / (double)best;
+    *sectionsPerByte = (double)sections / (double)sent;
+}
+
+int main(void)
+{
+    static const size_t prints[] = {1, 2, 12, 24, 5, 80, 3, 40};
+    static const size_t dumps[] = {256, 512, 1000, 4096};
+    size_t i;
+    unsigned e;
+    double before[2];
+    double after[2];
+
+    for (i = 0; i < SINK_SIZE; i++) {
+        source[i] = (unsigned char)rnd();
+    }
+
+    for (e = 0; e < 2; e++) {
+        testWraparound(&engines[e]);
+    }
+
+    printf("%-22s %14s %14s %10s\n", "workload",
+        "per-byte B/" CYCLE_UNIT, "bulk B/" CYCLE_UNIT, "sections/B");
+    benchmark(&engines[0], prints, 8, &before[0], &before[1]);
+    benchmark(&engines[1], prints, 8, &after[0], &after[1]);
+    printf("%-22s %14.3f %14.3f %4.2f->%4.2f\n", "Serial.print() sizes",
+        before[0], after[0], before[1], after[1]);
+    benchmark(&engines[0], dumps, 4, &before[0], &before[1]);
+    benchmark(&engines[1], dumps, 4, &after[0], &after[1]);
+    printf("%-22s %14.3f %14.3f %4.2f->%4.2f\n", "telemetry dumps",
+        before[0], after[0], before[1], after[1]);
+
+    printf("%s\n", failures ? "FAILED" : "all streams intact");
+
+    return (failures ? 1 : 0);
+}
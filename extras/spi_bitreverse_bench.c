@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== spi_bitreverse_bench.c ========
+ *  Host check and benchmark for the LSBFIRST buffer reversal in SPI.cpp
+ *
+ *  SPIClass::reverseBuffer() reverses aligned words with RBIT and REV
+ *  and sends the unaligned head and tail through reverseBits(), which
+ *  falls back to a 256-entry table on targets without RBIT. Both are
+ *  reproduced below and checked against a bit-by-bit reference, kept as
+ *  Ref_*: the table over all 256 values, and reverseBuffer() over every
+ *  start alignment and every length up to several words, with guard
+ *  bytes on both sides that must not change. Then the old per-byte loop
+ *  and reverseBuffer() are timed over typical buffer sizes.
+ *
+ *  RBIT and REV are single instructions on ARM hosts; elsewhere they are
+ *  emulated, so only ARM timings reflect the word path's real speed.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o spi_bitreverse_bench extras/spi_bitreverse_bench.c
+ *      ./spi_bitreverse_bench
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ *  ======== Reference implementation ========
+ */
+static __attribute__((noinline)) uint8_t Ref_reverseBits(uint8_t data)
+{
+    uint8_t result = 0;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        result = (result << 1) | ((data >> i) & 1);
+    }
+
+    return (result);
+}
+
+/*
+ *  ======== SPI.cpp ========
+ *  reverseTable[] and reverseBuffer() as in SPIClass, with RBIT and REV
+ *  as inline functions.
+ */
+static const uint8_t reverseTable[256] = {
+#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
+#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
+#define R6(n) R4(n), R4(n + 2*4), R4(n + 1*4), R4(n + 3*4)
+    R6(0), R6(2), R6(1), R6(3)
+#undef R6
+#undef R4
+#undef R2
+};
+
+static inline uint32_t rbit(uint32_t word)
+{
+#if defined(__aarch64__)
+    asm("rbit %w0, %w1" : "=r" (word) : "r" (word));
+#elif defined(__arm__)
+    asm("rbit %0, %1" : "=r" (word) : "r" (word));
+#else
+    word = ((word >> 1) & 0x55555555) | ((word & 0x55555555) << 1);
+    word = ((word >> 2) & 0x33333333) | ((word & 0x33333333) << 2);
+    word = ((word >> 4) & 0x0f0f0f0f) | ((word & 0x0f0f0f0f) << 4);
+    word = __builtin_bswap32(word);
+#endif
+    return (word);
+}
+
+static inline uint32_t rev(uint32_t word)
+{
+    return (__builtin_bswap32(word));
+}
+
+static inline uint8_t reverseBits(uint8_t data)
+{
+    return (reverseTable[data]);
+}
+
+static __attribute__((noinline)) void reverseBuffer(uint8_t *buffer,
+    size_t size)
+{
+    uint32_t *words;
+    uint32_t word;
+
+    while (size != 0 && ((uintptr_t)buffer & 3) != 0) {
+        *buffer = reverseBits(*buffer);
+        buffer++;
+        size--;
+    }
+
+    words = (uint32_t *)buffer;
+
+    for (; size >= 4; size -= 4) {
+        word = *words;
+        word = rev(rbit(word));
+        *words++ = word;
+    }
+
+    buffer = (uint8_t *)words;
+
+    while (size-- != 0) {
+        *buffer = reverseBits(*buffer);
+        buffer++;
+    }
+}
+
+/* the loop SPIClass::transfer() ran before reverseBuffer() */
+static __attribute__((noinline)) void reversePerByte(uint8_t *buffer,
+    size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        buffer[i] = reverseBits(buffer[i]);
+    }
+}
+
+/*
+ *  ======== Harness ========
+ */
+#define GUARD           8
+#define MAX_LEN         4096
+
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, long a, long b, long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %ld got %ld expected %ld\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+static void testTable(void)
+{
+    int i;
+
+    for (i = 0; i < 256; i++) {
+        vectors++;
+        if (reverseBits(i) != Ref_reverseBits(i)) {
+            fail("reverseTable", i, reverseBits(i), Ref_reverseBits(i));
+        }
+    }
+}
+
+static void testBuffer(size_t offset, size_t len)
+{
+    static uint32_t store[(MAX_LEN + 2 * GUARD + 8) / 4];
+    uint8_t *base = (uint8_t *)store;
+    uint8_t copy[MAX_LEN + 2 * GUARD + 8];
+    size_t total = offset + len + 2 * GUARD;
+    size_t i;
+
+    for (i = 0; i < total; i++) {
+        base[i] = copy[i] = rnd();
+    }
+
+    reverseBuffer(base + GUARD + offset, len);
+
+    vectors++;
+    for (i = 0; i < total; i++) {
+        uint8_t expect = copy[i];
+
+        if (i >= GUARD + offset && i < GUARD + offset + len) {
+            expect = Ref_reverseBits(copy[i]);
+        }
+        if (base[i] != expect) {
+            fail(i < GUARD + offset || i >= GUARD + offset + len ?
+                "guard byte changed" : "reverseBuffer", (long)len,
+                base[i], expect);
+            return;
+        }
+    }
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+static void timeBuffers(void)
+{
+    static uint32_t store[MAX_LEN / 4];
+    static const size_t sizes[] = {4, 16, 64, 256, 1024, 4096};
+    uint8_t *buf = (uint8_t *)store;
+    double t0, tByte, tWord;
+    unsigned i, n, reps;
+
+    for (i = 0; i < MAX_LEN; i++) {
+        buf[i] = rnd();
+    }
+
+    printf("%6s %14s %14s %8s\n", "bytes", "per-byte MB/s", "words MB/s",
+        "speedup");
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        reps = (64 << 20) / sizes[i];
+
+        t0 = now();
+        for (n = 0; n < reps; n++) {
+            reversePerByte(buf, sizes[i]);
+        }
+        tByte = now() - t0;
+
+        t0 = now();
+        for (n = 0; n < reps; n++) {
+            reverseBuffer(buf, sizes[i]);
+        }
+        tWord = now() - t0;
+
+        printf("%6zu %14.1f %14.1f %7.2fx\n", sizes[i], 64 / tByte,
+            64 / tWord, tByte / tWord);
+    }
+}
+
+int main(void)
+{
+    size_t offset;
+    size_t len;
+
+    testTable();
+
+    for (offset = 0; offset < 8; offset++) {
+        for (len = 0; len <= 67; len++) {
+            testBuffer(offset, len);
+        }
+        testBuffer(offset, 1000);
+        testBuffer(offset, MAX_LEN - 8);
+    }
+
+    timeBuffers();
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+
+    return (failures ? 1 : 0);
+}
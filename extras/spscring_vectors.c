@@ -0,0 +1,570 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== spscring_vectors.c ========
+ *  Host test vectors and throughput benchmark for
+ *  system/source/ti/drivers/utils/SPSCRing.h
+ *
+ *  For every capacity up to 64 bytes and every fill level, with head and
+ *  tail started at every ring offset and just below the SIZE_MAX + 1
+ *  index wrap, SPSCRing_peekSpans() and SPSCRing_reserveSpans() must
+ *  return the regions the Ref_* model below computes byte by byte; data
+ *  written through reserved spans must read back in order through peeked
+ *  spans. Random sequences of write/read, put/get/peek and span calls
+ *  are then checked against a plain byte queue.
+ *
+ *  Finally a producer and a consumer thread stream data through a
+ *  256 byte ring, each side picking the copying, per-byte or in-place
+ *  calls at random. Every byte is checked, and the throughput of the
+ *  copying and in-place paths is reported. A side that finds the ring
+ *  full or empty yields, so this also completes on a single CPU.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -pthread -o spscring_vectors -Isystem/source \
+ *          extras/spscring_vectors.c
+ *      ./spscring_vectors
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <ti/drivers/utils/SPSCRing.h>
+
+#define MAX_SIZE        64
+
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, unsigned long long a,
+    unsigned long long b, unsigned long long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %llu got %llu expected %llu\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+static uint64_t nsNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+/*
+ *  ======== Ref_spans ========
+ *  Walk 'count' ring positions from index 'start' one byte at a time and
+ *  record where the walk jumps back to the start of the buffer.
+ */
+static __attribute__((noinline)) void Ref_spans(size_t size, size_t start,
+    size_t count, size_t *off0, size_t *len0, size_t *len1)
+{
+    size_t i, pos;
+
+    *off0 = start % size;
+    *len0 = 0;
+    *len1 = 0;
+    for (i = 0; i < count; i++) {
+        pos = (start + i) % size;
+        if (*len1 == 0 && pos == *off0 + *len0) {
+            (*len0)++;
+        }
+        else {
+            (*len1)++;
+        }
+    }
+}
+
+static void checkSpans(const char *what, size_t size, size_t start,
+    size_t count, const unsigned char *buf, const SPSCRing_Span spans[2],
+    size_t total)
+{
+    size_t off0, len0, len1;
+
+    vectors++;
+    Ref_spans(size, start, count, &off0, &len0, &len1);
+    if (total != count) {
+        fail(what, start, total, count);
+    }
+    if (spans[0].buf != buf + off0 || spans[0].len != len0) {
+        fail(what, start, spans[0].len, len0);
+    }
+    if (spans[1].buf != buf || spans[1].len != len1) {
+        fail(what, start, spans[1].len, len1);
+    }
+}
+
+/*
+ *  ======== testSpans ========
+ */
+static void testSpans(size_t size, size_t base)
+{
+    static unsigned char buf[MAX_SIZE];
+    SPSCRing_Object ring;
+    SPSCRing_Span spans[2];
+    size_t start, fill, total, i, n;
+    unsigned char expect;
+
+    SPSCRing_construct(&ring, buf, size);
+
+    for (start = base; start != base + size; start++) {
+        for (fill = 0; fill <= size; fill++) {
+            ring.head = start + fill;
+            ring.tail = start;
+
+            total = SPSCRing_peekSpans(&ring, spans);
+            checkSpans("peekSpans", size, start, fill, buf, spans, total);
+
+            total = SPSCRing_reserveSpans(&ring, spans);
+            checkSpans("reserveSpans", size, start + fill, size - fill, buf,
+                spans, total);
+
+            vectors++;
+            if (SPSCRing_getCount(&ring) != fill ||
+                SPSCRing_getSpace(&ring) != size - fill) {
+                fail("count/space", start, SPSCRing_getCount(&ring), fill);
+            }
+
+            /* fill the free spans, publish them and read them back */
+            ring.head = start;
+            SPSCRing_reserveSpans(&ring, spans);
+            n = 0;
+            for (i = 0; i < spans[0].len && n < fill; i++) {
+                spans[0].buf[i] = (unsigned char)(start + n++);
+            }
+            for (i = 0; i < spans[1].len && n < fill; i++) {
+                spans[1].buf[i] = (unsigned char)(start + n++);
+            }
+            SPSCRing_commit(&ring, fill);
+
+            vectors++;
+            SPSCRing_peekSpans(&ring, spans);
+            n = 0;
+            for (i = 0; i < spans[0].len + spans[1].len; i++) {
+                expect = (unsigned char)(start + n++);
+                if ((i < spans[0].len ? spans[0].buf[i] :
+                        spans[1].buf[i - spans[0].len]) != expect) {
+                    fail("span data", start, i, expect);
+                    break;
+                }
+            }
+            SPSCRing_consume(&ring, fill);
+            if (ring.head != ring.tail) {
+                fail("consume", start, ring.tail, ring.head);
+            }
+        }
+    }
+}
+
+/*
+ *  ======== testConstruct ========
+ */
+static void testConstruct(void)
+{
+    static unsigned char buf[MAX_SIZE];
+    SPSCRing_Object ring;
+    size_t size;
+    bool pow2;
+
+    for (size = 0; size <= MAX_SIZE; size++) {
+        vectors++;
+        pow2 = size != 0 && (size & (size - 1)) == 0;
+        if (SPSCRing_construct(&ring, buf, size) != pow2) {
+            fail("construct", size, !pow2, pow2);
+        }
+        if (pow2 && (SPSCRing_getSize(&ring) != size ||
+            SPSCRing_getCount(&ring) != 0 ||
+            SPSCRing_getSpace(&ring) != size)) {
+            fail("construct size", size, SPSCRing_getSize(&ring), size);
+        }
+    }
+}
+
+/*
+ *  ======== testRandom ========
+ *  Random calls on one ring, against a byte queue that never wraps.
+ */
+#define REF_SIZE        (1 << 20)
+
+static unsigned char refQ[REF_SIZE];
+static size_t refHead, refTail;
+
+static __attribute__((noinline)) size_t Ref_write(const unsigned char *src,
+    size_t len, size_t size)
+{
+    size_t n = size - (refHead - refTail);
+
+    if (n > len) {
+        n = len;
+    }
+    memcpy(refQ + refHead, src, n);
+    refHead += n;
+
+    return (n);
+}
+
+static __attribute__((noinline)) size_t Ref_read(unsigned char *dst,
+    size_t len)
+{
+    size_t n = refHead - refTail;
+
+    if (n > len) {
+        n = len;
+    }
+    memcpy(dst, refQ + refTail, n);
+    refTail += n;
+
+    return (n);
+}
+
+static void testRandom(size_t size, size_t base, unsigned ops)
+{
+    static unsigned char buf[MAX_SIZE];
+    unsigned char src[2 * MAX_SIZE], dst[2 * MAX_SIZE], ref[2 * MAX_SIZE];
+    SPSCRing_Object ring;
+    SPSCRing_Span spans[2];
+    size_t len, n, want, i;
+    unsigned char c;
+    bool ok, refOk;
+    unsigned op;
+
+    SPSCRing_construct(&ring, buf, size);
+    ring.head = ring.tail = base;
+    refHead = refTail = 0;
+
+    for (op = 0; op < ops && refHead + 2 * MAX_SIZE < REF_SIZE; op++) {
+        len = rnd() % (2 * size + 1);
+        for (i = 0; i < len; i++) {
+            src[i] = (unsigned char)rnd();
+        }
+
+        vectors++;
+        switch (rnd() % 7) {
+        case 0:
+            n = SPSCRing_write(&ring, src, len);
+            want = Ref_write(src, len, size);
+            if (n != want) {
+                fail("write", op, n, want);
+            }
+            break;
+
+        case 1:
+            n = SPSCRing_read(&ring, dst, len);
+            want = Ref_read(ref, len);
+            if (n != want || memcmp(dst, ref, n) != 0) {
+                fail("read", op, n, want);
+            }
+            break;
+
+        case 2:
+            ok = SPSCRing_put(&ring, src[0]);
+            refOk = Ref_write(src, 1, size) == 1;
+            if (ok != refOk) {
+                fail("put", op, ok, refOk);
+            }
+            break;
+
+        case 3:
+            c = 0;
+            ok = SPSCRing_peek(&ring, &c);
+            refOk = refHead != refTail;
+            if (ok != refOk || (ok && c != refQ[refTail])) {
+                fail("peek", op, c, refOk ? refQ[refTail] : 0);
+            }
+            ok = SPSCRing_get(&ring, &c);
+            refOk = Ref_read(ref, 1) == 1;
+            if (ok != refOk || (ok && c != ref[0])) {
+                fail("get", op, c, ref[0]);
+            }
+            break;
+
+        case 4:
+            /* write part of the reserved space in place */
+            SPSCRing_reserveSpans(&ring, spans);
+            n = len;
+            if (n > spans[0].len + spans[1].len) {
+                n = spans[0].len + spans[1].len;
+            }
+            for (i = 0; i < n; i++) {
+                if (i < spans[0].len) {
+                    spans[0].buf[i] = src[i];
+                }
+                else {
+                    spans[1].buf[i - spans[0].len] = src[i];
+                }
+            }
+            SPSCRing_commit(&ring, n);
+            want = Ref_write(src, n, size);
+            if (n != want) {
+                fail("commit", op, n, want);
+            }
+            break;
+
+        case 5:
+            /* consume part of the data in place */
+            SPSCRing_peekSpans(&ring, spans);
+            n = len;
+            if (n > spans[0].len + spans[1].len) {
+                n = spans[0].len + spans[1].len;
+            }
+            for (i = 0; i < n; i++) {
+                dst[i] = i < spans[0].len ? spans[0].buf[i] :
+                    spans[1].buf[i - spans[0].len];
+            }
+            SPSCRing_consume(&ring, n);
+            want = Ref_read(ref, n);
+            if (n != want || memcmp(dst, ref, n) != 0) {
+                fail("consume", op, n, want);
+            }
+            break;
+
+        default:
+            n = SPSCRing_getCount(&ring);
+            if (n != refHead - refTail ||
+                    SPSCRing_getSpace(&ring) != size - n) {
+                fail("getCount", op, n, refHead - refTail);
+            }
+            break;
+        }
+    }
+}
+
+/*
+ *  ======== Two threads ========
+ *  The producer sends the bytes of a counter-driven sequence, the
+ *  consumer checks each one. With 'mixed' set both sides pick a random
+ *  API for every step; otherwise they use the copying calls or the span
+ *  calls only.
+ */
+enum { API_COPY, API_SPANS, API_MIXED };
+
+#define RING_SIZE       256
+
+static unsigned char ringBuf[RING_SIZE];
+static SPSCRing_Object ring;
+static size_t streamLen;
+static int streamApi;
+static volatile size_t badOffset;
+
+static inline unsigned char streamByte(size_t i)
+{
+    return ((unsigned char)(i * 131 + (i >> 8)));
+}
+
+static void *producer(void *arg)
+{
+    uint32_t state = 0x12345678;
+    unsigned char chunk[RING_SIZE];
+    SPSCRing_Span spans[2];
+    size_t sent = 0, len, n, i;
+    int api;
+
+    (void)arg;
+
+    while (sent < streamLen) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        len = 1 + state % RING_SIZE;
+        if (len > streamLen - sent) {
+            len = streamLen - sent;
+        }
+        api = streamApi == API_MIXED ? (int)(state >> 24) % 3 : streamApi;
+
+        if (api == API_COPY) {
+            for (i = 0; i < len; i++) {
+                chunk[i] = streamByte(sent + i);
+            }
+            n = SPSCRing_write(&ring, chunk, len);
+        }
+        else if (api == API_SPANS) {
+            SPSCRing_reserveSpans(&ring, spans);
+            n = spans[0].len + spans[1].len;
+            if (n > len) {
+                n = len;
+            }
+            for (i = 0; i < n; i++) {
+                if (i < spans[0].len) {
+                    spans[0].buf[i] = streamByte(sent + i);
+                }
+                else {
+                    spans[1].buf[i - spans[0].len] = streamByte(sent + i);
+                }
+            }
+            SPSCRing_commit(&ring, n);
+        }
+        else {
+            n = SPSCRing_put(&ring, streamByte(sent)) ? 1 : 0;
+        }
+        if (n == 0) {
+            sched_yield();
+        }
+        sent += n;
+    }
+
+    return (NULL);
+}
+
+static void *consumer(void *arg)
+{
+    uint32_t state = 0x9ABCDEF0;
+    unsigned char chunk[RING_SIZE];
+    SPSCRing_Span spans[2];
+    size_t got = 0, len, n, i;
+    unsigned char c;
+    int api;
+
+    (void)arg;
+
+    while (got < streamLen) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        len = 1 + state % RING_SIZE;
+        api = streamApi == API_MIXED ? (int)(state >> 24) % 3 : streamApi;
+
+        if (api == API_COPY) {
+            n = SPSCRing_read(&ring, chunk, len);
+            for (i = 0; i < n; i++) {
+                if (chunk[i] != streamByte(got + i) && badOffset == 0) {
+                    badOffset = got + i + 1;
+                }
+            }
+        }
+        else if (api == API_SPANS) {
+            SPSCRing_peekSpans(&ring, spans);
+            n = spans[0].len + spans[1].len;
+            if (n > len) {
+                n = len;
+            }
+            for (i = 0; i < n; i++) {
+                c = i < spans[0].len ? spans[0].buf[i] :
+                    spans[1].buf[i - spans[0].len];
+                if (c != streamByte(got + i) && badOffset == 0) {
+                    badOffset = got + i + 1;
+                }
+            }
+            SPSCRing_consume(&ring, n);
+        }
+        else {
+            n = 0;
+            if (SPSCRing_get(&ring, &c)) {
+                n = 1;
+                if (c != streamByte(got) && badOffset == 0) {
+                    badOffset = got + 1;
+                }
+            }
+        }
+        if (n == 0) {
+            sched_yield();
+        }
+        got += n;
+    }
+
+    return (NULL);
+}
+
+static void testThreads(const char *what, int api, size_t len, size_t base)
+{
+    pthread_t prod, cons;
+    uint64_t t0, ns;
+
+    SPSCRing_construct(&ring, ringBuf, RING_SIZE);
+    ring.head = ring.tail = base;
+    streamLen = len;
+    streamApi = api;
+    badOffset = 0;
+
+    t0 = nsNow();
+    pthread_create(&cons, NULL, consumer, NULL);
+    pthread_create(&prod, NULL, producer, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    ns = nsNow() - t0;
+
+    vectors++;
+    if (badOffset != 0) {
+        fail(what, len, badOffset - 1, 0);
+    }
+    if (ring.head != base + len || ring.tail != base + len) {
+        fail(what, len, ring.tail - base, len);
+    }
+
+    printf("%-7s %4u MB in %6.1f ms, %7.1f MB/s\n", what,
+        (unsigned)(len >> 20), ns / 1e6, (double)len * 1e3 / ns);
+}
+
+int main(void)
+{
+    size_t size, nearWrap = (size_t)0 - 3 * MAX_SIZE;
+    unsigned i;
+
+    testConstruct();
+
+    for (size = 1; size <= MAX_SIZE; size *= 2) {
+        testSpans(size, 0);
+        testSpans(size, nearWrap);
+        for (i = 0; i < 20; i++) {
+            testRandom(size, i & 1 ? nearWrap : rnd(), 20000);
+        }
+    }
+
+    testThreads("mixed", API_MIXED, (size_t)16 << 20, (size_t)0 - 100000);
+    testThreads("copy", API_COPY, (size_t)256 << 20, 0);
+    testThreads("spans", API_SPANS, (size_t)256 << 20, 0);
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+
+    return (failures ? 1 : 0);
+}
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== timebase_vectors.c ========
+ *  Host test vectors for cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_timebase.c
+ *
+ *  Builds the real timebase module against mocks of the TI-RTOS
+ *  TimestampProvider, Hwi and Clock modules and of the DWT registers,
+ *  then checks micros64(), micros() and millis() against the 64-bit
+ *  divisions they replaced, kept below as Ref_*.
+ *
+ *  micros64() is driven through monotonic timestamp sequences with small
+ *  steps, steps that straddle the rebase threshold, long idle gaps and
+ *  the 2^32 cycle wrap of the low timestamp word, for whole MHz clocks
+ *  and ones that shrink the rebase interval or fall back to dividing.
+ *  The cycle reciprocal is also checked exhaustively over its 2^30 delta
+ *  range at 48 MHz. millis() is checked over edge and random tick counts
+ *  across the full 32-bit range for several Clock tick periods, including
+ *  ones that take the division fallback. It also times both versions,
+ *  though a host CPU divides far faster than the Cortex-M3, which has no
+ *  64-bit divide instruction.
+ *
+ *  Build from the repository root and run:
+ *
+ *      cc -O2 -o timebase_vectors -Icores/cc13xx -Isystem/source \
+ *          -Isystem/kernel/tirtos/packages extras/timebase_vectors.c
+ *      ./timebase_vectors
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ *  ======== Mocks ========
+ *  Stand-ins for the headers wiring_timebase.c includes. The cycle
+ *  counter advances on every read so that the delay spins terminate.
+ */
+#define Energia_h
+#define ti_sysbios_family_arm_m3_TimestampProvider__include
+#define ti_sysbios_family_arm_m3_Hwi__include
+#define xdc_runtime_Types__include
+#define ti_sysbios_knl_Clock__include
+#define ti_sysbios_family_arm_m3_TimestampProvider__localnames__done
+#define ti_sysbios_family_arm_m3_Hwi__localnames__done
+#define xdc_runtime_Types__localnames__done
+#define ti_sysbios_knl_Clock__localnames__done
+#define __HW_TYPES_H__
+
+#define min(a, b)   ((a) < (b) ? (a) : (b))
+#define max(a, b)   ((a) > (b) ? (a) : (b))
+
+typedef struct Types_FreqHz {
+    uint32_t hi;
+    uint32_t lo;
+} Types_FreqHz;
+
+typedef struct Types_Timestamp64 {
+    uint32_t hi;
+    uint32_t lo;
+} Types_Timestamp64;
+
+static uint32_t mockFreq;
+static uint64_t mockTimestamp;
+static uint32_t mockTicks;
+static uint32_t Clock_tickPeriod;
+
+static volatile uint32_t mockCyccnt;
+static volatile uint32_t mockRegs[4];
+
+static void TimestampProvider_getFreq(Types_FreqHz *freq)
+{
+    freq->hi = 0;
+    freq->lo = mockFreq;
+}
+
+static void TimestampProvider_get64(Types_Timestamp64 *time)
+{
+    time->hi = (uint32_t)(mockTimestamp >> 32);
+    time->lo = (uint32_t)mockTimestamp;
+}
+
+static inline unsigned int Hwi_disable(void)
+{
+    return (0);
+}
+
+static inline void Hwi_restore(unsigned int key)
+{
+    (void)key;
+}
+
+static inline uint32_t Clock_getTicks(void)
+{
+    return (mockTicks);
+}
+
+static volatile uint32_t *mockReg(uintptr_t addr)
+{
+    if (addr == 0xE0001004) {       /* CPU_DWT_O_CYCCNT */
+        mockCyccnt++;
+        return (&mockCyccnt);
+    }
+
+    return (&mockRegs[addr & 3]);
+}
+
+#define HWREG(x)    (*mockReg(x))
+
+void delayMicroseconds(unsigned int us);
+void delayMicrosecondsAtomic(unsigned int us);
+uint64_t micros64(void);
+unsigned long micros(void);
+unsigned long millis(void);
+
+#include "../cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_timebase.c"
+
+/*
+ *  ======== Reference implementation ========
+ *  The 64-bit divisions micros() and millis() used before, in the
+ *  device's 32-bit unsigned long.
+ */
+
+static __attribute__((noinline)) uint32_t Ref_micros(void)
+{
+    Types_FreqHz freq;
+    Types_Timestamp64 time;
+    uint64_t t64;
+
+    TimestampProvider_getFreq(&freq);
+    TimestampProvider_get64(&time);
+    t64 = ((uint64_t)time.hi << 32) | time.lo;
+    return (t64/(freq.lo/1000000));
+}
+
+static __attribute__((noinline)) uint32_t Ref_millis(void)
+{
+    uint64_t milliseconds;
+
+    milliseconds = ((uint64_t)Clock_getTicks() * (uint64_t)Clock_tickPeriod) / (uint64_t)1000;
+
+    return (milliseconds);
+}
+
+/* exact microseconds, for clocks that are not a whole number of MHz */
+static uint64_t exactMicros(uint64_t cycles)
+{
+    return ((uint64_t)(((unsigned __int128)cycles * 1000000) / mockFreq));
+}
+
+/*
+ *  ======== Harness ========
+ */
+static unsigned vectors = 0;
+static unsigned failures = 0;
+
+static void fail(const char *what, unsigned long long a,
+    unsigned long long b, unsigned long long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %llu got %llu expected %llu\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+static void setFreq(uint32_t freq)
+{
+    mockFreq = freq;
+    mockTimestamp = 0;
+    baseCycles = 0;
+    baseMicros = 0;
+    rebaseCycles = 0;
+    timebaseInit();
+}
+
+static void checkMicros(void)
+{
+    uint64_t us = micros64();
+    uint64_t exact = exactMicros(mockTimestamp);
+
+    vectors++;
+    if (us != exact) {
+        fail("micros64", mockTimestamp, us, exact);
+    }
+    if ((uint32_t)micros() != (uint32_t)exact) {
+        fail("micros", mockTimestamp, (uint32_t)micros(), (uint32_t)exact);
+    }
+    if ((mockFreq % 1000000) == 0 && mockTimestamp < ((uint64_t)1 << 52)
+        && (uint32_t)micros() != Ref_micros()) {
+        fail("micros vs Ref", mockTimestamp, (uint32_t)micros(), Ref_micros());
+    }
+}
+
+static void testMicros(uint32_t freq)
+{
+    uint64_t step;
+    int i;
+
+    setFreq(freq);
+
+    /* small steps, as from a busy loop */
+    for (i = 0; i < 100000; i++) {
+        mockTimestamp += rnd() % 200;
+        checkMicros();
+    }
+
+    /* steps just either side of the rebase threshold */
+    for (i = 0; i < 10000; i++) {
+        step = TIMEBASE_MAX_DELTA - 64 + (rnd() % 128);
+        mockTimestamp += step;
+        checkMicros();
+    }
+
+    /* across every 2^32 wrap of the low timestamp word */
+    for (i = 0; i < 64; i++) {
+        mockTimestamp = (((mockTimestamp >> 32) + 1) << 32) - 8;
+        for (step = 0; step < 16; step++) {
+            mockTimestamp++;
+            checkMicros();
+        }
+    }
+
+    /* long idle gaps, hours to weeks without a call */
+    for (i = 0; i < 1000; i++) {
+        mockTimestamp += ((uint64_t)rnd() << 8) | (rnd() & 0xff);
+        checkMicros();
+    }
+}
+
+/* the cycle reciprocal must match the division over its whole range */
+static void testCycleReciprocal(void)
+{
+    uint32_t x;
+
+    setFreq(48000000);
+
+    for (x = 0; x < TIMEBASE_MAX_DELTA; x++) {
+        if (TIMEBASE_SCALE(cyclesToMicros, x) != x / 48) {
+            fail("cyclesToMicros", x, TIMEBASE_SCALE(cyclesToMicros, x), x / 48);
+            break;
+        }
+    }
+    vectors += TIMEBASE_MAX_DELTA;
+}
+
+static void checkMillis(uint32_t ticks)
+{
+    mockTicks = ticks;
+
+    vectors++;
+    if ((uint32_t)millis() != Ref_millis()) {
+        fail("millis", ticks, (uint32_t)millis(), Ref_millis());
+    }
+}
+
+static void testMillis(uint32_t tickPeriod, bool expectExact)
+{
+    uint32_t i;
+
+    Clock_tickPeriod = tickPeriod;
+    setFreq(48000000);
+
+    if (millisExact != expectExact) {
+        fail("millisExact", tickPeriod, millisExact, expectExact);
+    }
+
+    for (i = 0; i < 100000; i++) {
+        checkMillis(i);
+        checkMillis(0xffffffff - i);
+        checkMillis(rnd());
+    }
+    /* around every millisecond boundary near the top of the range */
+    for (i = 0; i < 1000; i++) {
+        checkMillis((uint32_t)((((uint64_t)0xffffffff * 1000 / tickPeriod)
+            / 1000 - i) * 1000 / tickPeriod));
+    }
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+static void timeTimebase(void)
+{
+    volatile uint32_t sink = 0;
+    double t0, tRef, tNew;
+    int i;
+
+    setFreq(48000000);
+    Clock_tickPeriod = 10;
+
+    t0 = now();
+    for (i = 0; i < 10000000; i++) {
+        mockTimestamp += 97;
+        sink += Ref_micros();
+    }
+    tRef = now() - t0;
+
+    t0 = now();
+    for (i = 0; i < 10000000; i++) {
+        mockTimestamp += 97;
+        sink += micros();
+    }
+    tNew = now() - t0;
+
+    printf("micros: Ref %.2f ns, new %.2f ns per call\n",
+        tRef * 100, tNew * 100);
+
+    t0 = now();
+    for (i = 0; i < 10000000; i++) {
+        mockTicks += 97;
+        sink += Ref_millis();
+    }
+    tRef = now() - t0;
+
+    t0 = now();
+    for (i = 0; i < 10000000; i++) {
+        mockTicks += 97;
+        sink += millis();
+    }
+    tNew = now() - t0;
+
+    printf("millis: Ref %.2f ns, new %.2f ns per call\n",
+        tRef * 100, tNew * 100);
+}
+
+int main(void)
+{
+    Clock_tickPeriod = 10;
+
+    testMicros(48000000);
+    testMicros(24000000);
+    testMicros(1000000);
+    testMicros(47185920);
+    testMicros(32768000);
+    testMicros(47999999);
+    testCycleReciprocal();
+
+    testMillis(10, true);
+    testMillis(1000, true);
+    testMillis(100, true);
+    testMillis(7, false);
+    testMillis(30517, false);
+
+    timeTimebase();
+
+    printf("%u vectors, %u failures\n", vectors, failures);
+
+    return (failures ? 1 : 0);
+}
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017, Texas Instruments Incorporated
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# *  Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# *  Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# *  Neither the name of Texas Instruments Incorporated nor the names of
+#    its contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+# THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+# OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+# OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Count the CPU wakeups a mix of timeouts causes in TickMode_DYNAMIC, with
+and without slack: Energia's setTimerSlack() for delay(), and
+Clock_setSlack() for Clock objects.
+
+Each timer is [d|c|p]PERIOD[:PHASE] in milliseconds:
+
+    PERIOD      periodic Clock without slack, runs exactly every PERIOD
+    dPERIOD     delay loop, sleeps PERIOD again from whenever it last woke
+                up, like loop() calling delay(); takes --slack
+    cPERIOD     one-shot Clock that restarts itself with Clock_start()
+                from its function; takes --clock-slack
+    pPERIOD     periodic Clock with --clock-slack; Clock_start() moves
+                its first timeout, after that it keeps its period
+
+    timerslack.py 1000 250 d100 d330 --slack 10
+    timerslack.py 100 d150 c225 p500:7 --slack 25 --clock-slack 25 --work 2
+
+The slack is applied the way delay() and Clock_start() do it: a timeout
+joins the next scheduled wakeup if that is within the slack, otherwise
+it ends on the last multiple of the largest power of 2 <= slack + 1
+ticks that is not more than slack ticks late, so timeouts whose windows
+overlap tend to end on the same tick.
+
+Without --work every loop sleeps again on the very tick it woke up, so
+loops and periodic Clocks stay in lockstep and coincide more often than
+on a device; slack then breaks that up and can cost wakeups.
+"""
+
+import argparse
+import random
+import sys
+
+
+def align(due, slack, next_wake):
+    """Tick a timeout due at 'due' ends on, as delay()/Clock_start()."""
+    if slack == 0:
+        return due
+    if next_wake is not None and due <= next_wake <= due + slack:
+        return next_wake
+    a = 1 << ((slack + 1).bit_length() - 1)
+    return (due + slack) & ~(a - 1)
+
+
+class Timer(object):
+    def __init__(self, spec, tick_us, slack, clock_slack):
+        self.spec = spec
+        self.kind = spec[0] if spec[0] in "dcp" else ""
+        fields = spec.lstrip("dcp").split(":")
+        to_ticks = lambda ms: int(round(float(ms) * 1000 / tick_us))
+        self.period = to_ticks(fields[0])
+        if self.period <= 0:
+            raise ValueError("period must be positive: " + spec)
+        self.slack = {"d": slack, "c": clock_slack,
+                      "p": clock_slack}.get(self.kind, 0)
+        self.fires = 0
+        self.late_max = 0
+        self.late_sum = 0
+        phase = to_ticks(fields[1]) if len(fields) > 1 else 0
+        self.due = phase + self.period
+        self.wake = align(self.due, self.slack, None)
+        # a periodic Clock keeps the offset of its first timeout
+        self.offset = self.wake - self.due
+
+    def fire(self, now, next_wake, work):
+        late = now - self.due
+        self.fires += 1
+        self.late_max = max(self.late_max, late)
+        self.late_sum += late
+        if self.kind in "dc":
+            self.due = now + work + self.period
+            self.wake = align(self.due, self.slack, next_wake)
+        else:
+            self.due += self.period
+            self.wake = self.due + (self.offset if self.kind == "p" else 0)
+
+
+def simulate(specs, args, slack, clock_slack):
+    timers = [Timer(s, args.tick_us, slack, clock_slack) for s in specs]
+    rnd = random.Random(1)
+    work = int(args.work * 1000 / args.tick_us)
+    end = int(args.seconds * 1e6 / args.tick_us)
+    wakeups = 0
+
+    while True:
+        now = min(t.wake for t in timers)
+        if now > end:
+            break
+        wakeups += 1
+        for t in timers:
+            if t.wake == now:
+                # the wakeup the kernel has scheduled next
+                later = [u.wake for u in timers if u.wake > now]
+                t.fire(now, min(later) if later else None,
+                       rnd.randint(0, work))
+
+    return wakeups, timers
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("timers", nargs="+", help="[d|c|p]PERIOD[:PHASE] in ms")
+    ap.add_argument("--slack", type=float, default=0,
+                    help="setTimerSlack() in ms (default 0)")
+    ap.add_argument("--clock-slack", type=float, default=0,
+                    help="Clock_setSlack() in ms (default 0)")
+    ap.add_argument("--work", type=float, default=0,
+                    help="delay loops and restarting Clocks run up to this\n"
+                         "many ms before they sleep again (default 0)")
+    ap.add_argument("--seconds", type=float, default=60,
+                    help="simulated time (default 60)")
+    ap.add_argument("--tick-us", type=float, default=10,
+                    help="Clock.tickPeriod in microseconds (default 10)")
+    args = ap.parse_args()
+
+    to_slack = lambda ms: min(int(ms * 1000 / args.tick_us), 0x7FFFFFFF)
+    slack = to_slack(args.slack)
+    clock_slack = to_slack(args.clock_slack)
+
+    try:
+        base, _ = simulate(args.timers, args, 0, 0)
+        wakeups, timers = simulate(args.timers, args, slack, clock_slack)
+    except ValueError as e:
+        sys.exit(str(e))
+
+    ms = args.tick_us / 1000.0
+    print("%-16s %8s %10s %10s" % ("timer", "runs", "late avg", "late max"))
+    for t in timers:
+        avg = float(t.late_sum) / t.fires if t.fires else 0
+        print("%-16s %8d %8.2fms %8.2fms" %
+              (t.spec, t.fires, avg * ms, t.late_max * ms))
+    print("")
+    print("wakeups without slack %8d  (%.2f/s)" %
+          (base, base / args.seconds))
+    print("wakeups with slack    %8d  (%.2f/s)" %
+          (wakeups, wakeups / args.seconds))
+    if base:
+        print("saved                 %7.1f%%" % (100.0 * (base - wakeups) / base))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017, Texas Instruments Incorporated
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# *  Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# *  Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# *  Neither the name of Texas Instruments Incorporated nor the names of
+#    its contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+# THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+# OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+# OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Decode event traces recorded with wiring_trace.c into Chrome trace-event
+JSON (load it in chrome://tracing or https://ui.perfetto.dev).
+
+Input is either the byte stream written by traceDrain()/traceDrainTo(),
+possibly interleaved with other serial output, or a raw RAM dump that
+contains the traceLog structure (--dump).
+
+    trace2json.py capture.bin -o trace.json
+    trace2json.py --dump ram.bin --cpu-hz 48000000 -e 16=rx_packet
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+FRAME_SYNC = 0xA5
+TRACE_MAGIC = b"TRC1"
+HDR_ABS = 0x8
+
+CTX_NAMES = ["Hwi", "Swi", "Task"]
+
+ID_TASK_SWITCH = 1
+ID_SWI_BEGIN = 2
+ID_SWI_END = 3
+ID_HWI_BEGIN = 4
+ID_HWI_END = 5
+
+
+def varint(buf, pos):
+    """Return (value, next pos), or (None, pos) if buf ends first."""
+    value = 0
+    shift = 0
+    while pos < len(buf):
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if b < 0x80:
+            return value, pos
+        shift += 7
+        if shift > 35:
+            break
+    return None, pos
+
+
+def read_stream(data, num_ctx=3):
+    """Collect the ring bytes of each context from traceDrain() frames."""
+    rings = [bytearray() for _ in range(num_ctx)]
+    dropped = [0] * num_ctx
+    pos = 0
+    while pos < len(data):
+        if data[pos] != FRAME_SYNC or pos + 1 >= len(data) \
+                or data[pos + 1] >= num_ctx:
+            pos += 1
+            continue
+        ctx = data[pos + 1]
+        drops, p = varint(data, pos + 2)
+        count, p = varint(data, p)
+        if drops is None or count is None or p + count > len(data):
+            pos += 1
+            continue
+        rings[ctx] += data[p:p + count]
+        dropped[ctx] = drops
+        pos = p + count
+    return rings, dropped, [None] * num_ctx
+
+
+def read_dump(data):
+    """Collect the unread ring bytes of each context from a RAM dump."""
+    base = data.find(TRACE_MAGIC)
+    if base < 0:
+        sys.exit("trace2json: no traceLog found in dump")
+    ring_size, num_ctx, _enabled = struct.unpack_from("<III", data, base + 4)
+    pos = base + 16
+    rings = []
+    dropped = []
+    anchors = []
+    for _ in range(num_ctx):
+        (_reserve, commit, tail, _writers, last, last_end,
+         drops) = struct.unpack_from("<7I", data, pos)
+        ring = data[pos + 28:pos + 28 + ring_size]
+        rings.append(bytes(ring[(tail + i) % ring_size]
+                           for i in range((commit - tail) & 0xFFFFFFFF)))
+        dropped.append(drops)
+        # the record ending at last_end was logged at time last
+        anchors.append(((last_end - tail) & 0xFFFFFFFF, last))
+        pos += 28 + ((ring_size + 3) & ~3)
+    return rings, dropped, anchors
+
+
+def parse_ring(buf, anchor=None):
+    """Yield (cycles, id, args) with cycles unwrapped to 64 bits.
+
+    Records that precede the first absolute timestamp are relative to
+    records no longer in buf.  They are placed using anchor, the
+    (end offset, time) of one of them, if given, and dropped otherwise.
+    """
+    now = None
+    pending = []
+    rel = 0
+    pos = 0
+    while pos < len(buf):
+        hdr, pos = varint(buf, pos)
+        time, pos = varint(buf, pos)
+        if hdr is None or time is None:
+            return
+        args = []
+        for _ in range(hdr & 0x7):
+            arg, pos = varint(buf, pos)
+            if arg is None:
+                return
+            args.append(arg)
+        if hdr & HDR_ABS:
+            pending = []
+            if now is None:
+                now = time
+            else:
+                wrapped = (now & ~0xFFFFFFFF) | time
+                if wrapped < now:
+                    wrapped += 1 << 32
+                now = wrapped
+        elif now is None:
+            rel += time
+            pending.append((rel, hdr >> 4, args))
+            if anchor is None or anchor[0] != pos:
+                continue
+            for cycles, ev, ev_args in pending:
+                yield anchor[1] - rel + cycles, ev, ev_args
+            now = anchor[1]
+            pending = []
+            continue
+        else:
+            now += time
+        yield now, hdr >> 4, args
+
+
+def to_chrome(rings, anchors, cpu_hz, names):
+    events = []
+    threads = {}
+    running = {}
+
+    def thread(kind, handle):
+        key = (kind, handle)
+        if key not in threads:
+            threads[key] = len(threads) + 1
+        return threads[key]
+
+    def usec(cycles):
+        return cycles * 1e6 / cpu_hz
+
+    for ctx, buf in enumerate(rings):
+        ctx_name = CTX_NAMES[ctx] if ctx < len(CTX_NAMES) else str(ctx)
+        for cycles, ev, args in parse_ring(buf, anchors[ctx]):
+            ts = usec(cycles)
+            if ev == ID_TASK_SWITCH and len(args) == 2:
+                prev, nxt = args
+                if running.get("Task") is not None:
+                    events.append({"name": "Task 0x%08x" % prev, "ph": "E",
+                                   "pid": 0, "ts": ts,
+                                   "tid": thread("Task", prev)})
+                events.append({"name": "Task 0x%08x" % nxt, "ph": "B",
+                               "pid": 0, "ts": ts,
+                               "tid": thread("Task", nxt)})
+                running["Task"] = nxt
+            elif ev in (ID_SWI_BEGIN, ID_SWI_END, ID_HWI_BEGIN, ID_HWI_END) \
+                    and len(args) == 1:
+                kind = "Swi" if ev in (ID_SWI_BEGIN, ID_SWI_END) else "Hwi"
+                phase = "B" if ev in (ID_SWI_BEGIN, ID_HWI_BEGIN) else "E"
+                events.append({"name": "%s 0x%08x" % (kind, args[0]),
+                               "ph": phase, "pid": 0, "ts": ts,
+                               "tid": thread(kind, args[0])})
+            else:
+                events.append({"name": names.get(ev, "event %d" % ev),
+                               "ph": "i", "s": "t", "pid": 0, "ts": ts,
+                               "tid": thread(ctx_name, None),
+                               "args": dict(("a%d" % i, a)
+                                            for i, a in enumerate(args))})
+
+    events.sort(key=lambda e: e["ts"])
+
+    for (kind, handle), tid in threads.items():
+        name = kind if handle is None else "%s 0x%08x" % (kind, handle)
+        events.append({"name": "thread_name", "ph": "M", "pid": 0,
+                       "tid": tid, "args": {"name": name}})
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("input", help="drained trace stream or RAM dump")
+    ap.add_argument("-o", "--output", help="JSON file (default stdout)")
+    ap.add_argument("--dump", action="store_true",
+                    help="input is a RAM dump holding traceLog")
+    ap.add_argument("--cpu-hz", type=float, default=48e6,
+                    help="CPU clock in Hz (default 48 MHz)")
+    ap.add_argument("-e", "--event", action="append", default=[],
+                    metavar="ID=NAME", help="name a user event id")
+    opts = ap.parse_args()
+
+    names = {}
+    for spec in opts.event:
+        ev, _, name = spec.partition("=")
+        names[int(ev, 0)] = name
+
+    with open(opts.input, "rb") as f:
+        data = f.read()
+
+    rings, dropped, anchors = \
+        read_dump(data) if opts.dump else read_stream(data)
+    trace = to_chrome(rings, anchors, opts.cpu_hz, names)
+
+    for ctx, drops in enumerate(dropped):
+        if drops:
+            print("trace2json: %d %s records dropped" %
+                  (drops, CTX_NAMES[ctx] if ctx < 3 else ctx),
+                  file=sys.stderr)
+
+    out = open(opts.output, "w") if opts.output else sys.stdout
+    json.dump(trace, out, indent=1)
+    out.write("\n")
+    if opts.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,692 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== trace_vectors.c ========
+ *  Host test vectors for cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_trace.c
+ *  and extras/trace2json.py
+ *
+ *  Builds the real tracer against a mocked kernel and cycle counter and
+ *  with LDREX/STREX replaced by a simulated exclusive monitor. Before
+ *  and after every exclusive access, and at every cycle counter read,
+ *  the writer may be preempted by a nested Hwi, Swi or Task that logs
+ *  records of its own, into its own ring or the same one; preemption
+ *  clears the monitor as exception entry does on the CPU. Every record
+ *  that claims ring space is noted with the time it read and its
+ *  arguments.
+ *
+ *  The rings are drained in random sized pieces, also by a Task that
+ *  preempts one in the middle of a record, mixed with other text as on
+ *  a serial port, and drained rarely enough at times that they
+ *  overflow. The cycle counter wraps several times and one run starts
+ *  the ring positions just short of their 2^32 wrap. trace2json.py then
+ *  decodes the drained stream and a RAM dump of traceLog taken after a
+ *  partial drain, and every record it returns must match the noted one
+ *  in order, arguments and time (up to the multiple of 2^32 cycles the
+ *  decoder cannot see, which must stay the same between records of a
+ *  ring less than 2^32 cycles apart). From the dump it can only place
+ *  the records from the first one with an absolute timestamp on, or, if
+ *  there is none, all of them from the time traceLog keeps for the last
+ *  one. Dropped
+ *  record counts and the number of Chrome trace events are checked as
+ *  well.
+ *
+ *  Preemption is strictly nested. Tasks of equal priority interleaving
+ *  their records under round-robin scheduling, which the writer count
+ *  also guards against, are not simulated. The ~40 cycle cost of a
+ *  record on the CC13xx is not measured here either.
+ *
+ *  Build from the repository root and run (needs python3):
+ *
+ *      cc -O2 -o trace_vectors -Icores/cc13xx -Isystem/source \
+ *          -Isystem/kernel/tirtos/packages extras/trace_vectors.c
+ *      ./trace_vectors
+ *
+ *  Exits with 0 if all vectors match.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *  ======== Mocks ========
+ *  Stand-ins for the headers wiring_trace.c includes.
+ */
+#define ti_sysbios_BIOS__include
+#define ti_sysbios_BIOS__localnames__done
+#define ti_sysbios_knl_Task__include
+#define ti_sysbios_knl_Task__localnames__done
+#define ti_sysbios_knl_Swi__include
+#define ti_sysbios_knl_Swi__localnames__done
+#define ti_sysbios_family_arm_m3_Hwi__include
+#define ti_sysbios_family_arm_m3_Hwi__localnames__done
+#define __HW_TYPES_H__
+#define __HW_MEMMAP_H__
+#define __HW_CPU_DWT_H__
+
+/* use the simulated exclusive monitor below */
+#define TRACE_HOST_EXCLUSIVES
+
+#define BIOS_ThreadType_Hwi     0
+#define BIOS_ThreadType_Swi     1
+#define BIOS_ThreadType_Task    2
+
+/* 32-bit handles, as on the target */
+typedef uint32_t Task_Handle;
+typedef uint32_t Swi_Handle;
+typedef uint32_t Hwi_Handle;
+
+#define CPU_DWT_BASE            0xE0001000
+#define CPU_DWT_O_CYCCNT        0x00000004
+#define HWREG(x)                mockRead(x)
+
+static uint32_t mockRead(uint32_t addr);
+static int BIOS_getThreadType(void);
+static uint32_t traceLdrex(volatile uint32_t *addr);
+static uint32_t traceStrex(volatile uint32_t *addr, uint32_t value);
+static void traceClrex(void);
+
+#include "../cores/cc13xx/ti/runtime/wiring/cc13xx/wiring_trace.c"
+
+static unsigned failures = 0;
+static unsigned vectors = 0;
+
+static void fail(const char *what, long long a, long long b, long long c)
+{
+    if (failures++ < 20) {
+        printf("FAIL %s: %lld got %lld expected %lld\n", what, a, b, c);
+    }
+}
+
+static uint32_t rndState = 1;
+
+static uint32_t rnd(void)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+
+    return (rndState);
+}
+
+/*
+ *  ======== Thread simulator ========
+ *  Level 0 is the Task that logs and drains; each preemption runs one
+ *  level deeper, in a context at least as urgent as the one it preempts.
+ */
+#define MAX_LEVEL       4
+#define MAX_RECORDS     200000
+
+typedef struct Record {
+    uint32_t pos;       /* ring position claimed */
+    uint64_t time;      /* cycle count read by the claim */
+    uint32_t id;
+    uint32_t nargs;
+    uint32_t args[4];
+    bool absolute;      /* logged with absolute time */
+} Record;
+
+static Record records[TRACE_NUM_CTX][MAX_RECORDS];
+static unsigned numRecords[TRACE_NUM_CTX];
+static unsigned expectDrops[TRACE_NUM_CTX];
+static unsigned numTaskSwitches;
+static unsigned numPreemptions;
+
+static uint64_t now;                    /* the cycle counter, unwrapped */
+static volatile uint32_t *monitor;      /* held by the last traceLdrex() */
+static int level;
+static int levelCtx[MAX_LEVEL + 1];
+static uint64_t levelTime[MAX_LEVEL + 1];
+static Record levelEvent[MAX_LEVEL + 1];
+static bool levelClaimed[MAX_LEVEL + 1];
+static unsigned preemptOdds;
+
+static void runThread(int ctx);
+static void drain(size_t size);
+
+/* an interrupt may be taken here; its entry and return clear the monitor */
+static void maybePreempt(void)
+{
+    int ctx;
+
+    if (level >= MAX_LEVEL || preemptOdds == 0
+        || rnd() % (preemptOdds << level) != 0) {
+        return;
+    }
+
+    /* a Hwi, a Swi or (at exception return) a Task */
+    ctx = rnd() % (levelCtx[level] + 1);
+    numPreemptions++;
+
+    level++;
+    levelCtx[level] = ctx;
+    runThread(ctx);
+    level--;
+
+    monitor = NULL;
+}
+
+static uint32_t mockRead(uint32_t addr)
+{
+    if (addr != CPU_DWT_BASE + CPU_DWT_O_CYCCNT) {
+        fail("register read", addr, 0, 0);
+    }
+
+    maybePreempt();
+
+    /* mostly short steps, now and then a long one */
+    now += (rnd() % 64 == 0) ? rnd() % (1 << 22) : 1 + rnd() % 200;
+    levelTime[level] = now;
+
+    return ((uint32_t)now);
+}
+
+static int BIOS_getThreadType(void)
+{
+    return (levelCtx[level]);
+}
+
+static uint32_t traceLdrex(volatile uint32_t *addr)
+{
+    maybePreempt();
+    monitor = addr;
+
+    return (*addr);
+}
+
+static uint32_t traceStrex(volatile uint32_t *addr, uint32_t value)
+{
+    TraceRing *r;
+    Record *rec;
+    int ctx;
+
+    maybePreempt();
+
+    if (monitor != addr) {
+        return (1);
+    }
+    monitor = NULL;
+
+    /* a successful claim: note the record the current level is logging */
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        r = &traceLog.ring[ctx];
+        if (addr == &r->reserve) {
+            if (levelClaimed[level]) {
+                fail("second claim", ctx, level, 0);
+            }
+            levelClaimed[level] = true;
+            if (numRecords[ctx] == MAX_RECORDS) {
+                fail("too many records", ctx, MAX_RECORDS, 0);
+                exit(1);
+            }
+            rec = &records[ctx][numRecords[ctx]++];
+            *rec = levelEvent[level];
+            rec->pos = *addr;
+            rec->time = levelTime[level];
+            rec->absolute = (r->lastEnd != rec->pos);
+        }
+    }
+
+    *addr = value;
+
+    maybePreempt();
+
+    return (0);
+}
+
+static void traceClrex(void)
+{
+    monitor = NULL;
+}
+
+static uint32_t randomArg(void)
+{
+    switch (rnd() % 4) {
+        case 0:
+            return (rnd() % 128);
+        case 1:
+            return (rnd() % 20000);
+        case 2:
+            return (0xFFFFFFFF - rnd() % 4);
+        default:
+            return (rnd());
+    }
+}
+
+/* log one record from a thread of context ctx at the current level */
+static void logEvent(int ctx)
+{
+    Record *ev = &levelEvent[level];
+    uint32_t i;
+
+    memset(ev, 0, sizeof(*ev));
+    ev->nargs = rnd() % 5;
+    if (ev->nargs == 3) {
+        ev->nargs = 4;
+    }
+    for (i = 0; i < ev->nargs; i++) {
+        ev->args[i] = randomArg();
+    }
+
+    /* the kernel hooks log into the ring of their own context */
+    if (rnd() % 3 == 0) {
+        ev->nargs = (ctx == TRACE_CTX_TASK) ? 2 : 1;
+        ev->args[0] = rnd();
+        ev->args[1] = rnd();
+    }
+    else {
+        ev->id = TRACE_ID_USER + rnd() % 100;
+    }
+
+    levelClaimed[level] = false;
+
+    if (ev->id != 0) {
+        switch (ev->nargs) {
+            case 0:
+                traceEvent0(ev->id);
+                break;
+            case 1:
+                traceEvent1(ev->id, ev->args[0]);
+                break;
+            case 2:
+                traceEvent2(ev->id, ev->args[0], ev->args[1]);
+                break;
+            default:
+                traceEvent4(ev->id, ev->args[0], ev->args[1], ev->args[2],
+                    ev->args[3]);
+                break;
+        }
+    }
+    else if (ctx == TRACE_CTX_TASK) {
+        ev->id = TRACE_ID_TASK_SWITCH;
+        traceTaskSwitch(ev->args[0],
+            ev->args[1]);
+    }
+    else if (ctx == TRACE_CTX_SWI) {
+        ev->id = (rnd() & 1) ? TRACE_ID_SWI_BEGIN : TRACE_ID_SWI_END;
+        if (ev->id == TRACE_ID_SWI_BEGIN) {
+            traceSwiBegin(ev->args[0]);
+        }
+        else {
+            traceSwiEnd(ev->args[0]);
+        }
+    }
+    else {
+        ev->id = (rnd() & 1) ? TRACE_ID_HWI_BEGIN : TRACE_ID_HWI_END;
+        if (ev->id == TRACE_ID_HWI_BEGIN) {
+            traceHwiBegin(ev->args[0]);
+        }
+        else {
+            traceHwiEnd(ev->args[0]);
+        }
+    }
+
+    if (levelClaimed[level]) {
+        if (ev->id == TRACE_ID_TASK_SWITCH) {
+            numTaskSwitches++;
+        }
+    }
+    else {
+        expectDrops[ctx]++;
+    }
+}
+
+static void runThread(int ctx)
+{
+    int n = 1 + rnd() % 3;
+
+    /*
+     * the draining Task may preempt a Task in the middle of a record;
+     * it is still the only reader
+     */
+    if (ctx == TRACE_CTX_TASK && rnd() % 4 == 0) {
+        drain(1 + rnd() % 200);
+    }
+
+    while (n--) {
+        logEvent(ctx);
+    }
+}
+
+/*
+ *  ======== Output ========
+ */
+static FILE *stream;
+
+/* other serial output; never the frame sync byte */
+static void writeNoise(void)
+{
+    static const char text[] = "rx ok 42\r\nlink up\r\n";
+    size_t len = rnd() % sizeof(text);
+
+    fwrite(text, 1, len, stream);
+}
+
+static void drain(size_t size)
+{
+    uint8_t buf[2048];
+    size_t count;
+
+    count = traceDrain(buf, size);
+    fwrite(buf, 1, count, stream);
+}
+
+/*
+ *  ======== Decoder check ========
+ *  trace2json.py prints the records it decodes, one per line:
+ *  "<kind> <ctx> <cycles> <id> <args>...", then "<kind>drops" lines.
+ */
+static const char checkScript[] =
+    "import sys\n"
+    "sys.path.insert(0, 'extras')\n"
+    "import trace2json as t\n"
+    "def show(kind, rings, dropped, anchors):\n"
+    "    for ctx, buf in enumerate(rings):\n"
+    "        for cycles, ev, args in t.parse_ring(buf, anchors[ctx]):\n"
+    "            print(kind, ctx, cycles, ev, *args)\n"
+    "    print(kind + 'drops', *dropped)\n"
+    "    trace = t.to_chrome(rings, anchors, 1e6, {})\n"
+    "    print(kind + 'events', sum(e['ph'] != 'M'\n"
+    "                                for e in trace['traceEvents']))\n"
+    "show('s', *t.read_stream(open(sys.argv[1], 'rb').read()))\n"
+    "show('m', *t.read_dump(open(sys.argv[2], 'rb').read()))\n";
+
+typedef struct Check {
+    unsigned next[TRACE_NUM_CTX];       /* next record expected per ring */
+    int64_t offset[TRACE_NUM_CTX];      /* decoded minus real cycles */
+    uint64_t last[TRACE_NUM_CTX];       /* real cycles of the last record */
+    bool haveOffset[TRACE_NUM_CTX];
+} Check;
+
+static void checkRecord(Check *c, const char *kind, int ctx,
+    long long cycles, uint32_t id, uint32_t *args, int nargs)
+{
+    const char *from = (kind[0] == 'm') ? "dump" : "stream";
+    char what[32];
+    Record *rec;
+    int64_t offset;
+    int i;
+
+    vectors++;
+
+    if (ctx < 0 || ctx >= TRACE_NUM_CTX || c->next[ctx] >= numRecords[ctx]) {
+        snprintf(what, sizeof(what), "%s extra record", from);
+        fail(what, ctx, c->next[ctx], numRecords[ctx]);
+        return;
+    }
+
+    rec = &records[ctx][c->next[ctx]++];
+
+    if (id != rec->id || nargs != (int)rec->nargs) {
+        snprintf(what, sizeof(what), "%s id", from);
+        fail(what, c->next[ctx] - 1, id, rec->id);
+        return;
+    }
+    for (i = 0; i < nargs; i++) {
+        if (args[i] != rec->args[i]) {
+            snprintf(what, sizeof(what), "%s arg", from);
+            fail(what, c->next[ctx] - 1, args[i], rec->args[i]);
+        }
+    }
+
+    /* whole wraps between records 2^32 cycles apart cannot be told */
+    if (rec->time - c->last[ctx] >= ((uint64_t)1 << 32)) {
+        c->haveOffset[ctx] = false;
+    }
+    c->last[ctx] = rec->time;
+
+    offset = (int64_t)cycles - (int64_t)rec->time;
+    if ((offset & 0xFFFFFFFF) != 0) {
+        snprintf(what, sizeof(what), "%s time", from);
+        fail(what, c->next[ctx] - 1, cycles, rec->time);
+    }
+    else if (c->haveOffset[ctx] && offset != c->offset[ctx]) {
+        snprintf(what, sizeof(what), "%s time unwrap", from);
+        fail(what, c->next[ctx] - 1, offset, c->offset[ctx]);
+    }
+    c->offset[ctx] = offset;
+    c->haveOffset[ctx] = true;
+}
+
+static void checkDecoder(const char *streamName, const char *dumpName,
+    const unsigned *dumpFirst)
+{
+    char cmd[256], line[512], kind[16];
+    Check checks[2];
+    Check *c;
+    FILE *py, *out;
+    unsigned expectEvents, drops[TRACE_NUM_CTX];
+    uint32_t args[4], id;
+    long long cycles;
+    int ctx, n, pos, nargs;
+
+    snprintf(cmd, sizeof(cmd), "python3 - %s %s > %s.out",
+        streamName, dumpName, streamName);
+    py = popen(cmd, "w");
+    if (py == NULL) {
+        fail("python3", 0, 0, 0);
+        return;
+    }
+    fputs(checkScript, py);
+    if (pclose(py) != 0) {
+        fail("trace2json.py", 0, 1, 0);
+        return;
+    }
+
+    snprintf(cmd, sizeof(cmd), "%s.out", streamName);
+    out = fopen(cmd, "r");
+    if (out == NULL) {
+        fail("decoder output", 0, 0, 0);
+        return;
+    }
+
+    memset(checks, 0, sizeof(checks));
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        checks[1].next[ctx] = dumpFirst[ctx];
+    }
+
+    /* every decoded event plus an end for all but the first Task switch */
+    expectEvents = numTaskSwitches;
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        expectEvents += numRecords[ctx];
+    }
+    expectEvents -= numTaskSwitches ? 1 : 0;
+
+    while (fgets(line, sizeof(line), out) != NULL) {
+        if (sscanf(line, "%15s%n", kind, &pos) != 1) {
+            continue;
+        }
+        c = &checks[kind[0] == 'm'];
+
+        if (strcmp(kind + 1, "drops") == 0) {
+            n = sscanf(line + pos, "%u %u %u", &drops[0], &drops[1],
+                &drops[2]);
+            for (ctx = 0; ctx < n; ctx++) {
+                vectors++;
+                /* a frame carries the count at the time it was drained */
+                if (kind[0] == 'm' ? drops[ctx] != expectDrops[ctx]
+                                   : drops[ctx] > expectDrops[ctx]) {
+                    fail(kind, ctx, drops[ctx], expectDrops[ctx]);
+                }
+            }
+        }
+        else if (strcmp(kind + 1, "events") == 0) {
+            vectors++;
+            sscanf(line + pos, "%d", &n);
+            /* the dump holds fewer events; only the stream is counted */
+            if (kind[0] == 's' && (unsigned)n != expectEvents) {
+                fail("Chrome trace events", 0, n, expectEvents);
+            }
+        }
+        else {
+            nargs = sscanf(line + pos, "%d %lld %u %u %u %u %u", &ctx,
+                &cycles, &id, &args[0], &args[1], &args[2], &args[3]) - 3;
+            if (nargs < 0) {
+                fail("decoder line", 0, 0, 0);
+                continue;
+            }
+            checkRecord(c, kind, ctx, cycles, id, args, nargs);
+        }
+    }
+    fclose(out);
+    remove(cmd);
+
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        if (checks[0].next[ctx] != numRecords[ctx]) {
+            fail("stream records", ctx, checks[0].next[ctx], numRecords[ctx]);
+        }
+        if (checks[1].next[ctx] != numRecords[ctx]) {
+            fail("dump records", ctx, checks[1].next[ctx], numRecords[ctx]);
+        }
+    }
+}
+
+/*
+ *  ======== testRun ========
+ *  Log events events from the Task, preempted once every odds hook
+ *  calls on average, with rings starting at position start.
+ */
+static void testRun(unsigned events, unsigned odds, uint32_t start)
+{
+    static const char streamName[] = "trace_vectors.stream";
+    static const char dumpName[] = "trace_vectors.dump";
+    unsigned dumpFirst[TRACE_NUM_CTX];
+    unsigned i, first, drainOdds;
+    uint32_t tail;
+    TraceRing *r;
+    FILE *dump;
+    int ctx;
+
+    memset(numRecords, 0, sizeof(numRecords));
+    memset(expectDrops, 0, sizeof(expectDrops));
+    numTaskSwitches = 0;
+    now = ((uint64_t)1 << 32) - (rnd() % 100000);
+    monitor = NULL;
+    level = 0;
+    levelCtx[0] = TRACE_CTX_TASK;
+    preemptOdds = odds;
+
+    traceStart();
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        r = &traceLog.ring[ctx];
+        r->reserve = r->commit = r->tail = start;
+    }
+
+    stream = fopen(streamName, "wb");
+    if (stream == NULL) {
+        fail("stream file", 0, 0, 0);
+        return;
+    }
+
+    for (i = 0; i < events; i++) {
+        logEvent(TRACE_CTX_TASK);
+
+        /* drain often, then so rarely that the rings overflow */
+        drainOdds = ((i / 5000) & 1) ? 400 : 4;
+        if (rnd() % drainOdds == 0) {
+            writeNoise();
+            drain(1 + rnd() % 200);
+        }
+    }
+
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        r = &traceLog.ring[ctx];
+        vectors++;
+        if (r->writers != 0 || r->commit != r->reserve) {
+            fail("unpublished records", ctx, r->commit, r->reserve);
+        }
+    }
+
+    /* leave part of the records in the rings for the dump */
+    drain(100);
+
+    for (ctx = 0; ctx < TRACE_NUM_CTX; ctx++) {
+        tail = traceLog.ring[ctx].tail;
+        for (i = 0; i < numRecords[ctx]
+             && records[ctx][i].pos - start < tail - start; i++) {
+        }
+
+        /* leading relative records can only be placed if none follows */
+        for (first = i; i < numRecords[ctx] && !records[ctx][i].absolute;
+             i++) {
+        }
+        dumpFirst[ctx] = (i < numRecords[ctx]) ? i : first;
+        vectors++;
+        if (traceDropped(ctx) != expectDrops[ctx]) {
+            fail("traceDropped", ctx, traceDropped(ctx), expectDrops[ctx]);
+        }
+    }
+
+    dump = fopen(dumpName, "wb");
+    if (dump == NULL) {
+        fail("dump file", 0, 0, 0);
+        fclose(stream);
+        return;
+    }
+    fwrite(&traceLog, sizeof(traceLog), 1, dump);
+    fclose(dump);
+
+    drain(sizeof(traceLog));
+    fclose(stream);
+
+    checkDecoder(streamName, dumpName, dumpFirst);
+
+    remove(streamName);
+    remove(dumpName);
+
+    /* only preempting threads log into the Hwi and Swi rings */
+    for (ctx = odds ? 0 : TRACE_CTX_TASK; ctx < TRACE_NUM_CTX; ctx++) {
+        if (numRecords[ctx] == 0 || expectDrops[ctx] == 0) {
+            fail("ring not exercised", ctx, numRecords[ctx], expectDrops[ctx]);
+        }
+    }
+}
+
+int main(void)
+{
+    /* no preemption, then preemption at one hook call in 20 and in 6 */
+    testRun(40000, 0, 0);
+    testRun(20000, 20, 0);
+    testRun(20000, 6, 0);
+
+    /* ring positions wrapping past 2^32 */
+    testRun(20000, 6, 0xFFFFFFFF - 3000);
+
+    printf("%u preemptions, %u vectors, %u failures\n", numPreemptions,
+        vectors, failures);
+
+    return (failures ? 1 : 0);
+}
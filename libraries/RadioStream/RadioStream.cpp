@@ -0,0 +1,181 @@
+/*
+ RadioStream.cpp - Packet streaming over the CC13xx radio for Energia
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RadioStream.h"
+
+#include <string.h>
+
+// uint32_t arrays keep the pools 4-byte aligned as RFStream requires
+static uint32_t rxPool[(RFStream_RX_BUFFER_SIZE(RADIOSTREAM_RX_PACKETS, RADIOSTREAM_MAX_PACKET) + 3) / 4];
+static uint32_t txPool[(RFStream_TX_BUFFER_SIZE(RADIOSTREAM_TX_PACKETS, RADIOSTREAM_MAX_PACKET) + 3) / 4];
+
+RadioStreamClass RadioStream;
+
+RadioStreamClass::RadioStreamClass()
+{
+	rfHandle = NULL;
+	stream = NULL;
+	lastRssi = RF_GET_RSSI_ERROR_VAL;
+}
+
+bool RadioStreamClass::begin(RF_Mode *mode, rfc_CMD_PROP_RADIO_DIV_SETUP_t *setup, rfc_CMD_FS_t *fs, uint32_t syncWord)
+{
+	return begin(mode, (RF_RadioSetup *)setup, fs, syncWord);
+}
+
+bool RadioStreamClass::begin(RF_Mode *mode, RF_RadioSetup *setup, rfc_CMD_FS_t *fs, uint32_t syncWord)
+{
+	RF_Params rfParams;
+	RFStream_Params params;
+
+	if (stream != NULL) {
+		end();
+	}
+
+	RF_Params_init(&rfParams);
+	rfHandle = RF_open(&rfObject, mode, setup, &rfParams);
+	if (rfHandle == NULL) {
+		return false;
+	}
+
+	// The synth must be programmed before the first RX/TX command
+	if (!(RF_runCmd(rfHandle, (RF_Op *)fs, RF_PriorityNormal, NULL, 0) & RF_EventLastCmdDone)) {
+		RF_close(rfHandle);
+		rfHandle = NULL;
+		return false;
+	}
+
+	RFStream_Params_init(&params);
+	params.rxBuf = rxPool;
+	params.rxBufSize = sizeof(rxPool);
+	params.txBuf = txPool;
+	params.txBufSize = sizeof(txPool);
+	params.maxPacketLen = RADIOSTREAM_MAX_PACKET;
+	params.syncWord = syncWord;
+
+	stream = RFStream_open(&streamObject, rfHandle, &params);
+	if (stream == NULL) {
+		RF_close(rfHandle);
+		rfHandle = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+void RadioStreamClass::end()
+{
+	if (stream != NULL) {
+		RFStream_close(stream);
+		stream = NULL;
+	}
+	if (rfHandle != NULL) {
+		RF_close(rfHandle);
+		rfHandle = NULL;
+	}
+}
+
+// Queues one packet and sends it as soon as the radio is free. Returns 0
+// if len is 0 or larger than RADIOSTREAM_MAX_PACKET, or if all transmit
+// slots are taken; availableForWrite() tells how many are free. Call it
+// from one sketch thread only: RFStream_write() has a single writer.
+size_t RadioStreamClass::write(const uint8_t *buf, size_t len)
+{
+	if (stream == NULL) {
+		return 0;
+	}
+
+	len = RFStream_write(stream, buf, len);
+	if (len != 0) {
+		RFStream_flush(stream);
+	}
+
+	return len;
+}
+
+size_t RadioStreamClass::write(const char *str)
+{
+	return write((const uint8_t *)str, strlen(str));
+}
+
+int RadioStreamClass::availableForWrite()
+{
+	if (stream == NULL) {
+		return 0;
+	}
+
+	return RFStream_getTxSpace(stream);
+}
+
+// Waits until every queued packet has been sent
+void RadioStreamClass::flush()
+{
+	if (stream == NULL) {
+		return;
+	}
+
+	RFStream_flush(stream);
+	while (RFStream_getTxSpace(stream) < RADIOSTREAM_TX_PACKETS) {
+		delay(1);
+	}
+}
+
+// Number of received packets waiting to be read
+int RadioStreamClass::available()
+{
+	if (stream == NULL) {
+		return 0;
+	}
+
+	return RFStream_available(stream);
+}
+
+// Copies the oldest received packet into buf, truncated to len bytes, and
+// returns its full length, or -1 if there is none.
+int RadioStreamClass::read(uint8_t *buf, size_t len)
+{
+	int8_t packetRssi;
+	int n;
+
+	if (stream == NULL) {
+		return -1;
+	}
+
+	n = RFStream_read(stream, buf, len, &packetRssi);
+	if (n >= 0) {
+		lastRssi = packetRssi;
+	}
+
+	return n;
+}
+
+// RSSI of the last packet returned by read(), in dBm
+int8_t RadioStreamClass::rssi()
+{
+	return lastRssi;
+}
+
+// Number of received packets dropped because the pool was full
+unsigned long RadioStreamClass::overruns()
+{
+	if (stream == NULL) {
+		return 0;
+	}
+
+	return RFStream_getOverruns(stream);
+}
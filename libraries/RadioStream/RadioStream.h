@@ -0,0 +1,92 @@
+/*
+ RadioStream.h - Packet streaming over the CC13xx radio for Energia
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef RADIOSTREAM_H
+#define RADIOSTREAM_H
+
+#include "Energia.h"
+#include <ti/drivers/rf/RF.h>
+#include <ti/drivers/rf/RFStream.h>
+
+//
+// RadioStream is a thin wrapper around the RFStream driver: the receiver
+// runs continuously into a pool of RADIOSTREAM_RX_PACKETS buffers, and
+// every write() joins the next burst of up to RADIOSTREAM_TX_PACKETS
+// packets, sent as one chain of radio commands. write() must only be
+// called from one thread, such as one sketch tab's loop(); reading may
+// happen in another.
+//
+// The radio settings (RF_Mode, setup and frequency synthesizer commands)
+// come from the sketch, e.g. the smartrf_settings.c/.h pair exported by
+// SmartRF Studio added as tabs, as in the RadioStreamPing example:
+//
+//   RadioStream.begin(&RF_prop, &RF_cmdPropRadioDivSetup, &RF_cmdFs);
+//   ...
+//   if (RadioStream.availableForWrite()) {
+//       RadioStream.write(sample, sizeof(sample));
+//   }
+//   while (RadioStream.available()) {
+//       int len = RadioStream.read(packet, sizeof(packet));
+//       ...
+//   }
+//
+
+// Largest payload, in bytes (at most 255)
+#ifndef RADIOSTREAM_MAX_PACKET
+#define RADIOSTREAM_MAX_PACKET      64
+#endif
+
+// Receive pool size, in packets (at least 2)
+#ifndef RADIOSTREAM_RX_PACKETS
+#define RADIOSTREAM_RX_PACKETS      8
+#endif
+
+// Transmit ring size, in packets (at most RFStream_MAX_CHAIN_LEN)
+#ifndef RADIOSTREAM_TX_PACKETS
+#define RADIOSTREAM_TX_PACKETS      8
+#endif
+
+// Sync word used by the SmartRF Studio proprietary settings
+#define RADIOSTREAM_SYNC_WORD       0x930B51DE
+
+class RadioStreamClass
+{
+private:
+	RF_Object rfObject;
+	RF_Handle rfHandle;
+	RFStream_Object streamObject;
+	RFStream_Handle stream;
+	int8_t lastRssi;
+public:
+	RadioStreamClass();
+	bool begin(RF_Mode *mode, rfc_CMD_PROP_RADIO_DIV_SETUP_t *setup, rfc_CMD_FS_t *fs, uint32_t syncWord = RADIOSTREAM_SYNC_WORD);
+	bool begin(RF_Mode *mode, RF_RadioSetup *setup, rfc_CMD_FS_t *fs, uint32_t syncWord = RADIOSTREAM_SYNC_WORD);
+	void end();
+	size_t write(const uint8_t *buf, size_t len);
+	size_t write(const char *str);
+	int availableForWrite();
+	void flush();
+	int available();
+	int read(uint8_t *buf, size_t len);
+	int8_t rssi();
+	unsigned long overruns();
+};
+
+extern RadioStreamClass RadioStream;
+
+#endif // RADIOSTREAM_H
@@ -0,0 +1,60 @@
+// RadioStreamPing
+// Load this sketch on two CC1310 LaunchPads. Each board sends a
+// numbered packet every 100 ms and prints the packets it hears from
+// the other one, together with their RSSI.
+//
+// The radio settings are in the smartrf_settings.c and smartrf_settings.h
+// tabs: 868 MHz, 50 kbps 2-GFSK. Replace them with your own SmartRF Studio
+// export for another band or data rate.
+//
+// This example code is in the public domain.
+
+#include <RadioStream.h>
+#include "smartrf_settings.h"
+
+unsigned long sent = 0;
+unsigned long lastSend = 0;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  if (!RadioStream.begin(&RF_prop, &RF_cmdPropRadioDivSetup, &RF_cmdFs)) {
+    Serial.println("RadioStream.begin() failed");
+    while (1) {
+      delay(1000);
+    }
+  }
+}
+
+void loop()
+{
+  char packet[RADIOSTREAM_MAX_PACKET + 1];
+  int len;
+
+  // write() only queues the packet, so loop() never waits for the radio
+  if (millis() - lastSend >= 100 && RadioStream.availableForWrite() > 0) {
+    lastSend = millis();
+    String ping = "ping " + String(sent++);
+    RadioStream.write(ping.c_str());
+  }
+
+  while (RadioStream.available()) {
+    len = RadioStream.read((uint8_t *)packet, RADIOSTREAM_MAX_PACKET);
+    if (len < 0) {
+      break;
+    }
+    if (len > RADIOSTREAM_MAX_PACKET) {
+      len = RADIOSTREAM_MAX_PACKET;   // read() truncated it
+    }
+    packet[len] = '\0';
+
+    Serial.print(packet);
+    Serial.print("  RSSI ");
+    Serial.print(RadioStream.rssi());
+    Serial.print(" dBm  overruns ");
+    Serial.println(RadioStream.overruns());
+  }
+
+  delay(1);
+}
@@ -0,0 +1,130 @@
+//*********************************************************************************
+// Radio settings for RadioStreamPing, see smartrf_settings.h
+//*********************************************************************************
+
+#include <rf_patches/rf_patch_cpe_genfsk.h>
+#include <rf_patches/rf_patch_rfe_genfsk.h>
+#include "smartrf_settings.h"
+
+// TI-RTOS RF Mode Object
+RF_Mode RF_prop =
+{
+    .rfMode = RF_MODE_PROPRIETARY_SUB_1,
+    .cpePatchFxn = &rf_patch_cpe_genfsk,
+    .mcePatchFxn = 0,
+    .rfePatchFxn = &rf_patch_rfe_genfsk,
+};
+
+// Overrides for CMD_PROP_RADIO_DIV_SETUP
+static uint32_t pOverrides[] =
+{
+    // override_use_patch_prop_genfsk.xml
+    // PHY: Use MCE ROM bank 4, RFE RAM patch
+    MCE_RFE_OVERRIDE(0,4,0,1,0,0),
+    // override_synth_prop_863_930_div5.xml
+    // Synth: Set recommended RTRIM to 7
+    HW_REG_OVERRIDE(0x4038,0x0037),
+    // Synth: Set Fref to 4 MHz
+    (uint32_t)0x000684A3,
+    // Synth: Configure fine calibration setting
+    HW_REG_OVERRIDE(0x4020,0x7F00),
+    // Synth: Configure fine calibration setting
+    HW_REG_OVERRIDE(0x4064,0x0040),
+    // Synth: Configure fine calibration setting
+    (uint32_t)0xB1070503,
+    // Synth: Configure fine calibration setting
+    (uint32_t)0x05330523,
+    // Synth: Set loop bandwidth after lock to 20 kHz
+    (uint32_t)0x0A480583,
+    // Synth: Set loop bandwidth after lock to 20 kHz
+    (uint32_t)0x7AB80603,
+    // Synth: Configure VCO LDO (in ADI1, set VCOLDOCFG=0x9F to use voltage input reference)
+    ADI_REG_OVERRIDE(1,4,0x9F),
+    // Synth: Configure synth LDO (in ADI1, set SLDOCTL0.COMP_CAP=1)
+    ADI_HALFREG_OVERRIDE(1,7,0x4,0x4),
+    // Synth: Use 24 MHz XOSC as synth clock, enable extra PLL filtering
+    (uint32_t)0x02010403,
+    // Synth: Configure extra PLL filtering
+    (uint32_t)0x00108463,
+    // Synth: Increase synth programming timeout (0x04B0 RAT ticks = 300 us)
+    (uint32_t)0x04B00243,
+    // override_phy_rx_aaf_bw_0xd.xml
+    // Rx: Set anti-aliasing filter bandwidth to 0xD (in ADI0, set IFAMPCTL3[7:4]=0xD)
+    ADI_HALFREG_OVERRIDE(0,61,0xF,0xD),
+    // override_phy_gfsk_rx.xml
+    // Rx: Set LNA bias current trim offset to 3
+    (uint32_t)0x00038883,
+    // Rx: Freeze RSSI on sync found event
+    HW_REG_OVERRIDE(0x6084,0x35F1),
+    // override_phy_gfsk_pa_ramp_agc_reflevel_0x1a.xml
+    // Tx: Enable PA ramping (0x41). Rx: Set AGC reference level to 0x1A.
+    HW_REG_OVERRIDE(0x6088,0x411A),
+    // Tx: Configure PA ramping setting
+    HW_REG_OVERRIDE(0x608C,0x8213),
+    // override_phy_rx_rssi_offset_5db.xml
+    // Rx: Set RSSI offset to adjust reported RSSI by +5 dB
+    (uint32_t)0x00FB88A3,
+    // TX power override
+    // Tx: Set PA trim to max (in ADI0, set PACTL0=0xF8)
+    ADI_REG_OVERRIDE(0,12,0xF8),
+    (uint32_t)0xFFFFFFFF,
+};
+
+// CMD_PROP_RADIO_DIV_SETUP
+rfc_CMD_PROP_RADIO_DIV_SETUP_t RF_cmdPropRadioDivSetup =
+{
+    .commandNo = 0x3807,
+    .status = 0x0000,
+    .pNextOp = 0,
+    .startTime = 0x00000000,
+    .startTrigger.triggerType = 0x0,
+    .startTrigger.bEnaCmd = 0x0,
+    .startTrigger.triggerNo = 0x0,
+    .startTrigger.pastTrig = 0x0,
+    .condition.rule = 0x1,
+    .condition.nSkip = 0x0,
+    .modulation.modType = 0x1,
+    .modulation.deviation = 0x64,
+    .symbolRate.preScale = 0xF,
+    .symbolRate.rateWord = 0x8000,
+    .rxBw = 0x24,
+    .preamConf.nPreamBytes = 0x4,
+    .preamConf.preamMode = 0x0,
+    .formatConf.nSwBits = 0x20,
+    .formatConf.bBitReversal = 0x0,
+    .formatConf.bMsbFirst = 0x1,
+    .formatConf.fecMode = 0x0,
+    .formatConf.whitenMode = 0x0,
+    .config.frontEndMode = 0x0,
+    .config.biasMode = 0x1,
+    .config.analogCfgMode = 0x0,
+    .config.bNoFsPowerUp = 0x0,
+    .txPower = 0xA73F,
+    .pRegOverride = pOverrides,
+    .centerFreq = 0x0364,
+    .intFreq = 0x8000,
+    .loDivider = 0x05,
+};
+
+// CMD_FS
+rfc_CMD_FS_t RF_cmdFs =
+{
+    .commandNo = 0x0803,
+    .status = 0x0000,
+    .pNextOp = 0,
+    .startTime = 0x00000000,
+    .startTrigger.triggerType = 0x0,
+    .startTrigger.bEnaCmd = 0x0,
+    .startTrigger.triggerNo = 0x0,
+    .startTrigger.pastTrig = 0x0,
+    .condition.rule = 0x1,
+    .condition.nSkip = 0x0,
+    .frequency = 0x0364,
+    .fractFreq = 0x0000,
+    .synthConf.bTxMode = 0x0,
+    .synthConf.refFreq = 0x0,
+    .__dummy0 = 0x00,
+    .__dummy1 = 0x00,
+    .__dummy2 = 0x00,
+    .__dummy3 = 0x0000,
+};
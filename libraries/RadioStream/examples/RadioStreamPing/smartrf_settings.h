@@ -0,0 +1,36 @@
+#ifndef _SMARTRF_SETTINGS_H_
+#define _SMARTRF_SETTINGS_H_
+
+//*********************************************************************************
+// Radio settings for RadioStreamPing, in the layout SmartRF Studio exports
+//
+// Device: CC1310
+// Frequency: 868 MHz
+// Data rate: 50 kbps, 2-GFSK, 25 kHz deviation
+// RX filter bandwidth: 98 kHz
+// TX power: 14 dBm
+//
+// Export the settings for another band or rate from SmartRF Studio and
+// replace smartrf_settings.c and smartrf_settings.h with them.
+//*********************************************************************************
+#include <driverlib/rf_mailbox.h>
+#include <driverlib/rf_common_cmd.h>
+#include <driverlib/rf_prop_cmd.h>
+#include <ti/drivers/rf/RF.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// TI-RTOS RF Mode Object
+extern RF_Mode RF_prop;
+
+// RF Core API commands
+extern rfc_CMD_PROP_RADIO_DIV_SETUP_t RF_cmdPropRadioDivSetup;
+extern rfc_CMD_FS_t RF_cmdFs;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SMARTRF_SETTINGS_H_
@@ -364,12 +364,22 @@ function module$use()
         if (BIOS.heapSize != 0) {
             Program.exportModule('xdc.runtime.Memory');
 
-            var HeapMem = xdc.useModule('ti.sysbios.heaps.HeapMem', true);
-            HeapMem.common$.fxntab = true;
-            var heapMemParams = new HeapMem.Params;
-            heapMemParams.size = BIOS.heapSize;
-            heapMemParams.sectionName = BIOS.heapSection;
-            var heap0 = HeapMem.create(heapMemParams);
+            if (BIOS.heapTLSFEnabled) {
+                var HeapTLSF = xdc.useModule('ti.sysbios.heaps.HeapTLSF', true);
+                HeapTLSF.common$.fxntab = true;
+                var heapTLSFParams = new HeapTLSF.Params;
+                heapTLSFParams.size = BIOS.heapSize;
+                heapTLSFParams.sectionName = BIOS.heapSection;
+                var heap0 = HeapTLSF.create(heapTLSFParams);
+            }
+            else {
+                var HeapMem = xdc.useModule('ti.sysbios.heaps.HeapMem', true);
+                HeapMem.common$.fxntab = true;
+                var heapMemParams = new HeapMem.Params;
+                heapMemParams.size = BIOS.heapSize;
+                heapMemParams.sectionName = BIOS.heapSection;
+                var heap0 = HeapMem.create(heapMemParams);
+            }
 
             if (BIOS.heapTrackEnabled) {
                 var HeapTrack = xdc.useModule('ti.sysbios.heaps.HeapTrack', true);
@@ -632,6 +632,13 @@ function getCFiles(target)
      * logic to trim the C files down to just what the application needs
      */
     biosSources += "BIOS.c ";
+
+    /*
+     * GateRW is plain C with no module to pull it in; it only costs
+     * anything when the application calls it.
+     */
+    biosSources += "gates/GateRW.c ";
+
     for each (var mod in Program.targetModules()) {
         var mn = mod.$name;
         var pn = mn.substring(0, mn.lastIndexOf("."));
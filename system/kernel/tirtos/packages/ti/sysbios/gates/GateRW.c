@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== GateRW.c ========
+ */
+#include <xdc/std.h>
+#include <xdc/runtime/Assert.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Queue.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Task.h>
+
+#include "GateRW.h"
+
+/*
+ *  A Task that has to wait queues one of these on its stack.  Whoever
+ *  hands it the gate sets 'granted' and posts 'sem'.
+ */
+typedef struct GateRW_Waiter {
+    Queue_Elem          elem;       /* must be first */
+    Task_Handle         task;
+    Bool                writer;
+    volatile Bool       granted;
+    Semaphore_Struct    sem;
+} GateRW_Waiter;
+
+/*
+ *  ======== GateRW_update ========
+ *  Atomically clear and set flags in the state word and add delta to
+ *  the reader count.  Called with the scheduler disabled, but the
+ *  reader fast paths of preempted Tasks may still race with it.
+ */
+static Void GateRW_update(GateRW_Handle gate, UInt32 clear, UInt32 set,
+        Int delta)
+{
+    UInt32 state;
+
+    do {
+        state = gate->state;
+    } while (!GateRW_cas(&gate->state, state,
+            ((state & ~clear) | set) + delta));
+}
+
+/*
+ *  ======== GateRW_insertPri ========
+ *  Inserts the waiter in order by priority, with higher priority
+ *  waiters at the head of the queue.
+ */
+static Void GateRW_insertPri(Queue_Handle pendQ, GateRW_Waiter *waiter,
+        Int pri)
+{
+    Queue_Elem *qelem;
+
+    for (qelem = Queue_head(pendQ); qelem != (Queue_Elem *)pendQ;
+         qelem = Queue_next(qelem)) {
+        /* Tasks of equal priority will be FIFO, so '>', not '>='. */
+        if (pri > Task_getPri(((GateRW_Waiter *)qelem)->task)) {
+            Queue_insert(qelem, &waiter->elem);
+            return;
+        }
+    }
+
+    Queue_enqueue(pendQ, &waiter->elem);
+}
+
+/*
+ *  ======== GateRW_headPri ========
+ *  Priority of the first waiting Task, -1 if there is none.
+ */
+static Int GateRW_headPri(GateRW_Handle gate)
+{
+    Queue_Handle pendQ = Queue_handle(&gate->pendQ);
+
+    if (Queue_empty(pendQ)) {
+        return (-1);
+    }
+
+    return (Task_getPri(((GateRW_Waiter *)Queue_head(pendQ))->task));
+}
+
+/*
+ *  ======== GateRW_wake ========
+ *  Hand the gate to as many waiting Tasks as may now have it: the head
+ *  writer if the gate is free, else all readers up to the first writer
+ *  as long as no writer holds it.  Called with the scheduler disabled.
+ */
+static Void GateRW_wake(GateRW_Handle gate)
+{
+    Queue_Handle pendQ = Queue_handle(&gate->pendQ);
+    GateRW_Waiter *waiter;
+
+    while (!Queue_empty(pendQ)) {
+        waiter = (GateRW_Waiter *)Queue_head(pendQ);
+
+        if (waiter->writer) {
+            if (gate->state & (GateRW_WRITER | GateRW_READERS)) {
+                break;
+            }
+            gate->owner = waiter->task;
+            gate->ownerOrigPri = Task_getPri(waiter->task);
+            GateRW_update(gate, 0, GateRW_WRITER, 0);
+        }
+        else {
+            if (gate->state & GateRW_WRITER) {
+                break;
+            }
+            GateRW_update(gate, 0, 0, 1);
+        }
+
+        Queue_remove(&waiter->elem);
+        waiter->granted = TRUE;
+        Semaphore_post(Semaphore_handle(&waiter->sem));
+
+        if (waiter->writer) {
+            break;
+        }
+    }
+
+    if (Queue_empty(pendQ)) {
+        GateRW_update(gate, GateRW_WAITING, 0, 0);
+    }
+}
+
+/*
+ *  ======== GateRW_wait ========
+ *  Queue the calling Task and block until the gate is handed to it or
+ *  timeout expires.  Entered with the scheduler disabled by key; returns
+ *  with it restored.
+ */
+static Bool GateRW_wait(GateRW_Handle gate, Task_Handle tsk, Bool writer,
+        UInt32 timeout, UInt key)
+{
+    GateRW_Waiter waiter;
+    Int pri;
+    Int headPri;
+
+    /* no waiting before BIOS_start() */
+    if (timeout == 0 || tsk == NULL) {
+        Task_restore(key);
+        return (FALSE);
+    }
+
+    /* the Task_restore() below must be able to block this Task */
+    Assert_isTrue(key == 0, 0);
+
+    pri = Task_getPri(tsk);
+    waiter.task = tsk;
+    waiter.writer = writer;
+    waiter.granted = FALSE;
+    Semaphore_construct(&waiter.sem, 0, 0);
+
+    GateRW_insertPri(Queue_handle(&gate->pendQ), &waiter, pri);
+    GateRW_update(gate, 0, GateRW_WAITING, 0);
+
+    /* donate priority to the writer holding the gate */
+    if (gate->owner != NULL && pri > Task_getPri(gate->owner)) {
+        Task_setPri(gate->owner, pri);
+    }
+
+    Task_restore(key);
+
+    Semaphore_pend(Semaphore_handle(&waiter.sem), timeout);
+
+    key = Task_disable();
+
+    if (!waiter.granted) {
+        /* timed out: leave the queue and take back our donation */
+        Queue_remove(&waiter.elem);
+
+        if (gate->owner != NULL) {
+            headPri = GateRW_headPri(gate);
+            if (headPri < gate->ownerOrigPri) {
+                headPri = gate->ownerOrigPri;
+            }
+            if (Task_getPri(gate->owner) > headPri) {
+                Task_setPri(gate->owner, headPri);
+            }
+        }
+
+        /* readers queued behind a writer that gave up may now enter */
+        GateRW_wake(gate);
+    }
+
+    Task_restore(key);
+
+    Semaphore_destruct(&waiter.sem);
+
+    return (waiter.granted);
+}
+
+/*
+ *  ======== GateRW_construct ========
+ */
+Void GateRW_construct(GateRW_Struct *gate)
+{
+    gate->state = 0;
+    Queue_construct(&gate->pendQ, 0);
+    gate->owner = NULL;
+    gate->ownerOrigPri = 0;
+}
+
+/*
+ *  ======== GateRW_destruct ========
+ */
+Void GateRW_destruct(GateRW_Struct *gate)
+{
+    Queue_destruct(&gate->pendQ);
+}
+
+/*
+ *  ======== GateRW_enterReadSlow ========
+ *  Called by GateRW_enterRead() when a writer holds or waits for the
+ *  gate.  A reader still gets in past waiting Tasks of lower priority.
+ */
+Bool GateRW_enterReadSlow(GateRW_Handle gate, UInt32 timeout)
+{
+    Task_Handle tsk;
+    UInt32 state;
+    UInt key;
+
+    Assert_isTrue(((BIOS_getThreadType() == BIOS_ThreadType_Task) ||
+                   (BIOS_getThreadType() == BIOS_ThreadType_Main)), 0);
+
+    tsk = Task_self();
+
+    key = Task_disable();
+
+    for (;;) {
+        state = gate->state;
+        if (state & GateRW_WRITER) {
+            break;
+        }
+        if ((state & GateRW_WAITING) &&
+                (tsk == NULL || GateRW_headPri(gate) >= Task_getPri(tsk))) {
+            break;
+        }
+        if (GateRW_cas(&gate->state, state, state + 1)) {
+            Task_restore(key);
+            return (TRUE);
+        }
+    }
+
+    return (GateRW_wait(gate, tsk, FALSE, timeout, key));
+}
+
+/*
+ *  ======== GateRW_leaveReadSlow ========
+ *  Called by GateRW_leaveRead() for the last reader while Tasks wait.
+ */
+Void GateRW_leaveReadSlow(GateRW_Handle gate)
+{
+    UInt key;
+
+    key = Task_disable();
+
+    GateRW_update(gate, 0, 0, -1);
+    GateRW_wake(gate);
+
+    Task_restore(key);
+}
+
+/*
+ *  ======== GateRW_enterWrite ========
+ *  Returns FALSE if the gate could not be entered within timeout
+ *  Clock ticks.
+ */
+Bool GateRW_enterWrite(GateRW_Handle gate, UInt32 timeout)
+{
+    Task_Handle tsk;
+    UInt key;
+
+    Assert_isTrue(((BIOS_getThreadType() == BIOS_ThreadType_Task) ||
+                   (BIOS_getThreadType() == BIOS_ThreadType_Main)), 0);
+
+    tsk = Task_self();
+
+    /*
+     * The scheduler is disabled so that no waiter can run between taking
+     * the gate and recording the owner it has to donate its priority to.
+     */
+    key = Task_disable();
+
+    if (GateRW_cas(&gate->state, 0, GateRW_WRITER)) {
+        gate->owner = tsk;
+        gate->ownerOrigPri = (tsk != NULL) ? Task_getPri(tsk) : 0;
+
+        Task_restore(key);
+        return (TRUE);
+    }
+
+    return (GateRW_wait(gate, tsk, TRUE, timeout, key));
+}
+
+/*
+ *  ======== GateRW_leaveWrite ========
+ */
+Void GateRW_leaveWrite(GateRW_Handle gate)
+{
+    Task_Handle owner;
+    UInt key;
+
+    key = Task_disable();
+
+    owner = gate->owner;
+
+    /* drop any priority inherited while holding the gate */
+    if (owner != NULL && gate->ownerOrigPri < Task_getPri(owner)) {
+        Task_setPri(owner, gate->ownerOrigPri);
+    }
+
+    gate->owner = NULL;
+    GateRW_update(gate, GateRW_WRITER, 0, 0);
+    GateRW_wake(gate);
+
+    Task_restore(key);
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== GateRW.h ========
+ *  Reader/writer gate with a lock-free reader fast path.
+ *
+ *  Any number of Tasks may hold the gate for reading, or one Task for
+ *  writing.  An uncontended gate is described by one word, 'state': the
+ *  number of active readers plus the WRITER and WAITING flags.
+ *  GateRW_enterRead() and GateRW_leaveRead() update it with a single
+ *  compare-and-swap and only call into the kernel when a writer holds
+ *  the gate or a Task is waiting for it.
+ *
+ *  Waiting Tasks queue in priority order, readers and writers together.
+ *  Once a writer waits, new readers of the same or lower priority queue
+ *  behind it, so a steady stream of readers cannot starve it.  While a
+ *  writer holds the gate it inherits the priority of the highest Task
+ *  waiting, as with GateMutexPri.  Readers are not tracked individually,
+ *  so they do not inherit priority.
+ *
+ *  The gate is not recursive and may only be used from Tasks, or from
+ *  main() before BIOS_start() where it never blocks.
+ *
+ *  GateRW is not an XDC module: it has no static configuration and needs
+ *  no application .cfg change.  The gates package library lists GateRW.c
+ *  in package.bld, and ti/sysbios/Build.xs adds it to every custom kernel
+ *  library.
+ */
+
+#ifndef ti_sysbios_gates_GateRW__include
+#define ti_sysbios_gates_GateRW__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <xdc/std.h>
+
+#include <ti/sysbios/knl/Queue.h>
+#include <ti/sysbios/knl/Task.h>
+
+#if !defined(__GNUC__) || defined(__ti__)
+#include <ti/sysbios/hal/Hwi.h>
+#endif
+
+/* state word layout */
+#define ti_sysbios_gates_GateRW_WRITER   (0x80000000)
+#define ti_sysbios_gates_GateRW_WAITING  (0x40000000)
+#define ti_sysbios_gates_GateRW_READERS  (0x3FFFFFFF)
+
+/*
+ *  ======== GateRW_Struct ========
+ *  state is only changed with GateRW_cas().  pendQ, owner and
+ *  ownerOrigPri are only touched with the scheduler disabled.
+ */
+typedef struct ti_sysbios_gates_GateRW_Struct {
+    volatile UInt32                 state;
+    ti_sysbios_knl_Queue_Struct     pendQ;          /* waiting Tasks */
+    ti_sysbios_knl_Task_Handle      owner;          /* writer, or NULL */
+    Int                             ownerOrigPri;
+} ti_sysbios_gates_GateRW_Struct;
+
+typedef ti_sysbios_gates_GateRW_Struct *ti_sysbios_gates_GateRW_Handle;
+
+extern Void ti_sysbios_gates_GateRW_construct(
+        ti_sysbios_gates_GateRW_Struct *gate);
+extern Void ti_sysbios_gates_GateRW_destruct(
+        ti_sysbios_gates_GateRW_Struct *gate);
+extern Bool ti_sysbios_gates_GateRW_enterReadSlow(
+        ti_sysbios_gates_GateRW_Handle gate, UInt32 timeout);
+extern Void ti_sysbios_gates_GateRW_leaveReadSlow(
+        ti_sysbios_gates_GateRW_Handle gate);
+extern Bool ti_sysbios_gates_GateRW_enterWrite(
+        ti_sysbios_gates_GateRW_Handle gate, UInt32 timeout);
+extern Void ti_sysbios_gates_GateRW_leaveWrite(
+        ti_sysbios_gates_GateRW_Handle gate);
+
+/*
+ *  ======== GateRW_cas ========
+ *  Atomically replace *ptr by newVal if it still equals oldVal.  GCC
+ *  turns this into an LDREX/STREX pair on Cortex-M3; other compilers
+ *  get a short interrupt lock.
+ */
+static inline Bool ti_sysbios_gates_GateRW_cas(volatile UInt32 *ptr,
+        UInt32 oldVal, UInt32 newVal)
+{
+#if defined(__GNUC__) && !defined(__ti__)
+    return (__atomic_compare_exchange_n(ptr, &oldVal, newVal, 0,
+            __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+#else
+    UInt key;
+    Bool done = FALSE;
+
+    key = ti_sysbios_hal_Hwi_disable();
+    if (*ptr == oldVal) {
+        *ptr = newVal;
+        done = TRUE;
+    }
+    ti_sysbios_hal_Hwi_restore(key);
+
+    return (done);
+#endif
+}
+
+/*
+ *  ======== GateRW_enterRead ========
+ *  Returns FALSE if the gate could not be entered within timeout
+ *  Clock ticks (0 = don't wait, BIOS_WAIT_FOREVER = no limit).
+ */
+static inline Bool ti_sysbios_gates_GateRW_enterRead(
+        ti_sysbios_gates_GateRW_Handle gate, UInt32 timeout)
+{
+    UInt32 state;
+
+    for (;;) {
+        state = gate->state;
+        if (state & (ti_sysbios_gates_GateRW_WRITER |
+                ti_sysbios_gates_GateRW_WAITING)) {
+            return (ti_sysbios_gates_GateRW_enterReadSlow(gate, timeout));
+        }
+        if (ti_sysbios_gates_GateRW_cas(&gate->state, state, state + 1)) {
+            return (TRUE);
+        }
+    }
+}
+
+/*
+ *  ======== GateRW_leaveRead ========
+ *  Only the last reader leaving while Tasks wait needs the slow path.
+ */
+static inline Void ti_sysbios_gates_GateRW_leaveRead(
+        ti_sysbios_gates_GateRW_Handle gate)
+{
+    UInt32 state;
+
+    for (;;) {
+        state = gate->state;
+        if ((state & ti_sysbios_gates_GateRW_WAITING) &&
+                (state & ti_sysbios_gates_GateRW_READERS) == 1) {
+            ti_sysbios_gates_GateRW_leaveReadSlow(gate);
+            return;
+        }
+        if (ti_sysbios_gates_GateRW_cas(&gate->state, state, state - 1)) {
+            return;
+        }
+    }
+}
+
+/*
+ *  ======== GateRW_leave ========
+ *  Leave the gate whichever way the calling Task entered it.
+ */
+static inline Void ti_sysbios_gates_GateRW_leave(
+        ti_sysbios_gates_GateRW_Handle gate)
+{
+    if (gate->state & ti_sysbios_gates_GateRW_WRITER) {
+        ti_sysbios_gates_GateRW_leaveWrite(gate);
+    }
+    else {
+        ti_sysbios_gates_GateRW_leaveRead(gate);
+    }
+}
+
+/*
+ *  ======== GateRW_isBusy ========
+ *  TRUE if any Task holds the gate.
+ */
+static inline Bool ti_sysbios_gates_GateRW_isBusy(
+        ti_sysbios_gates_GateRW_Handle gate)
+{
+    return ((gate->state & (ti_sysbios_gates_GateRW_WRITER |
+            ti_sysbios_gates_GateRW_READERS)) != 0);
+}
+
+#if !defined(ti_sysbios_gates_GateRW__nolocalnames)
+
+#define GateRW_WRITER ti_sysbios_gates_GateRW_WRITER
+#define GateRW_WAITING ti_sysbios_gates_GateRW_WAITING
+#define GateRW_READERS ti_sysbios_gates_GateRW_READERS
+#define GateRW_Struct ti_sysbios_gates_GateRW_Struct
+#define GateRW_Handle ti_sysbios_gates_GateRW_Handle
+#define GateRW_construct ti_sysbios_gates_GateRW_construct
+#define GateRW_destruct ti_sysbios_gates_GateRW_destruct
+#define GateRW_cas ti_sysbios_gates_GateRW_cas
+#define GateRW_enterRead ti_sysbios_gates_GateRW_enterRead
+#define GateRW_enterReadSlow ti_sysbios_gates_GateRW_enterReadSlow
+#define GateRW_leaveRead ti_sysbios_gates_GateRW_leaveRead
+#define GateRW_leaveReadSlow ti_sysbios_gates_GateRW_leaveReadSlow
+#define GateRW_enterWrite ti_sysbios_gates_GateRW_enterWrite
+#define GateRW_leaveWrite ti_sysbios_gates_GateRW_leaveWrite
+#define GateRW_leave ti_sysbios_gates_GateRW_leave
+#define GateRW_isBusy ti_sysbios_gates_GateRW_isBusy
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* ti_sysbios_gates_GateRW__include */
@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== HeapTLSF.c ========
+ */
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/Assert.h>
+#include <xdc/runtime/Gate.h>
+#include <xdc/runtime/Memory.h>
+#include <xdc/runtime/Startup.h>
+
+#include <ti/sysbios/knl/Intrinsics.h>
+
+#include <stddef.h>
+
+#include "package/internal/HeapTLSF.xdc.h"
+
+/*
+ *  Every block, free or allocated, starts with a header holding a
+ *  pointer to the physically preceding block and the block's size
+ *  (header included). Sizes and addresses are multiples of ALIGN, so
+ *  bit 0 of the size marks free blocks and bit 1 marks blocks whose
+ *  physical predecessor is free. prevPhys is only needed to coalesce
+ *  with a free predecessor, so it is only kept up to date while that
+ *  predecessor is free; an allocated block's user area runs on over
+ *  the next block's prevPhys, and an allocation costs just the size
+ *  word. The free list links overlay the first bytes of the user area,
+ *  which sets the minimum block size.
+ *
+ *  Free blocks are binned into size classes: the first level is the
+ *  power of two range of the size, the second level linearly splits that
+ *  range into SL_COUNT lists. Blocks smaller than SMALL_BLOCK all live in
+ *  first level 0, split into ALIGN sized steps.
+ */
+#define HeapTLSF_ALIGN          8
+#define HeapTLSF_HEADERSIZE     (offsetof(HeapTLSF_Header, nextFree))
+#define HeapTLSF_MINBLOCK       (sizeof(HeapTLSF_Header))
+#define HeapTLSF_OVERHEAD       (HeapTLSF_HEADERSIZE - sizeof(Ptr))
+#define HeapTLSF_FREE           ((Memory_Size)1)
+#define HeapTLSF_PREVFREE       ((Memory_Size)2)
+#define HeapTLSF_FLAGS          (HeapTLSF_FREE | HeapTLSF_PREVFREE)
+
+#define HeapTLSF_SL_LOG2        3
+#define HeapTLSF_SL_COUNT       (1 << HeapTLSF_SL_LOG2)
+#define HeapTLSF_FL_SHIFT       (HeapTLSF_SL_LOG2 + 3)   /* log2(ALIGN) */
+#define HeapTLSF_SMALL_BLOCK    (1 << HeapTLSF_FL_SHIFT)
+
+#define HeapTLSF_size(h)        ((h)->size & ~HeapTLSF_FLAGS)
+#define HeapTLSF_isFree(h)      (((h)->size & HeapTLSF_FREE) != 0)
+#define HeapTLSF_isPrevFree(h)  (((h)->size & HeapTLSF_PREVFREE) != 0)
+#define HeapTLSF_nextPhys(h)    \
+    ((HeapTLSF_Header *)((Char *)(h) + HeapTLSF_size(h)))
+
+/* lowest set bit; Intrinsics only provides the highest */
+#define HeapTLSF_minbit(bits)   Intrinsics_maxbit((bits) & (0 - (bits)))
+
+/*
+ *  ======== HeapTLSF_mapping ========
+ *  Size class of a free block of the given size.
+ */
+static inline Void HeapTLSF_mapping(Memory_Size size, UInt *fl, UInt *sl)
+{
+    UInt msb;
+
+    if (size < HeapTLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (UInt)size / HeapTLSF_ALIGN;
+    }
+    else {
+        msb = Intrinsics_maxbit(size);
+        *fl = msb - (HeapTLSF_FL_SHIFT - 1);
+        *sl = (UInt)(size >> (msb - HeapTLSF_SL_LOG2)) - HeapTLSF_SL_COUNT;
+    }
+}
+
+/*
+ *  ======== HeapTLSF_lists ========
+ */
+static inline HeapTLSF_Header **HeapTLSF_lists(HeapTLSF_Object *obj,
+    UInt fl, UInt sl)
+{
+    return ((HeapTLSF_Header **)obj->freeLists +
+        (fl << HeapTLSF_SL_LOG2) + sl);
+}
+
+/*
+ *  ======== HeapTLSF_insert ========
+ *  Push a free block onto the head of its size class list and point the
+ *  next block back at it. Free blocks never follow each other, so the
+ *  block's own PREVFREE bit is clear.
+ */
+static Void HeapTLSF_insert(HeapTLSF_Object *obj, HeapTLSF_Header *block)
+{
+    HeapTLSF_Header **list;
+    HeapTLSF_Header *next;
+    UInt fl, sl;
+    Memory_Size size = HeapTLSF_size(block);
+
+    HeapTLSF_mapping(size, &fl, &sl);
+    list = HeapTLSF_lists(obj, fl, sl);
+
+    block->size = size | HeapTLSF_FREE;
+    block->prevFree = NULL;
+    block->nextFree = *list;
+    if (*list != NULL) {
+        (*list)->prevFree = block;
+    }
+    *list = block;
+
+    next = HeapTLSF_nextPhys(block);
+    next->prevPhys = block;
+    next->size |= HeapTLSF_PREVFREE;
+
+    ((UInt8 *)obj->slBitmap)[fl] |= (UInt8)(1 << sl);
+    obj->flBitmap |= (UInt32)1 << fl;
+    obj->freeSize += size;
+}
+
+/*
+ *  ======== HeapTLSF_remove ========
+ *  Unlink a free block from its size class list and mark it used.
+ */
+static Void HeapTLSF_remove(HeapTLSF_Object *obj, HeapTLSF_Header *block)
+{
+    HeapTLSF_Header **list;
+    UInt fl, sl;
+    Memory_Size size = HeapTLSF_size(block);
+
+    HeapTLSF_mapping(size, &fl, &sl);
+    list = HeapTLSF_lists(obj, fl, sl);
+
+    if (block->nextFree != NULL) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+    if (block->prevFree != NULL) {
+        block->prevFree->nextFree = block->nextFree;
+    }
+    else {
+        *list = block->nextFree;
+        if (*list == NULL) {
+            ((UInt8 *)obj->slBitmap)[fl] &= (UInt8)~(1 << sl);
+            if (((UInt8 *)obj->slBitmap)[fl] == 0) {
+                obj->flBitmap &= ~((UInt32)1 << fl);
+            }
+        }
+    }
+
+    block->size &= ~HeapTLSF_FREE;
+    HeapTLSF_nextPhys(block)->size &= ~HeapTLSF_PREVFREE;
+    obj->freeSize -= size;
+}
+
+/*
+ *  ======== HeapTLSF_search ========
+ *  Find a free block of at least size MAUs.
+ *
+ *  The size is rounded up to the next size class boundary so the head of
+ *  any list found through the bitmaps is guaranteed to fit, and no list
+ *  is ever walked. A block in the request's own class that happens to be
+ *  large enough is not considered; this is the memory TLSF gives up for
+ *  a constant time search.
+ */
+static HeapTLSF_Header *HeapTLSF_search(HeapTLSF_Object *obj,
+    Memory_Size size)
+{
+    UInt fl, sl;
+    UInt32 map;
+
+    if (size >= HeapTLSF_SMALL_BLOCK) {
+        size += ((Memory_Size)1 <<
+            (Intrinsics_maxbit(size) - HeapTLSF_SL_LOG2)) - 1;
+    }
+
+    HeapTLSF_mapping(size, &fl, &sl);
+    if (fl >= obj->flCount) {
+        return (NULL);
+    }
+
+    map = ((UInt8 *)obj->slBitmap)[fl] & (~(UInt32)0 << sl);
+    if (map == 0) {
+        map = obj->flBitmap & (~(UInt32)0 << fl << 1);
+        if (map == 0) {
+            return (NULL);
+        }
+        fl = HeapTLSF_minbit(map);
+        map = ((UInt8 *)obj->slBitmap)[fl];
+    }
+
+    return (*HeapTLSF_lists(obj, fl, HeapTLSF_minbit(map)));
+}
+
+/*
+ *  ======== HeapTLSF_split ========
+ *  Cut an allocated block down to size MAUs and return the tail to the
+ *  free lists. The tail is never adjacent to another free block: the
+ *  block was just allocated out of a free block.
+ */
+static Void HeapTLSF_split(HeapTLSF_Object *obj, HeapTLSF_Header *block,
+    Memory_Size size)
+{
+    HeapTLSF_Header *tail;
+    Memory_Size remain = HeapTLSF_size(block) - size;
+
+    if (remain < HeapTLSF_MINBLOCK) {
+        return;
+    }
+
+    tail = (HeapTLSF_Header *)((Char *)block + size);
+    tail->size = remain;
+    block->size = size | (block->size & HeapTLSF_PREVFREE);
+
+    HeapTLSF_insert(obj, tail);
+}
+
+/*
+ *  ======== HeapTLSF_init ========
+ */
+Void HeapTLSF_init()
+{
+    Int i;
+    HeapTLSF_Object *obj;
+
+    /*
+     * HeapTLSF inherits from IHeap. Is part of runtime.
+     * Will be called during first pass.
+     * All APIs need to be ready after first pass.
+     */
+
+    for (i = 0; i < HeapTLSF_Object_count(); i++) {
+        obj = HeapTLSF_Object_get(NULL, i);
+
+        /*
+         * Align the buffer at runtime for targets that don't support the
+         * align directive; the static create code pads the buffer so the
+         * size stays valid (see HeapMem_init).
+         */
+        obj->buf = (Char *)xdc_uargToPtr(((Memory_Size)(obj->buf) +
+                            (obj->align - 1)) & ~(obj->align - 1));
+
+        HeapTLSF_restore(obj);
+    }
+}
+
+/*
+ *  ======== HeapTLSF_Instance_init ========
+ */
+Void HeapTLSF_Instance_init(HeapTLSF_Object *obj, const HeapTLSF_Params *params)
+{
+    Memory_Size offset;
+
+    obj->align = HeapTLSF_ALIGN;
+    obj->buf = params->buf;
+    obj->size = params->size;
+
+    /* Force the buffer alignment. This reduces the size of the buffer. */
+    if ((offset = (Memory_Size)(obj->buf) & (HeapTLSF_ALIGN - 1)) != 0) {
+        offset = HeapTLSF_ALIGN - offset;
+        obj->buf += offset;
+        obj->size -= offset;
+    }
+
+    /* Make sure the size is a multiple of the alignment */
+    obj->size &= ~(Memory_Size)(HeapTLSF_ALIGN - 1);
+
+    HeapTLSF_restore(obj);
+}
+
+/*
+ *  ======== HeapTLSF_restore ========
+ *  Layout of the buffer:
+ *
+ *      freeLists[flCount][SL_COUNT] | slBitmap[flCount] | blocks ... | end
+ *
+ *  The blocks start out as one free block spanning the whole remainder.
+ *  'end' is a zero size header marked as used that stops coalescing at
+ *  the top of the buffer; the first block has no previous block, so its
+ *  PREVFREE bit stays clear.
+ */
+Void HeapTLSF_restore(HeapTLSF_Object *obj)
+{
+    HeapTLSF_Header *block;
+    HeapTLSF_Header *end;
+    HeapTLSF_Header **lists;
+    Memory_Size ctrlSize;
+    UInt i;
+
+    /* enough first levels to hold a block as large as the buffer */
+    obj->flCount = 1;
+    if (obj->size >= HeapTLSF_SMALL_BLOCK) {
+        obj->flCount = Intrinsics_maxbit(obj->size) - HeapTLSF_FL_SHIFT + 2;
+    }
+
+    ctrlSize = obj->flCount * (1 + HeapTLSF_SL_COUNT * sizeof(Ptr));
+    ctrlSize = (ctrlSize + HeapTLSF_ALIGN - 1) &
+        ~(Memory_Size)(HeapTLSF_ALIGN - 1);
+
+    Assert_isTrue((obj->size >= ctrlSize + HeapTLSF_MINBLOCK +
+        HeapTLSF_HEADERSIZE), HeapTLSF_A_heapSize);
+
+    obj->freeLists = obj->buf;
+    obj->slBitmap = obj->buf + obj->flCount * HeapTLSF_SL_COUNT * sizeof(Ptr);
+    obj->flBitmap = 0;
+    obj->freeSize = 0;
+
+    lists = (HeapTLSF_Header **)obj->freeLists;
+    for (i = 0; i < obj->flCount; i++) {
+        ((UInt8 *)obj->slBitmap)[i] = 0;
+    }
+    for (i = 0; i < obj->flCount * HeapTLSF_SL_COUNT; i++) {
+        lists[i] = NULL;
+    }
+
+    block = (HeapTLSF_Header *)(obj->buf + ctrlSize);
+    block->prevPhys = NULL;
+    block->size = obj->size - ctrlSize - HeapTLSF_HEADERSIZE;
+
+    end = HeapTLSF_nextPhys(block);
+    end->size = 0;
+
+    HeapTLSF_insert(obj, block);
+}
+
+/*
+ *  ======== HeapTLSF_alloc ========
+ */
+Ptr HeapTLSF_alloc(HeapTLSF_Object *obj, SizeT reqSize,
+                    SizeT reqAlign, Error_Block *eb)
+{
+    IArg key;
+    Ptr buffer;
+
+    key = Gate_enterModule();
+
+    buffer = HeapTLSF_allocUnprotected(obj, reqSize, reqAlign);
+
+    Gate_leaveModule(key);
+
+    if (buffer == NULL) {
+        Error_raise(eb, HeapTLSF_E_memory, (IArg)obj, (IArg)reqSize);
+    }
+    return (buffer);
+}
+
+/*
+ *  ======== HeapTLSF_allocUnprotected ========
+ *  For alignments above ALIGN the search asks for enough slack to place
+ *  an aligned block anywhere inside the free block found, including a
+ *  leading remainder large enough to be a free block of its own.
+ */
+Ptr HeapTLSF_allocUnprotected(HeapTLSF_Object *obj, SizeT reqSize,
+    SizeT reqAlign)
+{
+    HeapTLSF_Header *block;
+    HeapTLSF_Header *head;
+    Memory_Size size;
+    Memory_Size gap;
+    Char *user;
+
+    /* Assert that requested align is a power of 2 */
+    Assert_isTrue(((reqAlign & (reqAlign - 1)) == 0), HeapTLSF_A_align);
+
+    /* Assert that requested block size is non-zero */
+    Assert_isTrue((reqSize != 0), HeapTLSF_A_zeroBlock);
+
+    if (reqSize > obj->size) {
+        return (NULL);
+    }
+
+    size = ((Memory_Size)reqSize + HeapTLSF_OVERHEAD + HeapTLSF_ALIGN - 1) &
+        ~(Memory_Size)(HeapTLSF_ALIGN - 1);
+    if (size < HeapTLSF_MINBLOCK) {
+        size = HeapTLSF_MINBLOCK;
+    }
+
+    if (reqAlign <= HeapTLSF_ALIGN) {
+        if ((block = HeapTLSF_search(obj, size)) == NULL) {
+            return (NULL);
+        }
+        HeapTLSF_remove(obj, block);
+    }
+    else {
+        if (reqAlign > obj->size ||
+            (block = HeapTLSF_search(obj,
+                size + reqAlign + HeapTLSF_MINBLOCK)) == NULL) {
+            return (NULL);
+        }
+        HeapTLSF_remove(obj, block);
+
+        user = (Char *)block + HeapTLSF_HEADERSIZE;
+        gap = (Memory_Size)(0 - (Memory_Size)user) & (reqAlign - 1);
+        if (gap != 0) {
+            /* the leading remainder must be able to stand as a block */
+            while (gap < HeapTLSF_MINBLOCK) {
+                gap += reqAlign;
+            }
+
+            head = block;
+            block = (HeapTLSF_Header *)((Char *)head + gap);
+            block->size = HeapTLSF_size(head) - gap;
+            head->size = gap;
+
+            HeapTLSF_insert(obj, head);
+        }
+    }
+
+    HeapTLSF_split(obj, block, size);
+
+    return ((Char *)block + HeapTLSF_HEADERSIZE);
+}
+
+/*
+ *  ======== HeapTLSF_free ========
+ */
+Void HeapTLSF_free(HeapTLSF_Object *obj, Ptr addr, SizeT size)
+{
+    IArg key;
+
+    key = Gate_enterModule();
+
+    HeapTLSF_freeUnprotected(obj, addr, size);
+
+    Gate_leaveModule(key);
+}
+
+/*
+ *  ======== HeapTLSF_freeUnprotected ========
+ */
+Void HeapTLSF_freeUnprotected(HeapTLSF_Object *obj, Ptr addr, SizeT size)
+{
+    HeapTLSF_Header *block;
+    HeapTLSF_Header *next;
+    HeapTLSF_Header *prev;
+
+    block = (HeapTLSF_Header *)((Char *)addr - HeapTLSF_HEADERSIZE);
+
+    /*
+     *  Make sure the block lies within the heap, is not already free and
+     *  is at least as large as the size being freed.
+     */
+    Assert_isTrue((((UArg)addr & (HeapTLSF_ALIGN - 1)) == 0) &&
+                  ((Char *)block >= obj->buf) &&
+                  ((Char *)addr < obj->buf + obj->size) &&
+                  !HeapTLSF_isFree(block) &&
+                  (size <= HeapTLSF_size(block) - HeapTLSF_OVERHEAD),
+                  HeapTLSF_A_invalidFree);
+
+    /* Join with the upper block */
+    next = HeapTLSF_nextPhys(block);
+    if (HeapTLSF_isFree(next)) {
+        HeapTLSF_remove(obj, next);
+        block->size += HeapTLSF_size(next);
+    }
+
+    /* Join with the lower block; prevPhys is only valid if it is free */
+    if (HeapTLSF_isPrevFree(block)) {
+        prev = block->prevPhys;
+        HeapTLSF_remove(obj, prev);
+        prev->size += HeapTLSF_size(block);
+        block = prev;
+    }
+
+    HeapTLSF_insert(obj, block);
+}
+
+/*
+ *  ======== HeapTLSF_isBlocking ========
+ */
+Bool HeapTLSF_isBlocking(HeapTLSF_Object *obj)
+{
+    return (Gate_canBlock());
+}
+
+/*
+ *  ======== HeapTLSF_getStats ========
+ *  totalFreeSize is kept up to date by insert and remove. The largest
+ *  free block is not tracked; largestFreeSize is the lower bound of the
+ *  highest non-empty size class instead, which is the largest request
+ *  HeapTLSF_search is guaranteed to satisfy. It is at most one eighth
+ *  below the actual largest free block.
+ */
+Void HeapTLSF_getStats(HeapTLSF_Object *obj, Memory_Stats *stats)
+{
+    IArg key;
+    Memory_Size base;
+    UInt fl, sl;
+
+    stats->totalSize         = obj->size;
+    stats->largestFreeSize   = 0;
+
+    key = Gate_enterModule();
+
+    stats->totalFreeSize = obj->freeSize;
+
+    if (obj->flBitmap != 0) {
+        fl = Intrinsics_maxbit(obj->flBitmap);
+        sl = Intrinsics_maxbit(((UInt8 *)obj->slBitmap)[fl]);
+        if (fl == 0) {
+            base = (Memory_Size)sl * HeapTLSF_ALIGN;
+        }
+        else {
+            base = ((Memory_Size)(HeapTLSF_SL_COUNT + sl)) <<
+                (fl + HeapTLSF_FL_SHIFT - 1 - HeapTLSF_SL_LOG2);
+        }
+        stats->largestFreeSize = base - HeapTLSF_OVERHEAD;
+    }
+
+    Gate_leaveModule(key);
+}
+
+/*
+ *  ======== HeapTLSF_getExtendedStats ========
+ */
+Void HeapTLSF_getExtendedStats(HeapTLSF_Object *obj,
+    HeapTLSF_ExtendedStats *stats)
+{
+    stats->buf   = obj->buf;
+    stats->size  = obj->size;
+
+    return;
+}
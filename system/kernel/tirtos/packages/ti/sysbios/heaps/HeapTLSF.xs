@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== HeapTLSF.xs ========
+ */
+
+var HeapTLSF = null;
+var Memory = null;
+var Startup = null;
+
+/*
+ *  ======== module$use ========
+ *  Initialize module values.
+ */
+function module$use(mod, params)
+{
+    HeapTLSF = this;
+    Memory = xdc.useModule('xdc.runtime.Memory');
+
+    Startup = xdc.useModule('xdc.runtime.Startup');
+
+    xdc.useModule('ti.sysbios.knl.Intrinsics');
+
+    /* initialize HeapTLSF objects early */
+    Startup.firstFxns.$add(HeapTLSF.init);
+
+    /*
+     *  Every HeapTLSF operation runs in bounded time, so unlike HeapMem
+     *  the default module Gate simply disables interrupts. This also
+     *  lets Hwis and Swis allocate.
+     */
+    if (HeapTLSF.common$.gate === undefined) {
+        var GateHwi = xdc.useModule('ti.sysbios.gates.GateHwi');
+        HeapTLSF.common$.gate = GateHwi.create();
+    }
+}
+
+/*
+ *  ======== minSize ========
+ *  Smallest buffer that holds the free list index for a heap of 'size'
+ *  MAUs plus one minimum block and the end marker (see HeapTLSF_restore).
+ */
+function minSize(size)
+{
+    var Program = xdc.module('xdc.cfg.Program');
+    var ptrSize = Program.build.target.stdTypes.t_Ptr.size;
+    var flCount = 1;
+    var msb;
+
+    if (size >= 64) {
+        for (msb = 0; (size >>> (msb + 1)) != 0; msb++) {
+        }
+        flCount = msb - 6 + 2;
+    }
+
+    return (((flCount * (1 + 8 * ptrSize) + 7) & ~7) + 6 * ptrSize);
+}
+
+/*
+ *  ======== instance$static$init ========
+ */
+function instance$static$init(obj, params)
+{
+    var Program = xdc.module('xdc.cfg.Program');
+    var target  = Program.build.target;
+
+    /* Don't support static Constructs */
+    if (this.$category == "Struct") {
+        HeapTLSF.$logFatal("HeapTLSF does not support statically" +
+                          "Constructed heaps.", this);
+    }
+
+    /* Verify requested alignment is a power of 2 */
+    if ((params.align != 0) &&
+        ((params.align - 1) & params.align) != 0) {
+        HeapTLSF.$logFatal("Requested alignment must be a power of 2.", this,
+            "align");
+    }
+
+    /* HeapTLSF keeps all blocks 8 MAU aligned */
+    obj.align = params.align;
+    if (obj.align < 8) {
+        obj.align = 8;
+    }
+
+    /* Make sure the size is a multiple of 8. If not round down. */
+    params.size = (Math.floor(params.size / 8)) * 8;
+
+    if (params.size < minSize(params.size)) {
+        HeapTLSF.$logError("HeapTLSF size must be at least " +
+            minSize(params.size) + " MAUs.", this, "size");
+    }
+
+    obj.size = params.size;
+    obj.freeSize = 0;
+    obj.flCount = 0;
+    obj.flBitmap = 0;
+    obj.slBitmap = null;
+    obj.freeLists = null;
+
+    /*
+     *  If the align directive is not supported, (add align - 1) MAUs to the
+     *  size of the buffer. Then during runtime find the proper alignment.
+     */
+    if (target.alignDirectiveSupported == true) {
+        obj.buf.length = params.size;
+    }
+    else {
+        obj.buf.length = params.size + (obj.align - 1);
+    }
+    Memory.staticPlace(obj.buf, obj.align, params.sectionName);
+}
+
+/*
+ *  ======== viewInitBasic ========
+ */
+function viewInitBasic(view, obj)
+{
+    var Program = xdc.useModule('xdc.rov.Program');
+
+    view.label = Program.getShortName(obj.$label);
+
+    view.buf = "0x" + Number(obj.buf.$addr).toString(16);
+    view.totalSize = "0x" + Number(obj.size).toString(16);
+    view.sectionName = obj.sectionName;
+}
+
+/*
+ *  ======== viewInitDetailed ========
+ *  Initialize the 'Detailed' HeapTLSF instance view.
+ */
+function viewInitDetailed(view, obj)
+{
+    viewInitBasic(view, obj);
+
+    view.totalFreeSize = "0x" + Number(obj.freeSize).toString(16);
+
+    if (Number(obj.freeSize) > Number(obj.size)) {
+        view.$status["totalFreeSize"] = "Error: totalFreeSize (" +
+                view.totalFreeSize + ") > totalSize (" + view.totalSize +
+                ")!";
+    }
+}
@@ -93,6 +93,21 @@ typedef ti_sysbios_heaps_HeapCallback_Object* ti_sysbios_heaps_HeapCallback_Hand
 typedef struct ti_sysbios_heaps_HeapCallback_Object__ ti_sysbios_heaps_HeapCallback_Instance_State;
 typedef ti_sysbios_heaps_HeapCallback_Object* ti_sysbios_heaps_HeapCallback_Instance;
 
+/*
+ * ======== module ti.sysbios.heaps.HeapTLSF ========
+ */
+
+typedef struct ti_sysbios_heaps_HeapTLSF_ExtendedStats ti_sysbios_heaps_HeapTLSF_ExtendedStats;
+typedef struct ti_sysbios_heaps_HeapTLSF_Header ti_sysbios_heaps_HeapTLSF_Header;
+typedef struct ti_sysbios_heaps_HeapTLSF_Fxns__ ti_sysbios_heaps_HeapTLSF_Fxns__;
+typedef const struct ti_sysbios_heaps_HeapTLSF_Fxns__* ti_sysbios_heaps_HeapTLSF_Module;
+typedef struct ti_sysbios_heaps_HeapTLSF_Params ti_sysbios_heaps_HeapTLSF_Params;
+typedef struct ti_sysbios_heaps_HeapTLSF_Object ti_sysbios_heaps_HeapTLSF_Object;
+typedef struct ti_sysbios_heaps_HeapTLSF_Struct ti_sysbios_heaps_HeapTLSF_Struct;
+typedef ti_sysbios_heaps_HeapTLSF_Object* ti_sysbios_heaps_HeapTLSF_Handle;
+typedef struct ti_sysbios_heaps_HeapTLSF_Object__ ti_sysbios_heaps_HeapTLSF_Instance_State;
+typedef ti_sysbios_heaps_HeapTLSF_Object* ti_sysbios_heaps_HeapTLSF_Instance;
+
 /*
  * ======== module ti.sysbios.heaps.HeapMem_Module_GateProxy ========
  */
@@ -102,5 +117,14 @@ typedef const struct ti_sysbios_heaps_HeapMem_Module_GateProxy_Fxns__* ti_sysbio
 typedef struct ti_sysbios_heaps_HeapMem_Module_GateProxy_Params ti_sysbios_heaps_HeapMem_Module_GateProxy_Params;
 typedef struct xdc_runtime_IGateProvider___Object *ti_sysbios_heaps_HeapMem_Module_GateProxy_Handle;
 
+/*
+ * ======== module ti.sysbios.heaps.HeapTLSF_Module_GateProxy ========
+ */
+
+typedef struct ti_sysbios_heaps_HeapTLSF_Module_GateProxy_Fxns__ ti_sysbios_heaps_HeapTLSF_Module_GateProxy_Fxns__;
+typedef const struct ti_sysbios_heaps_HeapTLSF_Module_GateProxy_Fxns__* ti_sysbios_heaps_HeapTLSF_Module_GateProxy_Module;
+typedef struct ti_sysbios_heaps_HeapTLSF_Module_GateProxy_Params ti_sysbios_heaps_HeapTLSF_Module_GateProxy_Params;
+typedef struct xdc_runtime_IGateProvider___Object *ti_sysbios_heaps_HeapTLSF_Module_GateProxy_Handle;
+
 
 #endif /* ti_sysbios_heaps__ */ 
@@ -40,6 +40,7 @@
 #include <xdc/runtime/Startup.h>
 
 #include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Intrinsics.h>
 #include <ti/sysbios/knl/Queue.h>
 #include <ti/sysbios/knl/Swi.h>
 #include <ti/sysbios/hal/Hwi.h>
@@ -62,6 +63,65 @@
 #define ti_sysbios_knl_Clock_stopCheckNext__D FALSE
 #endif
 
+#ifndef ti_sysbios_knl_Clock_timingWheel__D
+#define ti_sysbios_knl_Clock_timingWheel__D FALSE
+#endif
+
+#ifndef ti_sysbios_knl_Clock_numSlack__D
+#define ti_sysbios_knl_Clock_numSlack__D 8
+#endif
+
+/*
+ *  Instance slack, see Clock_setSlack(). Clock_Struct is shared with
+ *  prebuilt libraries and the generated configuration, so the slack is
+ *  kept in this table instead of in the instance. Entries with a NULL
+ *  obj are free.
+ */
+typedef struct Clock_SlackEntry {
+    Clock_Object *obj;
+    UInt32 slack;
+} Clock_SlackEntry;
+
+static Clock_SlackEntry Clock_slackTab[ti_sysbios_knl_Clock_numSlack__D];
+static UInt Clock_slackUsed = 0;                /* entries in use */
+
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+/*
+ *  Timing wheel backend, selected with Clock.timingWheel = true.
+ *
+ *  Active Clock objects are filed in a hierarchical timing wheel instead
+ *  of being found by walking clockQ. Level n has WHEEL_SLOTS slots of
+ *  WHEEL_SLOTS^n ticks each. An object is kept at the lowest level where
+ *  its currTimeout agrees with Clock_wheelTick in all higher digits, so
+ *  a level 0 slot only ever holds objects due on one exact tick. When
+ *  Clock_wheelTick crosses into a higher level slot, that slot is
+ *  cascaded down. Start, stop and expiry are O(1), each object is
+ *  cascaded at most WHEEL_LEVELS - 1 times, and the next deadline is
+ *  read from the per-level occupancy bitmaps plus one slot scan.
+ *
+ *  Idle objects stay on clockQ. The wheel costs
+ *  WHEEL_LEVELS * WHEEL_SLOTS queue heads (1 KB) of RAM.
+ *
+ *  In TickMode_PERIODIC the generated Clock_doTick() only posts the Clock
+ *  Swi while ti_sysbios_knl_Clock_wheelActive is non-zero, so ticks with
+ *  nothing armed cost no Swi at all.
+ */
+#define WHEEL_BITS      4
+#define WHEEL_SLOTS     (1 << WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS    (32 / WHEEL_BITS)
+
+static Queue_Elem Clock_wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static UInt32 Clock_wheelMap[WHEEL_LEVELS];     /* non-empty slots */
+static UInt32 Clock_wheelTick;                  /* tick wheel is filed for */
+static Bool Clock_wheelBusy;                    /* Clock_workFunc() servicing */
+
+/* number of active objects, read by the generated Clock_doTick() */
+UInt ti_sysbios_knl_Clock_wheelActive = 0;
+
+static Void Clock_wheelInit();
+#endif
+
 /* MODULE LEVEL FUNCTIONS */
 
 /*
@@ -83,6 +143,10 @@ Int Clock_Module_startup(Int phase)
                 Clock_TimerProxy_getMaxTicks(Clock_module->timer);
     }
 
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    Clock_wheelInit();
+#endif
+
     return Startup_DONE;
 }
 
@@ -239,6 +303,301 @@ Void Clock_tickStart()
     }
 }
 
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+/*
+ *  ======== Clock_wheelInsert ========
+ *  File an active object in the wheel. Must be called with interrupts
+ *  disabled.
+ */
+static Void Clock_wheelInsert(Clock_Object *obj)
+{
+    UInt32 diff;
+    UInt level, slot;
+
+    /* the highest digit in which currTimeout and wheelTick differ */
+    diff = (obj->currTimeout ^ Clock_wheelTick) >> WHEEL_BITS;
+    level = 0;
+    while (diff != 0) {
+        diff >>= WHEEL_BITS;
+        level++;
+    }
+
+    slot = (obj->currTimeout >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+    Queue_enqueue((Queue_Handle)&Clock_wheel[level][slot], &obj->elem);
+    Clock_wheelMap[level] |= (UInt32)1 << slot;
+}
+
+/*
+ *  ======== Clock_wheelUnlink ========
+ *  Take an object off the wheel (if active) or off clockQ (if idle).
+ *  Must be called with interrupts disabled.
+ *
+ *  An object's slot is a function of currTimeout and Clock_wheelTick
+ *  alone (cascading preserves this), so it is recomputed here to keep
+ *  the occupancy bitmap exact.
+ */
+static Void Clock_wheelUnlink(Clock_Object *obj)
+{
+    UInt32 diff;
+    UInt level, slot;
+
+    Queue_remove(&obj->elem);
+
+    if (obj->active == TRUE) {
+        ti_sysbios_knl_Clock_wheelActive--;
+
+        diff = (obj->currTimeout ^ Clock_wheelTick) >> WHEEL_BITS;
+        level = 0;
+        while (diff != 0) {
+            diff >>= WHEEL_BITS;
+            level++;
+        }
+
+        slot = (obj->currTimeout >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+        if (Queue_empty((Queue_Handle)&Clock_wheel[level][slot])) {
+            Clock_wheelMap[level] &= ~((UInt32)1 << slot);
+        }
+    }
+}
+
+/*
+ *  ======== Clock_wheelActivate ========
+ *  File a newly started object. Must be called with interrupts disabled.
+ *
+ *  While no object is active in TickMode_PERIODIC the Clock Swi is not
+ *  posted and Clock_wheelTick stops following Clock_module->ticks. The
+ *  wheel is empty then, so it is simply moved up to the last tick the
+ *  Swi will see before the first object is filed. This is skipped while
+ *  Clock_workFunc() is servicing: it is advancing the wheel itself.
+ */
+static Void Clock_wheelActivate(Clock_Object *obj)
+{
+    if ((ti_sysbios_knl_Clock_wheelActive++ == 0) &&
+        (CLOCK_TICK_MODE == Clock_TickMode_PERIODIC) &&
+        (Clock_wheelBusy == FALSE)) {
+        Clock_wheelTick = Clock_module->ticks - Clock_module->swiCount;
+    }
+
+    Clock_wheelInsert(obj);
+}
+
+/*
+ *  ======== Clock_wheelInit ========
+ *  Called once from Clock_Module_startup(). Objects started statically
+ *  are still on clockQ and are moved into the wheel here.
+ */
+static Void Clock_wheelInit()
+{
+    Queue_Handle clockQ;
+    Queue_Elem  *elem;
+    Clock_Object *obj;
+    UInt level, slot;
+
+    for (level = 0; level < WHEEL_LEVELS; level++) {
+        for (slot = 0; slot < WHEEL_SLOTS; slot++) {
+            Queue_elemClear(&Clock_wheel[level][slot]);
+        }
+        Clock_wheelMap[level] = 0;
+    }
+
+    Clock_wheelTick = Clock_module->ticks;
+
+    clockQ = Clock_Module_State_clockQ();
+    elem = Queue_head(clockQ);
+
+    while (elem != (Queue_Elem *)(clockQ)) {
+        obj = (Clock_Object *)elem;
+        elem = Queue_next(elem);
+
+        if (obj->active == TRUE) {
+            Queue_remove(&obj->elem);
+            ti_sysbios_knl_Clock_wheelActive++;
+            Clock_wheelInsert(obj);
+        }
+    }
+}
+
+/*
+ *  ======== Clock_wheelAdvance ========
+ *  Move Clock_wheelTick forward to 'tick', cascading every slot whose
+ *  start was crossed. The caller guarantees no timeout falls strictly
+ *  between the old and new wheelTick (one tick at a time for
+ *  TickMode_PERIODIC, the walked distance for TickMode_DYNAMIC).
+ */
+static Void Clock_wheelAdvance(UInt32 tick)
+{
+    Queue_Elem pending;
+    Queue_Elem *head, *first, *last;
+    Clock_Object *obj;
+    UInt32 delta, low, crossed;
+    UInt level, shift, cur, offset, slot;
+    UInt hwiKey;
+
+    Queue_elemClear(&pending);
+
+    hwiKey = Hwi_disable();
+
+    delta = tick - Clock_wheelTick;
+
+    for (level = 0; level < WHEEL_LEVELS; level++) {
+        shift = level * WHEEL_BITS;
+        low = ((UInt32)1 << shift) - 1;
+
+        /* number of level slot boundaries crossed */
+        crossed = (delta >> shift) +
+                  (((Clock_wheelTick & low) + (delta & low)) >> shift);
+
+        /* a level's boundaries are a subset of the level below's */
+        if (crossed == 0) {
+            break;
+        }
+        if (crossed > WHEEL_SLOTS) {
+            crossed = WHEEL_SLOTS;
+        }
+
+        cur = (Clock_wheelTick >> shift) & WHEEL_MASK;
+
+        for (offset = 1; offset <= crossed; offset++) {
+            slot = (cur + offset) & WHEEL_MASK;
+
+            if (Clock_wheelMap[level] & ((UInt32)1 << slot)) {
+                /* splice the whole slot onto the pending list */
+                head = &Clock_wheel[level][slot];
+                first = head->next;
+                last = head->prev;
+
+                first->prev = pending.prev;
+                pending.prev->next = first;
+                last->next = &pending;
+                pending.prev = last;
+
+                Queue_elemClear(head);
+                Clock_wheelMap[level] &= ~((UInt32)1 << slot);
+            }
+        }
+    }
+
+    Clock_wheelTick = tick;
+
+    Hwi_restore(hwiKey);
+
+    /*
+     * Re-file the cascaded objects one at a time to bound interrupt
+     * latency. Clock_stop()/Clock_start() from a Hwi may still unlink an
+     * object from 'pending' meanwhile; Queue_remove() handles that.
+     */
+    for (;;) {
+        hwiKey = Hwi_disable();
+
+        if (Queue_empty((Queue_Handle)&pending)) {
+            Hwi_restore(hwiKey);
+            break;
+        }
+
+        obj = (Clock_Object *)Queue_dequeue((Queue_Handle)&pending);
+        Clock_wheelInsert(obj);
+
+        Hwi_restore(hwiKey);
+    }
+}
+
+/*
+ *  ======== Clock_wheelService ========
+ *  Advance the wheel to 'tick' and run every Clock function due on it
+ */
+static Void Clock_wheelService(UInt32 tick)
+{
+    Queue_Handle slotQ;
+    Clock_Object *obj;
+    UInt hwiKey;
+
+    Clock_wheelAdvance(tick);
+
+    /* everything in this level 0 slot is due on exactly 'tick' */
+    slotQ = (Queue_Handle)&Clock_wheel[0][tick & WHEEL_MASK];
+
+    for (;;) {
+        hwiKey = Hwi_disable();
+
+        if (Queue_empty(slotQ)) {
+            Clock_wheelMap[0] &= ~((UInt32)1 << (tick & WHEEL_MASK));
+            Hwi_restore(hwiKey);
+            break;
+        }
+
+        obj = (Clock_Object *)Queue_dequeue(slotQ);
+
+        if (obj->period == 0) { /* oneshot? */
+            /* mark object idle */
+            obj->active = FALSE;
+            ti_sysbios_knl_Clock_wheelActive--;
+            Queue_enqueue(Clock_Module_State_clockQ(), &obj->elem);
+        }
+        else {                  /* periodic */
+            /* refresh timeout */
+            obj->currTimeout += obj->period;
+            Clock_wheelInsert(obj);
+        }
+
+        Hwi_restore(hwiKey);
+
+        Log_write2(Clock_LM_begin, (UArg)obj, (UArg)obj->fxn);
+
+        /* call handler */
+        obj->fxn(obj->arg);
+    }
+}
+
+/*
+ *  ======== Clock_wheelNext ========
+ *  Ticks from Clock_wheelTick to the soonest active timeout, ~0 if none.
+ *
+ *  The soonest timeout lives in the lowest non-empty level, in the first
+ *  occupied slot after the current one, so only that slot is scanned.
+ */
+static UInt32 Clock_wheelNext()
+{
+    UInt32 distance = ~0;
+    UInt32 delta;
+    Queue_Elem *head, *elem;
+    UInt level, cur, offset, slot;
+    UInt hwiKey;
+
+    hwiKey = Hwi_disable();
+
+    for (level = 0; level < WHEEL_LEVELS; level++) {
+        if (Clock_wheelMap[level] == 0) {
+            continue;
+        }
+
+        cur = (Clock_wheelTick >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+        /* level 0 may hold wheelTick itself, higher levels start past it */
+        for (offset = (level == 0) ? 0 : 1; offset <= WHEEL_SLOTS; offset++) {
+            slot = (cur + offset) & WHEEL_MASK;
+            if (Clock_wheelMap[level] & ((UInt32)1 << slot)) {
+                break;
+            }
+        }
+
+        head = &Clock_wheel[level][slot];
+        for (elem = head->next; elem != head; elem = elem->next) {
+            delta = ((Clock_Object *)elem)->currTimeout - Clock_wheelTick;
+            if (delta < distance) {
+                distance = delta;
+            }
+        }
+        break;
+    }
+
+    Hwi_restore(hwiKey);
+
+    return (distance);
+}
+#endif
+
 /*
  *  ======== Clock_walkQueuePeriodic ========
  *  Walk the Clock Queue for TickMode_PERIODIC to determine the number of
@@ -246,6 +605,20 @@ Void Clock_tickStart()
  */
 UInt32 Clock_walkQueuePeriodic()
 {
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    UInt32 distance;
+    UInt32 behind;
+
+    distance = Clock_wheelNext();
+
+    /* Clock_module->ticks may run ahead of the wheel until the Swi runs */
+    if (distance != ~0) {
+        behind = Clock_module->ticks - Clock_wheelTick;
+        distance = (distance > behind) ? (distance - behind) : 0;
+    }
+
+    return (distance);
+#else
     UInt32 distance = ~0;
     Queue_Handle clockQ;
     Queue_Elem  *elem;
@@ -276,6 +649,7 @@ UInt32 Clock_walkQueuePeriodic()
     }
 
     return (distance);
+#endif
 }
 
 /*
@@ -284,16 +658,21 @@ UInt32 Clock_walkQueuePeriodic()
  */
 Void Clock_workFunc(UArg arg0, UArg arg1)
 {
-    Queue_Elem  *elem;
     UInt hwiKey, count;
     UInt32 time, compare;
+#if ti_sysbios_knl_Clock_timingWheel__D==FALSE
+    Queue_Elem  *elem;
     Clock_Object *obj;
     Queue_Handle clockQ;
+#endif
 
     hwiKey = Hwi_disable();
     time = Clock_module->ticks;
     count = Clock_module->swiCount;
     Clock_module->swiCount = 0;
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    Clock_wheelBusy = TRUE;
+#endif
     Hwi_restore(hwiKey);
 
     /* Log when count > 1, meaning Clock_swi is delayed */
@@ -317,6 +696,9 @@ Void Clock_workFunc(UArg arg0, UArg arg1)
         compare = compare + 1;
         count = count - 1;
 
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+        Clock_wheelService(compare);
+#else
         /* Traverse clock queue */
 
         clockQ = Clock_Module_State_clockQ();
@@ -343,7 +725,12 @@ Void Clock_workFunc(UArg arg0, UArg arg1)
                 obj->fxn(obj->arg);
              }
          }
+#endif
      }
+
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    Clock_wheelBusy = FALSE;
+#endif
 }
 
 /*
@@ -353,6 +740,22 @@ Void Clock_workFunc(UArg arg0, UArg arg1)
  */
 UInt32 Clock_walkQueueDynamic(Bool service, UInt32 thisTick)
 {
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    UInt32 distance;
+
+    if (service == TRUE) {
+        Clock_wheelService(thisTick);
+    }
+
+    distance = Clock_wheelNext();
+
+    /* distance is relative to wheelTick, rebase it on thisTick */
+    if (distance != ~0) {
+        distance -= thisTick - Clock_wheelTick;
+    }
+
+    return (distance);
+#else
     UInt32 distance = ~0;
     Queue_Handle clockQ;
     Queue_Elem  *elem;
@@ -408,6 +811,7 @@ UInt32 Clock_walkQueueDynamic(Bool service, UInt32 thisTick)
     }
 
     return (distance);
+#endif
 }
 
 /*
@@ -549,8 +953,15 @@ Void Clock_Instance_finalize(Clock_Object *obj)
                    (BIOS_getThreadType() != BIOS_ThreadType_Swi)),
                         Clock_A_badThreadType);
 
+    /* free the object's slack entry, if any */
+    Clock_setSlack(obj, 0);
+
     key = Hwi_disable();
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    Clock_wheelUnlink(obj);
+#else
     Queue_remove(&obj->elem);
+#endif
     Hwi_restore(key);
 }
 
@@ -579,7 +990,11 @@ Void Clock_addI(Clock_Object *obj, Clock_FuncPtr func, UInt32 timeout, UArg arg)
  */
 Void Clock_removeI(Clock_Object *obj)
 {
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    Clock_wheelUnlink(obj);
+#else
     Queue_remove(&obj->elem);
+#endif
 }
 
 /*
@@ -589,6 +1004,11 @@ Void Clock_removeI(Clock_Object *obj)
  */
 Void Clock_startI(Clock_Object *obj)
 {
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    /* restarting re-files the object, it is re-inserted below */
+    Clock_wheelUnlink(obj);
+#endif
+
     if (CLOCK_TICK_MODE == Clock_TickMode_DYNAMIC) {
         UInt32 nowTick, nowDelta;
         UInt32 scheduledTick, scheduledDelta;
@@ -618,6 +1038,9 @@ Void Clock_startI(Clock_Object *obj)
                 /* start new Clock object */
                 obj->currTimeout = nowTick + obj->timeout;
                 obj->active = TRUE;
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+                Clock_wheelActivate(obj);
+#endif
 
                 /* get the next scheduled tick */
                 scheduledTick = Clock_module->nextScheduledTick;
@@ -642,6 +1065,9 @@ Void Clock_startI(Clock_Object *obj)
             /* start new Clock object */
             obj->currTimeout = nowTick + obj->timeout;
             obj->active = TRUE;
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+            Clock_wheelActivate(obj);
+#endif
 
             if (Clock_module->inWorkFunc == TRUE) {
                 Clock_module->startDuringWorkFunc = TRUE;
@@ -652,20 +1078,52 @@ Void Clock_startI(Clock_Object *obj)
     else {
         obj->currTimeout = (Clock_module->ticks + obj->timeout);
         obj->active = TRUE;
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+        Clock_wheelActivate(obj);
+#endif
     }
 }
 
 /*
  *  ======== Clock_start ========
+ *  In TickMode_DYNAMIC an instance with slack joins the wakeup that is
+ *  already scheduled if that falls within [timeout, timeout + slack].
+ *  Otherwise its timeout is moved to the last multiple of the largest
+ *  power of 2 <= slack + 1 ticks that is no more than slack ticks late,
+ *  so instances whose windows overlap tend to expire on the same tick.
  */
 Void Clock_start(Clock_Object *obj)
 {
     UInt key;
+    UInt32 slack, align, now, timeout;
 
     Assert_isTrue(obj->timeout, (Assert_Id) NULL);
 
     key = Hwi_disable();
-    Clock_startI(obj);
+
+    slack = 0;
+    if ((CLOCK_TICK_MODE == Clock_TickMode_DYNAMIC) && (Clock_slackUsed != 0)) {
+        slack = Clock_getSlack(obj);
+    }
+
+    if (slack != 0 && obj->timeout <= 0x7FFFFFFF) {
+        timeout = obj->timeout;
+        now = Clock_getTicks();
+        if ((Clock_module->ticking == TRUE) &&
+            (Clock_module->nextScheduledTick - (now + timeout) <= slack)) {
+            obj->timeout = Clock_module->nextScheduledTick - now;
+        }
+        else {
+            align = (UInt32)1 << Intrinsics_maxbit(slack + 1);
+            obj->timeout = ((now + timeout + slack) & ~(align - 1)) - now;
+        }
+        Clock_startI(obj);
+        obj->timeout = timeout;
+    }
+    else {
+        Clock_startI(obj);
+    }
+
     Hwi_restore(key);
 }
 
@@ -675,7 +1133,20 @@ Void Clock_start(Clock_Object *obj)
  */
 Void Clock_stop(Clock_Object *obj)
 {
+#if ti_sysbios_knl_Clock_timingWheel__D==TRUE
+    UInt key;
+
+    /* move the object off the wheel and back onto clockQ */
+    key = Hwi_disable();
+    if (obj->active == TRUE) {
+        Clock_wheelUnlink(obj);
+        Queue_enqueue(Clock_Module_State_clockQ(), &obj->elem);
+    }
     obj->active = FALSE;
+    Hwi_restore(key);
+#else
+    obj->active = FALSE;
+#endif
 #if ti_sysbios_knl_Clock_stopCheckNext__D==TRUE
     if (obj->currTimeout == Clock_module->nextScheduledTick) {
         Clock_start(Clock_triggerClock);
@@ -696,6 +1167,71 @@ Void Clock_setFunc(Clock_Object *obj, Clock_FuncPtr fxn, UArg arg)
     Hwi_restore(key);
 }
 
+/*
+ *  ======== Clock_setSlack ========
+ */
+Bool Clock_setSlack(Clock_Object *obj, UInt32 slack)
+{
+    Clock_SlackEntry *entry = NULL;
+    Clock_SlackEntry *unused = NULL;
+    UInt key;
+    UInt i;
+
+    if (slack > 0x7FFFFFFF) {
+        slack = 0x7FFFFFFF;
+    }
+
+    key = Hwi_disable();
+
+    for (i = 0; i < ti_sysbios_knl_Clock_numSlack__D; i++) {
+        if (Clock_slackTab[i].obj == obj) {
+            entry = &Clock_slackTab[i];
+            break;
+        }
+        if (Clock_slackTab[i].obj == NULL && unused == NULL) {
+            unused = &Clock_slackTab[i];
+        }
+    }
+
+    if (entry == NULL && slack != 0) {
+        if (unused == NULL) {
+            Hwi_restore(key);
+            return (FALSE);
+        }
+        entry = unused;
+        entry->obj = obj;
+        Clock_slackUsed++;
+    }
+
+    if (entry != NULL) {
+        entry->slack = slack;
+        if (slack == 0) {
+            entry->obj = NULL;
+            Clock_slackUsed--;
+        }
+    }
+
+    Hwi_restore(key);
+
+    return (TRUE);
+}
+
+/*
+ *  ======== Clock_getSlack ========
+ */
+UInt32 Clock_getSlack(Clock_Object *obj)
+{
+    UInt i;
+
+    for (i = 0; i < ti_sysbios_knl_Clock_numSlack__D; i++) {
+        if (Clock_slackTab[i].obj == obj) {
+            return (Clock_slackTab[i].slack);
+        }
+    }
+
+    return (0);
+}
+
 /*
  *  ======== Clock_setPeriod ========
  */
@@ -604,6 +604,16 @@ __extern xdc_Void ti_sysbios_knl_Clock_setTimeout__E( ti_sysbios_knl_Clock_Handl
 xdc__CODESECT(ti_sysbios_knl_Clock_setFunc__E, "ti_sysbios_knl_Clock_setFunc")
 __extern xdc_Void ti_sysbios_knl_Clock_setFunc__E( ti_sysbios_knl_Clock_Handle __inst, ti_sysbios_knl_Clock_FuncPtr fxn, xdc_UArg arg );
 
+/* setSlack__E */
+#define ti_sysbios_knl_Clock_setSlack ti_sysbios_knl_Clock_setSlack__E
+xdc__CODESECT(ti_sysbios_knl_Clock_setSlack__E, "ti_sysbios_knl_Clock_setSlack")
+__extern xdc_Bool ti_sysbios_knl_Clock_setSlack__E( ti_sysbios_knl_Clock_Handle __inst, xdc_UInt32 slack );
+
+/* getSlack__E */
+#define ti_sysbios_knl_Clock_getSlack ti_sysbios_knl_Clock_getSlack__E
+xdc__CODESECT(ti_sysbios_knl_Clock_getSlack__E, "ti_sysbios_knl_Clock_getSlack")
+__extern xdc_UInt32 ti_sysbios_knl_Clock_getSlack__E( ti_sysbios_knl_Clock_Handle __inst );
+
 /* getPeriod__E */
 #define ti_sysbios_knl_Clock_getPeriod ti_sysbios_knl_Clock_getPeriod__E
 xdc__CODESECT(ti_sysbios_knl_Clock_getPeriod__E, "ti_sysbios_knl_Clock_getPeriod")
@@ -866,6 +876,8 @@ static inline ti_sysbios_knl_Queue_Handle ti_sysbios_knl_Clock_Module_State_cloc
 #define Clock_setPeriod ti_sysbios_knl_Clock_setPeriod
 #define Clock_setTimeout ti_sysbios_knl_Clock_setTimeout
 #define Clock_setFunc ti_sysbios_knl_Clock_setFunc
+#define Clock_setSlack ti_sysbios_knl_Clock_setSlack
+#define Clock_getSlack ti_sysbios_knl_Clock_getSlack
 #define Clock_getPeriod ti_sysbios_knl_Clock_getPeriod
 #define Clock_getTimeout ti_sysbios_knl_Clock_getTimeout
 #define Clock_isActive ti_sysbios_knl_Clock_isActive
@@ -238,6 +238,12 @@ function module$validate()
         }
     }
 
+    /* the ROM'ed Clock functions only know the linear clockQ walk */
+    if ((Clock.timingWheel == true) &&
+        (xdc.module('ti.sysbios.rom.ROM').$used == true)) {
+        Clock.$logError("Clock.timingWheel is not supported with the kernel in ROM", Clock, "timingWheel");
+    }
+
     /* validate all "created" instances */
     for (var i = 0; i < Clock.$instances.length; i++) {
         instance_validate(Clock.$instances[i]);
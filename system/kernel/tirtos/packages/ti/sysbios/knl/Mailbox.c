@@ -218,8 +218,12 @@ Int Mailbox_getNumFreeMsgs(Mailbox_Object *obj)
  */
 Int Mailbox_getNumPendingMsgs(Mailbox_Object *obj)
 {
-    /* return the number of unread msgs */
-    return (obj->numMsgs - obj->numFreeMsgs);
+    /*
+     * return the number of unread msgs: those posted and not yet pended
+     * on. Buffers held by allocRef() or pendRef() callers are neither
+     * free nor pending, so this is the count of dataSem.
+     */
+    return (Semaphore_getCount(Mailbox_Instance_State_dataSem(obj)));
 }
 
 /*
@@ -318,6 +322,144 @@ Bool Mailbox_post(Mailbox_Object *obj, Ptr msg, UInt32 timeout)
     }
 }
 
+/*
+ *  ======== Mailbox_allocRef ========
+ */
+Ptr Mailbox_allocRef(Mailbox_Object *obj, UInt32 timeout)
+{
+    Mailbox_MbxElem *elem;
+    Queue_Handle freeQue;
+    Semaphore_Handle freeSem;
+    UInt key;
+
+    freeQue = Mailbox_Instance_State_freeQue(obj);
+    freeSem = Mailbox_Instance_State_freeSem(obj);
+
+    if (!Semaphore_pend(freeSem, timeout)) {
+        return (NULL);
+    }
+
+    /* perform the dequeue and decrement numFreeMsgs atomically */
+    key = Hwi_disable();
+
+    elem = Queue_dequeue(freeQue);
+
+    /* Make sure that a valid pointer was returned. */
+    if (elem == (Mailbox_MbxElem *)(freeQue)) {
+        Hwi_restore(key);
+        return (NULL);
+    }
+
+    obj->numFreeMsgs--;
+
+    Hwi_restore(key);
+
+    /* the message lives right behind its queue element */
+    return (elem + 1);
+}
+
+/*
+ *  ======== Mailbox_postRef ========
+ */
+Void Mailbox_postRef(Mailbox_Object *obj, Ptr msg)
+{
+    Queue_put(Mailbox_Instance_State_dataQue(obj),
+        (Queue_Elem *)((Mailbox_MbxElem *)msg - 1));
+
+    Semaphore_post(Mailbox_Instance_State_dataSem(obj));
+}
+
+/*
+ *  ======== Mailbox_postRefN ========
+ */
+Void Mailbox_postRefN(Mailbox_Object *obj, Ptr *msgs, UInt count)
+{
+    Queue_Handle dataQue;
+    Semaphore_Handle dataSem;
+    UInt key;
+    UInt i;
+
+    dataQue = Mailbox_Instance_State_dataQue(obj);
+    dataSem = Mailbox_Instance_State_dataSem(obj);
+
+    /* queue the whole batch before any reader can run */
+    key = Hwi_disable();
+
+    for (i = 0; i < count; i++) {
+        Queue_enqueue(dataQue, (Queue_Elem *)((Mailbox_MbxElem *)msgs[i] - 1));
+    }
+
+    Hwi_restore(key);
+
+    for (i = 0; i < count; i++) {
+        Semaphore_post(dataSem);
+    }
+}
+
+/*
+ *  ======== Mailbox_pendRef ========
+ */
+Ptr Mailbox_pendRef(Mailbox_Object *obj, UInt32 timeout)
+{
+    Mailbox_MbxElem *elem;
+
+    if (!Semaphore_pend(Mailbox_Instance_State_dataSem(obj), timeout)) {
+        return (NULL);
+    }
+
+    elem = Queue_get(Mailbox_Instance_State_dataQue(obj));
+
+    return (elem + 1);
+}
+
+/*
+ *  ======== Mailbox_pendRefN ========
+ */
+UInt Mailbox_pendRefN(Mailbox_Object *obj, Ptr *msgs, UInt count,
+    UInt32 timeout)
+{
+    Mailbox_MbxElem *elem;
+    Queue_Handle dataQue;
+    Semaphore_Handle dataSem;
+    UInt n;
+
+    dataQue = Mailbox_Instance_State_dataQue(obj);
+    dataSem = Mailbox_Instance_State_dataSem(obj);
+
+    if (count == 0 || !Semaphore_pend(dataSem, timeout)) {
+        return (0);
+    }
+
+    /* each count taken from dataSem guarantees one element on dataQue */
+    n = 0;
+    do {
+        elem = Queue_get(dataQue);
+        msgs[n++] = elem + 1;
+    } while (n < count && Semaphore_pend(dataSem, BIOS_NO_WAIT));
+
+    return (n);
+}
+
+/*
+ *  ======== Mailbox_releaseRef ========
+ */
+Void Mailbox_releaseRef(Mailbox_Object *obj, Ptr msg)
+{
+    UInt key;
+
+    /* perform the enqueue and increment numFreeMsgs atomically */
+    key = Hwi_disable();
+
+    Queue_enqueue(Mailbox_Instance_State_freeQue(obj),
+        (Queue_Elem *)((Mailbox_MbxElem *)msg - 1));
+
+    obj->numFreeMsgs++;
+
+    Hwi_restore(key);
+
+    Semaphore_post(Mailbox_Instance_State_freeSem(obj));
+}
+
 /*
  *  ======== Mailbox_postInit ========
  */
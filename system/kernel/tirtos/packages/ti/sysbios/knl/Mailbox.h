@@ -404,6 +404,36 @@ __extern xdc_Bool ti_sysbios_knl_Mailbox_pend__E( ti_sysbios_knl_Mailbox_Handle
 xdc__CODESECT(ti_sysbios_knl_Mailbox_post__E, "ti_sysbios_knl_Mailbox_post")
 __extern xdc_Bool ti_sysbios_knl_Mailbox_post__E( ti_sysbios_knl_Mailbox_Handle __inst, xdc_Ptr msg, xdc_UInt32 timeout );
 
+/* allocRef__E */
+#define ti_sysbios_knl_Mailbox_allocRef ti_sysbios_knl_Mailbox_allocRef__E
+xdc__CODESECT(ti_sysbios_knl_Mailbox_allocRef__E, "ti_sysbios_knl_Mailbox_allocRef")
+__extern xdc_Ptr ti_sysbios_knl_Mailbox_allocRef__E( ti_sysbios_knl_Mailbox_Handle __inst, xdc_UInt32 timeout );
+
+/* postRef__E */
+#define ti_sysbios_knl_Mailbox_postRef ti_sysbios_knl_Mailbox_postRef__E
+xdc__CODESECT(ti_sysbios_knl_Mailbox_postRef__E, "ti_sysbios_knl_Mailbox_postRef")
+__extern xdc_Void ti_sysbios_knl_Mailbox_postRef__E( ti_sysbios_knl_Mailbox_Handle __inst, xdc_Ptr msg );
+
+/* postRefN__E */
+#define ti_sysbios_knl_Mailbox_postRefN ti_sysbios_knl_Mailbox_postRefN__E
+xdc__CODESECT(ti_sysbios_knl_Mailbox_postRefN__E, "ti_sysbios_knl_Mailbox_postRefN")
+__extern xdc_Void ti_sysbios_knl_Mailbox_postRefN__E( ti_sysbios_knl_Mailbox_Handle __inst, xdc_Ptr *msgs, xdc_UInt count );
+
+/* pendRef__E */
+#define ti_sysbios_knl_Mailbox_pendRef ti_sysbios_knl_Mailbox_pendRef__E
+xdc__CODESECT(ti_sysbios_knl_Mailbox_pendRef__E, "ti_sysbios_knl_Mailbox_pendRef")
+__extern xdc_Ptr ti_sysbios_knl_Mailbox_pendRef__E( ti_sysbios_knl_Mailbox_Handle __inst, xdc_UInt32 timeout );
+
+/* pendRefN__E */
+#define ti_sysbios_knl_Mailbox_pendRefN ti_sysbios_knl_Mailbox_pendRefN__E
+xdc__CODESECT(ti_sysbios_knl_Mailbox_pendRefN__E, "ti_sysbios_knl_Mailbox_pendRefN")
+__extern xdc_UInt ti_sysbios_knl_Mailbox_pendRefN__E( ti_sysbios_knl_Mailbox_Handle __inst, xdc_Ptr *msgs, xdc_UInt count, xdc_UInt32 timeout );
+
+/* releaseRef__E */
+#define ti_sysbios_knl_Mailbox_releaseRef ti_sysbios_knl_Mailbox_releaseRef__E
+xdc__CODESECT(ti_sysbios_knl_Mailbox_releaseRef__E, "ti_sysbios_knl_Mailbox_releaseRef")
+__extern xdc_Void ti_sysbios_knl_Mailbox_releaseRef__E( ti_sysbios_knl_Mailbox_Handle __inst, xdc_Ptr msg );
+
 /* cleanQue__I */
 #define ti_sysbios_knl_Mailbox_cleanQue ti_sysbios_knl_Mailbox_cleanQue__I
 xdc__CODESECT(ti_sysbios_knl_Mailbox_cleanQue__I, "ti_sysbios_knl_Mailbox_cleanQue")
@@ -621,6 +651,12 @@ static inline ti_sysbios_knl_Semaphore_Handle ti_sysbios_knl_Mailbox_Instance_St
 #define Mailbox_getNumPendingMsgs ti_sysbios_knl_Mailbox_getNumPendingMsgs
 #define Mailbox_pend ti_sysbios_knl_Mailbox_pend
 #define Mailbox_post ti_sysbios_knl_Mailbox_post
+#define Mailbox_allocRef ti_sysbios_knl_Mailbox_allocRef
+#define Mailbox_postRef ti_sysbios_knl_Mailbox_postRef
+#define Mailbox_postRefN ti_sysbios_knl_Mailbox_postRefN
+#define Mailbox_pendRef ti_sysbios_knl_Mailbox_pendRef
+#define Mailbox_pendRefN ti_sysbios_knl_Mailbox_pendRefN
+#define Mailbox_releaseRef ti_sysbios_knl_Mailbox_releaseRef
 #define Mailbox_Module_name ti_sysbios_knl_Mailbox_Module_name
 #define Mailbox_Module_id ti_sysbios_knl_Mailbox_Module_id
 #define Mailbox_Module_startup ti_sysbios_knl_Mailbox_Module_startup
@@ -113,4 +113,8 @@ function close()
     /* add -D to compile line with definition for Clock.stopCheckNext */
     Build.ccArgs.$add("-Dti_sysbios_knl_Clock_stopCheckNext__D=" +
             (Clock.stopCheckNext ? "TRUE" : "FALSE"));
+
+    /* add -D to compile line with definition for Clock.timingWheel */
+    Build.ccArgs.$add("-Dti_sysbios_knl_Clock_timingWheel__D=" +
+            (Clock.timingWheel ? "TRUE" : "FALSE"));
 }
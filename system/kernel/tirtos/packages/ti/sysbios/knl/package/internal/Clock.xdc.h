@@ -121,6 +121,14 @@
 #undef ti_sysbios_knl_Clock_setFunc
 #define ti_sysbios_knl_Clock_setFunc ti_sysbios_knl_Clock_setFunc__E
 
+/* setSlack */
+#undef ti_sysbios_knl_Clock_setSlack
+#define ti_sysbios_knl_Clock_setSlack ti_sysbios_knl_Clock_setSlack__E
+
+/* getSlack */
+#undef ti_sysbios_knl_Clock_getSlack
+#define ti_sysbios_knl_Clock_getSlack ti_sysbios_knl_Clock_getSlack__E
+
 /* getPeriod */
 #undef ti_sysbios_knl_Clock_getPeriod
 #define ti_sysbios_knl_Clock_getPeriod ti_sysbios_knl_Clock_getPeriod__E
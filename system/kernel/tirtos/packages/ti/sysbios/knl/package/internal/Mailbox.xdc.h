@@ -41,6 +41,30 @@
 #undef ti_sysbios_knl_Mailbox_post
 #define ti_sysbios_knl_Mailbox_post ti_sysbios_knl_Mailbox_post__E
 
+/* allocRef */
+#undef ti_sysbios_knl_Mailbox_allocRef
+#define ti_sysbios_knl_Mailbox_allocRef ti_sysbios_knl_Mailbox_allocRef__E
+
+/* postRef */
+#undef ti_sysbios_knl_Mailbox_postRef
+#define ti_sysbios_knl_Mailbox_postRef ti_sysbios_knl_Mailbox_postRef__E
+
+/* postRefN */
+#undef ti_sysbios_knl_Mailbox_postRefN
+#define ti_sysbios_knl_Mailbox_postRefN ti_sysbios_knl_Mailbox_postRefN__E
+
+/* pendRef */
+#undef ti_sysbios_knl_Mailbox_pendRef
+#define ti_sysbios_knl_Mailbox_pendRef ti_sysbios_knl_Mailbox_pendRef__E
+
+/* pendRefN */
+#undef ti_sysbios_knl_Mailbox_pendRefN
+#define ti_sysbios_knl_Mailbox_pendRefN ti_sysbios_knl_Mailbox_pendRefN__E
+
+/* releaseRef */
+#undef ti_sysbios_knl_Mailbox_releaseRef
+#define ti_sysbios_knl_Mailbox_releaseRef ti_sysbios_knl_Mailbox_releaseRef__E
+
 /* cleanQue */
 #define Mailbox_cleanQue ti_sysbios_knl_Mailbox_cleanQue__I
 
@@ -54,6 +54,7 @@ function getCFiles(targetName)
              "pthread_rwlock.c",
              "clock.c",
              "mqueue.c",
+             "nametab.c",
              "sched.c",
              "semaphore.c",
              "sleep.c",
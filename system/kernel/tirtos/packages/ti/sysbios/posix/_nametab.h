@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== _nametab.h ========
+ *  Hashed name registry shared by the named POSIX objects (message
+ *  queues and semaphores).  Not part of the POSIX API.
+ *
+ *  Objects embed a NameTab_Elem and are chained into one of
+ *  NameTab_NUMBUCKETS buckets by the hash of their name, so lookups cost
+ *  one hash plus a short bucket walk instead of a strcmp() against every
+ *  open object.  Callers serialize access with Task_disable().
+ */
+
+#ifndef ti_sysbios_posix__nametab__include
+#define ti_sysbios_posix__nametab__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <xdc/std.h>
+
+/* Number of hash buckets, must be a power of two */
+#define NameTab_NUMBUCKETS 16
+
+/*
+ *  ======== NameTab_Elem ========
+ */
+typedef struct NameTab_Elem {
+    struct NameTab_Elem *next;
+    UInt32               hash;
+    const char          *name;
+} NameTab_Elem;
+
+/*
+ *  ======== NameTab ========
+ *  A zero-initialized NameTab is empty.
+ */
+typedef struct NameTab {
+    NameTab_Elem *buckets[NameTab_NUMBUCKETS];
+} NameTab;
+
+extern UInt32 NameTab_hash(const char *name);
+extern NameTab_Elem *NameTab_find(NameTab *tab, const char *name,
+        UInt32 hash);
+extern Void NameTab_add(NameTab *tab, NameTab_Elem *elem, const char *name,
+        UInt32 hash);
+extern Void NameTab_remove(NameTab *tab, NameTab_Elem *elem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* ti_sysbios_posix__nametab__include */
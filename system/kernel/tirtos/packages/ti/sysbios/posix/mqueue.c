@@ -51,6 +51,7 @@
 #include "pthread.h"
 #include "mqueue.h"
 #include "errno.h"
+#include "_nametab.h"
 
 /*
  *  ======== MQueueObj ========
@@ -58,8 +59,7 @@
  *  opened.
  */
 typedef struct MQueueObj {
-    struct MQueueObj  *next;
-    struct MQueueObj  *prev;
+    NameTab_Elem       elem;      /* must be first, see findInList() */
     Mailbox_Handle     mailbox;
     mq_attr            attrs;
     int                refCount;
@@ -76,9 +76,25 @@ typedef struct MQueueDesc {
     long       flags;
 } MQueueDesc;
 
-static MQueueObj *findInList(const char *name);
+static MQueueObj *createQueue(const char *name, mq_attr *attrs);
+static Void deleteQueue(MQueueObj *msgQueue);
+static MQueueObj *findInList(const char *name, UInt32 hash);
+static UInt32 getTimeout(MQueueDesc *mqd);
 
-static MQueueObj *mqList = NULL;
+static NameTab mqTable;
+
+/*
+ *  ======== mq_alloc_ref ========
+ *  Get a free message buffer of the queue for mq_send_ref().  Blocks
+ *  until one is free unless the descriptor is O_NONBLOCK.
+ */
+char *mq_alloc_ref(mqd_t mqdes)
+{
+    MQueueDesc *mqd = (MQueueDesc *)mqdes;
+    MQueueObj  *msgQueue = mqd->msgQueue;
+
+    return ((char *)Mailbox_allocRef(msgQueue->mailbox, getTimeout(mqd)));
+}
 
 /*
  *  ======== mq_close ========
@@ -126,11 +142,11 @@ mqd_t mq_open(const char *name, int oflags, ...)
     mode_t            mode;
     mq_attr          *attrs = NULL;
     MQueueObj        *msgQueue;
+    MQueueObj        *newQueue = NULL;
     MQueueDesc       *msgQueueDesc = NULL;
-    MQueueDesc       *mqd = (MQueueDesc *)(-1);
     Error_Block       eb;
     UInt              key;
-    Bool              failedStatus = FALSE;
+    UInt32            hash;
 
     va_start(va, oflags);
 
@@ -145,10 +161,10 @@ mqd_t mq_open(const char *name, int oflags, ...)
         return ((mqd_t)(-1));
     }
 
-    Error_init(&eb);
+    hash = NameTab_hash(name);
 
     key = Task_disable();
-    msgQueue = findInList(name);
+    msgQueue = findInList(name, hash);
     Task_restore(key);
 
     if ((msgQueue != NULL) && (oflags & O_CREAT) && (oflags & O_EXCL)) {
@@ -165,92 +181,65 @@ mqd_t mq_open(const char *name, int oflags, ...)
         return ((mqd_t)(-1));
     }
 
+    Error_init(&eb);
+
     msgQueueDesc = (MQueueDesc *)Memory_alloc(Task_Object_heap(),
             sizeof(MQueueDesc), 0, &eb);
     if (msgQueueDesc == NULL) {
         return ((mqd_t)(-1));
     }
 
+    /*
+     *  The queue cannot be created with Task disabled, so create it up
+     *  front and look the name up again when adding it: another task
+     *  may have created the queue in the meantime.
+     */
     if (msgQueue == NULL) {
-        /* Allocate the MQueueObj */
-        msgQueue = (MQueueObj *)Memory_alloc(Task_Object_heap(),
-                sizeof(MQueueObj), 0, &eb);
-        if (msgQueue == NULL) {
-            failedStatus = TRUE;
-            goto done;
-        }
-
-        msgQueue->refCount = 1;
-        msgQueue->attrs = *attrs;
-
-        msgQueue->name = (char *)Memory_alloc(Task_Object_heap(),
-                strlen(name) + 1, 0, &eb);
-
-        if (msgQueue->name == NULL) {
-            failedStatus = TRUE;
-            goto done;
-        }
-
-        strcpy(msgQueue->name, name);
-
-        msgQueue->mailbox = Mailbox_create(attrs->mq_msgsize,
-                attrs->mq_maxmsg, NULL, &eb);
-
-        if (msgQueue->mailbox == NULL) {
-            failedStatus = TRUE;
-            goto done;
+        newQueue = createQueue(name, attrs);
+        if (newQueue == NULL) {
+            Memory_free(Task_Object_heap(), msgQueueDesc, sizeof(MQueueDesc));
+            return ((mqd_t)(-1));
         }
+    }
 
-        /*
-         *  Add the message queue to the list now
-         */
-        msgQueue->prev = NULL;
+    key = Task_disable();
 
-        key = Task_disable();
+    msgQueue = findInList(name, hash);
 
-        if (mqList != NULL) {
-            mqList->prev = msgQueue;
+    if (msgQueue == NULL) {
+        if (newQueue == NULL) {
+            /* unlinked since the first lookup */
+            Task_restore(key);
+            Memory_free(Task_Object_heap(), msgQueueDesc, sizeof(MQueueDesc));
+            return ((mqd_t)(-1));
         }
-
-        msgQueue->next = mqList;
-        mqList = msgQueue;
+        msgQueue = newQueue;
+        newQueue = NULL;
+        NameTab_add(&mqTable, &msgQueue->elem, msgQueue->name, hash);
+    }
+    else if ((newQueue != NULL) && (oflags & O_EXCL)) {
+        /* lost the race to create an O_EXCL queue */
+        Task_restore(key);
+        deleteQueue(newQueue);
+        Memory_free(Task_Object_heap(), msgQueueDesc, sizeof(MQueueDesc));
+        return ((mqd_t)(-1));
     }
     else {
-        key = Task_disable();
         msgQueue->refCount++;
     }
 
     Task_restore(key);
 
-    msgQueueDesc->msgQueue = msgQueue;
+    if (newQueue != NULL) {
+        deleteQueue(newQueue);
+    }
 
+    msgQueueDesc->msgQueue = msgQueue;
     msgQueueDesc->flags = (oflags & O_NONBLOCK) ? O_NONBLOCK : 0;
 
-done:
-    if (failedStatus) {
-        /*
-         *  We only get here if we attempted to allocate msgQueue (i.e., it
-         *  was not already in the list), so we're ok to free it.
-         */
-        if (msgQueue != NULL) {
-            if (msgQueue->name != NULL) {
-                Memory_free(Task_Object_heap(), msgQueue->name,
-                    strlen(name) + 1);
-            }
-            Memory_free(Task_Object_heap(), msgQueue, sizeof(MQueueObj));
-        }
-
-        if (msgQueueDesc != NULL) {
-            Memory_free(Task_Object_heap(), msgQueueDesc, sizeof(MQueueDesc));
-        }
-    }
-    else {
-        mqd = msgQueueDesc;
-    }
-
     (void)mode;
 
-    return ((mqd_t)mqd);
+    return ((mqd_t)msgQueueDesc);
 }
 
 /*
@@ -282,11 +271,54 @@ ssize_t mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
     /* Receive a message */
     if (Mailbox_pend(msgQueue->mailbox, (Ptr)msg_ptr, timeout)) {
         retVal = (msgQueue->attrs).mq_msgsize;
+
+        /* msg_prio is ignored on send, every message has priority 0 */
+        if (msg_prio != NULL) {
+            *msg_prio = 0;
+        }
     }
 
     return (retVal);
 }
 
+/*
+ *  ======== mq_receive_ref ========
+ *  Take the next message without copying it.  *msg_ref is set to the
+ *  message buffer, which must be given back with mq_release_ref().
+ *  Fails like mq_receive(): -1 if an O_NONBLOCK queue is empty.
+ */
+ssize_t mq_receive_ref(mqd_t mqdes, char **msg_ref, unsigned int *msg_prio)
+{
+    MQueueDesc *mqd = (MQueueDesc *)mqdes;
+    MQueueObj  *msgQueue = mqd->msgQueue;
+
+    *msg_ref = (char *)Mailbox_pendRef(msgQueue->mailbox, getTimeout(mqd));
+
+    if (*msg_ref == NULL) {
+        return (-1);
+    }
+
+    if (msg_prio != NULL) {
+        *msg_prio = 0;
+    }
+
+    return ((msgQueue->attrs).mq_msgsize);
+}
+
+/*
+ *  ======== mq_release_ref ========
+ *  Give back a buffer from mq_receive_ref(), or an unused one from
+ *  mq_alloc_ref().
+ */
+int mq_release_ref(mqd_t mqdes, char *msg_ref)
+{
+    MQueueDesc *mqd = (MQueueDesc *)mqdes;
+
+    Mailbox_releaseRef(mqd->msgQueue->mailbox, (Ptr)msg_ref);
+
+    return (0);
+}
+
 /*
  *  ======== mq_send ========
  */
@@ -312,6 +344,21 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
     return (0);
 }
 
+/*
+ *  ======== mq_send_ref ========
+ *  Queue a buffer from mq_alloc_ref() that the caller has filled in.
+ *  It joins the same FIFO as messages sent with mq_send(); msg_prio is
+ *  ignored in the same way.  Never blocks, the slot is already reserved.
+ */
+int mq_send_ref(mqd_t mqdes, char *msg_ref, unsigned int msg_prio)
+{
+    MQueueDesc *mqd = (MQueueDesc *)mqdes;
+
+    Mailbox_postRef(mqd->msgQueue->mailbox, (Ptr)msg_ref);
+
+    return (0);
+}
+
 /*
  *  ======== mq_setattr ========
  */
@@ -402,6 +449,11 @@ ssize_t mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
     /* Wait forever to receive a message */
     if (Mailbox_pend(msgQueue->mailbox, (Ptr)msg_ptr, timeout)) {
         retVal = (msgQueue->attrs).mq_msgsize;
+
+        /* msg_prio is ignored on send, every message has priority 0 */
+        if (msg_prio != NULL) {
+            *msg_prio = 0;
+        }
     }
 
     return (retVal);
@@ -462,44 +514,22 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 int mq_unlink(const char *name)
 {
     MQueueObj  *msgQueue;
-    MQueueObj  *nextMQ, *prevMQ;
+    UInt32      hash;
     UInt        key;
 
+    hash = NameTab_hash(name);
+
     key = Task_disable();
 
-    msgQueue = findInList(name);
+    msgQueue = findInList(name, hash);
 
     if ((msgQueue != NULL) && (msgQueue->refCount == 0)) {
-        /* If the message queue is in the list, remove it. */
-        if (mqList == msgQueue) {
-            mqList = msgQueue->next;
-        }
-        else {
-            prevMQ = msgQueue->prev;
-            nextMQ = msgQueue->next;
-
-            if (prevMQ) {
-                prevMQ->next = nextMQ;
-            }
-            if (nextMQ) {
-                nextMQ->prev = prevMQ;
-            }
-        }
-
-        msgQueue->next = msgQueue->prev = NULL;
+        /* If the message queue is in the table, remove it. */
+        NameTab_remove(&mqTable, &msgQueue->elem);
 
         Task_restore(key);
 
-        if (msgQueue->mailbox != NULL) {
-            Mailbox_delete(&msgQueue->mailbox);
-        }
-
-        if (msgQueue->name != NULL) {
-            Memory_free(Task_Object_heap(), msgQueue->name,
-                    strlen(msgQueue->name) + 1);
-        }
-
-        Memory_free(Task_Object_heap(), msgQueue, sizeof(MQueueObj));
+        deleteQueue(msgQueue);
 
         return (0);
     }
@@ -516,20 +546,74 @@ int mq_unlink(const char *name)
  */
 
 /*
- *  ======== findInList ========
+ *  ======== createQueue ========
+ *  Allocate a message queue with a reference count of 1, not yet in the
+ *  name table.
  */
-static MQueueObj *findInList(const char *name)
+static MQueueObj *createQueue(const char *name, mq_attr *attrs)
 {
-    MQueueObj *mq;
+    MQueueObj   *msgQueue;
+    Error_Block  eb;
 
-    mq = mqList;
+    Error_init(&eb);
 
-    while (mq != NULL) {
-        if (strcmp(mq->name, name) == 0) {
-            return (mq);
-        }
-        mq = mq->next;
+    msgQueue = (MQueueObj *)Memory_alloc(Task_Object_heap(),
+            sizeof(MQueueObj), 0, &eb);
+    if (msgQueue == NULL) {
+        return (NULL);
+    }
+
+    msgQueue->refCount = 1;
+    msgQueue->attrs = *attrs;
+    msgQueue->mailbox = NULL;
+
+    msgQueue->name = (char *)Memory_alloc(Task_Object_heap(),
+            strlen(name) + 1, 0, &eb);
+    if (msgQueue->name != NULL) {
+        strcpy(msgQueue->name, name);
+
+        msgQueue->mailbox = Mailbox_create(attrs->mq_msgsize,
+                attrs->mq_maxmsg, NULL, &eb);
+    }
+
+    if (msgQueue->mailbox == NULL) {
+        deleteQueue(msgQueue);
+        return (NULL);
+    }
+
+    return (msgQueue);
+}
+
+/*
+ *  ======== deleteQueue ========
+ *  Free a message queue that is no longer in the name table.
+ */
+static Void deleteQueue(MQueueObj *msgQueue)
+{
+    if (msgQueue->mailbox != NULL) {
+        Mailbox_delete(&msgQueue->mailbox);
+    }
+
+    if (msgQueue->name != NULL) {
+        Memory_free(Task_Object_heap(), msgQueue->name,
+                strlen(msgQueue->name) + 1);
     }
 
-    return (NULL);
+    Memory_free(Task_Object_heap(), msgQueue, sizeof(MQueueObj));
+}
+
+/*
+ *  ======== findInList ========
+ */
+static MQueueObj *findInList(const char *name, UInt32 hash)
+{
+    return ((MQueueObj *)NameTab_find(&mqTable, name, hash));
+}
+
+/*
+ *  ======== getTimeout ========
+ */
+static UInt32 getTimeout(MQueueDesc *mqd)
+{
+    return ((mqd->flags & O_NONBLOCK) ? BIOS_NO_WAIT : BIOS_WAIT_FOREVER);
 }
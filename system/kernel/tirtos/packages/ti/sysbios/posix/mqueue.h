@@ -89,6 +89,19 @@ extern int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
         unsigned int msg_prio, const struct timespec *abstime);
 extern int mq_unlink(const char *name);
 
+/*
+ *  Zero-copy extension (not POSIX).  mq_alloc_ref() hands out a free
+ *  message buffer of mq_msgsize bytes that is filled in place and queued
+ *  with mq_send_ref(); mq_receive_ref() hands the reader that same buffer,
+ *  which goes back to the queue with mq_release_ref().  Both directions
+ *  share the queue with mq_send()/mq_receive() and keep its ordering.
+ */
+extern char *mq_alloc_ref(mqd_t mqdes);
+extern ssize_t mq_receive_ref(mqd_t mqdes, char **msg_ref,
+        unsigned int *msg_prio);
+extern int mq_release_ref(mqd_t mqdes, char *msg_ref);
+extern int mq_send_ref(mqd_t mqdes, char *msg_ref, unsigned int msg_prio);
+
 #ifdef __cplusplus
 }
 #endif
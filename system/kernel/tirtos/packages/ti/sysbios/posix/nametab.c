@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== nametab.c ========
+ */
+
+#include <xdc/std.h>
+
+#include <string.h>
+
+#include "_nametab.h"
+
+#define BUCKET(hash)  ((hash) & (NameTab_NUMBUCKETS - 1))
+
+/*
+ *  ======== NameTab_hash ========
+ *  32-bit FNV-1a hash of a NUL terminated name
+ */
+UInt32 NameTab_hash(const char *name)
+{
+    UInt32 hash = 2166136261U;
+
+    while (*name != '\0') {
+        hash ^= (UInt8)*name++;
+        hash *= 16777619U;
+    }
+
+    return (hash);
+}
+
+/*
+ *  ======== NameTab_find ========
+ *  'hash' must be NameTab_hash(name).  The full hash is compared before
+ *  falling back to strcmp(), so a miss rarely touches a string.
+ */
+NameTab_Elem *NameTab_find(NameTab *tab, const char *name, UInt32 hash)
+{
+    NameTab_Elem *elem;
+
+    for (elem = tab->buckets[BUCKET(hash)]; elem != NULL; elem = elem->next) {
+        if ((elem->hash == hash) && (strcmp(elem->name, name) == 0)) {
+            return (elem);
+        }
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== NameTab_add ========
+ *  'name' is not copied and must stay valid until the element is removed.
+ */
+Void NameTab_add(NameTab *tab, NameTab_Elem *elem, const char *name,
+        UInt32 hash)
+{
+    NameTab_Elem **bucket = &tab->buckets[BUCKET(hash)];
+
+    elem->name = name;
+    elem->hash = hash;
+    elem->next = *bucket;
+    *bucket = elem;
+}
+
+/*
+ *  ======== NameTab_remove ========
+ */
+Void NameTab_remove(NameTab *tab, NameTab_Elem *elem)
+{
+    NameTab_Elem **link = &tab->buckets[BUCKET(elem->hash)];
+
+    while (*link != NULL) {
+        if (*link == elem) {
+            *link = elem->next;
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    elem->next = NULL;
+}
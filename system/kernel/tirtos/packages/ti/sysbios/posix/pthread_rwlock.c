@@ -34,18 +34,14 @@
  */
 
 #include <xdc/std.h>
-#include <xdc/runtime/Assert.h>
 
 #include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/knl/Clock.h>
-#include <ti/sysbios/knl/Semaphore.h>
-#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/gates/GateRW.h>
 
 #include "pthread.h"
 #include "errno.h"
 
-static int rdlockAcquire(pthread_rwlock_t *lock, UInt timeout);
-
 /*
  *************************************************************************
  *                      pthread_rwlockattr
@@ -79,12 +75,11 @@ int pthread_rwlockattr_init(pthread_rwlockattr_t * attr)
 int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 {
     /* Return EBUSY if the lock is in use. */
-    if (rwlock->owner != NULL) {
+    if (GateRW_isBusy(&(rwlock->gate))) {
         return (EBUSY);
     }
 
-    Semaphore_destruct(&(rwlock->sem));
-    Semaphore_destruct(&(rwlock->readSem));
+    GateRW_destruct(&(rwlock->gate));
 
     return (0);
 }
@@ -95,16 +90,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
         const pthread_rwlockattr_t *attr)
 {
-    /*
-     *  Default Semaphore mode is Semaphore_Mode_COUNTING.
-     */
-    Semaphore_construct(&(rwlock->sem), 1, NULL);
-    Semaphore_construct(&(rwlock->readSem), 0, NULL);
-
-    rwlock->activeReaderCnt = 0;
-    rwlock->blockedReaderCnt = 0;
-
-    rwlock->owner = NULL;
+    GateRW_construct(&(rwlock->gate));
 
     return (0);
 }
@@ -114,7 +100,9 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
  */
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 {
-    return (rdlockAcquire(rwlock, BIOS_WAIT_FOREVER));
+    GateRW_enterRead(&(rwlock->gate), BIOS_WAIT_FOREVER);
+
+    return (0);
 }
 
 /*
@@ -150,8 +138,11 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
         timeout = (UInt32)(usecs / Clock_tickPeriod);
     }
 
-    return (rdlockAcquire(rwlock, timeout));
+    if (GateRW_enterRead(&(rwlock->gate), timeout)) {
+        return (0);
+    }
 
+    return (ETIMEDOUT);
 }
 
 /*
@@ -187,11 +178,7 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
         timeout = usecs / Clock_tickPeriod;
     }
 
-    if (Semaphore_pend(Semaphore_handle(&(rwlock->sem)), timeout)) {
-        Assert_isTrue(rwlock->owner == NULL, 0);
-        rwlock->owner = pthread_self();
-        Assert_isTrue(rwlock->activeReaderCnt == 0, 0);
-
+    if (GateRW_enterWrite(&(rwlock->gate), timeout)) {
         return (0);
     }
 
@@ -203,7 +190,11 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 {
-    return (rdlockAcquire(rwlock, 0));
+    if (GateRW_enterRead(&(rwlock->gate), 0)) {
+        return (0);
+    }
+
+    return (EBUSY);
 }
 
 /*
@@ -211,11 +202,7 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 {
-    if (Semaphore_pend(Semaphore_handle(&(rwlock->sem)), 0)) {
-        Assert_isTrue(rwlock->owner == NULL, 0);
-        rwlock->owner = pthread_self();
-        Assert_isTrue(rwlock->activeReaderCnt == 0, 0);
-
+    if (GateRW_enterWrite(&(rwlock->gate), 0)) {
         return (0);
     }
 
@@ -227,42 +214,8 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
-    UInt                key;
-    int                 i;
-
-    key = Task_disable();
-
-    if (rwlock->activeReaderCnt) {
-        Assert_isTrue(rwlock->blockedReaderCnt == 0, 0);
-        /*
-         *  Lock is held by a reader.  The last active reader
-         *  releases the semaphore.
-         */
-        if (--rwlock->activeReaderCnt == 0) {
-            rwlock->owner = NULL;
-            Semaphore_post(Semaphore_handle(&(rwlock->sem)));
-        }
-    }
-    else {
-        /*
-         *  Lock is held by a writer.  Release the semaphore and
-         *  if there are any blocked readers, unblock all of them.
-         *  By unblocking all readers, we ensure that the highest
-         *  priority reader is unblocked.
-         */
-        Semaphore_post(Semaphore_handle(&(rwlock->sem)));
-
-        /* Unblock all readers */
-        for (i = 0; i < rwlock->blockedReaderCnt; i++) {
-            Semaphore_post(Semaphore_handle(&(rwlock->readSem)));
-        }
-
-        Assert_isTrue(rwlock->owner == pthread_self(), 0);
-        rwlock->owner = NULL;
-        Assert_isTrue(rwlock->activeReaderCnt == 0, 0);
-    }
-
-    Task_restore(key);
+    /* A writer holds the lock alone, so the gate knows which it was */
+    GateRW_leave(&(rwlock->gate));
 
     return (0);
 }
@@ -272,127 +225,7 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 {
-    Semaphore_pend(Semaphore_handle(&(rwlock->sem)), BIOS_WAIT_FOREVER);
-
-    Assert_isTrue(rwlock->owner == NULL, 0);
-    rwlock->owner = pthread_self();
-    Assert_isTrue(rwlock->activeReaderCnt == 0, 0);
+    GateRW_enterWrite(&(rwlock->gate), BIOS_WAIT_FOREVER);
 
     return (0);
 }
-
-
-/*
- *************************************************************************
- *                      internal functions
- *************************************************************************
- */
-
-/*
- *  ======== rdlockAcquire ========
- */
-static int rdlockAcquire(pthread_rwlock_t *rwlock, UInt timeout)
-{
-    UInt32              curTicks;
-    UInt32              prevTicks;
-    UInt32              deltaTicks;
-    UInt                key;
-
-    key = Task_disable();
-
-    if (rwlock->activeReaderCnt > 0) {
-        /* The semaphore is owned by a reader, no need to pend. */
-        rwlock->activeReaderCnt++;
-        Task_restore(key);
-
-        return (0);
-    }
-
-    if (Semaphore_pend(Semaphore_handle(&(rwlock->sem)), 0)) {
-        /* Got the semaphore */
-        rwlock->activeReaderCnt++;
-        Assert_isTrue(rwlock->activeReaderCnt == 1, 0);
-
-        Assert_isTrue(rwlock->owner == NULL, 0);
-        rwlock->owner = pthread_self();
-
-        /*
-         *  Either there are no blocked readers, or a writer has just
-         *  unlocked rwlock->sem and posted all the blocked readers.
-         */
-
-        Task_restore(key);
-
-        return (0);
-    }
-
-    if (timeout == 0) {
-        Task_restore(key);
-        return (EBUSY);
-    }
-
-    rwlock->blockedReaderCnt++;
-    curTicks = Clock_getTicks();
-
-    Task_restore(key);
-
-    for (;;) {
-        if (!Semaphore_pend(Semaphore_handle(&(rwlock->readSem)), timeout)) {
-            key = Task_disable();
-            rwlock->blockedReaderCnt--;
-            Task_restore(key);
-
-            return (ETIMEDOUT);
-        }
-
-        key = Task_disable();
-
-        /*
-         *  If another reader is active, the rwlock->sem is owned
-         *  by a reader, so just increment the active reader count.
-         */
-        if (rwlock->activeReaderCnt > 0) {
-            rwlock->blockedReaderCnt--;
-            rwlock->activeReaderCnt++;
-            Task_restore(key);
-
-            return (0);
-        }
-
-        /*
-         *  We have been unblocked by a writer.  Try again to take the
-         *  rwlock->sem, since another writer or reader may have taken
-         *  it in the meantime.
-         */
-        if (Semaphore_pend(Semaphore_handle(&(rwlock->sem)), 0)) {
-            /* Got it */
-            rwlock->blockedReaderCnt--;
-            rwlock->activeReaderCnt++;
-
-            Assert_isTrue(rwlock->activeReaderCnt == 1, 0);
-            Assert_isTrue(rwlock->owner == NULL, 0);
-            rwlock->owner = pthread_self();
-
-            Task_restore(key);
-            return (0);
-        }
-
-        if (timeout != BIOS_WAIT_FOREVER) {
-            prevTicks = curTicks;
-            curTicks = Clock_getTicks();
-            deltaTicks = curTicks - prevTicks;
-
-            if (deltaTicks >= timeout) {
-                /* Timed out without acquiring the lock */
-                rwlock->blockedReaderCnt--;
-                Task_restore(key);
-                break;
-            }
-            timeout -= deltaTicks;
-        }
-
-        Task_restore(key);
-    }
-
-    return (ETIMEDOUT);
-}
@@ -34,13 +34,66 @@
  */
 
 #include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/Memory.h>
+
+#include <stddef.h>
+#include <string.h>
+#include <stdarg.h>
 
 #include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/knl/Clock.h>
 #include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Task.h>
 
 #include "errno.h"
 #include "semaphore.h"
+#include "_nametab.h"
+
+/*
+ *  ======== SemNamedObj ========
+ *  A named semaphore, created the first time sem_open() is called with
+ *  its name.  sem_open() returns a pointer to the embedded sem_t.  The
+ *  object is freed once it has been unlinked and its last open reference
+ *  closed, whichever comes last.
+ */
+typedef struct SemNamedObj {
+    NameTab_Elem  elem;      /* must be first, see sem_open() */
+    sem_t         sem;
+    int           refCount;
+    Bool          unlinked;  /* removed from semTable by sem_unlink() */
+    char         *name;
+} SemNamedObj;
+
+#define NAMEDOBJ(semaphore) \
+    ((SemNamedObj *)((char *)(semaphore) - offsetof(SemNamedObj, sem)))
+
+static NameTab semTable;
+
+static SemNamedObj *createNamed(const char *name, unsigned value);
+static Void deleteNamed(SemNamedObj *obj);
+
+/*
+ *  ======== sem_close ========
+ *  Only for semaphores returned by sem_open().
+ */
+int sem_close(sem_t *semaphore)
+{
+    SemNamedObj *obj = NAMEDOBJ(semaphore);
+    Bool         last;
+    UInt         key;
+
+    key = Task_disable();
+    obj->refCount--;
+    last = (obj->refCount == 0) && obj->unlinked;
+    Task_restore(key);
+
+    if (last) {
+        deleteNamed(obj);
+    }
+
+    return (0);
+}
 
 /*
  *  ======== sem_destroy ========
@@ -82,6 +135,73 @@ int sem_init(sem_t *semaphore, int pshared, unsigned value)
     return (0);
 }
 
+/*
+ *  ======== sem_open ========
+ */
+sem_t *sem_open(const char *name, int oflag, ...)
+{
+    va_list      va;
+    unsigned     value = 0;
+    SemNamedObj *obj;
+    SemNamedObj *newObj = NULL;
+    UInt32       hash;
+    UInt         key;
+
+    va_start(va, oflag);
+
+    if (oflag & O_CREAT) {
+        (void)va_arg(va, unsigned);     /* mode, ignored */
+        value = va_arg(va, unsigned);
+    }
+
+    va_end(va);
+
+    if ((name == NULL) || ((int)value < 0)) {
+        return (SEM_FAILED);
+    }
+
+    hash = NameTab_hash(name);
+
+    /*
+     *  Allocate a new semaphore up front if we may have to create one, so
+     *  the lookup and the insert below happen under a single Task_disable()
+     *  and two tasks opening the same name cannot both add an entry.
+     */
+    if (oflag & O_CREAT) {
+        newObj = createNamed(name, value);
+        if (newObj == NULL) {
+            return (SEM_FAILED);
+        }
+    }
+
+    key = Task_disable();
+    obj = (SemNamedObj *)NameTab_find(&semTable, name, hash);
+
+    if (obj == NULL) {
+        if (newObj != NULL) {
+            NameTab_add(&semTable, &newObj->elem, newObj->name, hash);
+            obj = newObj;
+            newObj = NULL;
+        }
+    }
+    else if ((oflag & O_CREAT) && (oflag & O_EXCL)) {
+        /* Error: semaphore already exists and O_EXCL is set */
+        obj = NULL;
+    }
+    else {
+        obj->refCount++;
+    }
+
+    Task_restore(key);
+
+    if (newObj != NULL) {
+        /* Lost the race, or the open failed: drop the unused semaphore */
+        deleteNamed(newObj);
+    }
+
+    return ((obj == NULL) ? SEM_FAILED : &obj->sem);
+}
+
 /*
  *  ======== sem_post ========
  */
@@ -158,6 +278,45 @@ int sem_trywait(sem_t *semaphore)
     return (0);
 }
 
+/*
+ *  ======== sem_unlink ========
+ *  Removes the name at once.  A semaphore that is still open is freed by
+ *  its last sem_close().
+ */
+int sem_unlink(const char *name)
+{
+    SemNamedObj *obj;
+    UInt32       hash;
+    UInt         key;
+
+    hash = NameTab_hash(name);
+
+    key = Task_disable();
+
+    obj = (SemNamedObj *)NameTab_find(&semTable, name, hash);
+
+    if (obj == NULL) {
+        Task_restore(key);
+        return (-1);
+    }
+
+    NameTab_remove(&semTable, &obj->elem);
+    obj->unlinked = TRUE;
+
+    if (obj->refCount != 0) {
+        /* Still open, sem_close() frees it */
+        obj = NULL;
+    }
+
+    Task_restore(key);
+
+    if (obj != NULL) {
+        deleteNamed(obj);
+    }
+
+    return (0);
+}
+
 /*
  *  ======== sem_wait ========
  */
@@ -168,3 +327,52 @@ int sem_wait(sem_t *semaphore)
 
     return (0);
 }
+
+/*
+ *************************************************************************
+ *                      Internal functions
+ *************************************************************************
+ */
+
+/*
+ *  ======== createNamed ========
+ *  Allocate a named semaphore with a reference count of 1, not yet in
+ *  the name table.
+ */
+static SemNamedObj *createNamed(const char *name, unsigned value)
+{
+    SemNamedObj *obj;
+    Error_Block  eb;
+
+    Error_init(&eb);
+
+    obj = (SemNamedObj *)Memory_alloc(Task_Object_heap(),
+            sizeof(SemNamedObj), 0, &eb);
+    if (obj == NULL) {
+        return (NULL);
+    }
+
+    obj->name = (char *)Memory_alloc(Task_Object_heap(), strlen(name) + 1,
+            0, &eb);
+    if (obj->name == NULL) {
+        Memory_free(Task_Object_heap(), obj, sizeof(SemNamedObj));
+        return (NULL);
+    }
+
+    strcpy(obj->name, name);
+    obj->refCount = 1;
+    obj->unlinked = FALSE;
+    Semaphore_construct(&(obj->sem.sem), (int)value, NULL);
+
+    return (obj);
+}
+
+/*
+ *  ======== deleteNamed ========
+ */
+static Void deleteNamed(SemNamedObj *obj)
+{
+    Semaphore_destruct(&(obj->sem.sem));
+    Memory_free(Task_Object_heap(), obj->name, strlen(obj->name) + 1);
+    Memory_free(Task_Object_heap(), obj, sizeof(SemNamedObj));
+}
@@ -56,13 +56,27 @@ typedef struct sem_t {
     ti_sysbios_knl_Semaphore_Struct  sem;
 } sem_t;
 
+/* Returned by sem_open() on failure */
+#define SEM_FAILED      ((sem_t *)(-1))
 
+/* For sem_open(), same values as in mqueue.h */
+#ifndef O_CREAT
+#define O_CREAT         0x200
+#endif
+#ifndef O_EXCL
+#define O_EXCL          0x0800
+#endif
+
+
+int    sem_close(sem_t *sem);
 int    sem_destroy(sem_t *sem);
 int    sem_getvalue(sem_t *sem, int *value);
 int    sem_init(sem_t *sem, int pshared, unsigned value);
+sem_t *sem_open(const char *name, int oflag, ...);
 int    sem_post(sem_t *sem);
 int    sem_timedwait(sem_t *sem, const struct timespec *abstime);
 int    sem_trywait(sem_t *sem);
+int    sem_unlink(const char *name);
 int    sem_wait(sem_t *sem);
 
 #ifdef __cplusplus
@@ -45,6 +45,7 @@ extern "C" {
 
 #include <ti/sysbios/knl/Queue.h>
 #include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/gates/GateRW.h>
 
 
 #if !defined(__GNUC__) || defined(__ti__)
@@ -118,26 +119,11 @@ typedef uint32_t pthread_once_t;
  */
 typedef struct pthread_rwlock_t {
     /*
-     *  This semaphore must be acquired to obtain a write lock.
-     *  A readlock can be obtained if there is already a read lock
-     *  acquired, or by acquiring this semaphore.
+     *  Readers enter and leave with one atomic update of the gate's
+     *  state word; a writer holds it alone and inherits the priority
+     *  of the Tasks waiting for it.
      */
-    ti_sysbios_knl_Semaphore_Struct  sem;
-
-    /*
-     *  This semaphore is used to block readers when sem is in use
-     *  by a write lock.
-     */
-    ti_sysbios_knl_Semaphore_Struct  readSem;
-
-    int       activeReaderCnt;   /* Number of read locks acquired */
-    int       blockedReaderCnt;  /* Number of readers blocked on readSem */
-
-    /*
-     *  The 'owner' is the writer holding the lock, or the first reader
-     *  that acquired the lock.
-     */
-    pthread_t owner;
+    ti_sysbios_gates_GateRW_Struct  gate;
 } pthread_rwlock_t;
 
 struct _pthread_cleanup_context {
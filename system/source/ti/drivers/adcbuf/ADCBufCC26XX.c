@@ -46,6 +46,7 @@
 /* TI-RTOS drivers */
 #include <ti/drivers/ADCBuf.h>
 #include <ti/drivers/adcbuf/ADCBufCC26XX.h>
+#include <ti/drivers/adcbuf/ADCBufCC26XXCalibration.h>
 #include <ti/drivers/PIN.h>
 #include <ti/drivers/pin/PINCC26XX.h>
 #include <ti/drivers/dma/UDMACC26XX.h>
@@ -65,6 +66,7 @@
 #include DEVICE_FAMILY_PATH(inc/hw_ints.h)
 #include DEVICE_FAMILY_PATH(inc/hw_types.h)
 #include DEVICE_FAMILY_PATH(inc/hw_aux_evctl.h)
+#include DEVICE_FAMILY_PATH(inc/hw_udma.h)
 #include DEVICE_FAMILY_PATH(driverlib/aux_adc.h)
 #include DEVICE_FAMILY_PATH(driverlib/aux_wuc.h)
 #include DEVICE_FAMILY_PATH(driverlib/aux_smph.h)
@@ -94,16 +96,34 @@ int_fast16_t ADCBufCC26XX_control(ADCBuf_Handle handle, uint_fast16_t cmd, void
  */
 static bool ADCBufCC26XX_acquireADCSemaphore(ADCBuf_Handle handle);
 static bool ADCBufCC26XX_releaseADCSemaphore(ADCBuf_Handle handle);
-static void ADCBufCC26XX_configDMA(ADCBuf_Handle handle, ADCBuf_Conversion *conversion);
+static void ADCBufCC26XX_configDMA(ADCBuf_Handle handle);
 static void ADCBufCC26XX_hwiFxn (UArg arg);
 static void ADCBufCC26XX_swiFxn (UArg arg0, UArg arg1);
 static void ADCBufCC26XX_conversionCallback(ADCBuf_Handle handle, ADCBuf_Conversion *conversion, void *completedADCBuffer, uint32_t completedChannel);
 static uint32_t ADCBufCC26XX_freqToCounts(uint32_t frequency);
 static void ADCBufCC26XX_configGPTDMA(ADCBuf_Handle handle, ADCBuf_Conversion *conversion);
 static void ADCBufCC26XX_cleanADC(ADCBuf_Handle handle);
-static void ADCBufCC26XX_loadDMAControlTableEntry(ADCBuf_Handle handle, ADCBuf_Conversion *conversion, bool primaryEntry);
+static void ADCBufCC26XX_loadDMAControlTableEntry(ADCBuf_Handle handle, uint32_t block);
 static void ADCBufCC26XX_loadGPTDMAControlTableEntry(ADCBuf_Handle handle, ADCBuf_Conversion *conversion, bool primaryEntry);
 
+/*
+ *  Block n of a conversion is sampled on conversions[n % channelCount] into
+ *  that conversion's sampleBuffer or sampleBufferTwo, alternating on every
+ *  round. Even blocks go through the primary DMA control table entry, odd
+ *  blocks through the alternate one.
+ */
+static inline ADCBuf_Conversion *ADCBufCC26XX_blockConversion(ADCBufCC26XX_Object *object, uint32_t block)
+{
+    return (&object->currentConversion[block % object->channelCount]);
+}
+
+static inline void *ADCBufCC26XX_blockBuffer(ADCBufCC26XX_Object *object, uint32_t block)
+{
+    ADCBuf_Conversion *conversion = ADCBufCC26XX_blockConversion(object, block);
+
+    return (((block / object->channelCount) & 1) ? conversion->sampleBufferTwo : conversion->sampleBuffer);
+}
+
 /*
  * =============================================================================
  * Constants
@@ -279,6 +299,12 @@ ADCBuf_Handle ADCBufCC26XX_open(ADCBuf_Handle handle,
         object->samplingDuration            = ADCBufCC26XX_SAMPLING_DURATION_2P7_US;
     }
 
+    /* Read the factory trim once for the bulk adjust and microvolt conversion */
+    ADCBufCC26XXCalibration_init(&(object->calibration),
+                                 AUXADCGetAdjustmentGain(object->refSource),
+                                 AUXADCGetAdjustmentOffset(object->refSource),
+                                 (object->inputScalingEnabled) ? AUXADC_FIXED_REF_VOLTAGE_NORMAL : AUXADC_FIXED_REF_VOLTAGE_UNSCALED);
+
     /* Create the Hwi for this ADC peripheral. */
     Hwi_Params_init(&paramsUnion.hwiParams);
     paramsUnion.hwiParams.arg = (UArg) handle;
@@ -297,6 +323,19 @@ ADCBuf_Handle ADCBufCC26XX_open(ADCBuf_Handle handle,
     paramsUnion.timerParams.mode            = GPT_MODE_PERIODIC_UP;
     paramsUnion.timerParams.debugStallMode  = GPTimerCC26XX_DEBUG_STALL_OFF;
     object->timerHandle                     = GPTimerCC26XX_open(hwAttrs->gpTimerUnit, &paramsUnion.timerParams);
+    if (object->timerHandle == NULL) {
+        /* The GPTimer is in use elsewhere, e.g. for PWM; undo the above */
+        Swi_destruct(&(object->swi));
+        Hwi_destruct(&(object->hwi));
+        if (object->returnMode == ADCBuf_RETURN_MODE_BLOCKING) {
+            Semaphore_destruct(&(object->conversionComplete));
+        }
+        object->isOpen = false;
+
+        Log_warning0("ADCBuf: GPTimer not available");
+
+        return (NULL);
+    }
 
     adcPeriodCounts = ADCBufCC26XX_freqToCounts(object->samplingFrequency);
     GPTimerCC26XX_setLoadValue(object->timerHandle, adcPeriodCounts);
@@ -334,6 +373,15 @@ static void ADCBufCC26XX_hwiFxn (UArg arg) {
         /* Disable ADC DMA if we are only doing one conversion and clear DMA done interrupt. */
         HWREG(AUX_EVCTL_BASE + AUX_EVCTL_O_DMACTL) = AUX_EVCTL_DMACTL_REQ_MODE_SINGLE | AUX_EVCTL_DMACTL_SEL_FIFO_NOT_EMPTY ;
     }
+    else if (HWREG(UDMA0_BASE + UDMA_O_REQDONE) & (1 << UDMA_CHAN_AUX_ADC)) {
+        /* A block finished and the DMA moved on to the next one. Point the
+         * mux at the next block's channel before its first trigger arrives.
+         */
+        object->blocksCompleted++;
+        if (object->channelCount > 1) {
+            AUXADCSelectInput(hwAttrs->adcChannelLut[ADCBufCC26XX_blockConversion(object, object->blocksCompleted)->adcChannel].compBInput);
+        }
+    }
     UDMACC26XX_clearInterrupt(object->udmaHandle, (1 << UDMA_CHAN_AUX_ADC) | (hwAttrs->gptDMAChannelMask));
 
     /* Get the status of the ADC_IRQ line and ADC_DONE */
@@ -355,46 +403,48 @@ static void ADCBufCC26XX_swiFxn (UArg arg0, UArg arg1) {
     ADCBuf_Conversion               *conversion;
     ADCBufCC26XX_Object             *object;
     uint16_t                        *activeSampleBuffer;
+    uint32_t                        block;
 
     /* Get the pointer to the object */
     object = ((ADCBuf_Handle)arg0)->object;
 
     Log_print0(Diags_USER2, "ADC: swi interrupt context start");
 
-    /* Use a temporary transaction pointer in case the callback function
-     * attempts to perform another ADCBuf_transfer call
-     */
-    conversion = object->currentConversion;
-
-    /* Pass the primary sampleBuffer to the callback fxn by default */
-    activeSampleBuffer = conversion->sampleBuffer;
-
     if (object->recurrenceMode == ADCBuf_RECURRENCE_MODE_ONE_SHOT) {
+        /* Use a temporary transaction pointer in case the callback function
+         * attempts to perform another ADCBuf_transfer call
+         */
+        conversion = object->currentConversion;
+
         /* Clean up ADC and DMA */
         ADCBufCC26XX_cleanADC(((ADCBuf_Handle)arg0));
         /* Indicate we are done with this transfer */
         object->currentConversion = NULL;
+
+        /* Perform callback */
+        object->callbackFxn((ADCBuf_Handle)arg0, conversion, conversion->sampleBuffer, object->currentChannel);
     }
     else {
-        /* Reload the finished DMA control table entry */
-        // TODO: switch this to a base addr relative to the hwAttrs
-        if (HWREG(UDMA0_BASE + UDMA_O_SETCHNLPRIALT) & (1 << UDMA_CHAN_AUX_ADC)) {
-            /* We are currently using the alternate entry -> we just finished the primary entry -> reload primary entry */
-            ADCBufCC26XX_loadDMAControlTableEntry((ADCBuf_Handle)arg0, conversion, true);
-            ADCBufCC26XX_loadGPTDMAControlTableEntry((ADCBuf_Handle)arg0, conversion, true);
-        }
-        else {
-            /* We are currently using the primary entry -> we just finished the alternate entry -> reload the alternate entry */
-            ADCBufCC26XX_loadDMAControlTableEntry((ADCBuf_Handle)arg0, conversion, false);
-            ADCBufCC26XX_loadGPTDMAControlTableEntry((ADCBuf_Handle)arg0, conversion, false);
-            activeSampleBuffer = conversion->sampleBufferTwo;
+        /* Hand over every block the Hwi counted since the last run, unless
+         * the callback cancels the conversion on the way.
+         */
+        while (object->conversionInProgress && object->blocksHandled != object->blocksCompleted) {
+            block = object->blocksHandled++;
+            conversion = ADCBufCC26XX_blockConversion(object, block);
+            activeSampleBuffer = ADCBufCC26XX_blockBuffer(object, block);
+
+            /* Reload the finished DMA control table entry with the block after the one in progress */
+            ADCBufCC26XX_loadDMAControlTableEntry((ADCBuf_Handle)arg0, block + 2);
+            ADCBufCC26XX_loadGPTDMAControlTableEntry((ADCBuf_Handle)arg0, conversion, !(block & 1));
+
+            /* Save which channel the completed block was taken on for the callbackFxn */
+            object->currentChannel = conversion->adcChannel;
+
+            /* Perform callback */
+            object->callbackFxn((ADCBuf_Handle)arg0, conversion, activeSampleBuffer, object->currentChannel);
         }
     }
 
-
-    /* Perform callback */
-    object->callbackFxn((ADCBuf_Handle)arg0, conversion, activeSampleBuffer, object->currentChannel);
-
     Log_print0(Diags_USER2, "ADC: swi interrupt context end");
 }
 
@@ -444,7 +494,7 @@ static void ADCBufCC26XX_conversionCallback(ADCBuf_Handle handle, ADCBuf_Convers
 int_fast16_t ADCBufCC26XX_convert(ADCBuf_Handle handle, ADCBuf_Conversion conversions[],  uint_fast8_t channelCount) {
     ADCBufCC26XX_Object             *object;
     ADCBufCC26XX_HWAttrs const      *hwAttrs;
-    PIN_Config                      adcPinTable[2];
+    PIN_Config                      adcPinTable[ADCBufCC26XX_MAX_CHANNELS + 1];
     uint8_t i = 0;
 
     Assert_isTrue(handle, NULL);
@@ -453,10 +503,16 @@ int_fast16_t ADCBufCC26XX_convert(ADCBuf_Handle handle, ADCBuf_Conversion conver
     object = handle->object;
     hwAttrs = handle->hwAttrs;
 
-    Assert_isTrue(channelCount == 1, NULL);
+    /* Several channels are only sampled round robin in continuous mode */
+    Assert_isTrue(channelCount == 1 || (object->recurrenceMode == ADCBuf_RECURRENCE_MODE_CONTINUOUS && channelCount <= ADCBufCC26XX_MAX_CHANNELS), NULL);
     Assert_isTrue((conversions->samplesRequestedCount <= UDMA_XFER_SIZE_MAX), NULL);
     Assert_isTrue(conversions->sampleBuffer, NULL);
     Assert_isTrue(!(object->recurrenceMode == (ADCBuf_RECURRENCE_MODE_CONTINUOUS && !(conversions->sampleBufferTwo))), NULL);
+    for (i = 1; i < channelCount; i++) {
+        /* The DMA transfer size of the GPT entries is shared by all blocks */
+        Assert_isTrue(conversions[i].samplesRequestedCount == conversions->samplesRequestedCount, NULL);
+        Assert_isTrue(conversions[i].sampleBuffer && conversions[i].sampleBufferTwo, NULL);
+    }
 
     /* Check if ADC is open and that no other transfer is in progress */
     uint32_t key = Hwi_disable();
@@ -472,8 +528,10 @@ int_fast16_t ADCBufCC26XX_convert(ADCBuf_Handle handle, ADCBuf_Conversion conver
     /* Specify input in ADC module */
     AUXADCSelectInput(hwAttrs->adcChannelLut[conversions->adcChannel].compBInput);
 
-    /* Add pin to measure on */
-    adcPinTable[i++] = (hwAttrs->adcChannelLut[conversions->adcChannel].dio) | PIN_INPUT_EN;
+    /* Add pins to measure on */
+    for (i = 0; i < channelCount; i++) {
+        adcPinTable[i] = (hwAttrs->adcChannelLut[conversions[i].adcChannel].dio) | PIN_INPUT_EN;
+    }
     /* Terminate pin list */
     adcPinTable[i] = PIN_TERMINATE;
     object->pinHandle = PIN_open(&object->pinState, adcPinTable);
@@ -496,11 +554,14 @@ int_fast16_t ADCBufCC26XX_convert(ADCBuf_Handle handle, ADCBuf_Conversion conver
         object->adcSemaphoreInPossession = true;
     }
 
-    /* Store location of the current conversion */
+    /* Store location of the current conversion(s) */
     object->currentConversion = conversions;
+    object->channelCount = channelCount;
+    object->blocksCompleted = 0;
+    object->blocksHandled = 0;
 
     /* Configure and arm the DMA and AUX DMA control */
-    ADCBufCC26XX_configDMA(handle, conversions);
+    ADCBufCC26XX_configDMA(handle);
 
     /* Configure and arm the GPT DMA channel to clear the level-based GPT IRQ signal */
     ADCBufCC26XX_configGPTDMA(handle, conversions);
@@ -671,19 +732,10 @@ uint_fast8_t ADCBufCC26XX_getResolution(ADCBuf_Handle handle) {
  */
 int_fast16_t ADCBufCC26XX_adjustRawValues(ADCBuf_Handle handle, void *sampleBuffer, uint_fast16_t sampleCount, uint32_t adcChannel) {
     ADCBufCC26XX_Object *object;
-    uint32_t            gain;
-    uint32_t            offset;
-    uint16_t            i;
 
     object = handle->object;
 
-    gain = AUXADCGetAdjustmentGain(object->refSource);
-    offset = AUXADCGetAdjustmentOffset(object->refSource);
-
-    for (i = 0; i < sampleCount; i++) {
-        uint16_t tmpRawADCVal = ((uint16_t *)sampleBuffer)[i];
-        ((uint16_t *)sampleBuffer)[i] = AUXADCAdjustValueForGainAndOffset(tmpRawADCVal, gain, offset);
-    }
+    ADCBufCC26XXCalibration_adjust(&(object->calibration), (uint16_t *)sampleBuffer, sampleCount);
 
     return ADCBuf_STATUS_SUCCESS;
 }
@@ -709,16 +761,10 @@ int_fast16_t ADCBufCC26XX_adjustRawValues(ADCBuf_Handle handle, void *sampleBuff
  */
 int_fast16_t ADCBufCC26XX_convertAdjustedToMicroVolts(ADCBuf_Handle handle, uint32_t  adcChannel, void *adjustedSampleBuffer, uint32_t outputMicroVoltBuffer[], uint_fast16_t sampleCount) {
     ADCBufCC26XX_Object *object;
-    uint16_t            i;
-    uint32_t            voltageRef;
 
     object = handle->object;
 
-    voltageRef = (object->inputScalingEnabled) ? AUXADC_FIXED_REF_VOLTAGE_NORMAL : AUXADC_FIXED_REF_VOLTAGE_UNSCALED;
-
-    for (i = 0; i < sampleCount; i++) {
-        outputMicroVoltBuffer[i] = AUXADCValueToMicrovolts(voltageRef, ((uint16_t *)adjustedSampleBuffer)[i]);
-    }
+    ADCBufCC26XXCalibration_toMicroVolts(&(object->calibration), (uint16_t *)adjustedSampleBuffer, outputMicroVoltBuffer, sampleCount);
 
     return ADCBuf_STATUS_SUCCESS;
 }
@@ -732,21 +778,19 @@ int_fast16_t ADCBufCC26XX_convertAdjustedToMicroVolts(ADCBuf_Handle handle, uint
  *
  *  @param  handle An ADCBufCC26XX handle returned from ADCBufCC26XX_open()
  *
- *  @param  conversion A pointer to an ADCBuf_Conversion
- *
  */
-static void ADCBufCC26XX_configDMA(ADCBuf_Handle handle, ADCBuf_Conversion *conversion) {
+static void ADCBufCC26XX_configDMA(ADCBuf_Handle handle) {
     ADCBufCC26XX_Object             *object;
 
     /* Get the pointer to the object */
     object = handle->object;
 
     /* Set configure control table entry */
-    ADCBufCC26XX_loadDMAControlTableEntry(handle, conversion, true);
+    ADCBufCC26XX_loadDMAControlTableEntry(handle, 0);
 
     /* If we are operating in continous mode, load the alternate DMA control table data structure */
     if (object->recurrenceMode == ADCBuf_RECURRENCE_MODE_CONTINUOUS) {
-        ADCBufCC26XX_loadDMAControlTableEntry(handle, conversion, false);
+        ADCBufCC26XX_loadDMAControlTableEntry(handle, 1);
     }
 
     /* Enable the channels */
@@ -767,18 +811,20 @@ static void ADCBufCC26XX_configDMA(ADCBuf_Handle handle, ADCBuf_Conversion *conv
  *
  *  @param  handle An ADCBufCC26XX handle returned from ADCBufCC26XX_open()
  *
- *  @param  conversion A pointer to an ADCBuf_Conversion
- *
- *  @param  primaryEntry Is this supposed to modify the primary or the alternate control table entry
+ *  @param  block Index of the block to load, even blocks use the primary and odd blocks the alternate control table entry
  *
  */
-static void ADCBufCC26XX_loadDMAControlTableEntry(ADCBuf_Handle handle, ADCBuf_Conversion *conversion, bool primaryEntry) {
+static void ADCBufCC26XX_loadDMAControlTableEntry(ADCBuf_Handle handle, uint32_t block) {
     ADCBufCC26XX_Object             *object;
+    ADCBuf_Conversion               *conversion;
     volatile tDMAControlTable       *dmaControlTableEntry;
     uint32_t                        numberOfBytes;
+    bool                            primaryEntry;
 
     /* Get the pointer to the object*/
     object = handle->object;
+    conversion = ADCBufCC26XX_blockConversion(object, block);
+    primaryEntry = !(block & 1);
 
     /* Calculate the number of bytes for the transfer */
     numberOfBytes = (uint16_t)(conversion->samplesRequestedCount) * ADCBufCC26XX_BYTES_PER_SAMPLE;
@@ -791,7 +837,7 @@ static void ADCBufCC26XX_loadDMAControlTableEntry(ADCBuf_Handle handle, ADCBuf_C
                                         UDMA_DST_INC_16 |
                                         UDMA_ARB_1 |
                                         UDMACC26XX_SET_TRANSFER_SIZE((uint16_t)conversion->samplesRequestedCount);
-    dmaControlTableEntry->pvDstEndAddr = (void *)((uint32_t)(primaryEntry ? conversion->sampleBuffer : conversion->sampleBufferTwo) + numberOfBytes - 1);
+    dmaControlTableEntry->pvDstEndAddr = (void *)((uint32_t)ADCBufCC26XX_blockBuffer(object, block) + numberOfBytes - 1);
     dmaControlTableEntry->pvSrcEndAddr = (void *)(AUX_ANAIF_BASE + AUX_ANAIF_O_ADCFIFO);
 }
 
@@ -92,6 +92,17 @@
  *
  * @note    The ADCBuf driver requires GPTimer0A to function correctly. It will be unavailable for other uses.
  *
+ * # Multiple channels #
+ * In ::ADCBuf_RECURRENCE_MODE_CONTINUOUS, ADCBuf_convert() accepts up to
+ * ::ADCBufCC26XX_MAX_CHANNELS conversions. The ADC has a single input mux,
+ * so the channels are sampled round robin one block at a time: block n is
+ * taken on conversions[n % channelCount] and the callback for it gets that
+ * conversion and its channel. Each conversion alternates between its
+ * sampleBuffer and sampleBufferTwo. All conversions must request the same
+ * number of samples. The mux is switched in the DMA done interrupt, so at
+ * sampling periods close to the interrupt latency the first sample of a
+ * block may still be taken on the previous channel.
+ *
  * # Supported ADC pins #
  * Below is a table of the supported ADC IO pins for each package size, for both CC26xx and CC13xx.
  * It maps a DIO to its corresponding driverlib define for the CompBInput that it is hardwired to.
@@ -242,6 +253,7 @@ extern "C" {
 #include <ti/drivers/timer/GPTimerCC26XX.h>
 #include <ti/drivers/Power.h>
 #include <ti/drivers/power/PowerCC26XX.h>
+#include <ti/drivers/adcbuf/ADCBufCC26XXCalibration.h>
 
 #ifdef DEVICE_FAMILY
     #undef DEVICE_FAMILY_PATH
@@ -331,6 +343,11 @@ extern "C" {
 
 #define ADCBufCC26XX_BYTES_PER_SAMPLE      2
 
+/*!
+ *  @brief Maximum number of channels in one continuous ADCBuf_convert() call
+ */
+#define ADCBufCC26XX_MAX_CHANNELS          8
+
 /*
  * =============================================================================
  * Constants
@@ -539,7 +556,10 @@ typedef struct ADCBufCC26XX_Object{
     Swi_Struct                      swi;                        /*!< Swi object */
     Semaphore_Struct                conversionComplete;         /*!< ADC semaphore */
 
-    ADCBuf_Conversion               *currentConversion;         /*!< Pointer to the current conversion struct */
+    ADCBuf_Conversion               *currentConversion;         /*!< Pointer to the current conversion struct(s) */
+    uint8_t                         channelCount;               /*!< Number of conversions sampled round robin */
+    volatile uint32_t               blocksCompleted;            /*!< Blocks finished by the DMA, counted in the Hwi */
+    uint32_t                        blocksHandled;              /*!< Blocks passed to the callback by the Swi */
 
     /* PIN driver state object and handle */
     PIN_State                       pinState;                   /*!< Pin state object */
@@ -553,6 +573,7 @@ typedef struct ADCBufCC26XX_Object{
 
     uint32_t                        semaphoreTimeout;           /*!< Timeout for read semaphore in ::ADCBuf_RETURN_MODE_BLOCKING */
     uint32_t                        samplingFrequency;          /*!< Frequency in Hz at which the ADC is triggered */
+    ADCBufCC26XXCalibration         calibration;                /*!< Gain, offset and reference folded at open */
 } ADCBufCC26XX_Object, *ADCBufCC26XX_Handle;
 
 /*
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== ADCBufCC26XXCalibration.c ========
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <ti/drivers/adcbuf/ADCBufCC26XXCalibration.h>
+
+/* n / 4095 == (n * MAGIC) >> 43 for all n < 2^31 */
+#define DIV4095_MAGIC       2148008065UL
+#define DIV4095_SHIFT       43
+
+#define ADC_MAX             4095
+
+/*
+ *  ======== adjustOne ========
+ *  A negative sum wraps to a large unsigned value; the arithmetic shift
+ *  of its signed reading stays negative and saturates to 0.
+ */
+static inline uint32_t adjustOne(uint32_t gain, uint32_t bias, uint32_t x)
+{
+    int32_t v = (int32_t)(x * gain + bias) >> 15;
+
+    if (v < 0) {
+        return (0);
+    }
+    else if (v > ADC_MAX) {
+        return (ADC_MAX);
+    }
+
+    return ((uint32_t)v);
+}
+
+/*
+ *  ======== microVoltsOne ========
+ */
+static inline uint32_t microVoltsOne(uint32_t refScaled, uint32_t v)
+{
+    uint32_t n = v * refScaled + 2047;
+
+    return ((uint32_t)(((uint64_t)n * DIV4095_MAGIC) >> DIV4095_SHIFT) << 4);
+}
+
+/*
+ *  ======== ADCBufCC26XXCalibration_init ========
+ */
+void ADCBufCC26XXCalibration_init(ADCBufCC26XXCalibration *cal, int32_t gain,
+    int32_t offset, int32_t fixedRefVoltage)
+{
+    cal->gain = (uint32_t)gain;
+    cal->bias = (uint32_t)offset * (uint32_t)gain + 16384;
+
+    /* driverlib drops 4 bits of the reference to stay within 32 bits */
+    cal->refScaled = (uint32_t)(fixedRefVoltage >> 4);
+}
+
+/*
+ *  ======== ADCBufCC26XXCalibration_adjust ========
+ *  Both lanes of a 32-bit word go through the same function, so the
+ *  byte order doesn't matter here.
+ */
+void ADCBufCC26XXCalibration_adjust(const ADCBufCC26XXCalibration *cal,
+    uint16_t *samples, size_t count)
+{
+    uint32_t gain = cal->gain;
+    uint32_t bias = cal->bias;
+    uint32_t pair;
+
+    for (; count >= 2; count -= 2, samples += 2) {
+        /* memcpy compiles to a single (unaligned) LDR/STR on the M3 */
+        memcpy(&pair, samples, sizeof(pair));
+        pair = adjustOne(gain, bias, pair & 0xffff) |
+               (adjustOne(gain, bias, pair >> 16) << 16);
+        memcpy(samples, &pair, sizeof(pair));
+    }
+
+    if (count != 0) {
+        *samples = (uint16_t)adjustOne(gain, bias, *samples);
+    }
+}
+
+/*
+ *  ======== ADCBufCC26XXCalibration_toMicroVolts ========
+ *  The low half of each 32-bit load is the first sample (little endian).
+ */
+void ADCBufCC26XXCalibration_toMicroVolts(const ADCBufCC26XXCalibration *cal,
+    const uint16_t *samples, uint32_t *microVolts, size_t count)
+{
+    uint32_t refScaled = cal->refScaled;
+    uint32_t pair;
+
+    for (; count >= 2; count -= 2, samples += 2, microVolts += 2) {
+        memcpy(&pair, samples, sizeof(pair));
+        microVolts[0] = microVoltsOne(refScaled, pair & 0xffff);
+        microVolts[1] = microVoltsOne(refScaled, pair >> 16);
+    }
+
+    if (count != 0) {
+        *microVolts = microVoltsOne(refScaled, *samples);
+    }
+}
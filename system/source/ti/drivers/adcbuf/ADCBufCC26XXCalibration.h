@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       ADCBufCC26XXCalibration.h
+ *
+ *  @brief      Bulk gain/offset adjustment and microvolt conversion for the
+ *              CC26XX/CC13XX ADC
+ *
+ *  ADCBufCC26XX_adjustRawValues() and
+ *  ADCBufCC26XX_convertAdjustedToMicroVolts() used to call the driverlib
+ *  functions AUXADCAdjustValueForGainAndOffset() and
+ *  AUXADCValueToMicrovolts() once per sample, each with a division. This
+ *  module folds the factory gain, offset and reference voltage into
+ *  fixed-point constants once, when the driver is opened, and then works
+ *  through whole buffers two samples per 32-bit load without calls or
+ *  divides.
+ *
+ *  The results are bit-identical to the driverlib functions:
+ *  - adjust: ((x + offset) * gain + 16384) / 32768, saturated to 0..4095,
+ *    is computed as (x * gain + bias) >> 15 with bias folded in advance.
+ *    The two only differ in rounding for negative sums, which saturate to
+ *    0 either way.
+ *  - microvolts: ((v * (ref >> 4) + 2047) / 4095) << 4, where the division
+ *    by 4095 is a multiply by ceil(2^43 / 4095) and a shift, exact for all
+ *    dividends below 2^31.
+ *
+ *  extras/adccal_vectors.c checks this on the host over the full sample
+ *  range for every offset and a sweep of gains.
+ *
+ *  The module depends on nothing but the C library, so it builds on the
+ *  host as well.
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_adcbuf_ADCBufCC26XXCalibration__include
+#define ti_drivers_adcbuf_ADCBufCC26XXCalibration__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*!
+ *  @brief  Precomputed calibration constants
+ */
+typedef struct ADCBufCC26XXCalibration {
+    uint32_t    gain;       /*!< Factory gain, Q15 */
+    uint32_t    bias;       /*!< offset * gain + 16384, two's complement */
+    uint32_t    refScaled;  /*!< Fixed reference voltage in uV, >> 4 */
+} ADCBufCC26XXCalibration;
+
+/*!
+ *  @brief  Fold gain, offset and reference into cal
+ *
+ *  @param  cal             Calibration to initialize
+ *
+ *  @param  gain            AUXADCGetAdjustmentGain() for the reference
+ *
+ *  @param  offset          AUXADCGetAdjustmentOffset() for the reference
+ *
+ *  @param  fixedRefVoltage AUXADC_FIXED_REF_VOLTAGE_NORMAL or
+ *                          AUXADC_FIXED_REF_VOLTAGE_UNSCALED
+ */
+extern void ADCBufCC26XXCalibration_init(ADCBufCC26XXCalibration *cal,
+    int32_t gain, int32_t offset, int32_t fixedRefVoltage);
+
+/*!
+ *  @brief  Adjust raw samples for gain and offset in place
+ *
+ *  Equivalent to AUXADCAdjustValueForGainAndOffset() on every sample.
+ */
+extern void ADCBufCC26XXCalibration_adjust(const ADCBufCC26XXCalibration *cal,
+    uint16_t *samples, size_t count);
+
+/*!
+ *  @brief  Convert adjusted samples to microvolts
+ *
+ *  Equivalent to AUXADCValueToMicrovolts() on every sample. The samples
+ *  must be adjusted, i.e. in 0..4095.
+ */
+extern void ADCBufCC26XXCalibration_toMicroVolts(
+    const ADCBufCC26XXCalibration *cal, const uint16_t *samples,
+    uint32_t *microVolts, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_adcbuf_ADCBufCC26XXCalibration__include */
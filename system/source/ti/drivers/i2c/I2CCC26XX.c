@@ -248,12 +248,37 @@ void I2CCC26XX_close(I2C_Handle handle)
  *  @brief  Function for setting control parameters of the I2C driver
  *          after it has been opened.
  *
- *  @note   Currently not in use.
+ *  Supports ::I2CCC26XX_CMD_SET_READ_SEGMENTS.
  */
 int_fast16_t I2CCC26XX_control(I2C_Handle handle, uint_fast16_t cmd, void *arg)
 {
-    /* No implementation */
-    return (I2C_STATUS_UNDEFINEDCMD);
+    I2CCC26XX_Object            *object = handle->object;
+
+    switch (cmd) {
+        case I2CCC26XX_CMD_SET_READ_SEGMENTS:
+            /* Consumed by the next I2CCC26XX_primeTransfer() */
+            object->pendingSegments = (I2CCC26XX_ReadSegments const *)arg;
+            return (I2C_STATUS_SUCCESS);
+
+        default:
+            return (I2C_STATUS_UNDEFINEDCMD);
+    }
+}
+
+/*
+ *  ======== I2CCC26XX_nextReadSegment ========
+ *  Move readBufIdx to the next non-empty chained read segment once the
+ *  current one is full. readCountIdx already covers all segments, so the
+ *  ACK/NACK/STOP decisions in the Hwi are unaffected.
+ */
+static inline void I2CCC26XX_nextReadSegment(I2CCC26XX_Object *object)
+{
+    while ((object->readSegCountIdx == 0) && object->readSegmentsLeft) {
+        object->readBufIdx = object->readSegment->buf;
+        object->readSegCountIdx = object->readSegment->count;
+        object->readSegment++;
+        object->readSegmentsLeft--;
+    }
 }
 
 
@@ -422,6 +447,8 @@ static void I2CCC26XX_hwiFxn(UArg arg)
                         *(object->readBufIdx));
 
                 object->readBufIdx++;
+                object->readSegCountIdx--;
+                I2CCC26XX_nextReadSegment(object);
 
                 /* Check if any data needs to be received */
                 object->readCountIdx--;
@@ -706,6 +733,7 @@ I2C_Handle I2CCC26XX_open(I2C_Handle handle, I2C_Params *params)
     /* Clear the head pointer */
     object->headPtr = NULL;
     object->tailPtr = NULL;
+    object->pendingSegments = NULL;
 
     /* Register notification functions */
     Power_registerNotify(&object->i2cPostObj, PowerCC26XX_AWAKE_STANDBY, (Fxn)i2cPostNotify, (UInt32)handle);
@@ -738,6 +766,22 @@ static int I2CCC26XX_primeTransfer(I2C_Handle handle,
 
     object->readBufIdx = transaction->readBuf;
     object->readCountIdx = transaction->readCount;
+    object->readSegCountIdx = transaction->readCount;
+    object->readSegment = NULL;
+    object->readSegmentsLeft = 0;
+
+    /* Chain any read segments armed through I2C_control() */
+    if (object->pendingSegments) {
+        size_t i;
+
+        object->readSegment = object->pendingSegments->segments;
+        object->readSegmentsLeft = object->pendingSegments->numSegments;
+        for (i = 0; i < object->readSegmentsLeft; i++) {
+            object->readCountIdx += object->readSegment[i].count;
+        }
+        object->pendingSegments = NULL;
+        I2CCC26XX_nextReadSegment(object);
+    }
 
     Log_print2(Diags_USER1,
             "I2C:(%p) Starting transaction to slave: 0x%x",
@@ -330,7 +330,22 @@ extern "C" {
  *  @{
  */
 
-/* Add I2CCC26XX_CMD_* macros here */
+/*!
+ * @brief Command used by I2C_control to chain read segments onto the next
+ *        transaction
+ *
+ * The segments in the ::I2CCC26XX_ReadSegments list pointed to by @b arg are
+ * appended to the read phase of the next transaction passed to I2C_transfer().
+ * The bytes are clocked in as one burst: the bus is only NACKed and STOPped
+ * after the last byte of the last segment, and each byte is stored directly
+ * into its segment buffer. The transaction's readBuf and readCount describe
+ * the first segment. The list is consumed when that transaction starts and
+ * must stay valid until it completes. Passing NULL as @b arg disarms a
+ * pending list. Returns I2C_STATUS_SUCCESS.
+ *
+ * The caller must make sure no other task issues a transfer in between.
+ */
+#define I2CCC26XX_CMD_SET_READ_SEGMENTS     (I2C_CMD_RESERVED + 0)
 
 /** @}*/
 
@@ -369,6 +384,26 @@ typedef struct I2CCC26XX_I2CPinCfg {
     uint8_t pinSCL;
 } I2CCC26XX_I2CPinCfg;
 
+/*!
+ *  @brief  I2CCC26XX read segment
+ *
+ *  One buffer of a scatter-gather read, see ::I2CCC26XX_CMD_SET_READ_SEGMENTS.
+ */
+typedef struct I2CCC26XX_ReadSegment {
+    void               *buf;          /*!< Buffer to receive into */
+    size_t              count;        /*!< Number of bytes to receive */
+} I2CCC26XX_ReadSegment;
+
+/*!
+ *  @brief  I2CCC26XX read segment list
+ *
+ *  Argument of ::I2CCC26XX_CMD_SET_READ_SEGMENTS.
+ */
+typedef struct I2CCC26XX_ReadSegments {
+    I2CCC26XX_ReadSegment const *segments;    /*!< Array of segments */
+    size_t                       numSegments; /*!< Number of segments */
+} I2CCC26XX_ReadSegments;
+
 /*!
  *  @cond NODOC
  *  I2CCC26XX mode
@@ -497,6 +532,12 @@ typedef struct I2CCC26XX_Object {
     Power_NotifyObj     i2cPostObj;         /*!< I2C post-notification object */
 
     bool                isOpen;             /*!< flag to indicate module is open */
+
+    /* Chained read segments, see I2CCC26XX_CMD_SET_READ_SEGMENTS */
+    unsigned int        readSegCountIdx;     /*!< Bytes left in current segment */
+    I2CCC26XX_ReadSegment const *readSegment;  /*!< Next read segment */
+    size_t              readSegmentsLeft;    /*!< Read segments not started */
+    I2CCC26XX_ReadSegments const *pendingSegments; /*!< Armed by I2C_control */
 } I2CCC26XX_Object;
 
 /* Do not interfere with the app if they include the family Hwi module */
@@ -64,6 +64,7 @@
 * INCLUDES
 */
 #include <stdint.h>
+#include <stddef.h>
 #include <ti/drivers/pdm/Codec1.h>
 
 /**************************************************************************************************
@@ -85,76 +86,234 @@ static const uint16_t Codec1_stepsizeLut[89] =
     15289,16818,18500,20350,22385,24623,27086,29794, 32767
 };
 
-static const int8_t Codec1_IndexLut[16] =
+/* Step index adjustment, by the magnitude bits of the nibble */
+static const int8_t Codec1_IndexLut[8] =
 {
-    -1, -1, -1, -1, 2, 4, 6, 8,
     -1, -1, -1, -1, 2, 4, 6, 8
 };
 
-/*
-*  ======== Codec1_encodeSingle ========
+/**************************************************************************************************
+*                                        Local Functions
 */
-uint8_t Codec1_encodeSingle(int16_t audSample)
+
+/*
+ *  The encoder and decoder below work on the predicted value and step
+ *  index held in locals, so a buffer loop keeps them in registers. They
+ *  are bit-exact with the original per-nibble implementation, including
+ *  its int16_t wrap-arounds: the difference and the accumulated step are
+ *  truncated to 16 bits before they are used.
+ */
+
+/*
+ *  ======== Codec1_nextIndex ========
+ */
+static inline int32_t Codec1_nextIndex(int32_t si, uint32_t nibble)
 {
-    // Difference between samples and previous predicted value.
-    // This difference will be encoded
-    int16_t difference = audSample - Codec1_pvEnc;
-    //Final nibble value
-    uint8_t tic1_nibble_4bits = 0;
-    //Step size to quantisize the difference,
-    int16_t step = Codec1_stepsizeLut[Codec1_siEnc];
-    //cumulated difference from samples.
-    int16_t cum_diff = step>>3;
-
-    if(difference<0)
-    {
-        tic1_nibble_4bits = 8;
-        difference = -difference;
+    si += Codec1_IndexLut[nibble & 7];
+    if (si < 0) {
+        si = 0;
     }
-
-    if(difference>=step)
-    {
-        tic1_nibble_4bits |= 4;
-        difference -= step;
-        cum_diff += step;
+    if (si > 88) {
+        si = 88;
     }
+
+    return (si);
+}
+
+/*
+ *  ======== Codec1_encodeNibble ========
+ *  The quantizer subtracts the step with masks instead of branches.
+ */
+static inline uint32_t Codec1_encodeNibble(int32_t sample, int32_t *pv,
+    int32_t *si)
+{
+    int32_t step = Codec1_stepsizeLut[*si];
+    int32_t diff = (int16_t)(sample - *pv);
+    int32_t sign = diff >> 31;
+    int32_t cum = step >> 3;
+    uint32_t nibble = (uint32_t)sign & 8;
+    int32_t mask;
+    int32_t t;
+
+    /* |diff|; -32768 stays negative and quantizes to 0, as before */
+    diff = (int16_t)((diff ^ sign) - sign);
+
+    mask = -(int32_t)(diff >= step);
+    nibble |= (uint32_t)mask & 4;
+    diff -= step & mask;
+    cum += step & mask;
     step >>= 1;
-    if(difference>=step)
-    {
-        tic1_nibble_4bits |= 2;
-        difference -= step;
-        cum_diff += step;
-    }
+
+    mask = -(int32_t)(diff >= step);
+    nibble |= (uint32_t)mask & 2;
+    diff -= step & mask;
+    cum += step & mask;
     step >>= 1;
-    if(difference>=step)
-    {
-        tic1_nibble_4bits |= 1;
-        cum_diff += step;
+
+    mask = -(int32_t)(diff >= step);
+    nibble |= (uint32_t)mask & 1;
+    cum += step & mask;
+
+    cum = (int16_t)cum;
+
+    /* add or subtract; only the side matching the sign saturates */
+    t = *pv + ((cum ^ sign) - sign);
+    if (t > 0x7fff) {
+        t = sign ? (int16_t)t : 0x7fff;
+    }
+    else if (t < -32768) {
+        t = sign ? -32768 : (int16_t)t;
     }
+    *pv = t;
+
+    *si = Codec1_nextIndex(*si, nibble);
+
+    return (nibble);
+}
+
+/*
+ *  ======== Codec1_decodeNibble ========
+ */
+static inline int32_t Codec1_decodeNibble(uint32_t nibble, int32_t *pv,
+    int32_t *si)
+{
+    int32_t step = Codec1_stepsizeLut[*si];
+    int32_t sign = -(int32_t)((nibble >> 3) & 1);
+    int32_t cum = step >> 3;
+    int32_t t;
+
+    *si = Codec1_nextIndex(*si, nibble);
+
+    cum += step & -(int32_t)((nibble >> 2) & 1);
+    cum += (step >> 1) & -(int32_t)((nibble >> 1) & 1);
+    cum += (step >> 2) & -(int32_t)(nibble & 1);
+    cum = (int16_t)cum;
+
+    /* the decoder has always saturated at -32767 */
+    t = *pv + ((cum ^ sign) - sign);
+    if (t > 0x7fff) {
+        t = sign ? (int16_t)t : 0x7fff;
+    }
+    else if (t < -32767) {
+        t = sign ? -32767 : (int16_t)t;
+    }
+    *pv = t;
+
+    return (t);
+}
+
+/*
+ *  ======== Codec1_encodeLoop ========
+ *  Two samples per byte, first sample in the low nibble. state[0] codes
+ *  the first sample of each pair and state[1] the second; for mono both
+ *  point to the same state.
+ */
+static size_t Codec1_encodeLoop(uint8_t *dst, const int16_t *src,
+    size_t numPairs, Codec1_State *first, Codec1_State *second)
+{
+    int32_t pv0 = first->pv;
+    int32_t si0 = first->si;
+    int32_t pv1, si1;
+    size_t i;
+    uint32_t nibble;
+
+    if (first == second) {
+        for (i = 0; i < numPairs; i++) {
+            nibble = Codec1_encodeNibble(src[0], &pv0, &si0);
+            nibble |= Codec1_encodeNibble(src[1], &pv0, &si0) << 4;
+            src += 2;
+            dst[i] = (uint8_t)nibble;
+        }
+    }
+    else {
+        pv1 = second->pv;
+        si1 = second->si;
+        for (i = 0; i < numPairs; i++) {
+            nibble = Codec1_encodeNibble(src[0], &pv0, &si0);
+            nibble |= Codec1_encodeNibble(src[1], &pv1, &si1) << 4;
+            src += 2;
+            dst[i] = (uint8_t)nibble;
+        }
+        second->pv = (int16_t)pv1;
+        second->si = (int8_t)si1;
+    }
+    first->pv = (int16_t)pv0;
+    first->si = (int8_t)si0;
+
+    return (numPairs);
+}
+
+/*
+ *  ======== Codec1_decodeLoop ========
+ *  Inverse of Codec1_encodeLoop
+ */
+static void Codec1_decodeLoop(int16_t *dst, const uint8_t *src,
+    size_t numBytes, Codec1_State *first, Codec1_State *second)
+{
+    int32_t pv0 = first->pv;
+    int32_t si0 = first->si;
+    int32_t pv1, si1;
+    size_t i;
+    uint32_t byte;
 
-    if(tic1_nibble_4bits&8)
-    {
-        if (Codec1_pvEnc < (-32768+cum_diff))
-            (Codec1_pvEnc) = -32768;
-        else
-            Codec1_pvEnc -= cum_diff;
+    if (first == second) {
+        for (i = 0; i < numBytes; i++) {
+            byte = src[i];
+            dst[0] = (int16_t)Codec1_decodeNibble(byte & 0xF, &pv0, &si0);
+            dst[1] = (int16_t)Codec1_decodeNibble(byte >> 4, &pv0, &si0);
+            dst += 2;
+        }
     }
-    else
-    {
-        if (Codec1_pvEnc > (0x7fff-cum_diff))
-            (Codec1_pvEnc) = 0x7fff;
-        else
-            Codec1_pvEnc += cum_diff;
+    else {
+        pv1 = second->pv;
+        si1 = second->si;
+        for (i = 0; i < numBytes; i++) {
+            byte = src[i];
+            dst[0] = (int16_t)Codec1_decodeNibble(byte & 0xF, &pv0, &si0);
+            dst[1] = (int16_t)Codec1_decodeNibble(byte >> 4, &pv1, &si1);
+            dst += 2;
+        }
+        second->pv = (int16_t)pv1;
+        second->si = (int8_t)si1;
     }
+    first->pv = (int16_t)pv0;
+    first->si = (int8_t)si0;
+}
 
-    Codec1_siEnc += Codec1_IndexLut[tic1_nibble_4bits];
+/*
+ *  ======== Codec1_ringCopy ========
+ *  Copy len bytes to offset within the two spans of a ring reservation
+ */
+static void Codec1_ringCopy(SPSCRing_Span spans[2], size_t offset,
+    const uint8_t *data, size_t len)
+{
+    for (; len > 0; len--, offset++, data++) {
+        if (offset < spans[0].len) {
+            spans[0].buf[offset] = *data;
+        }
+        else {
+            spans[1].buf[offset - spans[0].len] = *data;
+        }
+    }
+}
 
-    if(Codec1_siEnc<0)
-        Codec1_siEnc = 0;
-    else if(Codec1_siEnc>88)
-        Codec1_siEnc = 88;
+/**************************************************************************************************
+*                                        Global Functions
+*/
 
-    return tic1_nibble_4bits;
+/*
+*  ======== Codec1_encodeSingle ========
+*/
+uint8_t Codec1_encodeSingle(int16_t audSample)
+{
+    int32_t pv = Codec1_pvEnc;
+    int32_t si = Codec1_siEnc;
+    uint8_t nibble = (uint8_t)Codec1_encodeNibble(audSample, &pv, &si);
+
+    Codec1_pvEnc = (int16_t)pv;
+    Codec1_siEnc = (int8_t)si;
+
+    return nibble;
 }
 
 
@@ -163,36 +322,14 @@ uint8_t Codec1_encodeSingle(int16_t audSample)
 */
 int16_t Codec1_decodeSingle(uint8_t nibble_4bits)
 {
-    int16_t step = Codec1_stepsizeLut[Codec1_siDec];
-    int16_t cum_diff  = step>>3;
-
-    Codec1_siDec += Codec1_IndexLut[nibble_4bits];
-    if(Codec1_siDec<0)
-        Codec1_siDec = 0;
-    else if(Codec1_siDec>88)
-        Codec1_siDec = 88;
-
-    if(nibble_4bits&4)
-        cum_diff += step;
-    if(nibble_4bits&2)
-        cum_diff += step>>1;
-    if(nibble_4bits&1)
-        cum_diff += step>>2;
-
-    if(nibble_4bits&8)
-    {
-        if (Codec1_pvDec < (-32767+cum_diff))
-            (Codec1_pvDec) = -32767;
-        else
-            Codec1_pvDec -= cum_diff;
-    }
-    else
-    {
-        if (Codec1_pvDec > (0x7fff-cum_diff))
-            (Codec1_pvDec) = 0x7fff;
-        else
-            Codec1_pvDec += cum_diff;
-    }
+    int32_t pv = Codec1_pvDec;
+    int32_t si = Codec1_siDec;
+
+    Codec1_decodeNibble(nibble_4bits & 0xF, &pv, &si);
+
+    Codec1_pvDec = (int16_t)pv;
+    Codec1_siDec = (int8_t)si;
+
     return Codec1_pvDec;
 }
 
@@ -202,26 +339,19 @@ int16_t Codec1_decodeSingle(uint8_t nibble_4bits)
 */
 uint8_t Codec1_encodeBuff(uint8_t* dst, int16_t* src, int16_t srcSize, int8_t *si, int16_t *pv)
 {
-    Codec1_pvEnc = *pv;
-    Codec1_siEnc = *si;
-    int16_t* end = (src + srcSize);
-    int8_t len = 0;
+    Codec1_State state;
+    size_t len;
 
-    while(src < end)
-    {
-        // encode a pcm value from input buffer
-        uint8_t nibble = Codec1_encodeSingle( *src++ );
+    state.pv = *pv;
+    state.si = *si;
 
-        nibble |= (Codec1_encodeSingle( *src++ ) << 4);
+    /* an odd srcSize has always encoded one sample beyond it */
+    len = (srcSize > 0) ? Codec1_encodeLoop(dst, src, ((size_t)srcSize + 1) / 2, &state, &state) : 0;
 
-        *dst++ = nibble;
+    Codec1_pvEnc = *pv = state.pv;
+    Codec1_siEnc = *si = state.si;
 
-        len++;
-    }
-
-    *pv = Codec1_pvEnc;
-    *si = Codec1_siEnc;
-    return len;
+    return (uint8_t)len;
 }
 
 
@@ -230,24 +360,90 @@ uint8_t Codec1_encodeBuff(uint8_t* dst, int16_t* src, int16_t srcSize, int8_t *s
 */
 void Codec1_decodeBuff(int16_t* dst, uint8_t* src, unsigned srcSize,  int8_t *si, int16_t *pv)
 {
-    Codec1_pvDec = *pv;
-    Codec1_siDec = *si;
-
-    // calculate pointers to iterate output buffer
-    int16_t* out = dst;
-    int16_t* end = out+(srcSize>>1);
-
-    while(out<end)
-    {
-        // get byte from src
-        uint8_t nibble = *src;
-        *out++ = Codec1_decodeSingle((nibble&0xF));  // decode value and store it
-        nibble >>= 4;  // use high nibble of byte
-        nibble &= 0xF;  // use high nibble of byte
-        *out++ = Codec1_decodeSingle(nibble);  // decode value and store it
-        ++src;        // move on a byte for next sample
+    Codec1_State state;
+
+    state.pv = *pv;
+    state.si = *si;
+
+    /* srcSize is in output bytes; each input byte yields two samples */
+    Codec1_decodeLoop(dst, src, ((srcSize >> 1) + 1) / 2, &state, &state);
+
+    Codec1_pvDec = *pv = state.pv;
+    Codec1_siDec = *si = state.si;
+}
+
+
+/*
+*  ======== Codec1_encodeInterleaved ========
+*/
+size_t Codec1_encodeInterleaved(uint8_t *dst, const int16_t *src, size_t numSamples,
+    Codec1_State *state, unsigned numChannels)
+{
+    return Codec1_encodeLoop(dst, src, numSamples / 2, &state[0],
+        &state[numChannels - 1]);
+}
+
+
+/*
+*  ======== Codec1_decodeInterleaved ========
+*/
+void Codec1_decodeInterleaved(int16_t *dst, const uint8_t *src, size_t srcSize,
+    Codec1_State *state, unsigned numChannels)
+{
+    Codec1_decodeLoop(dst, src, srcSize, &state[0], &state[numChannels - 1]);
+}
+
+
+/*
+*  ======== Codec1_decodeToRing ========
+*/
+size_t Codec1_decodeToRing(SPSCRing_Handle ring, const uint8_t *src, size_t srcSize,
+    Codec1_State *state, unsigned numChannels)
+{
+    SPSCRing_Span spans[2];
+    int16_t pair[2];
+    size_t total = SPSCRing_reserveSpans(ring, spans) / 4;
+    size_t written = 0;
+    size_t done = 0;
+    size_t n;
+    size_t offset;
+    SPSCRing_Span *span;
+
+    if (total > srcSize) {
+        total = srcSize;
+    }
+
+    while (done < total) {
+        /* decode straight into the span holding the next sample */
+        if (written < spans[0].len) {
+            span = &spans[0];
+            offset = written;
+        }
+        else {
+            span = &spans[1];
+            offset = written - spans[0].len;
+        }
+        n = (span->len - offset) / 4;
+        if (n > total - done) {
+            n = total - done;
+        }
+
+        if (n > 0 && ((uintptr_t)(span->buf + offset) & 1) == 0) {
+            Codec1_decodeLoop((int16_t *)(void *)(span->buf + offset), src + done, n,
+                &state[0], &state[numChannels - 1]);
+            done += n;
+            written += n * 4;
+        }
+        else {
+            /* unaligned, or split by the end of the ring */
+            Codec1_decodeLoop(pair, src + done, 1, &state[0], &state[numChannels - 1]);
+            Codec1_ringCopy(spans, written, (const uint8_t *)pair, sizeof(pair));
+            done++;
+            written += sizeof(pair);
+        }
     }
 
-    *pv = Codec1_pvDec;
-    *si = Codec1_siDec;
+    SPSCRing_commit(ring, written);
+
+    return done;
 }
@@ -67,6 +67,17 @@
  *
  *  This module provides functions for encoding and decoding data using ADPCM encoding.
  *
+ *  Each 16-bit sample is coded as a 4-bit nibble; two nibbles share a byte,
+ *  the earlier sample in the low nibble. The coder state, a predicted value
+ *  and a step index, carries over from one buffer to the next.
+ *
+ *  Interleaved stereo is coded with one ::Codec1_State per channel: every
+ *  byte holds a left sample in the low nibble and a right sample in the high
+ *  nibble. Mono streams are identical to those of ::Codec1_encodeBuff.
+ *
+ *  ::Codec1_decodeToRing decodes into a ::SPSCRing_Object, e.g. the ring an
+ *  audio output driver plays from, without an intermediate buffer.
+ *
  *  ============================================================================
  */
 
@@ -78,7 +89,20 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stddef.h>
 
+#include <ti/drivers/utils/SPSCRing.h>
+
+/*!
+ *  @brief  Coder state of one channel
+ *
+ *  Zero initialize it at the start of a stream, on both the encoding and
+ *  the decoding side.
+ */
+typedef struct Codec1_State {
+    int16_t pv;     /*!< Predicted value */
+    int8_t  si;     /*!< Step index, 0 to 88 */
+} Codec1_State;
 
 /*!
  *  @brief  This routine encodes one int16 sample with TI Codec Type 1.
@@ -135,6 +159,69 @@ extern uint8_t Codec1_encodeBuff(uint8_t* dst, int16_t* src, int16_t srcSize, in
  */
 extern void Codec1_decodeBuff(int16_t* dst, uint8_t* src, unsigned srcSize,  int8_t *si, int16_t *pv);
 
+/*!
+ *  @brief  This routine encodes a buffer of interleaved samples.
+ *
+ *  @param  dst Pointer to the buffer where encoding result will be written to,
+ *              numSamples / 2 bytes
+ *
+ *  @param  src Pointer to the interleaved samples to encode
+ *
+ *  @param  numSamples The number of samples (int16) in src, counting all
+ *                     channels. Must be a multiple of 2.
+ *
+ *  @param  state Array of numChannels coder states
+ *
+ *  @param  numChannels 1 for mono or 2 for stereo
+ *
+ *  @return Number of bytes written to the destination buffer
+ */
+extern size_t Codec1_encodeInterleaved(uint8_t *dst, const int16_t *src, size_t numSamples,
+                                       Codec1_State *state, unsigned numChannels);
+
+/*!
+ *  @brief  This routine decodes a buffer into interleaved samples.
+ *
+ *  @param  dst Pointer to the buffer where srcSize * 2 samples will be
+ *              written to
+ *
+ *  @param  src Pointer to the encoded data
+ *
+ *  @param  srcSize Number of bytes in src
+ *
+ *  @param  state Array of numChannels coder states
+ *
+ *  @param  numChannels 1 for mono or 2 for stereo
+ */
+extern void Codec1_decodeInterleaved(int16_t *dst, const uint8_t *src, size_t srcSize,
+                                     Codec1_State *state, unsigned numChannels);
+
+/*!
+ *  @brief  This routine decodes as much of a buffer as fits into a ring.
+ *
+ *  Decoded samples are written in place into the free space of the ring,
+ *  as its producer, and committed in one step. Every input byte needs four
+ *  bytes in the ring; decoding stops at the first byte that does not fit.
+ *  Samples are stored directly where the ring is 2-byte aligned and copied
+ *  bytewise otherwise.
+ *
+ *  @param  ring Ring to write the samples to. The caller must be its only
+ *               producer.
+ *
+ *  @param  src Pointer to the encoded data
+ *
+ *  @param  srcSize Number of bytes in src
+ *
+ *  @param  state Array of numChannels coder states
+ *
+ *  @param  numChannels 1 for mono or 2 for stereo
+ *
+ *  @return Number of bytes of src consumed; pass the rest in again when the
+ *          ring has drained
+ */
+extern size_t Codec1_decodeToRing(SPSCRing_Handle ring, const uint8_t *src, size_t srcSize,
+                                  Codec1_State *state, unsigned numChannels);
+
 #ifdef __cplusplus
 }
 #endif
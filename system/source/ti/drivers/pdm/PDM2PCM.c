@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2017 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free,
+ * non-exclusive license under copyrights and patents it now or hereafter
+ * owns or controls to make, have made, use, import, offer to sell and sell
+ * ("Utilize") this software subject to the terms herein. With respect to the
+ * foregoing patent license, such license is granted solely to the extent that
+ * any such patent is necessary to Utilize the software alone. The patent
+ * license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI
+ * ("TI Devices"). No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce
+ * this license (including the above copyright notice and the disclaimer and
+ * (if applicable) source code license limitations below) in the documentation
+ * and/or other materials provided with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * * No reverse engineering, decompilation, or disassembly of this software is
+ *   permitted with respect to any software provided in binary form.
+ *
+ * * any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * * Nothing shall obligate TI to provide you with source code for the software
+ *   licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution
+ * of the source code are permitted provided that the following conditions are
+ * met:
+ *
+ * * any redistribution and use of the source code, including any resulting
+ *   derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * * any redistribution and use of any object code compiled from the source
+ *   code and any resulting derivative works, are licensed by TI for use only
+ *   with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its
+ * suppliers may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+ * NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/***********************************************************************************
+* INCLUDES
+*/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <ti/drivers/pdm/PDM2PCM.h>
+
+/**************************************************************************************************
+*                                        Constants
+*/
+
+/*
+ *  sinc^4 decimating by 8, i.e. four 8-tap boxcars convolved: 29 taps
+ *  1, 4, 10, 20, 35, 56, 84, 120, 161, 204, 246, 284, 315, 336, 344, ...
+ *  summing to 8^4. Row i is the contribution of bits 4i..4i+3 (bit 0 is
+ *  the newest) for each nibble value, counting a 1 as +1 and a 0 as -1.
+ */
+static const int16_t PDM2PCM_cicLut[8][16] =
+{
+    {  -35,   -33,   -27,   -25,   -15,   -13,    -7,    -5,     5,     7,    13,    15,    25,    27,    33,    35},
+    { -295,  -225,  -183,  -113,  -127,   -57,   -15,    55,   -55,    15,    57,   127,   113,   183,   225,   295},
+    { -895,  -573,  -487,  -165,  -403,   -81,     5,   327,  -327,    -5,    81,   403,   165,   487,   573,   895},
+    {-1331,  -701,  -659,   -29,  -643,   -13,    29,   659,  -659,   -29,    13,   643,    29,   659,   701,  1331},
+    {-1049,  -419,  -481,   149,  -557,    73,    11,   641,  -641,   -11,   -73,   557,  -149,   481,   419,  1049},
+    { -421,   -99,  -181,   141,  -253,    69,   -13,   309,  -309,    13,   -69,   253,  -141,   181,    99,   421},
+    {  -69,     1,   -29,    41,   -49,    21,    -9,    61,   -61,     9,   -21,    49,   -41,    29,    -1,    69},
+    {   -1,     1,    -1,     1,    -1,     1,    -1,     1,    -1,     1,    -1,     1,    -1,     1,    -1,     1},
+};
+
+/*
+ *  Default coefficients: gain, DC notch and elliptic halfband low pass at
+ *  twice the output rate, no second cascade.
+ */
+const int32_t PDM2PCM_defaultCoeffs[PDM2PCM_DEFAULT_COEFFS_LEN] = {
+ //--v--  Adjust overall gain by changing this coefficient
+    331,     0, -1024, -1356,   342,     // DC-notch, halfband LP filter (@32 kHz)
+    200,   789,   934,  -994,   508,
+    538,   381,   944,  -519,   722,
+    732,   124,   987,  -386,   886,
+    763,    11,  1014,  -386,   886,
+    0, // Terminate first filter
+    // Insert optional second filter here (@16 kHz). Some examples:
+    //1147,-1516,   522, -1699,   708,    // +5dB peak filter (F0=500 Hz, BW=3 octaves)
+    //1313, -565,    -6,  -725,   281,    // +5dB peak filter (F0=2.5 kHz, BW=2 octaves)
+    //1335,  532,   -66,   694,   225,    // +5 dB peak filter (F0=5.5 kHz, BW=1 octave)
+    0, // Terminate second filter
+};
+
+/* Scale of the signal between the CIC and the output gain */
+#define PDM2PCM_FULL_SCALE_BITS     17
+
+/* Q10 output gain; 83 ~ 0 dB with the default filter */
+#define PDM2PCM_GAIN_SHIFT          10
+
+/* Values per biquad in the coefficient table */
+#define PDM2PCM_BQ_SIZE             5
+
+/**************************************************************************************************
+*                                        Local Functions
+*/
+
+/*
+ *  ======== PDM2PCM_cic8 ========
+ *  sinc^4 over the last 32 bits, evaluated once per PDM byte
+ */
+static inline int32_t PDM2PCM_cic8(uint32_t bits)
+{
+    return (PDM2PCM_cicLut[0][bits & 0xF] +
+            PDM2PCM_cicLut[1][(bits >> 4) & 0xF] +
+            PDM2PCM_cicLut[2][(bits >> 8) & 0xF] +
+            PDM2PCM_cicLut[3][(bits >> 12) & 0xF] +
+            PDM2PCM_cicLut[4][(bits >> 16) & 0xF] +
+            PDM2PCM_cicLut[5][(bits >> 20) & 0xF] +
+            PDM2PCM_cicLut[6][(bits >> 24) & 0xF] +
+            PDM2PCM_cicLut[7][bits >> 28]);
+}
+
+/*
+ *  ======== PDM2PCM_biquads ========
+ *  Run x through count biquads starting at coeffs. The first biquad's
+ *  g is skipped when it is the overall gain.
+ */
+static int32_t PDM2PCM_biquads(const int32_t *coeffs, int32_t (*bq)[4],
+    unsigned count, int32_t x, bool skipGain)
+{
+    int32_t num;
+    int32_t y;
+
+    for (; count > 0; count--, coeffs += PDM2PCM_BQ_SIZE, bq++) {
+        num = x + ((coeffs[1] * bq[0][0] + coeffs[2] * bq[0][1]) >> 10);
+        if (!skipGain) {
+            num = (coeffs[0] * num) >> 10;
+        }
+        skipGain = false;
+
+        y = num - ((coeffs[3] * bq[0][2] + coeffs[4] * bq[0][3]) >> 10);
+
+        bq[0][1] = bq[0][0];
+        bq[0][0] = x;
+        bq[0][3] = bq[0][2];
+        bq[0][2] = y;
+        x = y;
+    }
+
+    return (x);
+}
+
+/*
+ *  ======== PDM2PCM_output ========
+ *  Second cascade, gain and saturation for one output sample
+ */
+static int16_t PDM2PCM_output(PDM2PCM_State *state, int32_t x)
+{
+    const int32_t *coeffs = state->coeffs;
+
+    x = PDM2PCM_biquads(coeffs + (state->numBq1 + 1) * PDM2PCM_BQ_SIZE,
+        &state->bq[state->numBq1], state->numBq2, x, false);
+
+    x = (x * coeffs[0]) >> PDM2PCM_GAIN_SHIFT;
+
+    if (x > INT16_MAX) {
+        state->clipCount++;
+        x = INT16_MAX;
+    }
+    else if (x < INT16_MIN) {
+        state->clipCount++;
+        x = INT16_MIN;
+    }
+
+    return ((int16_t)x);
+}
+
+/**************************************************************************************************
+*                                        Global Functions
+*/
+
+/*
+ *  ======== PDM2PCM_init ========
+ */
+bool PDM2PCM_init(PDM2PCM_State *state, PDM2PCM_Rate rate,
+    const int32_t *coeffs)
+{
+    const int32_t *c;
+    int shift;
+    unsigned i;
+
+    /* count the biquads of both cascades */
+    for (c = coeffs, i = 0; c[0] != 0; c += PDM2PCM_BQ_SIZE) {
+        i++;
+    }
+    state->numBq1 = i;
+    for (c++, i = 0; c[0] != 0; c += PDM2PCM_BQ_SIZE) {
+        i++;
+    }
+    state->numBq2 = i;
+
+    if (state->numBq1 + state->numBq2 > PDM2PCM_MAX_BIQUADS) {
+        return (false);
+    }
+
+    state->coeffs = coeffs;
+    state->bytesPerCic = (uint8_t)rate;
+
+    /* CIC gain is (8 * bytesPerCic)^4 = 2^(12 + 4 * log2(bytesPerCic)) */
+    shift = 12 - PDM2PCM_FULL_SCALE_BITS;
+    for (i = rate; i > 1; i >>= 1) {
+        shift += 4;
+    }
+    state->cicLeft = (shift < 0);
+    state->cicShift = (uint8_t)(shift < 0 ? -shift : shift);
+
+    /* idle channel: all integrators and delays at zero */
+    state->bits = 0xAAAAAAAA;
+    for (i = 0; i < 4; i++) {
+        state->integ[i] = 0;
+        state->comb[i] = 0;
+    }
+    state->comp[0] = 0;
+    state->comp[1] = 0;
+    for (i = 0; i < PDM2PCM_MAX_BIQUADS; i++) {
+        state->bq[i][0] = 0;
+        state->bq[i][1] = 0;
+        state->bq[i][2] = 0;
+        state->bq[i][3] = 0;
+    }
+    state->clipCount = 0;
+    state->byteCount = 0;
+    state->odd = 0;
+
+    return (true);
+}
+
+/*
+ *  ======== PDM2PCM_process ========
+ */
+size_t PDM2PCM_process(PDM2PCM_State *state, const uint16_t *pdm,
+    size_t numWords, int16_t *pcm)
+{
+    uint32_t bits = state->bits;
+    uint32_t i1 = state->integ[0];
+    uint32_t i2 = state->integ[1];
+    uint32_t i3 = state->integ[2];
+    uint32_t i4 = state->integ[3];
+    unsigned byteCount = state->byteCount;
+    int16_t *out = pcm;
+    uint32_t c0, c1, c2, c3, c4;
+    int32_t x;
+    unsigned half;
+
+    for (; numWords > 0; numWords--, pdm++) {
+        for (half = 0; half < 2; half++) {
+            /* high byte is earlier in time */
+            bits = (bits << 8) | ((half == 0) ? (*pdm >> 8) : (*pdm & 0xFF));
+
+            /* sinc^4 by 8 from the bits, then the integrators of the rest */
+            i1 += (uint32_t)PDM2PCM_cic8(bits);
+            i2 += i1;
+            i3 += i2;
+            i4 += i3;
+
+            if (++byteCount < state->bytesPerCic) {
+                continue;
+            }
+            byteCount = 0;
+
+            /* combs; unsigned wrap-around cancels in the differences */
+            c0 = i4;
+            c1 = c0 - state->comb[0];
+            state->comb[0] = c0;
+            c2 = c1 - state->comb[1];
+            state->comb[1] = c1;
+            c3 = c2 - state->comb[2];
+            state->comb[2] = c2;
+            c4 = c3 - state->comb[3];
+            state->comb[3] = c3;
+
+            if (state->cicLeft) {
+                x = (int32_t)(c4 << state->cicShift);
+            }
+            else {
+                x = (int32_t)c4 >> state->cicShift;
+            }
+
+            /* droop compensation: -1/4, 3/2, -1/4 */
+            {
+                int32_t x1 = state->comp[0];
+                int32_t y = x1 + (x1 >> 1) - ((x + state->comp[1]) >> 2);
+
+                state->comp[1] = x1;
+                state->comp[0] = x;
+                x = y;
+            }
+
+            /* halfband cascade at twice the output rate */
+            x = PDM2PCM_biquads(state->coeffs, state->bq, state->numBq1, x,
+                true);
+
+            /* keep every second sample */
+            state->odd ^= 1;
+            if (state->odd) {
+                continue;
+            }
+
+            *out++ = PDM2PCM_output(state, x);
+        }
+    }
+
+    state->bits = bits;
+    state->integ[0] = i1;
+    state->integ[1] = i2;
+    state->integ[2] = i3;
+    state->integ[3] = i4;
+    state->byteCount = byteCount;
+
+    return ((size_t)(out - pcm));
+}
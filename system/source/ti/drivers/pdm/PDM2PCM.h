@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2017 Texas Instruments Incorporated
+ *
+ * All rights reserved not granted herein.
+ *
+ * Limited License.
+ *
+ * Texas Instruments Incorporated grants a world-wide, royalty-free,
+ * non-exclusive license under copyrights and patents it now or hereafter
+ * owns or controls to make, have made, use, import, offer to sell and sell
+ * ("Utilize") this software subject to the terms herein. With respect to the
+ * foregoing patent license, such license is granted solely to the extent that
+ * any such patent is necessary to Utilize the software alone. The patent
+ * license shall not apply to any combinations which include this software,
+ * other than combinations with devices manufactured by or for TI
+ * ("TI Devices"). No hardware patent is licensed hereunder.
+ *
+ * Redistributions must preserve existing copyright notices and reproduce
+ * this license (including the above copyright notice and the disclaimer and
+ * (if applicable) source code license limitations below) in the documentation
+ * and/or other materials provided with the distribution
+ *
+ * Redistribution and use in binary form, without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * * No reverse engineering, decompilation, or disassembly of this software is
+ *   permitted with respect to any software provided in binary form.
+ *
+ * * any redistribution and use are licensed by TI for use only with TI Devices.
+ *
+ * * Nothing shall obligate TI to provide you with source code for the software
+ *   licensed and provided to you in object code.
+ *
+ * If software source code is provided to you, modification and redistribution
+ * of the source code are permitted provided that the following conditions are
+ * met:
+ *
+ * * any redistribution and use of the source code, including any resulting
+ *   derivative works, are licensed by TI for use only with TI Devices.
+ *
+ * * any redistribution and use of any object code compiled from the source
+ *   code and any resulting derivative works, are licensed by TI for use only
+ *   with TI Devices.
+ *
+ * Neither the name of Texas Instruments Incorporated nor the names of its
+ * suppliers may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * DISCLAIMER.
+ *
+ * THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+ * NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** ============================================================================
+ *  @file       PDM2PCM.h
+ *
+ *  @brief      PDM to PCM decimation filter
+ *
+ *  Converts the 1.024 Mbit/s PDM bit stream from a digital microphone into
+ *  16-bit PCM at 8, 16 or 32 kHz. The filter chain is
+ *
+ *  - a 4th order CIC (sinc^4) decimating to twice the output rate. The
+ *    first factor of 8 is evaluated with nibble lookup tables straight
+ *    from the PDM bits, the rest with integrators and combs. This part
+ *    only uses shifts, adds and table loads.
+ *  - a 3-tap shift/add FIR that compensates most of the CIC droop.
+ *  - the first biquad cascade of the coefficient table (the halfband
+ *    low pass) at twice the output rate, then decimation by 2.
+ *  - the optional second biquad cascade at the output rate.
+ *  - the gain, with saturation to 16 bits.
+ *
+ *  The biquads only need 32-bit MUL/MLA, which the Cortex-M3 executes in
+ *  one or two cycles; no DSP extension is used.
+ *
+ *  The coefficient table has the format used by PDMCC26XX: each biquad is
+ *  five Q10 values g, b1, b2, a1, a2 for
+ *
+ *      H(z) = g/1024 * (1 + b1/1024 z^-1 + b2/1024 z^-2) /
+ *                      (1 + a1/1024 z^-1 + a2/1024 z^-2)
+ *
+ *  A g of 0 ends a cascade; the first cascade is followed by the second.
+ *  g of the very first biquad is the overall gain instead; it is applied
+ *  as a Q10 factor at the output. 83 maps a full scale PDM stream to
+ *  16-bit full scale through the default filter, whose DC notch has a
+ *  passband gain of about 1024/331; the default 331 adds 12 dB. Each
+ *  doubling adds 6 dB.
+ *
+ *  Internally the signal is scaled so a full scale PDM stream is +-2^17,
+ *  which leaves the biquads about two bits of headroom above the default
+ *  DC notch. Filters with a larger gain at any point of the chain may
+ *  overflow.
+ *
+ *  PDM words are 16 bits wide with the earliest bit in bit 15, as the
+ *  I2S module delivers them.
+ *
+ *  @code
+ *  PDM2PCM_State state;
+ *  int16_t pcm[PDM2PCM_SAMPLES(PDM2PCM_RATE_16K, 128)];
+ *
+ *  PDM2PCM_init(&state, PDM2PCM_RATE_16K, coeffs);
+ *  n = PDM2PCM_process(&state, pdmWords, 128, pcm);
+ *  @endcode
+ *
+ *  The code has no dependencies beyond the C library so it also builds on
+ *  a host, see extras/pdm2pcm_bench.c.
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_pdm_PDM2PCM__include
+#define ti_drivers_pdm_PDM2PCM__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*! Most biquads in both cascades together */
+#define PDM2PCM_MAX_BIQUADS     8
+
+/*! Number of values in ::PDM2PCM_defaultCoeffs */
+#define PDM2PCM_DEFAULT_COEFFS_LEN  27
+
+/*!
+ *  @brief  Output sample rates with a 1.024 MHz PDM clock
+ *
+ *  The value is the number of PDM words (16 bits) per output sample.
+ */
+typedef enum PDM2PCM_Rate {
+    PDM2PCM_RATE_32K = 2,       /*!< 32 kHz, decimation by 32 */
+    PDM2PCM_RATE_16K = 4,       /*!< 16 kHz, decimation by 64 */
+    PDM2PCM_RATE_8K = 8         /*!<  8 kHz, decimation by 128 */
+} PDM2PCM_Rate;
+
+/*! Number of PCM samples produced from numWords PDM words */
+#define PDM2PCM_SAMPLES(rate, numWords) ((numWords) / (size_t)(rate))
+
+/*!
+ *  @brief  Decimator state
+ *
+ *  The application may read clipCount but must not access any other
+ *  member variables of this structure!
+ */
+typedef struct PDM2PCM_State {
+    uint32_t        bits;           /*!< last 32 PDM bits, newest in bit 0 */
+    uint32_t        integ[4];       /*!< CIC integrators */
+    uint32_t        comb[4];        /*!< CIC comb delays */
+    int32_t         comp[2];        /*!< droop compensator delays */
+    int32_t         bq[PDM2PCM_MAX_BIQUADS][4]; /*!< x1, x2, y1, y2 */
+    const int32_t   *coeffs;        /*!< coefficient table */
+    uint32_t        clipCount;      /*!< samples saturated so far */
+    uint8_t         bytesPerCic;    /*!< PDM bytes per CIC output */
+    uint8_t         cicShift;       /*!< scales CIC output to 2^17 */
+    uint8_t         cicLeft;        /*!< cicShift is a left shift */
+    uint8_t         byteCount;      /*!< bytes since the last CIC output */
+    uint8_t         odd;            /*!< a CIC output is waiting for its pair */
+    uint8_t         numBq1;         /*!< biquads before decimation by 2 */
+    uint8_t         numBq2;         /*!< biquads after decimation by 2 */
+} PDM2PCM_State;
+
+/*!
+ *  @brief  Default coefficient table, +12 dB gain
+ *
+ *  The frequencies in its comments are for 16 kHz output; the response
+ *  scales with the output rate.
+ */
+extern const int32_t PDM2PCM_defaultCoeffs[PDM2PCM_DEFAULT_COEFFS_LEN];
+
+/*!
+ *  @brief  Initialize or reset a decimator
+ *
+ *  @param  state   State to initialize
+ *
+ *  @param  rate    Output sample rate
+ *
+ *  @param  coeffs  Biquad table, see above. Must stay valid while the
+ *                  state is used; the gain coefficient may be changed at
+ *                  any time.
+ *
+ *  @return false if the table has more than ::PDM2PCM_MAX_BIQUADS
+ *          biquads
+ */
+extern bool PDM2PCM_init(PDM2PCM_State *state, PDM2PCM_Rate rate,
+    const int32_t *coeffs);
+
+/*!
+ *  @brief  Convert PDM words to PCM samples
+ *
+ *  @param  state       Decimator state
+ *
+ *  @param  pdm         PDM words, earliest bit in bit 15
+ *
+ *  @param  numWords    Number of words in pdm. A multiple of the rate
+ *                      value keeps the output aligned to the input.
+ *
+ *  @param  pcm         Receives PDM2PCM_SAMPLES(rate, numWords) samples
+ *
+ *  @return Number of samples written. state->clipCount counts the
+ *          samples that had to be saturated.
+ */
+extern size_t PDM2PCM_process(PDM2PCM_State *state, const uint16_t *pdm,
+    size_t numWords, int16_t *pcm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_pdm_PDM2PCM__include */
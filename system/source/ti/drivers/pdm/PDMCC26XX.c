@@ -52,6 +52,7 @@
 #include <ti/drivers/power/PowerCC26XX.h>
 #include <ti/drivers/pdm/PDMCC26XX_util.h>
 #include <ti/drivers/pdm/PDMCC26XX.h>
+#include <ti/drivers/pdm/PDM2PCM.h>
 
 #include <string.h>
 
@@ -66,13 +67,17 @@
  *  32 bits, given that we assume 16kHz sampling rate. Hence, the number of PDM
  *  samples are always twice the potential number of 16bit PCM samples. */
 #define PDM_BLOCK_SIZE_IN_SAMPLES       64
+/*! Number of 16bit PDM words in a block, both channels */
+#define PDM_BLOCK_SIZE_IN_WORDS         (PDM_BLOCK_SIZE_IN_SAMPLES * PDM_NUM_OF_CHANNELS)
+/*! Largest number of PCM samples decimated from one block, at 32kHz */
+#define PDM_MAX_PCM_PER_BLOCK           PDM2PCM_SAMPLES(PDM2PCM_RATE_32K, PDM_BLOCK_SIZE_IN_WORDS)
 
 /*! Number of GPIOs used. */
 #define PDM_NUMBER_OF_PINS              1       // Only one pin to control microphone power
 /*! Number of compressed bytes produced by each PDM->PCM conversion and compression */
-#define PDMCC26XX_COMPR_ITER_OUTPUT_SIZE 16
+#define PDMCC26XX_COMPR_ITER_OUTPUT_SIZE(rate) (PDM2PCM_SAMPLES(rate, PDM_BLOCK_SIZE_IN_WORDS) / 2)
 /*! Number of uncompressed bytes produced by eahc PDM->PCM conversion and memcpy */
-#define PDMCC26XX_CPY_ITER_OUTPUT_SIZE   64
+#define PDMCC26XX_CPY_ITER_OUTPUT_SIZE(rate)   (PDM2PCM_SAMPLES(rate, PDM_BLOCK_SIZE_IN_WORDS) * 2)
 /*! This value defines how many samples are discarded at minimum each time the PDM stream starts.
  *  The first few samples that are processed by the driver will not be representative of their actual value
  *  as the decimation filter has not sufficiently updated its internal state. A value < 8 is not reccomended, as the
@@ -118,21 +123,6 @@
 /*********************************************************************
  * CONSTANTS
  */
-static const int32_t PDMCC26XX_aBqCoeffs[] = {
- //--v--  Adjust overall gain by changing this coefficient
-    331,     0, -1024, -1356,   342,     // DC-notch, halfband LP filter (@32 kHz)
-    200,   789,   934,  -994,   508,
-    538,   381,   944,  -519,   722,
-    732,   124,   987,  -386,   886,
-    763,    11,  1014,  -386,   886,
-    0, // Terminate first filter
-    // Insert optional second filter here (@16 kHz). Some examples:
-    //1147,-1516,   522, -1699,   708,    // +5dB peak filter (F0=500 Hz, BW=3 octaves)
-    //1313, -565,    -6,  -725,   281,    // +5dB peak filter (F0=2.5 kHz, BW=2 octaves)
-    //1335,  532,   -66,   694,   225,    // +5 dB peak filter (F0=5.5 kHz, BW=1 octave)
-    0, // Terminate second filter
-};
-
 static const uint16_t PDMCC26XX_gainTable[PDMCC26XX_GAIN_END] = {
     1318, //PDMCC26XX_GAIN_24,
     660, //PDMCC26XX_GAIN_18,
@@ -150,6 +140,7 @@ const PDMCC26XX_Params PDMCC26XX_defaultParams = {
     .useDefaultFilter = true,
     .decimationFilter = NULL,
     .micGain = PDMCC26XX_GAIN_12,
+    .sampleRate = PDMCC26XX_SAMPLE_RATE_16K,
     .micPowerActiveHigh = true,
     .applyCompression = true,
     .startupDelayWithClockInSamples = 0,
@@ -200,8 +191,8 @@ static Char pdmTaskStack[PDM_TASK_STACK_SIZE];
 /* Keep track of compression variables */
 static PDMCC26XX_metaData metaDataForNextFrame = {0};
 
-static int32_t decimationFilterInRAM[sizeof(PDMCC26XX_aBqCoeffs) / sizeof(PDMCC26XX_aBqCoeffs[0])];
-static uint32_t decimationState[6+5*2] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+static int32_t decimationFilterInRAM[PDM2PCM_DEFAULT_COEFFS_LEN];
+static PDM2PCM_State decimationState;
 
 static Queue_Struct pcmMsgReady;
 static Queue_Handle pcmMsgReadyQueue;
@@ -241,7 +232,6 @@ static inline uint32_t PDMCC26XX_maxUInt32(uint32_t a, uint32_t b);
 /*********************************************************************
  * EXTERNAL FUNCTIONS
  */
-extern bool pdm2pcm16k(const void* pIn, uint32_t* pState, const int32_t* pBqCoeffs, int16_t* pOut);
 extern uint8_t tic1_EncodeBuff(uint8_t* dst, int16_t* src, int16_t srcSize, int8_t *si, int16_t *pv);
 
 /*********************************************************************
@@ -313,7 +303,7 @@ PDMCC26XX_Handle PDMCC26XX_open(PDMCC26XX_Params *params) {
     Assert_isTrue(params->callbackFxn, NULL);
     Assert_isTrue(params->mallocFxn, NULL);
     Assert_isTrue(params->freeFxn, NULL);
-    Assert_isTrue((params->retBufSizeInBytes - PCM_METADATA_SIZE) >= (params->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE : PDMCC26XX_CPY_ITER_OUTPUT_SIZE), NULL);
+    Assert_isTrue((params->retBufSizeInBytes - PCM_METADATA_SIZE) >= (params->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE(params->sampleRate) : PDMCC26XX_CPY_ITER_OUTPUT_SIZE(params->sampleRate)), NULL);
     Assert_isTrue(params->useDefaultFilter || params->decimationFilter, NULL);
     Assert_isTrue(params->pdmBufferQueueDepth >= MINIMUM_PDM_BUFFER_QUEUE_DEPTH, NULL);
 
@@ -343,6 +333,8 @@ PDMCC26XX_Handle PDMCC26XX_open(PDMCC26XX_Params *params) {
     object->callbackFxn                    = params->callbackFxn;
     object->useDefaultFilter               = params->useDefaultFilter;
     object->micGain                        = params->micGain;
+    object->sampleRate                     = params->sampleRate;
+    object->iterOutputSize                 = params->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE(params->sampleRate) : PDMCC26XX_CPY_ITER_OUTPUT_SIZE(params->sampleRate);
     object->micPowerActiveHigh             = params->micPowerActiveHigh;
     object->applyCompression               = params->applyCompression;
     object->startupDelayWithClockInSamples = params->startupDelayWithClockInSamples;
@@ -411,7 +403,7 @@ PDMCC26XX_Handle PDMCC26XX_open(PDMCC26XX_Params *params) {
     if (object->useDefaultFilter) {
         /* Use default */
         object->decimationFilter = decimationFilterInRAM;
-        memcpy(object->decimationFilter, PDMCC26XX_aBqCoeffs, sizeof(PDMCC26XX_aBqCoeffs));
+        memcpy(object->decimationFilter, PDM2PCM_defaultCoeffs, sizeof(PDM2PCM_defaultCoeffs));
     }
     else {
         object->decimationFilter = params->decimationFilter;
@@ -477,10 +469,13 @@ bool PDMCC26XX_startStream(PDMCC26XX_Handle handle) {
         return (false);
     }
 
-    uint32_t i = 0;
     /* Reset decimation states */
-    for (i = 0; i < sizeof(decimationState)/sizeof(decimationState[0]); ++i) {
-        decimationState[i] = 0x00;
+    if (!PDM2PCM_init(&decimationState, (PDM2PCM_Rate)object->sampleRate, object->decimationFilter)) {
+        Hwi_restore(key);
+
+        Log_warning0("PDM: too many biquads in decimation filter");
+
+        return (false);
     }
 
     /* Free ready elements*/
@@ -594,7 +589,8 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
     PDMCC26XX_Object            *object = pdmHandle->object;;
     PDMCC26XX_HWAttrs const     *hwAttrs = pdmHandle->hwAttrs;
     uint32_t events             = 0;
-    int16_t tempPcmBuf[32];
+    int16_t tempPcmBuf[PDM_MAX_PCM_PER_BLOCK];
+    uint32_t tempPcmCount       = 0;    /* Number of samples in tempPcmBuf */
     uint32_t throwAwayCount     = 0;    /* Number of bytes the driver should drop from the processed PCM data stream */
     uint32_t byteCount          = 0;    /* Index of the PCMBuffer currently being filled specifying how many bytes have been filled */
     uint32_t currTempBufIndex   = 0;    /* Index of the tempPcmBuf specifying how many bytes have been filled */
@@ -713,7 +709,7 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
             /* The total number of PCM bytes that were dropped from the system. Includes those in the blocks dropped
              * by the I2S module and those already in the PCM buffer
              */
-            uint32_t pcmBytesDropped = byteCount + droppedPdmBlockCount * (object->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE : PDMCC26XX_CPY_ITER_OUTPUT_SIZE);
+            uint32_t pcmBytesDropped = byteCount + droppedPdmBlockCount * object->iterOutputSize;
             droppedPdmBlockCount = 0;
 
             Hwi_restore(key);
@@ -768,13 +764,13 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
                              * Note: Assuming that the (object->retBufSizeInBytes-PCM_METADATA_SIZE) is
                              * larger than the data output of one iteration.
                              */
-                            throwAwayCount = object->pcmBufferSizeInBytes - (object->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE : PDMCC26XX_CPY_ITER_OUTPUT_SIZE);
+                            throwAwayCount = object->pcmBufferSizeInBytes - object->iterOutputSize;
 
                             Log_warning1("PDM: throwing the next (%u) samples", throwAwayCount);
                         }
                     }
                     /* Decimate PDM data to PCM, result is stored in tempPcmBuf */
-                    pdm2pcm16k(bufferRequest.bufferIn, decimationState, object->decimationFilter, (int16_t *)&tempPcmBuf);
+                    tempPcmCount = PDM2PCM_process(&decimationState, bufferRequest.bufferIn, PDM_BLOCK_SIZE_IN_WORDS, tempPcmBuf);
 
                     /* Mark the temp buf as active */
                     tempBufActive = true;
@@ -813,9 +809,9 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
                              *
                              * Note: currTempBufIndex will always be multiple of 2.
                              */
-                            if ((object->pcmBufferSizeInBytes - byteCount) > PDMCC26XX_COMPR_ITER_OUTPUT_SIZE - (currTempBufIndex / 2)) {
+                            if ((object->pcmBufferSizeInBytes - byteCount) > object->iterOutputSize - (currTempBufIndex / 2)) {
                                 /* srcSize set to whatever is left in the tempPcmBuffer. */
-                                srcSize = (PDMCC26XX_COMPR_ITER_OUTPUT_SIZE * 2) - currTempBufIndex;
+                                srcSize = (object->iterOutputSize * 2) - currTempBufIndex;
                             }
                             else {
                                 /* This is the last compression into the current data buffer,
@@ -853,12 +849,12 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
                             /* Compression is disabled */
                             /* Compression will not be performed, so we copy data from
                              * temporary pcm buffer to allocated memory. Uncompressed
-                             * PCM data buffer is 64 Bytes wide.
+                             * PCM data is object->iterOutputSize bytes per block.
                              *
                              * Output and input are handled as bytes.
                              */
-                            if ((object->pcmBufferSizeInBytes - byteCount) > (PDMCC26XX_CPY_ITER_OUTPUT_SIZE - (currTempBufIndex * 2))) {
-                                srcSize = PDMCC26XX_CPY_ITER_OUTPUT_SIZE - (currTempBufIndex * 2);
+                            if ((object->pcmBufferSizeInBytes - byteCount) > (object->iterOutputSize - (currTempBufIndex * 2))) {
+                                srcSize = object->iterOutputSize - (currTempBufIndex * 2);
                             }
                             else {
                                 /* This is the last compression into the current data buffer,
@@ -889,7 +885,7 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
                          * If so, reset the index count and clear active flag.
                          *
                          */
-                        if (currTempBufIndex >= (sizeof(tempPcmBuf) / sizeof(tempPcmBuf[0]))) {
+                        if (currTempBufIndex >= tempPcmCount) {
                             tempBufActive = false;
                             currTempBufIndex = 0;
                         }
@@ -924,7 +920,7 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
                                  * compression/no compression), minus the data already
                                  * consumed by the previous buffer.
                                  */
-                                throwAwayCount = object->pcmBufferSizeInBytes - ((object->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE : PDMCC26XX_CPY_ITER_OUTPUT_SIZE) - currTempBufIndex);
+                                throwAwayCount = object->pcmBufferSizeInBytes - (object->iterOutputSize - currTempBufIndex);
 
                                 /* Mark the tempBuf as no longer active */
                                 tempBufActive = false;
@@ -937,7 +933,7 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
                 else {
                     Log_print1(Diags_USER1, "PDM: (%u) samples left to throw", throwAwayCount);
                     /* Still throwing away data */
-                    if (throwAwayCount <= (object->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE : PDMCC26XX_CPY_ITER_OUTPUT_SIZE)) {
+                    if (throwAwayCount <= object->iterOutputSize) {
                         /* if the amount to be thrown away is less than or equal to
                          * the output of one iteration of the data operation, the
                          * count must be set to zero, the sequence number must be
@@ -973,7 +969,7 @@ static void PDMCC26XX_taskFxn(UArg a0, UArg a1) {
                         /* Decrement the throw counter with amount corresponding to
                          * output data size of one iteration.
                          */
-                        throwAwayCount -= (object->applyCompression ? PDMCC26XX_COMPR_ITER_OUTPUT_SIZE : PDMCC26XX_CPY_ITER_OUTPUT_SIZE);
+                        throwAwayCount -= object->iterOutputSize;
                     }
                 }
                 /* Release PDM buffer */
@@ -52,7 +52,11 @@
  * 1.024 Mbps. The PDM driver consequently receives such a buffer approximately every 2ms.
  * A frame of ::PDMCC26XX_Params.retBufSizeInBytes PCM data bytes minus four metadata bytes is provided to the application
  * after being filled by all or part of one or more 64 byte buffers of PCM data derived from the 256 bytes of PDM data.
- * The resulting PCM frame provided to the application is a 16bit PCM signal sampled at 16kHz.
+ * The resulting PCM frame provided to the application is a 16bit PCM signal sampled at 16kHz by default;
+ * ::PDMCC26XX_Params.sampleRate selects 8kHz or 32kHz instead. Each PDM block then yields 16, 32 or 64 PCM samples.
+ *
+ * The decimation is done by the PDM2PCM module (ti/drivers/pdm/PDM2PCM.h), which also documents the format of
+ * ::PDMCC26XX_Params.decimationFilter. The frequencies of the default filter scale with the sample rate.
  *
  * The driver creates a separate task to run in.
  *
@@ -272,6 +276,7 @@ extern "C" {
 #include <ti/sysbios/family/arm/m3/Hwi.h>
 #include <ti/drivers/Power.h>
 #include <ti/drivers/power/PowerCC26XX.h>
+#include <ti/drivers/pdm/PDM2PCM.h>
 
 /*********************************************************************
  * CONSTANTS
@@ -407,6 +412,17 @@ typedef enum PDMCC26XX_Gain {
     PDMCC26XX_GAIN_END  /*!< Internal use only */
 } PDMCC26XX_Gain;
 
+/*!
+ *  @brief      PCM sample rates
+ *
+ *  The PDM clock stays at 1.024 MHz; only the decimation ratio changes.
+ */
+typedef enum PDMCC26XX_SampleRate {
+    PDMCC26XX_SAMPLE_RATE_8K  = PDM2PCM_RATE_8K,    /*!< 8kHz */
+    PDMCC26XX_SAMPLE_RATE_16K = PDM2PCM_RATE_16K,   /*!< 16kHz. Default */
+    PDMCC26XX_SAMPLE_RATE_32K = PDM2PCM_RATE_32K    /*!< 32kHz */
+} PDMCC26XX_SampleRate;
+
 /*!
  *  @brief
  *  A ::PDMCC26XX_StreamNotification data structure is used with PDMCC26XX_CallbackFxn().
@@ -485,6 +501,7 @@ typedef struct PDMCC26XX_Params {
     PDMCC26XX_MallocFxn     mallocFxn;              /*!< Malloc function pointer */
     PDMCC26XX_FreeFxn       freeFxn;                /*!< Free function pointer */
     uintptr_t               custom;                 /*!< Custom argument used by driver implementation */
+    PDMCC26XX_SampleRate    sampleRate;             /*!< PCM sample rate */
 } PDMCC26XX_Params;
 
 /*!
@@ -521,6 +538,10 @@ typedef struct PDMCC26XX_Object {
     PIN_State                       pinState;               /*!< Pin driver state object */
     PIN_Handle                      pinHandle;              /*!< Pin driver handle */
     ti_sysbios_family_arm_m3_Hwi_Struct hwi;                /*!< Hwi object handle */
+    PDMCC26XX_SampleRate            sampleRate;             /*!< PCM sample rate */
+    uint16_t                        iterOutputSize;         /*!< Bytes produced from each PDM block, after
+                                                             * compression if enabled
+                                                             */
 } PDMCC26XX_Object;
 
 /*!
@@ -0,0 +1,592 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== RFStream.c ========
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/SwiP.h>
+#include <ti/drivers/rf/RFStream.h>
+
+#include DEVICE_FAMILY_PATH(driverlib/rf_mailbox.h)
+#include DEVICE_FAMILY_PATH(driverlib/rf_prop_mailbox.h)
+
+/* Events the stream needs from every command it posts */
+#define RFStream_EVENTS     (RF_EventRxEntryDone | RF_EventTxDone | \
+                             RF_EventLastCmdDone)
+
+/* Events passed on to the stream callback */
+#define RFStream_USER_EVENTS (RF_EventRxEntryDone | RF_EventTxDone)
+
+#define RFStream_NO_CMD     ((RF_CmdHandle)-1)
+
+/* RSSI byte appended by the radio when the RSSI is not available */
+#define RFStream_RSSI_INVALID   (-128)
+
+static void callbackFxn(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+
+/* Open streams, at most one per RF client */
+static RFStream_Object *streamList = NULL;
+
+/*
+ *  ======== txSlot ========
+ */
+static inline rfc_CMD_PROP_TX_t *txSlot(RFStream_Object *object, uint8_t n)
+{
+    return ((rfc_CMD_PROP_TX_t *)(object->txSlots +
+        (size_t)n * object->txSlotSize));
+}
+
+/*
+ *  ======== txNext ========
+ *  Slot index n positions after index i, n <= txChainLen.
+ */
+static inline uint8_t txNext(RFStream_Object *object, uint8_t i, uint8_t n)
+{
+    unsigned int next = (unsigned int)i + n;
+
+    if (next >= object->txChainLen) {
+        next -= object->txChainLen;
+    }
+
+    return ((uint8_t)next);
+}
+
+/*
+ *  ======== findStream ========
+ *  Called with Swis disabled or from the RF Swi.
+ */
+static RFStream_Object *findStream(RF_Handle rfHandle)
+{
+    RFStream_Object *object;
+
+    for (object = streamList; object != NULL; object = object->next) {
+        if (object->rfHandle == rfHandle) {
+            break;
+        }
+    }
+
+    return (object);
+}
+
+/*
+ *  ======== removeStream ========
+ *  Called with Swis disabled.
+ */
+static void removeStream(RFStream_Object *object)
+{
+    RFStream_Object **link;
+
+    for (link = &streamList; *link != NULL; link = &(*link)->next) {
+        if (*link == object) {
+            *link = object->next;
+            break;
+        }
+    }
+}
+
+/*
+ *  ======== rxRestartable ========
+ *  Whether the RX command ended for a reason that reposting can cure.
+ *  Parameter and setup errors would only fail again immediately.
+ */
+static bool rxRestartable(RFStream_Object *object)
+{
+    switch (object->rxCmd.status) {
+        case PROP_ERROR_PAR:
+        case PROP_ERROR_NO_SETUP:
+        case PROP_ERROR_NO_FS:
+        case ERROR_PAR:
+        case ERROR_POINTER:
+        case ERROR_CMDID:
+            return (false);
+
+        default:
+            return (true);
+    }
+}
+
+/*
+ *  ======== recycleRx ========
+ *  The radio has moved on to the next entry of the circular queue. If
+ *  that entry still holds an unread packet, the pool is full: hand the
+ *  oldest unread entry back so that the radio always has one to fill.
+ *  Called with Swis disabled or from the RF Swi.
+ */
+static void recycleRx(RFStream_Object *object)
+{
+    rfc_dataEntryGeneral_t *next =
+        (rfc_dataEntryGeneral_t *)object->rxQueue.pCurrEntry;
+
+    if (next != NULL && next->status != DATA_ENTRY_PENDING) {
+        object->rxRead->status = DATA_ENTRY_PENDING;
+        object->rxRead = (rfc_dataEntryGeneral_t *)object->rxRead->pNextEntry;
+        object->rxOverruns++;
+    }
+}
+
+/*
+ *  ======== reapTx ========
+ *  Release the slots of burst packets the radio is done with, in order.
+ *  Called with Swis disabled or from the RF Swi.
+ */
+static void reapTx(RFStream_Object *object)
+{
+    while (object->txInFlight != 0 &&
+        txSlot(object, object->txHead)->status > ACTIVE) {
+        object->txHead = txNext(object, object->txHead, 1);
+        object->txInFlight--;
+    }
+}
+
+/*
+ *  ======== postBurst ========
+ *  Post the queued packets as one chain that ends in the RX command, then
+ *  stop the RX command currently running so the chain can start. Only
+ *  called while no packet is in flight, so txHead is the first queued
+ *  slot. Called with Swis disabled or from the RF Swi.
+ */
+static bool postBurst(RFStream_Object *object)
+{
+    uint8_t tail = txNext(object, object->txHead, object->txQueued - 1);
+    RF_CmdHandle ch;
+    uint8_t i;
+    uint8_t n;
+
+    /* undo the previous burst's link to RX; its packets are all done */
+    txSlot(object, object->txTail)->pNextOp =
+        (rfc_radioOp_t *)txSlot(object, txNext(object, object->txTail, 1));
+
+    for (i = 0, n = object->txHead; i < object->txQueued; i++) {
+        txSlot(object, n)->status = IDLE;
+        n = txNext(object, n, 1);
+    }
+    txSlot(object, tail)->pNextOp = (rfc_radioOp_t *)&object->rxCmd;
+    object->txTail = tail;
+
+    ch = RF_postCmd(object->rfHandle, (RF_Op *)txSlot(object, object->txHead),
+        RF_PriorityNormal, callbackFxn, RFStream_EVENTS);
+    if (ch < 0) {
+        return (false);
+    }
+
+    object->txInFlight = object->txQueued;
+    object->txQueued = 0;
+    object->txFlushPending = false;
+
+    /*
+     *  The RX command that ends the previous chain never finishes by
+     *  itself. A graceful stop lets it complete a packet in progress; the
+     *  new chain starts right after.
+     */
+    if (object->cmdHandle >= 0) {
+        object->prevHandle = object->cmdHandle;
+        RF_cancelCmd(object->rfHandle, object->cmdHandle, 1);
+    }
+    object->cmdHandle = ch;
+
+    return (true);
+}
+
+/*
+ *  ======== callbackFxn ========
+ *  RF callback for every command posted by a stream.
+ */
+static void callbackFxn(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    RFStream_Object *object = findStream(h);
+
+    if (object == NULL || !object->isOpen) {
+        return;
+    }
+
+    if (e & RF_EventRxEntryDone) {
+        recycleRx(object);
+    }
+
+    if (e & (RF_EventTxDone | RF_EventLastCmdDone)) {
+        reapTx(object);
+    }
+
+    if (e & RF_EventLastCmdDone) {
+        if (ch == object->cmdHandle) {
+            /*
+             *  The current chain ended without being superseded, e.g. on an
+             *  RX error. Packets it did not get to are lost.
+             */
+            object->txHead = txNext(object, object->txHead,
+                object->txInFlight);
+            object->txInFlight = 0;
+            object->cmdHandle = RFStream_NO_CMD;
+        }
+        else if (ch == object->prevHandle) {
+            object->prevHandle = RFStream_NO_CMD;
+        }
+    }
+
+    if (object->txInFlight == 0 && object->txQueued != 0 &&
+        object->txFlushPending) {
+        postBurst(object);
+    }
+
+    if (object->cmdHandle < 0 && rxRestartable(object)) {
+        object->cmdHandle = RF_postCmd(object->rfHandle,
+            (RF_Op *)&object->rxCmd, RF_PriorityNormal, callbackFxn,
+            RFStream_EVENTS);
+    }
+
+    if (object->callback != NULL && (e & RFStream_USER_EVENTS)) {
+        object->callback(object, e & RFStream_USER_EVENTS);
+    }
+}
+
+/*
+ *  ======== RFStream_Params_init ========
+ */
+void RFStream_Params_init(RFStream_Params *params)
+{
+    params->rxBuf = NULL;
+    params->rxBufSize = 0;
+    params->txBuf = NULL;
+    params->txBufSize = 0;
+    params->maxPacketLen = 32;
+    params->syncWord = 0x930B51DE;
+    params->callback = NULL;
+}
+
+/*
+ *  ======== RFStream_open ========
+ */
+RFStream_Handle RFStream_open(RFStream_Object *object, RF_Handle rfHandle,
+    RFStream_Params *params)
+{
+    size_t entrySize;
+    size_t slotSize;
+    size_t numEntries;
+    size_t chainLen;
+    size_t i;
+    uintptr_t key;
+    unsigned char *pool;
+    rfc_dataEntryGeneral_t *entry;
+    rfc_CMD_PROP_TX_t *txCmd;
+    bool ok;
+
+    if (params->maxPacketLen == 0 ||
+        params->rxBuf == NULL || ((uintptr_t)params->rxBuf & 3) != 0 ||
+        params->txBuf == NULL || ((uintptr_t)params->txBuf & 3) != 0) {
+        return (NULL);
+    }
+
+    entrySize = RFStream_RX_ENTRY_SIZE(params->maxPacketLen);
+    slotSize = RFStream_TX_SLOT_SIZE(params->maxPacketLen);
+    numEntries = params->rxBufSize / entrySize;
+    chainLen = params->txBufSize / slotSize;
+
+    if (numEntries < 2 || chainLen < 1) {
+        return (NULL);
+    }
+    if (numEntries > UINT16_MAX) {
+        numEntries = UINT16_MAX;
+    }
+    if (chainLen > RFStream_MAX_CHAIN_LEN) {
+        chainLen = RFStream_MAX_CHAIN_LEN;
+    }
+
+    memset(object, 0, sizeof(RFStream_Object));
+    object->rfHandle = rfHandle;
+    object->callback = params->callback;
+    object->cmdHandle = RFStream_NO_CMD;
+    object->prevHandle = RFStream_NO_CMD;
+    object->maxPacketLen = params->maxPacketLen;
+
+    /* RX pool: a circular queue of general entries with a length byte */
+    pool = params->rxBuf;
+    for (i = 0; i < numEntries; i++) {
+        entry = (rfc_dataEntryGeneral_t *)(pool + i * entrySize);
+        entry->pNextEntry = pool + ((i + 1) % numEntries) * entrySize;
+        entry->status = DATA_ENTRY_PENDING;
+        entry->config.type = DATA_ENTRY_TYPE_GEN;
+        entry->config.lenSz = 1;
+        entry->config.irqIntv = 0;
+        entry->length = entrySize - offsetof(rfc_dataEntryGeneral_t, data);
+    }
+    object->rxQueue.pCurrEntry = pool;
+    object->rxQueue.pLastEntry = NULL;
+    object->rxRead = (rfc_dataEntryGeneral_t *)pool;
+    object->rxEntries = numEntries;
+
+    /* RX runs until it is stopped, whatever it receives */
+    object->rxCmd.commandNo = CMD_PROP_RX;
+    object->rxCmd.status = IDLE;
+    object->rxCmd.startTrigger.triggerType = TRIG_NOW;
+    object->rxCmd.condition.rule = COND_NEVER;
+    object->rxCmd.pktConf.bRepeatOk = 1;
+    object->rxCmd.pktConf.bRepeatNok = 1;
+    object->rxCmd.pktConf.bUseCrc = 1;
+    object->rxCmd.pktConf.bVarLen = 1;
+    object->rxCmd.rxConf.bAutoFlushIgnored = 1;
+    object->rxCmd.rxConf.bAutoFlushCrcErr = 1;
+    object->rxCmd.rxConf.bAppendRssi = 1;
+    object->rxCmd.syncWord = params->syncWord;
+    object->rxCmd.maxPktLen = params->maxPacketLen;
+    object->rxCmd.endTrigger.triggerType = TRIG_NEVER;
+    object->rxCmd.pQueue = &object->rxQueue;
+    object->rxCmd.pOutput = (uint8_t *)&object->rxOutput;
+
+    /* TX ring: each command is linked to the next one once and for all */
+    object->txSlots = params->txBuf;
+    object->txSlotSize = slotSize;
+    object->txChainLen = chainLen;
+    for (i = 0; i < chainLen; i++) {
+        txCmd = txSlot(object, i);
+        memset(txCmd, 0, sizeof(rfc_CMD_PROP_TX_t));
+        txCmd->commandNo = CMD_PROP_TX;
+        txCmd->pNextOp = (rfc_radioOp_t *)txSlot(object, txNext(object, i, 1));
+        txCmd->startTrigger.triggerType = TRIG_NOW;
+        txCmd->condition.rule = COND_ALWAYS;
+        txCmd->pktConf.bUseCrc = 1;
+        txCmd->pktConf.bVarLen = 1;
+        txCmd->syncWord = params->syncWord;
+        txCmd->pPkt = (uint8_t *)(txCmd + 1);
+    }
+
+    key = SwiP_disable();
+
+    ok = (findStream(rfHandle) == NULL);
+    if (ok) {
+        object->isOpen = true;
+        object->next = streamList;
+        streamList = object;
+
+        object->cmdHandle = RF_postCmd(rfHandle, (RF_Op *)&object->rxCmd,
+            RF_PriorityNormal, callbackFxn, RFStream_EVENTS);
+        if (object->cmdHandle < 0) {
+            object->isOpen = false;
+            removeStream(object);
+            ok = false;
+        }
+    }
+
+    SwiP_restore(key);
+
+    return (ok ? object : NULL);
+}
+
+/*
+ *  ======== RFStream_close ========
+ */
+void RFStream_close(RFStream_Handle handle)
+{
+    RF_CmdHandle cmdHandle;
+    RF_CmdHandle prevHandle;
+    uintptr_t key;
+
+    key = SwiP_disable();
+    handle->isOpen = false;
+    cmdHandle = handle->cmdHandle;
+    prevHandle = handle->prevHandle;
+    SwiP_restore(key);
+
+    /* cancel the queued chain before aborting the one it waits for */
+    if (cmdHandle >= 0) {
+        RF_cancelCmd(handle->rfHandle, cmdHandle, 0);
+    }
+    if (prevHandle >= 0) {
+        RF_cancelCmd(handle->rfHandle, prevHandle, 0);
+        RF_pendCmd(handle->rfHandle, prevHandle, 0);
+    }
+    if (cmdHandle >= 0) {
+        RF_pendCmd(handle->rfHandle, cmdHandle, 0);
+    }
+
+    key = SwiP_disable();
+    removeStream(handle);
+    SwiP_restore(key);
+}
+
+/*
+ *  ======== RFStream_write ========
+ */
+size_t RFStream_write(RFStream_Handle handle, const void *buf, size_t len)
+{
+    rfc_CMD_PROP_TX_t *txCmd;
+    uintptr_t key;
+    uint8_t n;
+
+    if (len == 0 || len > handle->maxPacketLen) {
+        return (0);
+    }
+
+    key = SwiP_disable();
+
+    if (!handle->isOpen ||
+        handle->txInFlight + handle->txQueued >= handle->txChainLen) {
+        SwiP_restore(key);
+        return (0);
+    }
+    n = txNext(handle, handle->txHead,
+        handle->txInFlight + handle->txQueued);
+
+    /*
+     * the slot is neither in flight nor visible to the callback yet; a
+     * second writer would pick the same one, see RFStream_write() in
+     * RFStream.h
+     */
+    SwiP_restore(key);
+
+    txCmd = txSlot(handle, n);
+    memcpy(txCmd->pPkt, buf, len);
+    txCmd->pktLen = len;
+
+    key = SwiP_disable();
+    handle->txQueued++;
+    SwiP_restore(key);
+
+    return (len);
+}
+
+/*
+ *  ======== RFStream_flush ========
+ */
+bool RFStream_flush(RFStream_Handle handle)
+{
+    uintptr_t key;
+    bool ok = true;
+
+    key = SwiP_disable();
+
+    if (!handle->isOpen) {
+        ok = false;
+    }
+    else if (handle->txQueued != 0) {
+        if (handle->txInFlight != 0) {
+            /* the callback posts it when the current burst is done */
+            handle->txFlushPending = true;
+        }
+        else {
+            ok = postBurst(handle);
+        }
+    }
+
+    SwiP_restore(key);
+
+    return (ok);
+}
+
+/*
+ *  ======== RFStream_getTxSpace ========
+ */
+size_t RFStream_getTxSpace(RFStream_Handle handle)
+{
+    uintptr_t key;
+    size_t space;
+
+    key = SwiP_disable();
+    space = handle->txChainLen - handle->txInFlight - handle->txQueued;
+    SwiP_restore(key);
+
+    return (space);
+}
+
+/*
+ *  ======== RFStream_available ========
+ */
+size_t RFStream_available(RFStream_Handle handle)
+{
+    rfc_dataEntryGeneral_t *entry;
+    uintptr_t key;
+    size_t count = 0;
+
+    key = SwiP_disable();
+
+    entry = handle->rxRead;
+    while (count < handle->rxEntries && entry->status == DATA_ENTRY_FINISHED) {
+        entry = (rfc_dataEntryGeneral_t *)entry->pNextEntry;
+        count++;
+    }
+
+    SwiP_restore(key);
+
+    return (count);
+}
+
+/*
+ *  ======== RFStream_read ========
+ *  Entry data: length byte (payload + RSSI), payload, RSSI.
+ */
+int_fast16_t RFStream_read(RFStream_Handle handle, void *buf, size_t len,
+    int8_t *rssi)
+{
+    rfc_dataEntryGeneral_t *entry;
+    uint8_t *data;
+    size_t payloadLen;
+    uintptr_t key;
+
+    key = SwiP_disable();
+
+    entry = handle->rxRead;
+    if (entry->status != DATA_ENTRY_FINISHED) {
+        SwiP_restore(key);
+        return (-1);
+    }
+
+    data = &entry->data;
+    payloadLen = data[0] >= 1 ? data[0] - 1 : 0;
+    if (payloadLen > handle->maxPacketLen) {
+        payloadLen = handle->maxPacketLen;
+    }
+
+    memcpy(buf, data + 1, payloadLen < len ? payloadLen : len);
+    if (rssi != NULL) {
+        *rssi = data[0] >= 1 ? (int8_t)data[1 + payloadLen] :
+            RFStream_RSSI_INVALID;
+    }
+
+    entry->status = DATA_ENTRY_PENDING;
+    handle->rxRead = (rfc_dataEntryGeneral_t *)entry->pNextEntry;
+
+    SwiP_restore(key);
+
+    return ((int_fast16_t)payloadLen);
+}
+
+/*
+ *  ======== RFStream_getOverruns ========
+ */
+uint32_t RFStream_getOverruns(RFStream_Handle handle)
+{
+    return (handle->rxOverruns);
+}
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       RFStream.h
+ *
+ *  @brief      Streaming packet RX/TX on top of the RF driver
+ *
+ *  # Overview #
+ *  Posting one CMD_PROP_TX or CMD_PROP_RX per packet costs an RF_Cmd from
+ *  the driver's command pool (eight entries) plus a full pass through the
+ *  command queue and the RF Swi. A sustained packet stream runs into the
+ *  pool limit and spends most of its time in the scheduler.
+ *
+ *  RFStream keeps the number of posted commands independent of the packet
+ *  rate:
+ *  - Reception runs as a single CMD_PROP_RX that never ends. It fills a
+ *    circular queue of general data entries, the RX pool. The application
+ *    reads finished entries in place and returns them to the radio with
+ *    the same call.
+ *  - Transmission uses a ring of CMD_PROP_TX commands that are linked to
+ *    each other once, when the stream is opened. A burst of queued packets
+ *    is sent by pointing the last command of the burst at the RX command
+ *    and posting the first one. The whole burst, and the return to RX,
+ *    costs one RF_postCmd().
+ *
+ *  Because the RX command ends a burst, at most two stream commands are
+ *  ever in the RF driver's queue: the running chain and the next one.
+ *
+ *  # Buffers #
+ *  The caller provides the RX pool and the TX ring. Use
+ *  RFStream_RX_BUFFER_SIZE() and RFStream_TX_BUFFER_SIZE() to size them;
+ *  both must be 4-byte aligned and stay valid until RFStream_close().
+ *
+ *  The RX pool recycles itself: when the radio finishes an entry and the
+ *  entry it will use next still holds an unread packet, the oldest unread
+ *  packet is dropped (counted by RFStream_getOverruns()) so reception never
+ *  stalls on a slow reader.
+ *
+ *  The TX ring holds at most #RFStream_MAX_CHAIN_LEN packets, so a burst
+ *  plus its trailing RX command stays within the RF driver's chain length
+ *  limit.
+ *
+ *  # Usage #
+ *  The radio must already be open and set up; RFStream only takes over
+ *  packet traffic.
+ *  @code
+ *  static uint32_t rxBuf[RFStream_RX_BUFFER_SIZE(8, 32) / 4];
+ *  static uint32_t txBuf[RFStream_TX_BUFFER_SIZE(8, 32) / 4];
+ *  RFStream_Object stream;
+ *  RFStream_Params params;
+ *
+ *  rfHandle = RF_open(&rfObject, &RF_prop, (RF_RadioSetup *)&RF_cmdPropRadioDivSetup, NULL);
+ *  RF_runCmd(rfHandle, (RF_Op *)&RF_cmdFs, RF_PriorityNormal, NULL, 0);
+ *
+ *  RFStream_Params_init(&params);
+ *  params.rxBuf = rxBuf;
+ *  params.rxBufSize = sizeof(rxBuf);
+ *  params.txBuf = txBuf;
+ *  params.txBufSize = sizeof(txBuf);
+ *  params.maxPacketLen = 32;
+ *  RFStream_open(&stream, rfHandle, &params);
+ *
+ *  RFStream_write(&stream, sample, sizeof(sample));
+ *  RFStream_flush(&stream);
+ *
+ *  while ((len = RFStream_read(&stream, packet, sizeof(packet), &rssi)) >= 0) {
+ *      ...
+ *  }
+ *  @endcode
+ *
+ *  RFStream_flush() does not wait. If a burst is still on the air, the
+ *  packets written since join the next burst, which is posted from the RF
+ *  callback as soon as the current one is done.
+ *
+ *  All functions except RFStream_open() and RFStream_close() may be called
+ *  from Task or Swi context. They briefly disable Swis to serialize with
+ *  the RF callback.
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_rf_RFStream__include
+#define ti_drivers_rf_RFStream__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <ti/drivers/rf/RF.h>
+#include DEVICE_FAMILY_PATH(driverlib/rf_data_entry.h)
+
+/*!
+ *  @brief  Maximum number of packets in a TX burst
+ *
+ *  One less than the RF driver's RF_MAX_CHAIN_CMD_LEN, leaving room for
+ *  the RX command that ends every burst.
+ */
+#define RFStream_MAX_CHAIN_LEN          31
+
+/*!
+ *  @brief  Bytes stored per received packet besides the payload
+ *
+ *  A one byte length indicator in front and the RSSI byte appended by
+ *  the radio.
+ */
+#define RFStream_RX_OVERHEAD            2
+
+/*!
+ *  @brief  Size of one RX pool entry for packets up to maxLen bytes
+ */
+#define RFStream_RX_ENTRY_SIZE(maxLen)                                      \
+    ((offsetof(rfc_dataEntryGeneral_t, data) + RFStream_RX_OVERHEAD +       \
+      (maxLen) + 3) & ~(size_t)3)
+
+/*!
+ *  @brief  Size of an RX pool of numEntries packets up to maxLen bytes
+ */
+#define RFStream_RX_BUFFER_SIZE(numEntries, maxLen)                         \
+    ((numEntries) * RFStream_RX_ENTRY_SIZE(maxLen))
+
+/*!
+ *  @brief  Size of one TX ring slot, a CMD_PROP_TX and its payload
+ */
+#define RFStream_TX_SLOT_SIZE(maxLen)                                       \
+    ((sizeof(rfc_CMD_PROP_TX_t) + (maxLen) + 3) & ~(size_t)3)
+
+/*!
+ *  @brief  Size of a TX ring of chainLen packets up to maxLen bytes
+ */
+#define RFStream_TX_BUFFER_SIZE(chainLen, maxLen)                           \
+    ((chainLen) * RFStream_TX_SLOT_SIZE(maxLen))
+
+/*!
+ *  @brief  A handle that is returned from a RFStream_open() call
+ */
+typedef struct RFStream_Object *RFStream_Handle;
+
+/*!
+ *  @brief  Stream callback
+ *
+ *  Called from the RF Swi after the RF driver callback has recycled RX
+ *  entries and reaped finished TX commands.
+ *
+ *  @param  handle  Stream handle
+ *  @param  events  RF_EventRxEntryDone and/or RF_EventTxDone
+ */
+typedef void (*RFStream_Callback)(RFStream_Handle handle, RF_EventMask events);
+
+/*!
+ *  @brief  RFStream parameters
+ */
+typedef struct RFStream_Params {
+    void               *rxBuf;          /*!< RX pool, 4-byte aligned */
+    size_t              rxBufSize;      /*!< Size of rxBuf, >= 2 entries */
+    void               *txBuf;          /*!< TX ring, 4-byte aligned */
+    size_t              txBufSize;      /*!< Size of txBuf, >= 1 slot */
+    uint8_t             maxPacketLen;   /*!< Largest payload in bytes */
+    uint32_t            syncWord;       /*!< Sync word for TX and RX */
+    RFStream_Callback   callback;       /*!< Optional, NULL to poll */
+} RFStream_Params;
+
+/*!
+ *  @brief  RFStream object
+ *
+ *  The fields are private to the implementation.
+ */
+typedef struct RFStream_Object {
+    struct RFStream_Object *next;           /* open streams, by RF handle */
+    RF_Handle               rfHandle;
+    RFStream_Callback       callback;
+    RF_CmdHandle            cmdHandle;      /* chain currently posted */
+    RF_CmdHandle            prevHandle;     /* chain being stopped */
+    bool                    isOpen;
+    uint8_t                 maxPacketLen;
+
+    /* RX */
+    rfc_CMD_PROP_RX_t       rxCmd;
+    rfc_propRxOutput_t      rxOutput;
+    dataQueue_t             rxQueue;
+    rfc_dataEntryGeneral_t *rxRead;         /* oldest unread entry */
+    uint16_t                rxEntries;
+    volatile uint32_t       rxOverruns;
+
+    /* TX */
+    unsigned char          *txSlots;
+    uint16_t                txSlotSize;
+    uint8_t                 txChainLen;
+    uint8_t                 txHead;         /* oldest slot in flight */
+    uint8_t                 txTail;         /* slot linked to rxCmd */
+    uint8_t                 txInFlight;
+    uint8_t                 txQueued;
+    bool                    txFlushPending;
+} RFStream_Object;
+
+/*!
+ *  @brief  Initialize an RFStream_Params structure to its defaults
+ *
+ *  No buffers, 32 byte packets, the SmartRF Studio default sync word
+ *  0x930B51DE and no callback.
+ */
+extern void RFStream_Params_init(RFStream_Params *params);
+
+/*!
+ *  @brief  Start streaming on an open RF client
+ *
+ *  Formats the RX pool and the TX ring and posts the RX command.
+ *
+ *  @note Calling context : Task
+ *
+ *  @param  object      Stream object, persistent until RFStream_close()
+ *  @param  rfHandle    RF client with the radio set up and the synth
+ *                      programmed
+ *  @param  params      Buffers and packet format
+ *
+ *  @return The stream handle, or NULL if the buffers are too small or
+ *          misaligned, the client already streams, or RX could not be
+ *          posted
+ */
+extern RFStream_Handle RFStream_open(RFStream_Object *object,
+    RF_Handle rfHandle, RFStream_Params *params);
+
+/*!
+ *  @brief  Stop streaming
+ *
+ *  Aborts the running command, drops queued packets and waits until the
+ *  radio no longer accesses the buffers.
+ *
+ *  @note Calling context : Task
+ */
+extern void RFStream_close(RFStream_Handle handle);
+
+/*!
+ *  @brief  Queue one packet for transmission
+ *
+ *  Copies the payload into the next free TX slot. Nothing is sent until
+ *  RFStream_flush().
+ *
+ *  The slot is picked before it is counted as queued, so only one thread
+ *  may call RFStream_write() on a stream. RFStream_flush() and the read
+ *  side can run in other threads.
+ *
+ *  @return len, or 0 if len is 0 or exceeds maxPacketLen, or the ring is
+ *          full
+ */
+extern size_t RFStream_write(RFStream_Handle handle, const void *buf,
+    size_t len);
+
+/*!
+ *  @brief  Send the queued packets as one burst
+ *
+ *  @return false if the burst could not be posted to the RF driver; the
+ *          packets stay queued
+ */
+extern bool RFStream_flush(RFStream_Handle handle);
+
+/*!
+ *  @brief  Number of TX slots that RFStream_write() can fill right now
+ */
+extern size_t RFStream_getTxSpace(RFStream_Handle handle);
+
+/*!
+ *  @brief  Number of received packets waiting to be read
+ */
+extern size_t RFStream_available(RFStream_Handle handle);
+
+/*!
+ *  @brief  Take the oldest received packet
+ *
+ *  Copies up to len bytes of the payload and returns the entry to the
+ *  radio.
+ *
+ *  @param  handle  Stream handle
+ *  @param  buf     Payload destination
+ *  @param  len     Size of buf; a longer payload is truncated
+ *  @param  rssi    If not NULL, receives the RSSI of the packet in dBm
+ *
+ *  @return The full payload length, or -1 if no packet is waiting
+ */
+extern int_fast16_t RFStream_read(RFStream_Handle handle, void *buf,
+    size_t len, int8_t *rssi);
+
+/*!
+ *  @brief  Number of received packets dropped because the pool was full
+ */
+extern uint32_t RFStream_getOverruns(RFStream_Handle handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_rf_RFStream__include */
@@ -64,6 +64,7 @@
 #include DEVICE_FAMILY_PATH(driverlib/ioc.h)
 #include DEVICE_FAMILY_PATH(driverlib/prcm.h)
 #include DEVICE_FAMILY_PATH(driverlib/rom.h)
+#include DEVICE_FAMILY_PATH(driverlib/gpio.h)
 
 /* SPI test control register */
 #define SSI_O_TCR               0x00000080
@@ -81,6 +82,15 @@ ALLOCATE_CONTROL_TABLE_ENTRY(dmaSpi0RxControlTableEntry, UDMA_CHAN_SSI0_RX);
 ALLOCATE_CONTROL_TABLE_ENTRY(dmaSpi1TxControlTableEntry, UDMA_CHAN_SSI1_TX);
 ALLOCATE_CONTROL_TABLE_ENTRY(dmaSpi1RxControlTableEntry, UDMA_CHAN_SSI1_RX);
 
+/* Alternate control table entries, used for transfers longer than one uDMA segment */
+ALLOCATE_CONTROL_TABLE_ENTRY(dmaSpi0TxAltControlTableEntry, (UDMA_CHAN_SSI0_TX + UDMA_ALT_SELECT));
+ALLOCATE_CONTROL_TABLE_ENTRY(dmaSpi0RxAltControlTableEntry, (UDMA_CHAN_SSI0_RX + UDMA_ALT_SELECT));
+ALLOCATE_CONTROL_TABLE_ENTRY(dmaSpi1TxAltControlTableEntry, (UDMA_CHAN_SSI1_TX + UDMA_ALT_SELECT));
+ALLOCATE_CONTROL_TABLE_ENTRY(dmaSpi1RxAltControlTableEntry, (UDMA_CHAN_SSI1_RX + UDMA_ALT_SELECT));
+
+/* Maximum number of frames the uDMA moves per control table entry */
+#define SPICC26XXDMA_SEGMENT_SIZE      1024
+
 /* SPICC26XX functions */
 void         SPICC26XXDMA_close(SPI_Handle handle);
 int_fast16_t SPICC26XXDMA_control(SPI_Handle handle, uint_fast16_t cmd, void *arg);
@@ -95,6 +105,12 @@ static void SPICC26XXDMA_csnCallback(PIN_Handle handle, PIN_Id pinId);
 static void SPICC26XXDMA_initHw(SPI_Handle handle);
 static bool SPICC26XXDMA_initIO(SPI_Handle handle);
 static void SPICC26XXDMA_flushFifos(SPI_Handle handle);
+static size_t SPICC26XXDMA_loadSegment(SPI_Handle handle, SPI_Transaction *transaction,
+                                       bool isTx, volatile tDMAControlTable *dmaControlTableEntry,
+                                       size_t queued);
+static uint8_t SPICC26XXDMA_refillSegments(SPI_Handle handle, bool isTx);
+static void SPICC26XXDMA_startTransfer(SPI_Handle handle, SPI_Transaction *transaction);
+static void SPICC26XXDMA_startQueued(SPI_Handle handle);
 
 /* Internal power functions */
 #ifdef SPICC26XXDMA_WAKEUP_ENABLED
@@ -288,6 +304,8 @@ int_fast16_t SPICC26XXDMA_control(SPI_Handle handle, uint_fast16_t cmd, void *ar
     SPICC26XXDMA_HWAttrs const *hwAttrs;
     PIN_Config                  pinConfig;
     PIN_Id                      pinId;
+    SPI_Params                 *params;
+    unsigned int                key;
 
     /* Get the pointer to the object and hwAttr */
     hwAttrs = handle->hwAttrs;
@@ -357,6 +375,31 @@ int_fast16_t SPICC26XXDMA_control(SPI_Handle handle, uint_fast16_t cmd, void *ar
             }
             break;
 
+        case SPICC26XXDMA_CMD_SET_FRAME_FORMAT:
+            params = (SPI_Params *) arg;
+
+            /*
+             * The SSI can only be reprogrammed while the bus is idle and no
+             * queued transaction is waiting for it. Keep interrupts off until
+             * it is done, so the Swi cannot start a queued one meanwhile.
+             */
+            key = Hwi_disable();
+            if (object->currentTransaction || object->currentEntry || object->queueHead) {
+                Hwi_restore(key);
+                ret = SPI_STATUS_ERROR;
+                break;
+            }
+
+            /* Reconfigure the SSI only when the settings change */
+            if ((params->frameFormat != object->frameFormat) || (params->bitRate != object->bitRate)) {
+                object->frameFormat = params->frameFormat;
+                object->bitRate = params->bitRate;
+                SPICC26XXDMA_initHw(handle);
+            }
+            Hwi_restore(key);
+            ret = SPI_STATUS_SUCCESS;
+            break;
+
 #ifdef SPICC26XXDMA_WAKEUP_ENABLED
         case SPICC26XXDMA_CMD_SET_CSN_WAKEUP:
             /* Set wakeup callback function no matter what, NULL signals that the wakeup feature is disabled */
@@ -391,6 +434,42 @@ static void SPICC26XXDMA_configDMA(SPI_Handle handle, SPI_Transaction *transacti
     object = handle->object;
     hwAttrs = handle->hwAttrs;
 
+    /* Transactions longer than one uDMA segment are run in ping-pong mode */
+    if (transaction->count > SPICC26XXDMA_SEGMENT_SIZE) {
+        /* Fill both the primary and alternate entries of each channel */
+        object->rxQueued = SPICC26XXDMA_loadSegment(handle, transaction, false,
+            (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0RxControlTableEntry : &dmaSpi1RxControlTableEntry), 0);
+        object->rxQueued += SPICC26XXDMA_loadSegment(handle, transaction, false,
+            (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0RxAltControlTableEntry : &dmaSpi1RxAltControlTableEntry), object->rxQueued);
+        object->txQueued = SPICC26XXDMA_loadSegment(handle, transaction, true,
+            (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0TxControlTableEntry : &dmaSpi1TxControlTableEntry), 0);
+        object->txQueued += SPICC26XXDMA_loadSegment(handle, transaction, true,
+            (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0TxAltControlTableEntry : &dmaSpi1TxAltControlTableEntry), object->txQueued);
+
+        object->rxArmed = 0x3;
+        object->txArmed = 0x3;
+        object->rxNext = 0;
+        object->txNext = 0;
+
+        /* Both channels must start on their primary entries */
+        HWREG(((UDMACC26XX_HWAttrs const *)(object->udmaHandle->hwAttrs))->baseAddr + UDMA_O_CLEARCHNLPRIALT) =
+            (hwAttrs->rxChannelBitMask) | (hwAttrs->txChannelBitMask);
+
+        /* Enable the channels */
+        UDMACC26XX_channelEnable(object->udmaHandle, (hwAttrs->rxChannelBitMask) | (hwAttrs->txChannelBitMask));
+
+        /* Enable the required DMA channels in the SPI module to start the transaction */
+        SSIDMAEnable(hwAttrs->baseAddr, SSI_DMA_TX | SSI_DMA_RX);
+
+        Log_print2(Diags_USER1,"SPI:(%p) DMA ping-pong transfer enabled, count: %d",
+                                hwAttrs->baseAddr, (UArg)transaction->count);
+        return;
+    }
+
+    /* Single segment, no control table entries to refill */
+    object->rxArmed = 0;
+    object->txArmed = 0;
+
     /* Calculate the number of bytes for the transfer */
     numberOfBytes = ((uint16_t)(transaction->count) << (object->frameSize));
 
@@ -440,6 +519,138 @@ static void SPICC26XXDMA_configDMA(SPI_Handle handle, SPI_Transaction *transacti
                             (UArg)transaction->count);
 }
 
+/*
+ *  ======== SPICC26XXDMA_loadSegment ========
+ *  Loads the next segment of a ping-pong transaction into a control table
+ *  entry, starting "queued" frames into the transaction. Every segment but
+ *  the last is set up in ping-pong mode so that the uDMA moves straight on
+ *  to the other entry of the channel without a gap; the last segment uses
+ *  basic mode so that the channel stops when the transaction is done.
+ *
+ *  Returns the number of frames loaded, or 0 if the whole transaction has
+ *  already been handed to the channel.
+ */
+static size_t SPICC26XXDMA_loadSegment(SPI_Handle handle, SPI_Transaction *transaction,
+                                       bool isTx, volatile tDMAControlTable *dmaControlTableEntry,
+                                       size_t queued)
+{
+    SPICC26XXDMA_Object             *object;
+    SPICC26XXDMA_HWAttrs const      *hwAttrs;
+    void                            *buf;
+    void                            *bufEndAddr;
+    uint32_t                        control;
+    size_t                          count;
+
+    /* Get the pointer to the object and hwAttrs */
+    object = handle->object;
+    hwAttrs = handle->hwAttrs;
+
+    count = transaction->count - queued;
+    if (count == 0) {
+        return (0);
+    }
+    if (count > SPICC26XXDMA_SEGMENT_SIZE) {
+        count = SPICC26XXDMA_SEGMENT_SIZE;
+    }
+
+    buf = isTx ? transaction->txBuf : transaction->rxBuf;
+    if (buf) {
+        control = isTx ? dmaTxConfig[object->frameSize] : dmaRxConfig[object->frameSize];
+        bufEndAddr = (void *)((uint32_t)buf + ((queued + count) << (object->frameSize)) - 1);
+    }
+    else {
+        control = dmaNullConfig[object->frameSize];
+        bufEndAddr = (void *) &(object->scratchBuf);
+        if (isTx) {
+            object->scratchBuf = hwAttrs->defaultTxBufValue;
+        }
+    }
+
+    /* Hand over to the other entry of the channel unless this is the last segment */
+    if (queued + count < transaction->count) {
+        control = (control & ~UDMA_MODE_M) | UDMA_MODE_PINGPONG;
+    }
+
+    if (isTx) {
+        dmaControlTableEntry->pvSrcEndAddr = bufEndAddr;
+        dmaControlTableEntry->pvDstEndAddr = (void *)(hwAttrs->baseAddr + SSI_O_DR);
+    }
+    else {
+        dmaControlTableEntry->pvSrcEndAddr = (void *)(hwAttrs->baseAddr + SSI_O_DR);
+        dmaControlTableEntry->pvDstEndAddr = bufEndAddr;
+    }
+    dmaControlTableEntry->ui32Control = control | UDMACC26XX_SET_TRANSFER_SIZE((uint16_t)count);
+
+    return (count);
+}
+
+/*
+ *  ======== SPICC26XXDMA_refillSegments ========
+ *  Called from the hwi when a channel of a ping-pong transaction reports
+ *  done. Reloads every control table entry the uDMA has finished with, in
+ *  the order the entries were used, with the next segment of the
+ *  transaction.
+ *
+ *  Returns a bitmask of the entries still in flight (bit 0 primary, bit 1
+ *  alternate); 0 means the channel has moved its whole transaction.
+ */
+static uint8_t SPICC26XXDMA_refillSegments(SPI_Handle handle, bool isTx)
+{
+    SPICC26XXDMA_Object             *object;
+    SPICC26XXDMA_HWAttrs const      *hwAttrs;
+    volatile tDMAControlTable       *dmaControlTableEntry[2];
+    volatile tDMAControlTable       *entry;
+    uint8_t                         *armed;
+    uint8_t                         *next;
+    size_t                          *queued;
+    size_t                          count;
+
+    /* Get the pointer to the object and hwAttrs */
+    object = handle->object;
+    hwAttrs = handle->hwAttrs;
+
+    if (isTx) {
+        dmaControlTableEntry[0] = (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0TxControlTableEntry : &dmaSpi1TxControlTableEntry);
+        dmaControlTableEntry[1] = (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0TxAltControlTableEntry : &dmaSpi1TxAltControlTableEntry);
+        armed = &object->txArmed;
+        next = &object->txNext;
+        queued = &object->txQueued;
+    }
+    else {
+        dmaControlTableEntry[0] = (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0RxControlTableEntry : &dmaSpi1RxControlTableEntry);
+        dmaControlTableEntry[1] = (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0RxAltControlTableEntry : &dmaSpi1RxAltControlTableEntry);
+        armed = &object->rxArmed;
+        next = &object->rxNext;
+        queued = &object->rxQueued;
+    }
+
+    if (object->currentTransaction == NULL) {
+        *armed = 0;
+        return (0);
+    }
+
+    /* The uDMA sets an entry's mode to stop once it has been completed */
+    entry = dmaControlTableEntry[*next];
+    while ((*armed & (1 << *next)) && ((entry->ui32Control & UDMA_MODE_M) == UDMA_MODE_STOP)) {
+        count = SPICC26XXDMA_loadSegment(handle, object->currentTransaction, isTx, entry, *queued);
+        if (count) {
+            *queued += count;
+        }
+        else {
+            *armed &= ~(1 << *next);
+        }
+        *next ^= 1;
+        entry = dmaControlTableEntry[*next];
+    }
+
+    if (*armed) {
+        /* Restart the channel in case it caught up with a stopped entry */
+        UDMACC26XX_channelEnable(object->udmaHandle, isTx ? hwAttrs->txChannelBitMask : hwAttrs->rxChannelBitMask);
+    }
+
+    return (*armed);
+}
+
 /*
  *  ======== SPICC26XXDMA_hwiFxn ========
  *  HWI ISR for the SPI when we use the UDMA
@@ -495,9 +706,13 @@ static void SPICC26XXDMA_hwiFxn (UArg arg) {
          * a scratch memory location which is then discarded.
          */
         if (UDMACC26XX_channelDone(object->udmaHandle, hwAttrs->txChannelBitMask)) {
-            /* Disable SPI TX DMA and clear DMA done interrupt. */
-            SSIDMADisable(hwAttrs->baseAddr, SSI_DMA_TX);
+            /* Clear DMA done interrupt. */
             UDMACC26XX_clearInterrupt(object->udmaHandle, hwAttrs->txChannelBitMask);
+
+            /* Disable SPI TX DMA unless ping-pong segments are still in flight. */
+            if ((object->txArmed == 0) || (SPICC26XXDMA_refillSegments((SPI_Handle)arg, true) == 0)) {
+                SSIDMADisable(hwAttrs->baseAddr, SSI_DMA_TX);
+            }
         }
 
         /*
@@ -505,17 +720,22 @@ static void SPICC26XXDMA_hwiFxn (UArg arg) {
          * occurrence depends on when the SPI master starts sending data.
          */
         if (UDMACC26XX_channelDone(object->udmaHandle, hwAttrs->rxChannelBitMask)) {
-            /* Disable SPI RX DMA and clear DMA done interrupt. */
-            SSIDMADisable(hwAttrs->baseAddr, SSI_DMA_RX);
+            /* Clear DMA done interrupt. */
             UDMACC26XX_clearInterrupt(object->udmaHandle, hwAttrs->rxChannelBitMask);
 
-            /* Transaction is complete */
-            if (object->currentTransaction && (object->currentTransaction->status == SPI_TRANSFER_STARTED)) {
-                object->currentTransaction->status = SPI_TRANSFER_COMPLETED;
-            }
+            /* The transaction is complete unless ping-pong segments are still in flight. */
+            if ((object->rxArmed == 0) || (SPICC26XXDMA_refillSegments((SPI_Handle)arg, false) == 0)) {
+                /* Disable SPI RX DMA. */
+                SSIDMADisable(hwAttrs->baseAddr, SSI_DMA_RX);
+
+                /* Transaction is complete */
+                if (object->currentTransaction && (object->currentTransaction->status == SPI_TRANSFER_STARTED)) {
+                    object->currentTransaction->status = SPI_TRANSFER_COMPLETED;
+                }
 
-            /* Post SWI to handle remaining clean up and invocation of callback */
-            Swi_post(Swi_handle(&(object->swi)));
+                /* Post SWI to handle remaining clean up and invocation of callback */
+                Swi_post(Swi_handle(&(object->swi)));
+            }
         }
     }
 
@@ -530,8 +750,9 @@ static void SPICC26XXDMA_hwiFxn (UArg arg) {
  *  occurrence depends on when the SPI master starts sending data.
  */
 static void SPICC26XXDMA_swiFxn (UArg arg0, UArg arg1) {
-    SPI_Transaction         *transaction;
-    SPICC26XXDMA_Object     *object;
+    SPI_Transaction                 *transaction;
+    SPICC26XXDMA_Object             *object;
+    SPICC26XXDMA_QueuedTransaction  *entry;
 
     /* Get the pointer to the object and hwAttrs */
     object = ((SPI_Handle)arg0)->object;
@@ -566,8 +787,28 @@ static void SPICC26XXDMA_swiFxn (UArg arg0, UArg arg1) {
     /* Release constraint since transaction is done */
     threadSafeConstraintRelease((uint32_t)(transaction->txBuf), object);
 
+    /* Finish the queued transaction, if this was one */
+    entry = object->currentEntry;
+    if (entry && (&(entry->transaction) == transaction)) {
+        if (entry->csnPin != PIN_UNASSIGNED) {
+            GPIO_writeDio(entry->csnPin, 1);
+        }
+        object->currentEntry = NULL;
+    }
+    else {
+        entry = NULL;
+    }
+
+    /* Keep the bus busy: start the next queued transaction before the callback */
+    SPICC26XXDMA_startQueued((SPI_Handle)arg0);
+
     /* Perform callback */
-    object->transferCallbackFxn((SPI_Handle)arg0, transaction);
+    if (entry && entry->callbackFxn) {
+        entry->callbackFxn((SPI_Handle)arg0, transaction);
+    }
+    else {
+        object->transferCallbackFxn((SPI_Handle)arg0, transaction);
+    }
 
     Log_print1(Diags_USER2, "SPI:(%p) swi interrupt context end",
                              ((SPICC26XXDMA_HWAttrs const  *)(((SPI_Handle)arg0)->hwAttrs))->baseAddr);
@@ -693,6 +934,11 @@ SPI_Handle SPICC26XXDMA_open(SPI_Handle handle, SPI_Params *params)
     object->transferMode       = params->transferMode;
     object->transferTimeout    = params->transferTimeout;
     object->returnPartial      = false;
+    object->rxArmed            = 0;
+    object->txArmed            = 0;
+    object->queueHead          = NULL;
+    object->queueTail          = NULL;
+    object->currentEntry       = NULL;
 #ifdef SPICC26XXDMA_WAKEUP_ENABLED
     object->wakeupCallbackFxn  = NULL;
 #endif
@@ -790,6 +1036,38 @@ SPI_Handle SPICC26XXDMA_open(SPI_Handle handle, SPI_Params *params)
     return (handle);
 }
 
+/*
+ *  ======== SPICC26XXDMA_startTransfer ========
+ *  Programs the SSI and the uDMA for a transaction that already owns the
+ *  bus, i.e. that has been made the currentTransaction.
+ */
+static void SPICC26XXDMA_startTransfer(SPI_Handle handle, SPI_Transaction *transaction)
+{
+    SPICC26XXDMA_Object         *object;
+    SPICC26XXDMA_HWAttrs const  *hwAttrs;
+
+    /* Get the pointer to the object and hwAttrs */
+    object = handle->object;
+    hwAttrs = handle->hwAttrs;
+
+    /* In slave mode, optionally enable callback on CSN de-assert */
+    if (object->returnPartial) {
+        PIN_setInterrupt(object->pinHandle, object->csnPin | PIN_IRQ_POSEDGE);
+    }
+
+    /* Set constraints to guarantee transaction */
+    threadSafeConstraintSet((uint32_t)(transaction->txBuf), object);
+
+    /* Enable the SPI module */
+    SSIEnable(hwAttrs->baseAddr);
+
+    /* Setup DMA transfer. */
+    SPICC26XXDMA_configDMA(handle, transaction);
+
+    /* Enable the RX overrun interrupt in the SSI module */
+    SSIIntEnable(hwAttrs->baseAddr, SSI_RXOR);
+}
+
 /*!
  *  @brief  Function for transferring using the SPI interface.
  *
@@ -817,14 +1095,9 @@ bool SPICC26XXDMA_transfer(SPI_Handle handle, SPI_Transaction *transaction)
 {
     unsigned int                key;
     SPICC26XXDMA_Object         *object;
-    SPICC26XXDMA_HWAttrs const  *hwAttrs;
 
     /* Get the pointer to the object and hwAttr*/
     object = handle->object;
-    hwAttrs = handle->hwAttrs;
-
-    /* This is a limitation by the uDMA controller */
-    Assert_isTrue(transaction->count <= 1024, NULL);
 
     if (transaction->count == 0) {
         return (false);
@@ -857,22 +1130,7 @@ bool SPICC26XXDMA_transfer(SPI_Handle handle, SPI_Transaction *transaction)
 
     Hwi_restore(key);
 
-    /* In slave mode, optionally enable callback on CSN de-assert */
-    if (object->returnPartial) {
-        PIN_setInterrupt(object->pinHandle, object->csnPin | PIN_IRQ_POSEDGE);
-    }
-
-    /* Set constraints to guarantee transaction */
-    threadSafeConstraintSet((uint32_t)(transaction->txBuf), object);
-
-    /* Enable the SPI module */
-    SSIEnable(hwAttrs->baseAddr);
-
-    /* Setup DMA transfer. */
-    SPICC26XXDMA_configDMA(handle, transaction);
-
-    /* Enable the RX overrun interrupt in the SSI module */
-    SSIIntEnable(hwAttrs->baseAddr, SSI_RXOR);
+    SPICC26XXDMA_startTransfer(handle, transaction);
 
     if (object->transferMode == SPI_MODE_BLOCKING) {
         Log_print1(Diags_USER1, "SPI:(%p) transfer pending on transferComplete "
@@ -898,6 +1156,92 @@ bool SPICC26XXDMA_transfer(SPI_Handle handle, SPI_Transaction *transaction)
     return (true);
 }
 
+/*
+ *  ======== SPICC26XXDMA_startQueued ========
+ *  Starts the transaction at the head of the queue if the bus is idle.
+ *  The bus is claimed for it in the same critical section that takes it
+ *  off the queue, so a direct SPI_transfer() cannot slip in between; while
+ *  one holds the bus the entry stays at the head, and the Swi starts it
+ *  when that transfer completes. The transaction's bus settings are
+ *  applied and its chip select is asserted before the transfer is started.
+ */
+static void SPICC26XXDMA_startQueued(SPI_Handle handle)
+{
+    unsigned int                    key;
+    SPICC26XXDMA_Object             *object;
+    SPICC26XXDMA_QueuedTransaction  *entry;
+
+    /* Get the pointer to the object */
+    object = handle->object;
+
+    /* Claim the head of the queue and the bus */
+    key = Hwi_disable();
+    entry = object->queueHead;
+    if (object->currentEntry || object->currentTransaction || (entry == NULL)) {
+        Hwi_restore(key);
+        return;
+    }
+    object->queueHead = entry->next;
+    if (object->queueHead == NULL) {
+        object->queueTail = NULL;
+    }
+    object->currentEntry = entry;
+    object->currentTransaction = &(entry->transaction);
+    Hwi_restore(key);
+
+    /* Reconfigure the SSI only when the settings change */
+    if ((entry->frameFormat != object->frameFormat) || (entry->bitRate != object->bitRate)) {
+        object->frameFormat = entry->frameFormat;
+        object->bitRate = entry->bitRate;
+        SPICC26XXDMA_initHw(handle);
+    }
+
+    if (entry->csnPin != PIN_UNASSIGNED) {
+        GPIO_writeDio(entry->csnPin, 0);
+    }
+
+    SPICC26XXDMA_startTransfer(handle, &(entry->transaction));
+}
+
+/*
+ *  ======== SPICC26XXDMA_queueTransfer ========
+ */
+bool SPICC26XXDMA_queueTransfer(SPI_Handle handle, SPICC26XXDMA_QueuedTransaction *entry)
+{
+    unsigned int                key;
+    SPICC26XXDMA_Object         *object;
+
+    /* Get the pointer to the object */
+    object = handle->object;
+
+    /* The next transaction is started from the Swi, which must not block */
+    if ((object->transferMode == SPI_MODE_BLOCKING) || (entry->transaction.count == 0)) {
+        entry->transaction.status = SPI_TRANSFER_FAILED;
+        return (false);
+    }
+
+    entry->next = NULL;
+    entry->transaction.status = SPI_TRANSFER_STARTED;
+
+    key = Hwi_disable();
+    if (object->queueTail) {
+        object->queueTail->next = entry;
+    }
+    else {
+        object->queueHead = entry;
+    }
+    object->queueTail = entry;
+    Hwi_restore(key);
+
+    Log_print2(Diags_USER2,"SPI:(%p) transaction %p queued",
+                            ((SPICC26XXDMA_HWAttrs const *)(handle->hwAttrs))->baseAddr, (UArg)entry);
+
+    /* Start it now if the bus is idle */
+    SPICC26XXDMA_startQueued(handle);
+
+    return (true);
+}
+
 /*!
  *  @brief Function that cancels a SPI transfer. Will disable SPI and UDMA modules
  *         and allow standby.
@@ -912,6 +1256,7 @@ void SPICC26XXDMA_transferCancel(SPI_Handle handle) {
     SPICC26XXDMA_HWAttrs const  *hwAttrs;
     SPI_Transaction             *transaction;
     volatile tDMAControlTable   *dmaControlTableEntry;
+    size_t                      remaining;
 
     /* Get the pointer to the object and hwAttrs */
     object = handle->object;
@@ -962,7 +1307,24 @@ void SPICC26XXDMA_transferCancel(SPI_Handle handle) {
     /* Update the SPI_Transaction.count parameter */
     /* rxChannel always finishes after txChannel so remaining bytes of the rxChannel is used to update count */
     dmaControlTableEntry = (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0RxControlTableEntry : &dmaSpi1RxControlTableEntry);
-    transaction->count -= UDMACC26XX_GET_TRANSFER_SIZE(dmaControlTableEntry->ui32Control);
+    if (object->rxArmed) {
+        /* Frames never handed to the uDMA, plus those left in the loaded ping-pong segments */
+        remaining = transaction->count - object->rxQueued;
+        if ((dmaControlTableEntry->ui32Control & UDMA_MODE_M) != UDMA_MODE_STOP) {
+            remaining += UDMACC26XX_GET_TRANSFER_SIZE(dmaControlTableEntry->ui32Control);
+        }
+        dmaControlTableEntry = (hwAttrs->baseAddr == SSI0_BASE ? &dmaSpi0RxAltControlTableEntry : &dmaSpi1RxAltControlTableEntry);
+        if ((dmaControlTableEntry->ui32Control & UDMA_MODE_M) != UDMA_MODE_STOP) {
+            remaining += UDMACC26XX_GET_TRANSFER_SIZE(dmaControlTableEntry->ui32Control);
+        }
+        transaction->count -= remaining;
+
+        object->rxArmed = 0;
+        object->txArmed = 0;
+    }
+    else {
+        transaction->count -= UDMACC26XX_GET_TRANSFER_SIZE(dmaControlTableEntry->ui32Control);
+    }
 
     /* Post SWI to handle remaining clean up and invocation of callback */
     Swi_post(Swi_handle(&(object->swi)));
@@ -210,6 +210,22 @@
  *  The UDMA contoller only supports data transfers of upto 1024
  *  data frames. A data frame can be 4 to 16 bits in length.
  *
+ *  Longer transactions are split into 1024 frame segments which are run in
+ *  the UDMA ping-pong mode: while one control table entry of a channel is
+ *  being transferred, the driver reloads the other one with the next
+ *  segment. The SSI FIFOs are kept fed across segment boundaries, so there
+ *  is no gap on the bus and a hardware controlled CSN stays asserted for the
+ *  whole transaction. This uses the alternate control table entries of the
+ *  SSI channels, which must be placed by the linker like the primary ones.
+ *
+ *  ### Queued Transactions #
+ *
+ *  In ::SPI_MODE_CALLBACK, SPICC26XXDMA_queueTransfer() queues transactions
+ *  that each carry their own frame format, bit rate and software chip
+ *  select. The driver starts the next queued transaction from the
+ *  completion Swi of the previous one, so command and data phases for
+ *  several slave devices can be pipelined without the caller waiting.
+ *
  *  ### Scratch Buffers #
  *  A uint16_t scratch buffer is used to allow SPI_transfers where txBuf or rxBuf
  *  are NULL. Rather than requiring txBuf or rxBuf to have a dummy buffer of size
@@ -566,6 +582,16 @@ extern "C" {
  * wakeup it must be set to high before the SPI transfer.
  */
 #define SPICC26XXDMA_CMD_SET_CSN_WAKEUP         (SPI_CMD_RESERVED + 3)
+
+/*!
+ * @brief Command used by SPI_control to change the frame format and bit rate
+ *
+ * The frameFormat and bitRate of the SPI_Params pointed to by @b arg are
+ * applied to the following SPI_transfer calls, without closing and
+ * re-opening the driver. Returns SPI_STATUS_ERROR while a transfer is in
+ * progress, otherwise SPI_STATUS_SUCCESS.
+ */
+#define SPICC26XXDMA_CMD_SET_FRAME_FORMAT       (SPI_CMD_RESERVED + 4)
 /** @}*/
 
 /* BACKWARDS COMPATIBILITY */
@@ -605,6 +631,49 @@ typedef enum SPICC26XXDMA_FrameSize {
  */
 typedef void        (*SPICC26XXDMA_CallbackFxn) (SPI_Handle handle);
 
+/*!
+ *  @brief  A transaction for SPICC26XXDMA_queueTransfer()
+ *
+ *  Each queued transaction carries its own bus settings, so transactions
+ *  for several slave devices can be queued back to back. The structure
+ *  must stay valid until its callback has been called.
+ */
+typedef struct SPICC26XXDMA_QueuedTransaction {
+    SPI_Transaction        transaction;     /*!< count, txBuf, rxBuf and arg of the transfer */
+    SPI_FrameFormat        frameFormat;     /*!< Frame format to use for this transaction */
+    uint32_t               bitRate;         /*!< Bit rate to use for this transaction */
+    /*! @brief Software chip select, or PIN_UNASSIGNED
+
+        The pin is driven low for the length of the transaction and high
+        afterwards. It must already be configured as a GPIO output. */
+    PIN_Id                 csnPin;
+    SPI_CallbackFxn        callbackFxn;     /*!< Completion callback, or NULL for the one given to SPI_open() */
+    struct SPICC26XXDMA_QueuedTransaction *next;  /*!< For internal use by the driver */
+} SPICC26XXDMA_QueuedTransaction;
+
+/*!
+ *  @brief  Function to queue a transaction on a SPI opened in
+ *          ::SPI_MODE_CALLBACK
+ *
+ *  If the bus is idle the transaction starts right away. Otherwise it is
+ *  started from the completion Swi of the transaction ahead of it, before
+ *  that transaction's callback is called, so queued transactions follow
+ *  each other without waiting on the caller. A direct SPI_transfer() that
+ *  holds the bus delays the queue until it completes; queued transactions
+ *  are never failed because of it.
+ *
+ *  @pre    SPICC26XXDMA_open() has to be called first.
+ *          Calling context: Hwi, Swi, Task
+ *
+ *  @param  handle  A SPI handle returned from SPI_open()
+ *
+ *  @param  entry   Transaction to queue
+ *
+ *  @return true if the transaction was queued, false if the SPI is in
+ *          ::SPI_MODE_BLOCKING or the transaction is empty
+ */
+extern bool SPICC26XXDMA_queueTransfer(SPI_Handle handle, SPICC26XXDMA_QueuedTransaction *entry);
+
 /*!
  *  @brief  SPICC26XXDMA Hardware attributes
  *
@@ -759,6 +828,19 @@ typedef struct SPICC26XXDMA_Object {
     volatile bool          spiPowerConstraint; /*!< SPI power constraint flag, guard to avoid power constraints getting out of sync */
 
     bool                   isOpen;             /*!< Has the object been opened */
+
+    /* Ping-pong state for transactions longer than one uDMA segment */
+    size_t                 txQueued;           /*!< Frames handed to the TX uDMA channel */
+    size_t                 rxQueued;           /*!< Frames handed to the RX uDMA channel */
+    uint8_t                txArmed;            /*!< TX control table entries in flight (bit 0 primary, bit 1 alternate) */
+    uint8_t                rxArmed;            /*!< RX control table entries in flight (bit 0 primary, bit 1 alternate) */
+    uint8_t                txNext;             /*!< TX control table entry expected to finish next */
+    uint8_t                rxNext;             /*!< RX control table entry expected to finish next */
+
+    /* Queued transactions, see SPICC26XXDMA_queueTransfer() */
+    SPICC26XXDMA_QueuedTransaction *queueHead;  /*!< Next queued transaction to start */
+    SPICC26XXDMA_QueuedTransaction *queueTail;  /*!< Last queued transaction */
+    SPICC26XXDMA_QueuedTransaction *currentEntry; /*!< Queued transaction in progress */
 } SPICC26XXDMA_Object, *SPICC26XXDMA_Handle;
 
 
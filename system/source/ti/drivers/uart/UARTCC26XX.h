@@ -369,7 +369,7 @@ extern "C" {
 #include <ti/drivers/UART.h>
 #include <ti/drivers/pin/PINCC26XX.h>
 #include <ti/drivers/Power.h>
-#include <ti/drivers/utils/RingBuf.h>
+#include <ti/drivers/utils/SPSCRing.h>
 
 #ifdef DEVICE_FAMILY
     #undef DEVICE_FAMILY_PATH
@@ -520,7 +520,7 @@ typedef struct UARTCC26XX_HWAttrsV2 {
     uint8_t         ctsPin;       /*!< UART CTS pin */
     uint8_t         rtsPin;       /*!< UART RTS pin */
     unsigned char  *ringBufPtr;   /*! Pointer to an application ring buffer */
-    size_t          ringBufSize;  /*! Size of ringBufPtr */
+    size_t          ringBufSize;  /*! Size of ringBufPtr, a power of two */
 } UARTCC26XX_HWAttrsV2;
 
 /*!
@@ -593,7 +593,7 @@ typedef struct UARTCC26XX_Object {
     size_t                readSize;           /*!< Chars remaining in buffer */
     UART_FifoThreshold    readFifoThreshold;  /*! Threshold for generating RX IRQ */
     uint8_t               writeFifoThreshold; /*! Threshold for generating TX IRQ */
-    RingBuf_Object        ringBuffer;         /*! local circular buffer object */
+    SPSCRing_Object       ringBuffer;         /*! local circular buffer object */
 
     /* PIN driver state object and handle */
     PIN_State              pinState;
@@ -610,6 +610,8 @@ typedef struct UARTCC26XX_Object {
     Semaphore_Struct     writeSem;           /*!< UART write semaphore*/
     Semaphore_Struct     readSem;            /*!< UART read semaphore */
     Clock_Struct         txFifoEmptyClk;     /*!< UART TX FIFO empty clock */
+
+    uint32_t             rxOverruns;         /*!< RX overrun errors since UART_open() */
 } UARTCC26XX_Object, *UARTCC26XX_Handle;
 
 
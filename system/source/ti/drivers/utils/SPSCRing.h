@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       SPSCRing.h
+ *
+ *  @brief      Single-producer/single-consumer lock-free byte ring
+ *
+ *  A SPSCRing moves bytes from exactly one producer context to exactly one
+ *  consumer context, e.g. from a UART Hwi to a Task, without disabling
+ *  interrupts. The producer only ever writes the head index and the
+ *  consumer only ever writes the tail index; a memory barrier between the
+ *  data access and the index update orders the two for the other side.
+ *
+ *  The capacity must be a power of two. head and tail count bytes and run
+ *  freely, wrapping at SIZE_MAX + 1, so the full capacity is usable and no
+ *  modulo operations are needed.
+ *
+ *  Besides the copying ::SPSCRing_write and ::SPSCRing_read, the ring can
+ *  be accessed in place: ::SPSCRing_peekSpans returns the (up to two)
+ *  contiguous regions holding data, ::SPSCRing_reserveSpans the regions
+ *  that are free. After working on them, ::SPSCRing_consume and
+ *  ::SPSCRing_commit hand the bytes over to the other side. This lets a
+ *  driver DMA or UART_read straight into the ring.
+ *
+ *  @code
+ *  static unsigned char rxData[64];
+ *  SPSCRing_Object rx;
+ *
+ *  SPSCRing_construct(&rx, rxData, sizeof(rxData));
+ *
+ *  // producer, e.g. a Hwi
+ *  SPSCRing_write(&rx, fifo, n);
+ *
+ *  // consumer, e.g. a Task
+ *  n = SPSCRing_read(&rx, buf, sizeof(buf));
+ *  @endcode
+ *
+ *  If there are several producers (or several consumers), they must be
+ *  serialized among themselves; the other side still needs no lock.
+ *
+ *  All functions are static inline so they fold into the driver using
+ *  them; there is nothing to link.
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_utils_SPSCRing__include
+#define ti_drivers_utils_SPSCRing__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ *  Orders the data accesses before an index update against the other
+ *  side. On a single Cortex-M3 core a compiler barrier would do for
+ *  Hwi vs. Task, but DMB also covers other bus masters and SMP hosts.
+ */
+#if defined(__GNUC__)
+#define SPSCRing_barrier()  __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define SPSCRing_barrier()  __DMB()
+#else
+#define SPSCRing_barrier()  __asm(" dmb")
+#endif
+
+/*!
+ *  @brief  SPSCRing object
+ *
+ *  head is only written by the producer, tail only by the consumer.
+ */
+typedef struct SPSCRing_Object {
+    unsigned char      *buffer;
+    size_t              mask;       /*!< capacity - 1 */
+    volatile size_t     head;       /*!< bytes written since construct */
+    volatile size_t     tail;       /*!< bytes read since construct */
+} SPSCRing_Object, *SPSCRing_Handle;
+
+/*!
+ *  @brief  A contiguous region of the ring
+ */
+typedef struct SPSCRing_Span {
+    unsigned char      *buf;
+    size_t              len;
+} SPSCRing_Span;
+
+/*!
+ *  @brief  Initialize a ring
+ *
+ *  Not thread-safe: neither side may use the ring while it is constructed.
+ *
+ *  @param  object  Pointer to a SPSCRing Object
+ *
+ *  @param  bufPtr  Pointer to the storage of the ring
+ *
+ *  @param  bufSize Size of bufPtr in bytes, must be a power of two
+ *
+ *  @return         false if bufSize is not a power of two
+ */
+static inline bool SPSCRing_construct(SPSCRing_Handle object,
+    unsigned char *bufPtr, size_t bufSize)
+{
+    if (bufSize == 0 || (bufSize & (bufSize - 1)) != 0) {
+        return (false);
+    }
+
+    object->buffer = bufPtr;
+    object->mask = bufSize - 1;
+    object->head = 0;
+    object->tail = 0;
+
+    return (true);
+}
+
+/*!
+ *  @brief  Capacity of the ring in bytes
+ */
+static inline size_t SPSCRing_getSize(SPSCRing_Handle object)
+{
+    return (object->mask + 1);
+}
+
+/*!
+ *  @brief  Number of bytes waiting to be read
+ *
+ *  Exact when called by the consumer; a lower bound for anyone else.
+ */
+static inline size_t SPSCRing_getCount(SPSCRing_Handle object)
+{
+    return (object->head - object->tail);
+}
+
+/*!
+ *  @brief  Number of bytes that can be written
+ *
+ *  Exact when called by the producer; a lower bound for anyone else.
+ */
+static inline size_t SPSCRing_getSpace(SPSCRing_Handle object)
+{
+    return (object->mask + 1 - (object->head - object->tail));
+}
+
+/*!
+ *  @brief  Get the regions holding data (consumer only)
+ *
+ *  @param  object  Pointer to a SPSCRing Object
+ *
+ *  @param  spans   Filled with up to two regions, oldest data first;
+ *                  unused entries have len 0
+ *
+ *  @return         Total number of bytes in spans
+ */
+static inline size_t SPSCRing_peekSpans(SPSCRing_Handle object,
+    SPSCRing_Span spans[2])
+{
+    size_t tail = object->tail;
+    size_t count = object->head - tail;
+    size_t offset = tail & object->mask;
+    size_t first = object->mask + 1 - offset;
+
+    /* read the data only after seeing the producer's head update */
+    SPSCRing_barrier();
+
+    if (first > count) {
+        first = count;
+    }
+    spans[0].buf = object->buffer + offset;
+    spans[0].len = first;
+    spans[1].buf = object->buffer;
+    spans[1].len = count - first;
+
+    return (count);
+}
+
+/*!
+ *  @brief  Release bytes returned by SPSCRing_peekSpans (consumer only)
+ */
+static inline void SPSCRing_consume(SPSCRing_Handle object, size_t count)
+{
+    /* finish reading the data before the producer may reuse it */
+    SPSCRing_barrier();
+
+    object->tail += count;
+}
+
+/*!
+ *  @brief  Get the free regions of the ring (producer only)
+ *
+ *  @param  object  Pointer to a SPSCRing Object
+ *
+ *  @param  spans   Filled with up to two free regions, in order;
+ *                  unused entries have len 0
+ *
+ *  @return         Total number of bytes in spans
+ */
+static inline size_t SPSCRing_reserveSpans(SPSCRing_Handle object,
+    SPSCRing_Span spans[2])
+{
+    size_t head = object->head;
+    size_t space = object->mask + 1 - (head - object->tail);
+    size_t offset = head & object->mask;
+    size_t first = object->mask + 1 - offset;
+
+    /* write the data only after seeing the consumer's tail update */
+    SPSCRing_barrier();
+
+    if (first > space) {
+        first = space;
+    }
+    spans[0].buf = object->buffer + offset;
+    spans[0].len = first;
+    spans[1].buf = object->buffer;
+    spans[1].len = space - first;
+
+    return (space);
+}
+
+/*!
+ *  @brief  Publish bytes written into SPSCRing_reserveSpans (producer only)
+ */
+static inline void SPSCRing_commit(SPSCRing_Handle object, size_t count)
+{
+    /* the data must be visible before the consumer sees the new head */
+    SPSCRing_barrier();
+
+    object->head += count;
+}
+
+/*!
+ *  @brief  Copy up to len bytes into the ring (producer only)
+ *
+ *  @return         Number of bytes written
+ */
+static inline size_t SPSCRing_write(SPSCRing_Handle object, const void *src,
+    size_t len)
+{
+    SPSCRing_Span spans[2];
+    size_t count = SPSCRing_reserveSpans(object, spans);
+
+    if (count > len) {
+        count = len;
+    }
+    if (count <= spans[0].len) {
+        memcpy(spans[0].buf, src, count);
+    }
+    else {
+        memcpy(spans[0].buf, src, spans[0].len);
+        memcpy(spans[1].buf, (const unsigned char *)src + spans[0].len,
+            count - spans[0].len);
+    }
+
+    SPSCRing_commit(object, count);
+
+    return (count);
+}
+
+/*!
+ *  @brief  Copy up to len bytes out of the ring (consumer only)
+ *
+ *  @return         Number of bytes read
+ */
+static inline size_t SPSCRing_read(SPSCRing_Handle object, void *dst,
+    size_t len)
+{
+    SPSCRing_Span spans[2];
+    size_t count = SPSCRing_peekSpans(object, spans);
+
+    if (count > len) {
+        count = len;
+    }
+    if (count <= spans[0].len) {
+        memcpy(dst, spans[0].buf, count);
+    }
+    else {
+        memcpy(dst, spans[0].buf, spans[0].len);
+        memcpy((unsigned char *)dst + spans[0].len, spans[1].buf,
+            count - spans[0].len);
+    }
+
+    SPSCRing_consume(object, count);
+
+    return (count);
+}
+
+/*!
+ *  @brief  Put one byte into the ring (producer only)
+ *
+ *  @return         false if the ring is full
+ */
+static inline bool SPSCRing_put(SPSCRing_Handle object, unsigned char data)
+{
+    size_t head = object->head;
+
+    if (head - object->tail > object->mask) {
+        return (false);
+    }
+    SPSCRing_barrier();
+    object->buffer[head & object->mask] = data;
+    SPSCRing_commit(object, 1);
+
+    return (true);
+}
+
+/*!
+ *  @brief  Take one byte from the ring (consumer only)
+ *
+ *  @return         false if the ring is empty
+ */
+static inline bool SPSCRing_get(SPSCRing_Handle object, unsigned char *data)
+{
+    size_t tail = object->tail;
+
+    if (object->head == tail) {
+        return (false);
+    }
+    SPSCRing_barrier();
+    *data = object->buffer[tail & object->mask];
+    SPSCRing_consume(object, 1);
+
+    return (true);
+}
+
+/*!
+ *  @brief  Look at the oldest byte without removing it (consumer only)
+ *
+ *  @return         false if the ring is empty
+ */
+static inline bool SPSCRing_peek(SPSCRing_Handle object, unsigned char *data)
+{
+    size_t tail = object->tail;
+
+    if (object->head == tail) {
+        return (false);
+    }
+    SPSCRing_barrier();
+    *data = object->buffer[tail & object->mask];
+
+    return (true);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_utils_SPSCRing__include */
@@ -241,6 +241,16 @@ typedef enum CC1350STK_ADCName {
     CC1350STK_ADCCOUNT
 } CC1350STK_ADCName;
 
+/*!
+ *  @def    CC1350STK_ADCBufName
+ *  @brief  Enum of ADCBufs
+ */
+typedef enum CC1350STK_ADCBufName {
+    CC1350STK_ADCBUF0 = 0,
+
+    CC1350STK_ADCBUFCOUNT
+} CC1350STK_ADCBufName;
+
 /*!
  *  @def    CC1350STK_I2CName
  *  @brief  Enum of I2C names on the CC1350 dev board
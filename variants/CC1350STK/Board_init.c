@@ -187,6 +187,46 @@ const ADC_Config ADC_config[CC1350STK_ADCCOUNT] = {
 
 const uint_least8_t ADC_count = CC1350STK_ADCCOUNT;
 
+/*
+ *  =============================== ADCBuf ===============================
+ *  Virtual channels in the same order as the ADC instances above, so an
+ *  ADC index is also an ADCBuf channel.
+ */
+#include <ti/drivers/ADCBuf.h>
+#include <ti/drivers/adcbuf/ADCBufCC26XX.h>
+
+ADCBufCC26XX_Object adcBufCC26xxObjects[CC1350STK_ADCBUFCOUNT];
+
+const ADCBufCC26XX_AdcChannelLutEntry ADCBufCC26XX_adcChannelLut[CC1350STK_ADCCOUNT] = {
+    {CC1350STK_DIO23_ANALOG, ADC_COMPB_IN_AUXIO7},
+    {CC1350STK_DIO24_ANALOG, ADC_COMPB_IN_AUXIO6},
+    {CC1350STK_DIO25_ANALOG, ADC_COMPB_IN_AUXIO5},
+    {CC1350STK_DIO26_ANALOG, ADC_COMPB_IN_AUXIO4},
+    {CC1350STK_DIO27_ANALOG, ADC_COMPB_IN_AUXIO3},
+    {CC1350STK_DIO28_ANALOG, ADC_COMPB_IN_AUXIO2},
+    {CC1350STK_DIO29_ANALOG, ADC_COMPB_IN_AUXIO1},
+    {CC1350STK_DIO30_ANALOG, ADC_COMPB_IN_AUXIO0},
+    {PIN_UNASSIGNED, ADC_COMPB_IN_DCOUPL},
+    {PIN_UNASSIGNED, ADC_COMPB_IN_VSS},
+    {PIN_UNASSIGNED, ADC_COMPB_IN_VDDS},
+};
+
+const ADCBufCC26XX_HWAttrs adcBufCC26xxHWAttrs[CC1350STK_ADCBUFCOUNT] = {
+    {
+        .intPriority       = ~0,
+        .swiPriority       = 0,
+        .adcChannelLut     = ADCBufCC26XX_adcChannelLut,
+        .gpTimerUnit       = CC1350STK_GPTIMER0A,
+        .gptDMAChannelMask = 1 << UDMA_CHAN_TIMER0_A,
+    }
+};
+
+const ADCBuf_Config ADCBuf_config[CC1350STK_ADCBUFCOUNT] = {
+    {&ADCBufCC26XX_fxnTable, &adcBufCC26xxObjects[CC1350STK_ADCBUF0], &adcBufCC26xxHWAttrs[CC1350STK_ADCBUF0]},
+};
+
+const uint_least8_t ADCBuf_count = CC1350STK_ADCBUFCOUNT;
+
 /*
  *  ========================= IO driver initialization =========================
  *  From main, PIN_init(BoardGpioInitTable) should be called to setup safe
@@ -51,4 +51,45 @@ static const uint8_t A4 = 12;
 static const uint8_t A5 = 17;
 static const uint8_t A6 = 10;
 
+/*
+ * DIO number behind each pin, used by the digitalWriteFast() family
+ */
+#define NOT_A_DIO 0xff
+
+static const uint8_t digital_pin_to_dio[] = {
+    NOT_A_DIO,  /*  0  - dummy */
+    NOT_A_DIO,  /*  1  - VDD */
+    NOT_A_DIO,  /*  2  - GND */
+    6,          /*  3  - DIO_06 SCL */
+    5,          /*  4  - DIO_05 SDA */
+    16,         /*  5  - DIO_16 DP12/AUDIO FS/TD0 */
+    3,          /*  6  - DIO_03 DP7/AUDIO CLK */
+    20,         /*  7  - DIO_20 DP11/CSN */
+    22,         /*  8  - DIO_22 DP6/AUDIO DO */
+    NOT_A_DIO,  /*  9  - VDD */
+    29,         /*  10 - DIO_29 DP5/UART_TX */
+    19,         /*  11 - DIO_19 DP10/MOSI */
+    28,         /*  12 - DIO_28 DP4/UART_RX */
+    18,         /*  13 - DIO_18 DP9/MISO */
+    27,         /*  14 - DIO_27 DP3 */
+    17,         /*  15 - DIO_17 DP8/SCLK/TDI */
+    23,         /*  16 - DIO_23 DP2  */
+    30,         /*  17 - DIO_30 DP_ID */
+    24,         /*  18 - DIO_24 DP1 */
+    NOT_A_DIO,  /*  19 - POWER_GOOD */
+    25,         /*  20 - DIO_25 DP0 */
+    2,          /*  21 - DIO_02 AUDIO DI */
+    12,         /*  22 - DIO_12 MPU PWR */
+    21,         /*  23 - DIO_21 BUZZER */
+    1,          /*  24 - DIO_01 REED */
+    4,          /*  25 - DIO_04 BUTTON1 */
+    11,         /*  26 - DIO_11 TMP RDY */
+    10,         /*  27 - DIO_10 LED1 */
+    7,          /*  28 - DIO_07 MPU INT */
+    13,         /*  29 - DIO_13 MIC PWR */
+    15,         /*  30 - DIO_15 BUTTON2 */
+    NOT_A_DIO,  /*  31 - dummy (LED2 on CC2650 STK) */
+    14,         /*  32 - DIO_14 FLASH CS */
+};
+
 #endif
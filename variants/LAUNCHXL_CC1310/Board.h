@@ -189,6 +189,16 @@ typedef enum CC1310_LAUNCHXL_ADCName {
     CC1310_LAUNCHXL_ADCCOUNT
 } CC1310_LAUNCHXL_ADCName;
 
+/*!
+ *  @def    CC1310_LAUNCHXL_ADCBufName
+ *  @brief  Enum of ADCBufs
+ */
+typedef enum CC1310_LAUNCHXL_ADCBufName {
+    CC1310_LAUNCHXL_ADCBUF0 = 0,
+
+    CC1310_LAUNCHXL_ADCBUFCOUNT
+} CC1310_LAUNCHXL_ADCBufName;
+
 /*!
  *  @def    CC1310_I2CName
  *  @brief  Enum of I2C names on the CC1310 dev board
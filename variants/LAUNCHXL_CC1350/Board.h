@@ -189,6 +189,16 @@ typedef enum CC1350_LAUNCHXL_ADCName {
     CC1350_LAUNCHXL_ADCCOUNT
 } CC1350_LAUNCHXL_ADCName;
 
+/*!
+ *  @def    CC1350_LAUNCHXL_ADCBufName
+ *  @brief  Enum of ADCBufs
+ */
+typedef enum CC1350_LAUNCHXL_ADCBufName {
+    CC1350_LAUNCHXL_ADCBUF0 = 0,
+
+    CC1350_LAUNCHXL_ADCBUFCOUNT
+} CC1350_LAUNCHXL_ADCBufName;
+
 /*!
  *  @def    CC1350_I2CName
  *  @brief  Enum of I2C names on the CC1350 dev board